@@ -0,0 +1,114 @@
+#ifndef UM_CLIENT_HPP
+#define UM_CLIENT_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "types.hpp"
+#include "connection.hpp"
+#include "operations/string_operations.hpp"
+#include "operations/hash_operations.hpp"
+#include "operations/list_operations.hpp"
+#include "operations/set_operations.hpp"
+#include "operations/sorted_set_operations.hpp"
+#include "operations/expiration_operations.hpp"
+#include "operations/generic_operations.hpp"
+#include "operations/batch_operations.hpp"
+#include "operations/server_operations.hpp"
+#include "operations/probabilistic_operations.hpp"
+
+namespace um {
+
+/**
+ * @brief 标准 C++ 客户端
+ *
+ * 不依赖 Qt; 常用命令捕获异常后以 bool/std::optional 返回, 失败原因通过 lastError() 获取;
+ * 完整命令集通过 strings()/hashes()/generic() 等操作视图访问, 视图失败时抛出 sw::redis::Error
+ *
+ * 同一 Client 可被多个线程共享(连接池负责并发); lastError() 加锁返回副本,
+ * 记录的是所有线程中最近一次失败, 多线程下不一定对应本线程的上一次调用
+ */
+class Client
+{
+public:
+    Client();
+    ~Client();
+
+    Client(const Client &) = delete;
+    Client& operator=(const Client &) = delete;
+
+    /**
+    * @brief 连接管理
+    *
+    * 连接到服务器(PING 成功才视为已连接),断开连接,检查是否已连接,最近一次失败原因
+    */
+    bool connect(const std::string &host = "127.0.0.1", int port = 6379);
+    bool connect(const ConnectionOptions &options);
+    void disconnect();
+    bool isConnected() const;
+    std::string lastError() const;
+
+    /**
+    * @brief 字符串与字节流操作
+    */
+    bool set(std::string_view key, std::string_view value);
+    OptionalString get(std::string_view key);
+    bool setBytes(std::string_view key, const Bytes &value);
+    OptionalBytes getBytes(std::string_view key);
+
+    /**
+    * @brief 哈希表,列表,集合,有序集合操作
+    */
+    bool hset(std::string_view key, std::string_view field, std::string_view value);
+    OptionalString hget(std::string_view key, std::string_view field);
+    bool lpush(std::string_view key, std::string_view value);
+    OptionalString lpop(std::string_view key);
+    bool sadd(std::string_view key, std::string_view member);
+    bool sismember(std::string_view key, std::string_view member);
+    bool zadd(std::string_view key, double score, std::string_view member);
+
+    /**
+    * @brief 键与过期操作
+    *
+    * 失败时 ttl 返回 -2(与键不存在相同)
+    */
+    bool del(std::string_view key);
+    bool exists(std::string_view key);
+    bool expire(std::string_view key, long long seconds);
+    long long ttl(std::string_view key);
+
+    /**
+    * @brief 操作视图
+    *
+    * 未连接时调用属于使用错误, 抛出 std::logic_error
+    */
+    StringOperations strings() const;
+    HashOperations hashes() const;
+    ListOperations lists() const;
+    SetOperations sets() const;
+    SortedSetOperations sortedSets() const;
+    ExpirationOperations expiration() const;
+    GenericOperations generic() const;
+    BatchOperations batches() const;
+    ServerOperations server() const;
+    ProbabilisticOperations probabilistic() const;
+
+    Connection* connection() const noexcept;
+
+private:
+    template <typename Func, typename Default>
+    auto guarded(Func &&func, Default defaultValue) -> decltype(func());
+
+    sw::redis::Redis& redis() const;
+    void setLastError(std::string error);
+
+    std::unique_ptr<Connection> connection_;
+    mutable std::mutex errorMutex_;
+    std::string lastError_;
+};
+
+} // namespace um
+
+#endif // UM_CLIENT_HPP
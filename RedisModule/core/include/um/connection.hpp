@@ -0,0 +1,86 @@
+#ifndef UM_CONNECTION_HPP
+#define UM_CONNECTION_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 连接配置
+ *
+ * 超时为 0 表示不限制; poolSize 为连接池大小, poolWaitTimeout 为连接池耗尽时等待空闲连接的超时
+ */
+struct ConnectionOptions
+{
+    std::string host = "127.0.0.1";
+    int port = 6379;
+    std::chrono::milliseconds connectTimeout{1000};
+    std::chrono::milliseconds socketTimeout{0};
+    std::size_t poolSize = 1;
+    std::chrono::milliseconds poolWaitTimeout{0};
+};
+
+/**
+ * @brief 预热时单个连接的建连耗时(连接已存在时接近 0)与 PING 往返时间
+ */
+struct ConnectionWarmUp
+{
+    std::chrono::microseconds connectTime{0};
+    std::chrono::microseconds rtt{0};
+};
+
+/**
+ * @brief Redis 连接池
+ *
+ * 持有一个 redis-plus-plus 连接池, 连接在首次使用时建立;
+ * 操作类(StringOperations 等)以引用方式借用 redis(), 不拥有连接
+ */
+class Connection
+{
+public:
+    explicit Connection(const ConnectionOptions &options = ConnectionOptions());
+    ~Connection();
+
+    Connection(const Connection &) = delete;
+    Connection& operator=(const Connection &) = delete;
+
+    /**
+    * @brief 获取底层客户端与配置
+    */
+    sw::redis::Redis& redis() const noexcept;
+    const ConnectionOptions& options() const noexcept;
+
+    /**
+    * @brief 探测服务器是否可达, 失败时抛出 sw::redis::Error
+    */
+    void ping() const;
+
+    /**
+    * @brief 预热连接池
+    *
+    * 同时借出连接池中的 maxConnections 个连接(0 表示全部), 尚未建立的连接此时建立;
+    * 每个连接 PING pings 次(至少 2 次), 除首次外取最小往返时间, 之后全部归还。
+    * 借出连接受 poolWaitTimeout 约束: 等待超时时停止借出并返回已预热的部分(第一个连接即超时则抛出);
+    * poolWaitTimeout 为 0 时等待不限时, 连接池可能被其他线程占用时应限制 maxConnections。
+    * 其他失败抛出 sw::redis::Error
+    */
+    std::vector<ConnectionWarmUp> warmUp(int pings = 3, std::size_t maxConnections = 0) const;
+
+private:
+    ConnectionOptions options_;
+    std::unique_ptr<sw::redis::Redis> redis_;
+};
+
+} // namespace um
+
+#endif // UM_CONNECTION_HPP
@@ -0,0 +1,70 @@
+#ifndef UM_BATCH_OPERATIONS_HPP
+#define UM_BATCH_OPERATIONS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "um/types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 流水线中单条命令的应答
+ *
+ * 字符串与状态应答存入 str, 整数应答存入 integer, 数组应答只记录元素数量;
+ * 服务器错误不抛出, 以 Error 类型记录错误信息, 不影响同一批次的其他命令
+ */
+struct Reply
+{
+    enum class Type
+    {
+        Nil,
+        String,
+        Integer,
+        Array,
+        Error
+    };
+
+    Type type = Type::Nil;
+    std::string str;
+    long long integer = 0;
+    std::size_t elements = 0;
+};
+
+/**
+ * @brief 批量操作, 连接错误时抛出 sw::redis::Error
+ */
+class BatchOperations
+{
+public:
+    explicit BatchOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 多键操作
+    *
+    * 一次往返设置多个(键, 值),一次往返读取多个键(不存在的键为空)
+    */
+    void mset(const std::vector<FieldValue> &items);
+    std::vector<OptionalString> mget(const KeyList &keys);
+
+    /**
+    * @brief 流水线
+    *
+    * 每条命令为完整参数列表(命令名在前), 全部命令一次写出后按顺序读取应答
+    */
+    std::vector<Reply> pipeline(const std::vector<KeyList> &commands);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_BATCH_OPERATIONS_HPP
@@ -0,0 +1,39 @@
+#ifndef UM_EXPIRATION_OPERATIONS_HPP
+#define UM_EXPIRATION_OPERATIONS_HPP
+
+#include <string_view>
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 过期操作, 失败时抛出 sw::redis::Error
+ */
+class ExpirationOperations
+{
+public:
+    explicit ExpirationOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 过期操作
+    *
+    * 设置过期时间(秒),设置过期时间(Unix 时间戳, 秒)
+    * 获取剩余生存时间(-1 无过期时间, -2 键不存在),移除过期时间
+    */
+    bool expire(std::string_view key, long long seconds);
+    bool expireat(std::string_view key, long long timestamp);
+    long long ttl(std::string_view key);
+    bool persist(std::string_view key);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_EXPIRATION_OPERATIONS_HPP
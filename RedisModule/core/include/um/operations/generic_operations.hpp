@@ -0,0 +1,48 @@
+#ifndef UM_GENERIC_OPERATIONS_HPP
+#define UM_GENERIC_OPERATIONS_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 键操作, 失败时抛出 sw::redis::Error
+ */
+class GenericOperations
+{
+public:
+    explicit GenericOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 键操作
+    *
+    * 删除键并返回删除数量,检查键是否存在,查找符合模式的键
+    */
+    long long del(std::string_view key);
+    bool exists(std::string_view key);
+    std::vector<std::string> keys(std::string_view pattern);
+
+    /**
+    * @brief 增量遍历
+    *
+    * 从 cursor 开始遍历一批符合模式的键并追加到 keys, count 为每批建议数量,
+    * 返回下一次遍历的游标, 0 表示已遍历完
+    */
+    unsigned long long scan(unsigned long long cursor, std::string_view pattern, long long count,
+                            std::vector<std::string> &keys);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_GENERIC_OPERATIONS_HPP
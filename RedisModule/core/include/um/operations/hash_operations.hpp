@@ -0,0 +1,54 @@
+#ifndef UM_HASH_OPERATIONS_HPP
+#define UM_HASH_OPERATIONS_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 哈希表操作, 失败时抛出 sw::redis::Error
+ */
+class HashOperations
+{
+public:
+    explicit HashOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 哈希表操作
+    *
+    * 设置字段(新建字段时返回 true),获取字段值,获取全部字段和值,删除字段并返回删除数量
+    * 检查字段是否存在,获取全部字段名,获取字段数量
+    */
+    bool hset(std::string_view key, std::string_view field, std::string_view value);
+    OptionalString hget(std::string_view key, std::string_view field);
+    std::unordered_map<std::string, std::string> hgetall(std::string_view key);
+    long long hdel(std::string_view key, std::string_view field);
+    bool hexists(std::string_view key, std::string_view field);
+    std::vector<std::string> hkeys(std::string_view key);
+    long long hlen(std::string_view key);
+
+    /**
+    * @brief 批量操作
+    *
+    * 一次往返设置多个字段, 返回新建字段数量
+    */
+    long long hset(std::string_view key, const std::vector<FieldValue> &fields);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_HASH_OPERATIONS_HPP
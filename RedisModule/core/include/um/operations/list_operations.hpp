@@ -0,0 +1,65 @@
+#ifndef UM_LIST_OPERATIONS_HPP
+#define UM_LIST_OPERATIONS_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 列表端点, 对应 LEFT/RIGHT 参数
+ */
+enum class ListEnd
+{
+    Left,
+    Right
+};
+
+/**
+ * @brief 列表操作, 失败时抛出 sw::redis::Error
+ */
+class ListOperations
+{
+public:
+    explicit ListOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 列表操作
+    *
+    * 左侧/右侧推入并返回列表长度,左侧/右侧弹出(列表为空时为空)
+    * 获取指定范围内的元素,获取列表长度,获取指定索引的元素
+    */
+    long long lpush(std::string_view key, std::string_view value);
+    long long rpush(std::string_view key, std::string_view value);
+    OptionalString lpop(std::string_view key);
+    OptionalString rpop(std::string_view key);
+    std::vector<std::string> lrange(std::string_view key, long long start, long long stop);
+    long long llen(std::string_view key);
+    OptionalString lindex(std::string_view key, long long index);
+
+    /**
+    * @brief 批量与移动操作
+    *
+    * 一次往返从右侧推入多个值,按值删除元素(count 含义同 LREM, 返回删除数量)
+    * 从 source 的一端弹出元素并原子推入 destination 的一端
+    */
+    long long rpush(std::string_view key, const KeyList &values);
+    long long lrem(std::string_view key, long long count, std::string_view value);
+    OptionalString lmove(std::string_view source, std::string_view destination, ListEnd from, ListEnd to);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_LIST_OPERATIONS_HPP
@@ -0,0 +1,88 @@
+#ifndef UM_PROBABILISTIC_OPERATIONS_HPP
+#define UM_PROBABILISTIC_OPERATIONS_HPP
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief BITOP 的位运算
+ */
+enum class BitOperation
+{
+    And,
+    Or,
+    Xor,
+    Not
+};
+
+/**
+ * @brief HyperLogLog 与位图操作, 失败时抛出 sw::redis::Error
+ *
+ * HyperLogLog 以固定的至多 12KB 估计去重计数(标准误差 0.81%), 适合替代只用于计数的大集合;
+ * 位图以偏移量为下标, 每个标志只占 1 位
+ */
+class ProbabilisticOperations
+{
+public:
+    explicit ProbabilisticOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief HyperLogLog 操作
+    *
+    * 添加元素(估计值变化时返回 true),估计单个键或多个键并集的去重数量,把多个键合并到目标键
+    */
+    bool pfadd(std::string_view key, std::string_view element);
+    bool pfadd(std::string_view key, const KeyList &elements);
+    long long pfcount(std::string_view key);
+    long long pfcount(const KeyList &keys);
+    void pfmerge(std::string_view destination, const KeyList &sources);
+
+    /**
+    * @brief 位图操作
+    *
+    * 设置位并返回原值,读取位,统计字节区间[start, end]内为 1 的位数,
+    * 查找字节区间内第一个值为 bit 的位(不存在时为 -1),对多个键做位运算并返回结果长度(字节)
+    */
+    bool setbit(std::string_view key, long long offset, bool value);
+    bool getbit(std::string_view key, long long offset);
+    long long bitcount(std::string_view key, long long start = 0, long long end = -1);
+    long long bitpos(std::string_view key, bool bit, long long start = 0, long long end = -1);
+    long long bitop(BitOperation operation, std::string_view destination, const KeyList &keys);
+
+    /**
+    * @brief BITFIELD
+    *
+    * subcommands 为子命令参数(如 "INCRBY", "u8", "#0", "1", "OVERFLOW", "SAT"),
+    * 按顺序返回每个 GET/SET/INCRBY 的结果, OVERFLOW FAIL 时溢出的结果为空
+    */
+    std::vector<OptionalLongLong> bitfield(std::string_view key, const KeyList &subcommands);
+
+    /**
+    * @brief 批量操作
+    *
+    * 一次往返设置/读取同一个键的多个位(BITFIELD u1), 设置时返回各位原值;
+    * 一次往返向多个键各添加一个元素, 分别估计多个键的去重数量(流水线)
+    */
+    std::vector<bool> setbits(std::string_view key, const std::vector<std::pair<long long, bool>> &bits);
+    std::vector<bool> getbits(std::string_view key, const std::vector<long long> &offsets);
+    std::vector<bool> pfaddEach(const std::vector<FieldValue> &keyElements);
+    std::vector<long long> pfcountEach(const KeyList &keys);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_PROBABILISTIC_OPERATIONS_HPP
@@ -0,0 +1,103 @@
+#ifndef UM_SERVER_OPERATIONS_HPP
+#define UM_SERVER_OPERATIONS_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "um/types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief SLOWLOG GET 的一条记录
+ *
+ * timestamp 为服务器时钟的 Unix 秒, durationUs 为命令在服务器内的执行时间(不含排队与网络);
+ * 服务器最多保留 32 个参数, 过长的参数会被截断
+ */
+struct SlowLogEntry
+{
+    long long id = 0;
+    long long timestamp = 0;
+    long long durationUs = 0;
+    std::vector<std::string> args;
+    std::string client;
+    std::string clientName;
+};
+
+/**
+ * @brief LATENCY LATEST 的一个事件(command/fork/aof-fsync-always 等)
+ *
+ * timestamp 为最近一次超过 latency-monitor-threshold 的 Unix 秒
+ */
+struct LatencyEvent
+{
+    std::string event;
+    long long timestamp = 0;
+    long long latestMs = 0;
+    long long maxMs = 0;
+};
+
+/**
+ * @brief 服务器管理操作, 失败时抛出 sw::redis::Error
+ *
+ * 面向运维与压测(持久化、数据集规模), 业务代码通常不需要
+ */
+class ServerOperations
+{
+public:
+    explicit ServerOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 信息与配置
+    *
+    * INFO 原始文本(section 为空时返回默认段),读取配置项(不存在时为空),修改配置项
+    */
+    std::string info(std::string_view section = std::string_view());
+    OptionalString configGet(std::string_view parameter);
+    void configSet(std::string_view parameter, std::string_view value);
+
+    /**
+    * @brief 持久化
+    *
+    * 后台 RDB 快照,前台(阻塞)RDB 快照,后台 AOF 重写,最近一次成功快照的 Unix 时间戳
+    */
+    void bgsave();
+    void save();
+    void bgrewriteaof();
+    long long lastsave();
+
+    /**
+    * @brief 数据集
+    *
+    * 当前库键数量,清空当前库
+    * DEBUG POPULATE 在服务器端生成 count 个 <prefix>:<n> 键(值长度 valueSize, 已存在的键跳过),
+    * 需要服务器允许 DEBUG 命令(Redis 7 起 enable-debug-command)
+    */
+    long long dbsize();
+    void flushdb();
+    void debugPopulate(long long count, std::string_view prefix, long long valueSize);
+
+    /**
+    * @brief 延迟诊断
+    *
+    * 最近 count 条慢查询(从新到旧, count < 0 时返回全部),清空慢查询日志,
+    * 各事件最近一次的延迟尖峰(未开启 latency-monitor-threshold 时为空)
+    */
+    std::vector<SlowLogEntry> slowlogGet(long long count);
+    void slowlogReset();
+    std::vector<LatencyEvent> latencyLatest();
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_SERVER_OPERATIONS_HPP
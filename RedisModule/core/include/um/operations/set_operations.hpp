@@ -0,0 +1,56 @@
+#ifndef UM_SET_OPERATIONS_HPP
+#define UM_SET_OPERATIONS_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 集合操作, 失败时抛出 sw::redis::Error
+ *
+ * 成员列表按服务器返回顺序放入 std::vector, 不做去重或排序
+ */
+class SetOperations
+{
+public:
+    explicit SetOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 集合操作
+    *
+    * 添加成员并返回新增数量,检查成员是否存在,移除成员并返回移除数量,获取全部成员,获取成员数量
+    * 获取多个集合的并集,交集,差集
+    */
+    long long sadd(std::string_view key, std::string_view member);
+    bool sismember(std::string_view key, std::string_view member);
+    long long srem(std::string_view key, std::string_view member);
+    std::vector<std::string> smembers(std::string_view key);
+    long long scard(std::string_view key);
+    std::vector<std::string> sunion(const KeyList &keys);
+    std::vector<std::string> sinter(const KeyList &keys);
+    std::vector<std::string> sdiff(const KeyList &keys);
+
+    /**
+    * @brief 批量操作
+    *
+    * 一次往返添加多个成员, 返回新增数量
+    */
+    long long sadd(std::string_view key, const KeyList &members);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_SET_OPERATIONS_HPP
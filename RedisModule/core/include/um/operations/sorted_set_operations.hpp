@@ -0,0 +1,47 @@
+#ifndef UM_SORTED_SET_OPERATIONS_HPP
+#define UM_SORTED_SET_OPERATIONS_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 有序集合操作, 失败时抛出 sw::redis::Error
+ */
+class SortedSetOperations
+{
+public:
+    explicit SortedSetOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 有序集合操作
+    *
+    * 添加成员并返回新增数量,一次往返添加多个(成员, 分数),获取指定范围内的成员
+    * 获取成员分数,获取成员排名(升序/降序),获取成员数量,删除成员并返回删除数量
+    */
+    long long zadd(std::string_view key, double score, std::string_view member);
+    long long zadd(std::string_view key, const std::vector<ScoredMember> &members);
+    std::vector<std::string> zrange(std::string_view key, long long start, long long stop);
+    OptionalDouble zscore(std::string_view key, std::string_view member);
+    OptionalLongLong zrank(std::string_view key, std::string_view member);
+    OptionalLongLong zrevrank(std::string_view key, std::string_view member);
+    long long zcard(std::string_view key);
+    long long zrem(std::string_view key, std::string_view member);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_SORTED_SET_OPERATIONS_HPP
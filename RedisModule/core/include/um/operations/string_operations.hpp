@@ -0,0 +1,42 @@
+#ifndef UM_STRING_OPERATIONS_HPP
+#define UM_STRING_OPERATIONS_HPP
+
+#include <string_view>
+
+#include "../types.hpp"
+
+namespace sw {
+namespace redis {
+class Redis;
+}
+}
+
+namespace um {
+
+/**
+ * @brief 字符串/字节流操作
+ *
+ * 值按字节原样存取, 同时用于文本和二进制数据; 失败时抛出 sw::redis::Error
+ */
+class StringOperations
+{
+public:
+    explicit StringOperations(sw::redis::Redis &redis) noexcept : redis_(redis) {}
+
+    /**
+    * @brief 字符串操作
+    *
+    * 设置键值对,获取值(键不存在时为空),追加数据并返回追加后长度,获取值长度
+    */
+    void set(std::string_view key, std::string_view value);
+    OptionalString get(std::string_view key);
+    long long append(std::string_view key, std::string_view value);
+    long long strlen(std::string_view key);
+
+private:
+    sw::redis::Redis &redis_;
+};
+
+} // namespace um
+
+#endif // UM_STRING_OPERATIONS_HPP
@@ -0,0 +1,36 @@
+#ifndef UM_TYPES_HPP
+#define UM_TYPES_HPP
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace um {
+
+/**
+ * @brief 核心库基础类型
+ *
+ * 字节流直接使用 std::string 承载(二进制安全), 与 redis-plus-plus 的应答类型一致,
+ * 读取结果无需再拷贝一次转换为 std::vector<uint8_t>
+ */
+using Bytes = std::string;
+using OptionalString = std::optional<std::string>;
+using OptionalBytes = std::optional<Bytes>;
+using OptionalDouble = std::optional<double>;
+using OptionalLongLong = std::optional<long long>;
+
+/**
+ * @brief 参数类型
+ *
+ * 键、字段与值均以 std::string_view 传入, 调用期间必须保持有效;
+ * 多键参数使用 std::string_view 列表, 哈希字段为(字段, 值), 有序集合成员为(成员, 分数)
+ */
+using KeyList = std::vector<std::string_view>;
+using FieldValue = std::pair<std::string_view, std::string_view>;
+using ScoredMember = std::pair<std::string_view, double>;
+
+} // namespace um
+
+#endif // UM_TYPES_HPP
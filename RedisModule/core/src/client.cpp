@@ -0,0 +1,226 @@
+#include "um/client.hpp"
+#include <sw/redis++/redis++.h>
+#include <stdexcept>
+#include <utility>
+
+namespace um {
+
+Client::Client() = default;
+
+Client::~Client() = default;
+
+bool Client::connect(const std::string &host, int port)
+{
+    ConnectionOptions options;
+    options.host = host;
+    options.port = port;
+    return connect(options);
+}
+
+bool Client::connect(const ConnectionOptions &options)
+{
+    disconnect();
+    try {
+        auto connection = std::make_unique<Connection>(options);
+        // redis-plus-plus 延迟建连, 主动 PING 一次确认服务器可达
+        connection->ping();
+        connection_ = std::move(connection);
+        setLastError(std::string());
+        return true;
+    } catch (const std::exception &e) {
+        setLastError(e.what());
+        return false;
+    }
+}
+
+void Client::disconnect()
+{
+    connection_.reset();
+}
+
+bool Client::isConnected() const
+{
+    return connection_ != nullptr;
+}
+
+std::string Client::lastError() const
+{
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return lastError_;
+}
+
+void Client::setLastError(std::string error)
+{
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_ = std::move(error);
+}
+
+template <typename Func, typename Default>
+auto Client::guarded(Func &&func, Default defaultValue) -> decltype(func())
+{
+    if (!connection_) {
+        setLastError("not connected");
+        return defaultValue;
+    }
+    try {
+        return func();
+    } catch (const std::exception &e) {
+        setLastError(e.what());
+        return defaultValue;
+    }
+}
+
+bool Client::set(std::string_view key, std::string_view value)
+{
+    return guarded([&]() {
+        strings().set(key, value);
+        return true;
+    }, false);
+}
+
+OptionalString Client::get(std::string_view key)
+{
+    return guarded([&]() { return strings().get(key); }, OptionalString());
+}
+
+bool Client::setBytes(std::string_view key, const Bytes &value)
+{
+    return set(key, value);
+}
+
+OptionalBytes Client::getBytes(std::string_view key)
+{
+    return get(key);
+}
+
+bool Client::hset(std::string_view key, std::string_view field, std::string_view value)
+{
+    return guarded([&]() {
+        hashes().hset(key, field, value);
+        return true;
+    }, false);
+}
+
+OptionalString Client::hget(std::string_view key, std::string_view field)
+{
+    return guarded([&]() { return hashes().hget(key, field); }, OptionalString());
+}
+
+bool Client::lpush(std::string_view key, std::string_view value)
+{
+    return guarded([&]() {
+        lists().lpush(key, value);
+        return true;
+    }, false);
+}
+
+OptionalString Client::lpop(std::string_view key)
+{
+    return guarded([&]() { return lists().lpop(key); }, OptionalString());
+}
+
+bool Client::sadd(std::string_view key, std::string_view member)
+{
+    return guarded([&]() {
+        sets().sadd(key, member);
+        return true;
+    }, false);
+}
+
+bool Client::sismember(std::string_view key, std::string_view member)
+{
+    return guarded([&]() { return sets().sismember(key, member); }, false);
+}
+
+bool Client::zadd(std::string_view key, double score, std::string_view member)
+{
+    return guarded([&]() {
+        sortedSets().zadd(key, score, member);
+        return true;
+    }, false);
+}
+
+bool Client::del(std::string_view key)
+{
+    return guarded([&]() { return generic().del(key) > 0; }, false);
+}
+
+bool Client::exists(std::string_view key)
+{
+    return guarded([&]() { return generic().exists(key); }, false);
+}
+
+bool Client::expire(std::string_view key, long long seconds)
+{
+    return guarded([&]() { return expiration().expire(key, seconds); }, false);
+}
+
+long long Client::ttl(std::string_view key)
+{
+    return guarded([&]() { return expiration().ttl(key); }, -2LL);
+}
+
+sw::redis::Redis& Client::redis() const
+{
+    if (!connection_) {
+        throw std::logic_error("um::Client is not connected");
+    }
+    return connection_->redis();
+}
+
+StringOperations Client::strings() const
+{
+    return StringOperations(redis());
+}
+
+HashOperations Client::hashes() const
+{
+    return HashOperations(redis());
+}
+
+ListOperations Client::lists() const
+{
+    return ListOperations(redis());
+}
+
+SetOperations Client::sets() const
+{
+    return SetOperations(redis());
+}
+
+SortedSetOperations Client::sortedSets() const
+{
+    return SortedSetOperations(redis());
+}
+
+ExpirationOperations Client::expiration() const
+{
+    return ExpirationOperations(redis());
+}
+
+GenericOperations Client::generic() const
+{
+    return GenericOperations(redis());
+}
+
+BatchOperations Client::batches() const
+{
+    return BatchOperations(redis());
+}
+
+ServerOperations Client::server() const
+{
+    return ServerOperations(redis());
+}
+
+ProbabilisticOperations Client::probabilistic() const
+{
+    return ProbabilisticOperations(redis());
+}
+
+Connection* Client::connection() const noexcept
+{
+    return connection_.get();
+}
+
+} // namespace um
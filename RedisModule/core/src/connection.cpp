@@ -0,0 +1,87 @@
+#include "um/connection.hpp"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <chrono>
+#include <typeinfo>
+
+namespace um {
+
+Connection::Connection(const ConnectionOptions &options)
+    : options_(options)
+{
+    sw::redis::ConnectionOptions connectionOptions;
+    connectionOptions.host = options_.host;
+    connectionOptions.port = options_.port;
+    connectionOptions.connect_timeout = options_.connectTimeout;
+    connectionOptions.socket_timeout = options_.socketTimeout;
+
+    sw::redis::ConnectionPoolOptions poolOptions;
+    poolOptions.size = std::max<std::size_t>(1, options_.poolSize);
+    poolOptions.wait_timeout = options_.poolWaitTimeout;
+
+    redis_ = std::make_unique<sw::redis::Redis>(connectionOptions, poolOptions);
+}
+
+Connection::~Connection() = default;
+
+sw::redis::Redis& Connection::redis() const noexcept
+{
+    return *redis_;
+}
+
+const ConnectionOptions& Connection::options() const noexcept
+{
+    return options_;
+}
+
+void Connection::ping() const
+{
+    redis_->ping();
+}
+
+std::vector<ConnectionWarmUp> Connection::warmUp(int pings, std::size_t maxConnections) const
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::microseconds;
+    std::size_t size = std::max<std::size_t>(1, options_.poolSize);
+    if (maxConnections > 0) {
+        size = std::min(size, maxConnections);
+    }
+
+    // 不使用新连接的流水线在析构前一直占用借出的连接, 全部持有时连接池被迫建满;
+    // 连接在第一条命令时取得, 首次 PING 比最小往返时间多出的部分即建连耗时
+    std::vector<sw::redis::Pipeline> held;
+    std::vector<ConnectionWarmUp> result;
+    held.reserve(size);
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        held.push_back(redis_->pipeline(false));
+        ConnectionWarmUp sample;
+        microseconds first{0};
+        try {
+            for (int ping = 0; ping < std::max(2, pings); ++ping) {
+                const Clock::time_point start = Clock::now();
+                held.back().ping().exec();
+                const auto elapsed = std::chrono::duration_cast<microseconds>(Clock::now() - start);
+                if (ping == 0) {
+                    first = elapsed;
+                } else if (ping == 1 || elapsed < sample.rtt) {
+                    sample.rtt = elapsed;
+                }
+            }
+        } catch (const sw::redis::Error &e) {
+            // 等待空闲连接超时时 redis-plus-plus 抛出基类 Error, 其余连接被其他调用方占用
+            const bool poolExhausted = options_.poolWaitTimeout.count() > 0 && typeid(e) == typeid(sw::redis::Error);
+            if (!poolExhausted || result.empty()) {
+                throw;
+            }
+            held.pop_back();
+            break;
+        }
+        sample.connectTime = std::max(microseconds(0), first - sample.rtt);
+        result.push_back(sample);
+    }
+    return result;
+}
+
+} // namespace um
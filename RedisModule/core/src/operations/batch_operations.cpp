@@ -0,0 +1,92 @@
+#include "um/operations/batch_operations.hpp"
+#include "redis_args.hpp"
+#include <iterator>
+
+namespace um {
+
+using detail::arg;
+using detail::args;
+
+namespace {
+
+Reply toReply(const redisReply &reply)
+{
+    Reply result;
+    switch (reply.type) {
+    case REDIS_REPLY_STRING:
+    case REDIS_REPLY_STATUS:
+        result.type = Reply::Type::String;
+        result.str.assign(reply.str, reply.len);
+        break;
+    case REDIS_REPLY_INTEGER:
+        result.type = Reply::Type::Integer;
+        result.integer = reply.integer;
+        break;
+    case REDIS_REPLY_ARRAY:
+        result.type = Reply::Type::Array;
+        result.elements = reply.elements;
+        break;
+    default:
+        result.type = Reply::Type::Nil;
+        break;
+    }
+    return result;
+}
+
+} // namespace
+
+void BatchOperations::mset(const std::vector<FieldValue> &items)
+{
+    if (items.empty()) {
+        return;
+    }
+    std::vector<std::pair<sw::redis::StringView, sw::redis::StringView>> pairs;
+    pairs.reserve(items.size());
+    for (const auto &item : items) {
+        pairs.emplace_back(arg(item.first), arg(item.second));
+    }
+    redis_.mset(pairs.begin(), pairs.end());
+}
+
+std::vector<OptionalString> BatchOperations::mget(const KeyList &keys)
+{
+    std::vector<OptionalString> result;
+    if (keys.empty()) {
+        return result;
+    }
+    auto keyArgs = args(keys);
+    result.reserve(keys.size());
+    redis_.mget(keyArgs.begin(), keyArgs.end(), std::back_inserter(result));
+    return result;
+}
+
+std::vector<Reply> BatchOperations::pipeline(const std::vector<KeyList> &commands)
+{
+    std::vector<Reply> result;
+    if (commands.empty()) {
+        return result;
+    }
+
+    // 复用连接池中的连接, 不额外建立连接
+    auto pipe = redis_.pipeline(false);
+    for (const auto &command : commands) {
+        auto commandArgs = args(command);
+        pipe.command(commandArgs.begin(), commandArgs.end());
+    }
+    auto replies = pipe.exec();
+
+    result.reserve(replies.size());
+    for (std::size_t i = 0; i < replies.size(); ++i) {
+        try {
+            result.push_back(toReply(replies.get(i)));
+        } catch (const sw::redis::ReplyError &e) {
+            Reply error;
+            error.type = Reply::Type::Error;
+            error.str = e.what();
+            result.push_back(std::move(error));
+        }
+    }
+    return result;
+}
+
+} // namespace um
@@ -0,0 +1,28 @@
+#include "um/operations/expiration_operations.hpp"
+#include "redis_args.hpp"
+
+namespace um {
+
+using detail::arg;
+
+bool ExpirationOperations::expire(std::string_view key, long long seconds)
+{
+    return redis_.expire(arg(key), seconds);
+}
+
+bool ExpirationOperations::expireat(std::string_view key, long long timestamp)
+{
+    return redis_.expireat(arg(key), timestamp);
+}
+
+long long ExpirationOperations::ttl(std::string_view key)
+{
+    return redis_.ttl(arg(key));
+}
+
+bool ExpirationOperations::persist(std::string_view key)
+{
+    return redis_.persist(arg(key));
+}
+
+} // namespace um
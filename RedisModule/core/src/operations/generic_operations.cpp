@@ -0,0 +1,32 @@
+#include "um/operations/generic_operations.hpp"
+#include "redis_args.hpp"
+#include <iterator>
+
+namespace um {
+
+using detail::arg;
+
+long long GenericOperations::del(std::string_view key)
+{
+    return redis_.del(arg(key));
+}
+
+bool GenericOperations::exists(std::string_view key)
+{
+    return redis_.exists(arg(key)) > 0;
+}
+
+std::vector<std::string> GenericOperations::keys(std::string_view pattern)
+{
+    std::vector<std::string> result;
+    redis_.keys(arg(pattern), std::back_inserter(result));
+    return result;
+}
+
+unsigned long long GenericOperations::scan(unsigned long long cursor, std::string_view pattern,
+                                           long long count, std::vector<std::string> &keys)
+{
+    return redis_.scan(cursor, arg(pattern), count, std::back_inserter(keys));
+}
+
+} // namespace um
@@ -0,0 +1,61 @@
+#include "um/operations/hash_operations.hpp"
+#include "redis_args.hpp"
+#include <iterator>
+
+namespace um {
+
+using detail::arg;
+
+bool HashOperations::hset(std::string_view key, std::string_view field, std::string_view value)
+{
+    return redis_.hset(arg(key), arg(field), arg(value)) > 0;
+}
+
+OptionalString HashOperations::hget(std::string_view key, std::string_view field)
+{
+    return detail::optional<std::string>(redis_.hget(arg(key), arg(field)));
+}
+
+std::unordered_map<std::string, std::string> HashOperations::hgetall(std::string_view key)
+{
+    std::unordered_map<std::string, std::string> result;
+    redis_.hgetall(arg(key), std::inserter(result, result.begin()));
+    return result;
+}
+
+long long HashOperations::hdel(std::string_view key, std::string_view field)
+{
+    return redis_.hdel(arg(key), arg(field));
+}
+
+bool HashOperations::hexists(std::string_view key, std::string_view field)
+{
+    return redis_.hexists(arg(key), arg(field));
+}
+
+std::vector<std::string> HashOperations::hkeys(std::string_view key)
+{
+    std::vector<std::string> result;
+    redis_.hkeys(arg(key), std::back_inserter(result));
+    return result;
+}
+
+long long HashOperations::hlen(std::string_view key)
+{
+    return redis_.hlen(arg(key));
+}
+
+long long HashOperations::hset(std::string_view key, const std::vector<FieldValue> &fields)
+{
+    if (fields.empty()) {
+        return 0;
+    }
+    std::vector<std::pair<sw::redis::StringView, sw::redis::StringView>> items;
+    items.reserve(fields.size());
+    for (const auto &field : fields) {
+        items.emplace_back(arg(field.first), arg(field.second));
+    }
+    return redis_.hset(arg(key), items.begin(), items.end());
+}
+
+} // namespace um
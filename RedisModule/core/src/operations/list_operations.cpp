@@ -0,0 +1,76 @@
+#include "um/operations/list_operations.hpp"
+#include "redis_args.hpp"
+#include <iterator>
+
+namespace um {
+
+using detail::arg;
+
+namespace {
+
+const char* endName(ListEnd end)
+{
+    return end == ListEnd::Left ? "LEFT" : "RIGHT";
+}
+
+} // namespace
+
+long long ListOperations::lpush(std::string_view key, std::string_view value)
+{
+    return redis_.lpush(arg(key), arg(value));
+}
+
+long long ListOperations::rpush(std::string_view key, std::string_view value)
+{
+    return redis_.rpush(arg(key), arg(value));
+}
+
+OptionalString ListOperations::lpop(std::string_view key)
+{
+    return detail::optional<std::string>(redis_.lpop(arg(key)));
+}
+
+OptionalString ListOperations::rpop(std::string_view key)
+{
+    return detail::optional<std::string>(redis_.rpop(arg(key)));
+}
+
+std::vector<std::string> ListOperations::lrange(std::string_view key, long long start, long long stop)
+{
+    std::vector<std::string> result;
+    redis_.lrange(arg(key), start, stop, std::back_inserter(result));
+    return result;
+}
+
+long long ListOperations::llen(std::string_view key)
+{
+    return redis_.llen(arg(key));
+}
+
+OptionalString ListOperations::lindex(std::string_view key, long long index)
+{
+    return detail::optional<std::string>(redis_.lindex(arg(key), index));
+}
+
+long long ListOperations::rpush(std::string_view key, const KeyList &values)
+{
+    if (values.empty()) {
+        return llen(key);
+    }
+    std::vector<sw::redis::StringView> items = detail::args(values);
+    return redis_.rpush(arg(key), items.begin(), items.end());
+}
+
+long long ListOperations::lrem(std::string_view key, long long count, std::string_view value)
+{
+    return redis_.lrem(arg(key), count, arg(value));
+}
+
+OptionalString ListOperations::lmove(std::string_view source, std::string_view destination,
+                                     ListEnd from, ListEnd to)
+{
+    return detail::optional<std::string>(redis_.command<sw::redis::OptionalString>(
+        "LMOVE", arg(source), arg(destination), endName(from), endName(to)));
+}
+
+} // namespace um
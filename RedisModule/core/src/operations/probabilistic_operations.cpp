@@ -0,0 +1,220 @@
+#include "um/operations/probabilistic_operations.hpp"
+#include "redis_args.hpp"
+#include <string>
+
+namespace um {
+
+using detail::arg;
+
+namespace {
+
+sw::redis::BitOp toBitOp(BitOperation operation)
+{
+    switch (operation) {
+    case BitOperation::And:
+        return sw::redis::BitOp::AND;
+    case BitOperation::Or:
+        return sw::redis::BitOp::OR;
+    case BitOperation::Xor:
+        return sw::redis::BitOp::XOR;
+    case BitOperation::Not:
+        return sw::redis::BitOp::NOT;
+    }
+    return sw::redis::BitOp::AND;
+}
+
+// 应答为整数或 nil(OVERFLOW FAIL)组成的数组
+std::vector<OptionalLongLong> bitfieldReply(const redisReply *reply)
+{
+    std::vector<OptionalLongLong> result;
+    if (!reply || reply->type != REDIS_REPLY_ARRAY) {
+        return result;
+    }
+    result.reserve(reply->elements);
+    for (std::size_t i = 0; i < reply->elements; ++i) {
+        const redisReply *element = reply->element[i];
+        if (element && element->type == REDIS_REPLY_INTEGER) {
+            result.emplace_back(element->integer);
+        } else {
+            result.emplace_back(std::nullopt);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+bool ProbabilisticOperations::pfadd(std::string_view key, std::string_view element)
+{
+    return redis_.pfadd(arg(key), arg(element));
+}
+
+bool ProbabilisticOperations::pfadd(std::string_view key, const KeyList &elements)
+{
+    if (elements.empty()) {
+        return false;
+    }
+    std::vector<sw::redis::StringView> items = detail::args(elements);
+    return redis_.pfadd(arg(key), items.begin(), items.end());
+}
+
+long long ProbabilisticOperations::pfcount(std::string_view key)
+{
+    return redis_.pfcount(arg(key));
+}
+
+long long ProbabilisticOperations::pfcount(const KeyList &keys)
+{
+    if (keys.empty()) {
+        return 0;
+    }
+    std::vector<sw::redis::StringView> items = detail::args(keys);
+    return redis_.pfcount(items.begin(), items.end());
+}
+
+void ProbabilisticOperations::pfmerge(std::string_view destination, const KeyList &sources)
+{
+    std::vector<sw::redis::StringView> items = detail::args(sources);
+    redis_.pfmerge(arg(destination), items.begin(), items.end());
+}
+
+bool ProbabilisticOperations::setbit(std::string_view key, long long offset, bool value)
+{
+    return redis_.setbit(arg(key), offset, value ? 1 : 0) != 0;
+}
+
+bool ProbabilisticOperations::getbit(std::string_view key, long long offset)
+{
+    return redis_.getbit(arg(key), offset) != 0;
+}
+
+long long ProbabilisticOperations::bitcount(std::string_view key, long long start, long long end)
+{
+    return redis_.bitcount(arg(key), start, end);
+}
+
+long long ProbabilisticOperations::bitpos(std::string_view key, bool bit, long long start, long long end)
+{
+    return redis_.bitpos(arg(key), bit ? 1 : 0, start, end);
+}
+
+long long ProbabilisticOperations::bitop(BitOperation operation, std::string_view destination, const KeyList &keys)
+{
+    std::vector<sw::redis::StringView> items = detail::args(keys);
+    return redis_.bitop(toBitOp(operation), arg(destination), items.begin(), items.end());
+}
+
+std::vector<OptionalLongLong> ProbabilisticOperations::bitfield(std::string_view key, const KeyList &subcommands)
+{
+    std::vector<sw::redis::StringView> command;
+    command.reserve(subcommands.size() + 2);
+    command.push_back("BITFIELD");
+    command.push_back(arg(key));
+    for (std::string_view item : subcommands) {
+        command.push_back(arg(item));
+    }
+    auto reply = redis_.command(command.begin(), command.end());
+    return bitfieldReply(reply.get());
+}
+
+std::vector<bool> ProbabilisticOperations::setbits(std::string_view key,
+                                                   const std::vector<std::pair<long long, bool>> &bits)
+{
+    std::vector<bool> result;
+    if (bits.empty()) {
+        return result;
+    }
+    // 偏移量的文本形式需要在命令发出前保持有效
+    std::vector<std::string> offsets;
+    offsets.reserve(bits.size());
+    std::vector<sw::redis::StringView> command;
+    command.reserve(bits.size() * 4 + 2);
+    command.push_back("BITFIELD");
+    command.push_back(arg(key));
+    for (const auto &bit : bits) {
+        offsets.push_back(std::to_string(bit.first));
+    }
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        command.push_back("SET");
+        command.push_back("u1");
+        command.push_back(arg(offsets[i]));
+        command.push_back(bits[i].second ? "1" : "0");
+    }
+    auto reply = redis_.command(command.begin(), command.end());
+    result.reserve(bits.size());
+    for (const auto &value : bitfieldReply(reply.get())) {
+        result.push_back(value.value_or(0) != 0);
+    }
+    return result;
+}
+
+std::vector<bool> ProbabilisticOperations::getbits(std::string_view key, const std::vector<long long> &offsets)
+{
+    std::vector<bool> result;
+    if (offsets.empty()) {
+        return result;
+    }
+    std::vector<std::string> offsetText;
+    offsetText.reserve(offsets.size());
+    for (long long offset : offsets) {
+        offsetText.push_back(std::to_string(offset));
+    }
+    std::vector<sw::redis::StringView> command;
+    command.reserve(offsets.size() * 3 + 2);
+    command.push_back("BITFIELD");
+    command.push_back(arg(key));
+    for (const auto &offset : offsetText) {
+        command.push_back("GET");
+        command.push_back("u1");
+        command.push_back(arg(offset));
+    }
+    auto reply = redis_.command(command.begin(), command.end());
+    result.reserve(offsets.size());
+    for (const auto &value : bitfieldReply(reply.get())) {
+        result.push_back(value.value_or(0) != 0);
+    }
+    return result;
+}
+
+std::vector<bool> ProbabilisticOperations::pfaddEach(const std::vector<FieldValue> &keyElements)
+{
+    std::vector<bool> result;
+    if (keyElements.empty()) {
+        return result;
+    }
+
+    // 复用连接池中的连接, 不额外建立连接
+    auto pipe = redis_.pipeline(false);
+    for (const auto &item : keyElements) {
+        sw::redis::StringView command[] = {"PFADD", arg(item.first), arg(item.second)};
+        pipe.command(std::begin(command), std::end(command));
+    }
+    auto replies = pipe.exec();
+    result.reserve(replies.size());
+    for (std::size_t i = 0; i < replies.size(); ++i) {
+        result.push_back(replies.get<long long>(i) != 0);
+    }
+    return result;
+}
+
+std::vector<long long> ProbabilisticOperations::pfcountEach(const KeyList &keys)
+{
+    std::vector<long long> result;
+    if (keys.empty()) {
+        return result;
+    }
+
+    auto pipe = redis_.pipeline(false);
+    for (std::string_view key : keys) {
+        sw::redis::StringView command[] = {"PFCOUNT", arg(key)};
+        pipe.command(std::begin(command), std::end(command));
+    }
+    auto replies = pipe.exec();
+    result.reserve(replies.size());
+    for (std::size_t i = 0; i < replies.size(); ++i) {
+        result.push_back(replies.get<long long>(i));
+    }
+    return result;
+}
+
+} // namespace um
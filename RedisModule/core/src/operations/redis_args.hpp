@@ -0,0 +1,52 @@
+#ifndef UM_REDIS_ARGS_HPP
+#define UM_REDIS_ARGS_HPP
+
+#include <sw/redis++/redis++.h>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "um/types.hpp"
+
+namespace um {
+namespace detail {
+
+/**
+ * @brief std::string_view 到 redis-plus-plus 参数的转换
+ *
+ * 只传递指针和长度, 不复制数据
+ */
+inline sw::redis::StringView arg(std::string_view value)
+{
+    return sw::redis::StringView(value.data(), value.size());
+}
+
+inline std::vector<sw::redis::StringView> args(const KeyList &values)
+{
+    std::vector<sw::redis::StringView> result;
+    result.reserve(values.size());
+    for (std::string_view value : values) {
+        result.push_back(arg(value));
+    }
+    return result;
+}
+
+/**
+ * @brief redis-plus-plus 可选应答到 std::optional 的转换
+ *
+ * redis-plus-plus 以 C++17 编译时二者为同一类型, 这里只移动不复制
+ */
+template <typename T, typename Optional>
+std::optional<T> optional(Optional &&value)
+{
+    if (value) {
+        return std::optional<T>(std::move(*value));
+    }
+    return std::nullopt;
+}
+
+} // namespace detail
+} // namespace um
+
+#endif // UM_REDIS_ARGS_HPP
@@ -0,0 +1,155 @@
+#include "um/operations/server_operations.hpp"
+#include "redis_args.hpp"
+#include <vector>
+
+namespace um {
+
+using detail::arg;
+
+namespace {
+
+std::string replyString(const redisReply *reply)
+{
+    if (reply && (reply->type == REDIS_REPLY_STRING || reply->type == REDIS_REPLY_STATUS)) {
+        return std::string(reply->str, reply->len);
+    }
+    return std::string();
+}
+
+long long replyInteger(const redisReply *reply)
+{
+    return reply && reply->type == REDIS_REPLY_INTEGER ? reply->integer : 0;
+}
+
+bool isArray(const redisReply *reply)
+{
+    return reply && reply->type == REDIS_REPLY_ARRAY;
+}
+
+} // namespace
+
+std::string ServerOperations::info(std::string_view section)
+{
+    if (section.empty()) {
+        return redis_.info();
+    }
+    return redis_.info(arg(section));
+}
+
+OptionalString ServerOperations::configGet(std::string_view parameter)
+{
+    // 应答为 [name, value, ...], 参数名可以是通配符, 这里只取第一个匹配项
+    auto reply = redis_.command<std::vector<std::string>>("CONFIG", "GET", arg(parameter));
+    if (reply.size() < 2) {
+        return std::nullopt;
+    }
+    return OptionalString(std::move(reply[1]));
+}
+
+void ServerOperations::configSet(std::string_view parameter, std::string_view value)
+{
+    redis_.command<void>("CONFIG", "SET", arg(parameter), arg(value));
+}
+
+void ServerOperations::bgsave()
+{
+    redis_.bgsave();
+}
+
+void ServerOperations::save()
+{
+    redis_.save();
+}
+
+void ServerOperations::bgrewriteaof()
+{
+    redis_.bgrewriteaof();
+}
+
+long long ServerOperations::lastsave()
+{
+    return redis_.lastsave();
+}
+
+long long ServerOperations::dbsize()
+{
+    return redis_.dbsize();
+}
+
+void ServerOperations::flushdb()
+{
+    redis_.flushdb();
+}
+
+void ServerOperations::debugPopulate(long long count, std::string_view prefix, long long valueSize)
+{
+    const std::string countArg = std::to_string(count);
+    const std::string sizeArg = std::to_string(valueSize);
+    redis_.command<void>("DEBUG", "POPULATE", countArg, arg(prefix), sizeArg);
+}
+
+std::vector<SlowLogEntry> ServerOperations::slowlogGet(long long count)
+{
+    // 每条记录为 [id, 时间戳, 耗时(微秒), [参数...], 客户端地址, 客户端名称], 后两项 Redis 4.0 起提供
+    const std::string countArg = std::to_string(count);
+    auto reply = redis_.command("SLOWLOG", "GET", countArg);
+    std::vector<SlowLogEntry> result;
+    if (!isArray(reply.get())) {
+        return result;
+    }
+    result.reserve(reply->elements);
+    for (std::size_t i = 0; i < reply->elements; ++i) {
+        const redisReply *item = reply->element[i];
+        if (!isArray(item) || item->elements < 4) {
+            continue;
+        }
+        SlowLogEntry entry;
+        entry.id = replyInteger(item->element[0]);
+        entry.timestamp = replyInteger(item->element[1]);
+        entry.durationUs = replyInteger(item->element[2]);
+        const redisReply *commandArgs = item->element[3];
+        if (isArray(commandArgs)) {
+            entry.args.reserve(commandArgs->elements);
+            for (std::size_t j = 0; j < commandArgs->elements; ++j) {
+                entry.args.push_back(replyString(commandArgs->element[j]));
+            }
+        }
+        if (item->elements >= 6) {
+            entry.client = replyString(item->element[4]);
+            entry.clientName = replyString(item->element[5]);
+        }
+        result.push_back(std::move(entry));
+    }
+    return result;
+}
+
+void ServerOperations::slowlogReset()
+{
+    redis_.command<void>("SLOWLOG", "RESET");
+}
+
+std::vector<LatencyEvent> ServerOperations::latencyLatest()
+{
+    // 每个事件为 [名称, 时间戳, 最近一次(毫秒), 历史最大(毫秒)]
+    auto reply = redis_.command("LATENCY", "LATEST");
+    std::vector<LatencyEvent> result;
+    if (!isArray(reply.get())) {
+        return result;
+    }
+    result.reserve(reply->elements);
+    for (std::size_t i = 0; i < reply->elements; ++i) {
+        const redisReply *item = reply->element[i];
+        if (!isArray(item) || item->elements < 4) {
+            continue;
+        }
+        LatencyEvent event;
+        event.event = replyString(item->element[0]);
+        event.timestamp = replyInteger(item->element[1]);
+        event.latestMs = replyInteger(item->element[2]);
+        event.maxMs = replyInteger(item->element[3]);
+        result.push_back(std::move(event));
+    }
+    return result;
+}
+
+} // namespace um
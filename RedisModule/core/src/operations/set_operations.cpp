@@ -0,0 +1,69 @@
+#include "um/operations/set_operations.hpp"
+#include "redis_args.hpp"
+#include <iterator>
+
+namespace um {
+
+using detail::arg;
+
+long long SetOperations::sadd(std::string_view key, std::string_view member)
+{
+    return redis_.sadd(arg(key), arg(member));
+}
+
+bool SetOperations::sismember(std::string_view key, std::string_view member)
+{
+    return redis_.sismember(arg(key), arg(member));
+}
+
+long long SetOperations::srem(std::string_view key, std::string_view member)
+{
+    return redis_.srem(arg(key), arg(member));
+}
+
+std::vector<std::string> SetOperations::smembers(std::string_view key)
+{
+    std::vector<std::string> result;
+    redis_.smembers(arg(key), std::back_inserter(result));
+    return result;
+}
+
+long long SetOperations::scard(std::string_view key)
+{
+    return redis_.scard(arg(key));
+}
+
+std::vector<std::string> SetOperations::sunion(const KeyList &keys)
+{
+    std::vector<std::string> result;
+    std::vector<sw::redis::StringView> items = detail::args(keys);
+    redis_.sunion(items.begin(), items.end(), std::back_inserter(result));
+    return result;
+}
+
+std::vector<std::string> SetOperations::sinter(const KeyList &keys)
+{
+    std::vector<std::string> result;
+    std::vector<sw::redis::StringView> items = detail::args(keys);
+    redis_.sinter(items.begin(), items.end(), std::back_inserter(result));
+    return result;
+}
+
+std::vector<std::string> SetOperations::sdiff(const KeyList &keys)
+{
+    std::vector<std::string> result;
+    std::vector<sw::redis::StringView> items = detail::args(keys);
+    redis_.sdiff(items.begin(), items.end(), std::back_inserter(result));
+    return result;
+}
+
+long long SetOperations::sadd(std::string_view key, const KeyList &members)
+{
+    if (members.empty()) {
+        return 0;
+    }
+    std::vector<sw::redis::StringView> items = detail::args(members);
+    return redis_.sadd(arg(key), items.begin(), items.end());
+}
+
+} // namespace um
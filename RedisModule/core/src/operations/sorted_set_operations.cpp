@@ -0,0 +1,59 @@
+#include "um/operations/sorted_set_operations.hpp"
+#include "redis_args.hpp"
+#include <iterator>
+
+namespace um {
+
+using detail::arg;
+
+long long SortedSetOperations::zadd(std::string_view key, double score, std::string_view member)
+{
+    return redis_.zadd(arg(key), arg(member), score);
+}
+
+long long SortedSetOperations::zadd(std::string_view key, const std::vector<ScoredMember> &members)
+{
+    if (members.empty()) {
+        return 0;
+    }
+    std::vector<std::pair<sw::redis::StringView, double>> items;
+    items.reserve(members.size());
+    for (const auto &member : members) {
+        items.emplace_back(arg(member.first), member.second);
+    }
+    return redis_.zadd(arg(key), items.begin(), items.end());
+}
+
+std::vector<std::string> SortedSetOperations::zrange(std::string_view key, long long start, long long stop)
+{
+    std::vector<std::string> result;
+    redis_.zrange(arg(key), start, stop, std::back_inserter(result));
+    return result;
+}
+
+OptionalDouble SortedSetOperations::zscore(std::string_view key, std::string_view member)
+{
+    return detail::optional<double>(redis_.zscore(arg(key), arg(member)));
+}
+
+OptionalLongLong SortedSetOperations::zrank(std::string_view key, std::string_view member)
+{
+    return detail::optional<long long>(redis_.zrank(arg(key), arg(member)));
+}
+
+OptionalLongLong SortedSetOperations::zrevrank(std::string_view key, std::string_view member)
+{
+    return detail::optional<long long>(redis_.zrevrank(arg(key), arg(member)));
+}
+
+long long SortedSetOperations::zcard(std::string_view key)
+{
+    return redis_.zcard(arg(key));
+}
+
+long long SortedSetOperations::zrem(std::string_view key, std::string_view member)
+{
+    return redis_.zrem(arg(key), arg(member));
+}
+
+} // namespace um
@@ -0,0 +1,28 @@
+#include "um/operations/string_operations.hpp"
+#include "redis_args.hpp"
+
+namespace um {
+
+using detail::arg;
+
+void StringOperations::set(std::string_view key, std::string_view value)
+{
+    redis_.set(arg(key), arg(value));
+}
+
+OptionalString StringOperations::get(std::string_view key)
+{
+    return detail::optional<std::string>(redis_.get(arg(key)));
+}
+
+long long StringOperations::append(std::string_view key, std::string_view value)
+{
+    return redis_.append(arg(key), arg(value));
+}
+
+long long StringOperations::strlen(std::string_view key)
+{
+    return redis_.strlen(arg(key));
+}
+
+} // namespace um
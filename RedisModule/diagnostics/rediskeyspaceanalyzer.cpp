@@ -0,0 +1,414 @@
+#include "rediskeyspaceanalyzer.h"
+#include "../redismanager.h"
+#include <QDebug>
+#include <QJsonArray>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+
+namespace {
+
+constexpr int kCommandsPerKey = 4;
+const QString kUngrouped = QStringLiteral("(no prefix)");
+
+// 剩余生存时间区间的上界(毫秒), 最后一个区间无上界
+const qint64 kTtlBounds[] = {60 * 1000LL, 3600 * 1000LL, 24 * 3600 * 1000LL, 7 * 24 * 3600 * 1000LL};
+constexpr int kTtlBucketCount = 2 + sizeof(kTtlBounds) / sizeof(kTtlBounds[0]);
+
+// 小顶堆: 堆顶为当前保留的最小键
+bool largerBytes(const RedisKeyspaceKeyInfo &a, const RedisKeyspaceKeyInfo &b)
+{
+    return a.bytes > b.bytes;
+}
+
+QString formatBytes(qint64 bytes)
+{
+    const char *units[] = {"B", "KB", "MB", "GB", "TB"};
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024.0 && unit < 4) {
+        value /= 1024.0;
+        ++unit;
+    }
+    return unit == 0 ? QString("%1 B").arg(bytes) : QString("%1 %2").arg(value, 0, 'f', 1).arg(units[unit]);
+}
+
+QString formatCounts(const QMap<QString, qint64> &counts)
+{
+    QStringList parts;
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+        parts << QString("%1=%2").arg(it.key()).arg(it.value());
+    }
+    return parts.join(',');
+}
+
+QJsonObject countsToJson(const QMap<QString, qint64> &counts)
+{
+    QJsonObject object;
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+        object[it.key()] = static_cast<double>(it.value());
+    }
+    return object;
+}
+
+} // namespace
+
+QStringList RedisKeyspaceReport::ttlBucketLabels()
+{
+    return {"none", "<1m", "<1h", "<1d", "<7d", ">=7d"};
+}
+
+QString RedisKeyspaceReport::toText() const
+{
+    auto name = [](const QString &value) { return value.leftJustified(28); };
+    auto column = [](const QString &value) { return value.rightJustified(12); };
+
+    QString text;
+    QTextStream out(&text);
+    out << "Keyspace: " << scannedKeys << " keys scanned, " << sampledKeys << " sampled, "
+        << formatBytes(estimatedBytes) << " estimated in " << elapsedMs << " ms"
+        << (complete ? "" : " (partial)") << "\n\n";
+
+    out << name("group") << column("keys") << column("sampled") << column("bytes")
+        << column("estimated") << "  types / encodings\n";
+    for (const auto &group : groups) {
+        out << name(group.group) << column(QString::number(group.keys))
+            << column(QString::number(group.sampledKeys)) << column(formatBytes(group.bytes))
+            << column(formatBytes(group.estimatedBytes)) << "  " << formatCounts(group.types)
+            << " / " << formatCounts(group.encodings) << "\n";
+    }
+
+    out << "\nTTL distribution (sampled keys):\n" << name("group");
+    for (const auto &label : ttlBucketLabels()) {
+        out << column(label);
+    }
+    out << "\n";
+    for (const auto &group : groups) {
+        out << name(group.group);
+        for (qint64 count : group.ttlBuckets) {
+            out << column(QString::number(count));
+        }
+        out << "\n";
+    }
+
+    out << "\nLargest keys:\n";
+    for (const auto &key : largestKeys) {
+        out << "  " << column(formatBytes(key.bytes)) << "  " << key.type << "/" << key.encoding << "  "
+            << (key.ttlMs >= 0 ? QString("ttl=%1ms").arg(key.ttlMs) : QString("no ttl")) << "  "
+            << key.key << "\n";
+    }
+    out.flush();
+    return text;
+}
+
+QJsonObject RedisKeyspaceReport::toJson() const
+{
+    QJsonObject root;
+    root["scanned_keys"] = static_cast<double>(scannedKeys);
+    root["sampled_keys"] = static_cast<double>(sampledKeys);
+    root["total_bytes"] = static_cast<double>(totalBytes);
+    root["estimated_bytes"] = static_cast<double>(estimatedBytes);
+    root["elapsed_ms"] = static_cast<double>(elapsedMs);
+    root["complete"] = complete;
+
+    const QStringList labels = ttlBucketLabels();
+    QJsonArray groupArray;
+    for (const auto &group : groups) {
+        QJsonObject object;
+        object["group"] = group.group;
+        object["keys"] = static_cast<double>(group.keys);
+        object["sampled_keys"] = static_cast<double>(group.sampledKeys);
+        object["bytes"] = static_cast<double>(group.bytes);
+        object["estimated_bytes"] = static_cast<double>(group.estimatedBytes);
+        object["types"] = countsToJson(group.types);
+        object["encodings"] = countsToJson(group.encodings);
+        QJsonObject ttl;
+        for (int i = 0; i < labels.size() && i < group.ttlBuckets.size(); ++i) {
+            ttl[labels.at(i)] = static_cast<double>(group.ttlBuckets.at(i));
+        }
+        object["ttl"] = ttl;
+        groupArray.append(object);
+    }
+    root["groups"] = groupArray;
+
+    QJsonArray keyArray;
+    for (const auto &key : largestKeys) {
+        QJsonObject object;
+        object["key"] = key.key;
+        object["group"] = key.group;
+        object["type"] = key.type;
+        object["encoding"] = key.encoding;
+        object["bytes"] = static_cast<double>(key.bytes);
+        object["ttl_ms"] = static_cast<double>(key.ttlMs);
+        keyArray.append(object);
+    }
+    root["largest_keys"] = keyArray;
+    return root;
+}
+
+RedisKeyspaceAnalyzer::RedisKeyspaceAnalyzer(RedisManager *manager,
+                                             const RedisKeyspaceAnalyzerOptions &options)
+    : manager_(manager)
+    , options_(options)
+    , cursor_(0)
+    , started_(false)
+    , complete_(false)
+    , error_(false)
+    , stopRequested_(false)
+    , scannedKeys_(0)
+    , sampledKeys_(0)
+{
+    options_.scanCount = std::max(1, options_.scanCount);
+    options_.autoGroupDepth = std::max(1, options_.autoGroupDepth);
+    options_.sampleRate = std::max(0.0, std::min(options_.sampleRate, 1.0));
+    options_.topKeys = std::max(0, options_.topKeys);
+    for (const auto &pattern : options_.groupPatterns) {
+        patterns_.append(QRegularExpression(QRegularExpression::wildcardToRegularExpression(pattern)));
+    }
+}
+
+bool RedisKeyspaceAnalyzer::step()
+{
+    if (complete_ || stopRequested_) {
+        return false;
+    }
+    if (!started_) {
+        timer_.start();
+        started_ = true;
+    }
+
+    RedisScanResult batch = manager_->scan(cursor_, options_.matchPattern, options_.scanCount);
+    if (manager_->lastCallStatus() != RedisCallStatus::Ok) {
+        // 游标不变, 下一次 step() 从同一位置重试
+        error_ = true;
+        return false;
+    }
+
+    QVector<QString> keys = batch.keys;
+    bool reachedLimit = false;
+    if (options_.maxKeys > 0 && scannedKeys_ + keys.size() >= options_.maxKeys) {
+        keys.resize(static_cast<int>(options_.maxKeys - scannedKeys_));
+        reachedLimit = true;
+    }
+
+    QVector<QString> sampled;
+    sampled.reserve(keys.size());
+    for (const auto &key : keys) {
+        if (options_.sampleRate >= 1.0 || QRandomGenerator::global()->generateDouble() < options_.sampleRate) {
+            sampled.append(key);
+        }
+    }
+
+    QVector<RedisKeyspaceKeyInfo> infos;
+    if (!sample(sampled, infos)) {
+        // 采样失败时同样不推进游标, 避免这批键被计数却缺少内存统计
+        error_ = true;
+        return false;
+    }
+    error_ = false;
+
+    // 采样成功后才提交游标与统计
+    cursor_ = batch.cursor;
+    if (reachedLimit || cursor_ == 0) {
+        complete_ = true;
+    }
+    for (const auto &key : keys) {
+        const QString group = groupOf(key);
+        RedisKeyspaceGroupStats &stats = groups_[group];
+        if (stats.group.isEmpty()) {
+            stats.group = group;
+            stats.ttlBuckets.fill(0, kTtlBucketCount);
+        }
+        ++stats.keys;
+    }
+    scannedKeys_ += keys.size();
+    for (const auto &info : infos) {
+        record(info);
+    }
+
+    throttle();
+    return !complete_;
+}
+
+RedisKeyspaceReport RedisKeyspaceAnalyzer::analyze()
+{
+    while (step()) {
+    }
+    if (error_) {
+        qDebug() << "Keyspace analyzer stopped after error at cursor" << cursor_;
+    }
+    return report();
+}
+
+void RedisKeyspaceAnalyzer::requestStop()
+{
+    stopRequested_ = true;
+}
+
+void RedisKeyspaceAnalyzer::reset()
+{
+    cursor_ = 0;
+    started_ = false;
+    complete_ = false;
+    error_ = false;
+    stopRequested_ = false;
+    scannedKeys_ = 0;
+    sampledKeys_ = 0;
+    groups_.clear();
+    largest_.clear();
+}
+
+bool RedisKeyspaceAnalyzer::isComplete() const
+{
+    return complete_;
+}
+
+bool RedisKeyspaceAnalyzer::hasError() const
+{
+    return error_;
+}
+
+RedisKeyspaceReport RedisKeyspaceAnalyzer::report() const
+{
+    RedisKeyspaceReport report;
+    report.scannedKeys = scannedKeys_;
+    report.sampledKeys = sampledKeys_;
+    report.elapsedMs = started_ ? timer_.elapsed() : 0;
+    report.complete = complete_;
+
+    for (RedisKeyspaceGroupStats stats : groups_) {
+        // 未抽到样本的分组无法推算内存
+        stats.estimatedBytes = stats.sampledKeys > 0
+            ? static_cast<qint64>(static_cast<double>(stats.bytes) * stats.keys / stats.sampledKeys)
+            : 0;
+        report.totalBytes += stats.bytes;
+        report.estimatedBytes += stats.estimatedBytes;
+        report.groups.append(stats);
+    }
+    std::sort(report.groups.begin(), report.groups.end(),
+              [](const RedisKeyspaceGroupStats &a, const RedisKeyspaceGroupStats &b) {
+                  return a.estimatedBytes > b.estimatedBytes;
+              });
+
+    std::vector<RedisKeyspaceKeyInfo> largest = largest_;
+    std::sort(largest.begin(), largest.end(), largerBytes);
+    for (const auto &key : largest) {
+        report.largestKeys.append(key);
+    }
+    return report;
+}
+
+QString RedisKeyspaceAnalyzer::groupOf(const QString &key) const
+{
+    for (int i = 0; i < patterns_.size(); ++i) {
+        if (patterns_.at(i).match(key).hasMatch()) {
+            return options_.groupPatterns.at(i);
+        }
+    }
+
+    // 最后一段视为键自身的标识, 最多取前 autoGroupDepth 段作为前缀
+    const QStringList parts = key.split(options_.delimiter);
+    const int depth = std::min(options_.autoGroupDepth, parts.size() - 1);
+    if (depth <= 0) {
+        return kUngrouped;
+    }
+    return QStringList(parts.mid(0, depth)).join(options_.delimiter) + options_.delimiter + "*";
+}
+
+bool RedisKeyspaceAnalyzer::sample(const QVector<QString> &keys, QVector<RedisKeyspaceKeyInfo> &infos)
+{
+    if (keys.isEmpty()) {
+        return true;
+    }
+
+    QVector<QVector<QByteArray>> commands;
+    commands.reserve(keys.size() * kCommandsPerKey);
+    const QByteArray samples = QByteArray::number(options_.memorySamples);
+    for (const auto &key : keys) {
+        const QByteArray name = key.toUtf8();
+        commands.append({"TYPE", name});
+        commands.append({"OBJECT", "ENCODING", name});
+        commands.append({"PTTL", name});
+        commands.append({"MEMORY", "USAGE", name, "SAMPLES", samples});
+    }
+
+    QVector<RedisPipelineReply> replies = manager_->pipeline(commands);
+    if (replies.size() != commands.size()) {
+        return false;
+    }
+
+    infos.reserve(keys.size());
+    for (int i = 0; i < keys.size(); ++i) {
+        const RedisPipelineReply &type = replies.at(i * kCommandsPerKey);
+        const RedisPipelineReply &encoding = replies.at(i * kCommandsPerKey + 1);
+        const RedisPipelineReply &ttl = replies.at(i * kCommandsPerKey + 2);
+        const RedisPipelineReply &memory = replies.at(i * kCommandsPerKey + 3);
+
+        // SCAN 之后被删除或过期的键
+        if (type.isError() || type.value == "none" || ttl.integer == -2) {
+            continue;
+        }
+
+        RedisKeyspaceKeyInfo info;
+        info.key = keys.at(i);
+        info.group = groupOf(info.key);
+        info.type = QString::fromUtf8(type.value);
+        info.encoding = encoding.isError() ? QString("unknown") : QString::fromUtf8(encoding.value);
+        info.ttlMs = ttl.integer;
+        info.bytes = memory.type == RedisPipelineReply::Type::Integer ? memory.integer : 0;
+        infos.append(info);
+    }
+    return true;
+}
+
+void RedisKeyspaceAnalyzer::record(const RedisKeyspaceKeyInfo &info)
+{
+    RedisKeyspaceGroupStats &stats = groups_[info.group];
+    ++stats.sampledKeys;
+    stats.bytes += info.bytes;
+    ++stats.types[info.type];
+    ++stats.encodings[info.encoding];
+    ++stats.ttlBuckets[ttlBucket(info.ttlMs)];
+    ++sampledKeys_;
+
+    if (options_.topKeys == 0) {
+        return;
+    }
+    if (static_cast<int>(largest_.size()) < options_.topKeys) {
+        largest_.push_back(info);
+        std::push_heap(largest_.begin(), largest_.end(), largerBytes);
+    } else if (info.bytes > largest_.front().bytes) {
+        std::pop_heap(largest_.begin(), largest_.end(), largerBytes);
+        largest_.back() = info;
+        std::push_heap(largest_.begin(), largest_.end(), largerBytes);
+    }
+}
+
+void RedisKeyspaceAnalyzer::throttle()
+{
+    if (options_.maxKeysPerSecond <= 0 || complete_) {
+        return;
+    }
+    // 按已扫描的键数计算应当经过的时间, 超前则等待
+    const qint64 expectedMs = scannedKeys_ * 1000 / options_.maxKeysPerSecond;
+    const qint64 aheadMs = expectedMs - timer_.elapsed();
+    if (aheadMs > 0) {
+        QThread::msleep(static_cast<unsigned long>(aheadMs));
+    }
+}
+
+int RedisKeyspaceAnalyzer::ttlBucket(qint64 ttlMs)
+{
+    if (ttlMs < 0) {
+        return 0;
+    }
+    int bucket = 1;
+    for (qint64 bound : kTtlBounds) {
+        if (ttlMs < bound) {
+            return bucket;
+        }
+        ++bucket;
+    }
+    return bucket;
+}
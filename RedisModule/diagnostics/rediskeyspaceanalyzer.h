@@ -0,0 +1,172 @@
+#ifndef REDISKEYSPACEANALYZER_H
+#define REDISKEYSPACEANALYZER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMap>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <vector>
+#include "../tool/redismodule_export.h"
+
+class RedisManager;
+
+/**
+ * @brief 键空间分析参数
+ *
+ * groupPatterns 为分组用的通配符模式(如 "img:data:*"), 按顺序取第一个匹配的模式作为分组;
+ * 未匹配的键按 delimiter 切分后取前 autoGroupDepth 段自动分组(如 "img:tag:*")。
+ * 每批 SCAN 后对抽中的键用一次流水线发送 TYPE / OBJECT ENCODING / PTTL / MEMORY USAGE,
+ * 并把处理速度限制在 maxKeysPerSecond 以内, 可以在生产环境中长时间运行
+ */
+struct RedisKeyspaceAnalyzerOptions
+{
+    QStringList groupPatterns;
+    QChar delimiter = ':';
+    int autoGroupDepth = 2;
+
+    // SCAN MATCH / COUNT
+    QString matchPattern = "*";
+    int scanCount = 200;
+
+    // 每秒最多扫描的键数, 0 表示不限速
+    int maxKeysPerSecond = 1000;
+    // 扫描到的键中按此比例抽样采集内存与类型信息, 其余键只计数
+    double sampleRate = 1.0;
+    // MEMORY USAGE 对聚合类型抽样的元素数, 0 表示统计全部元素
+    int memorySamples = 5;
+
+    int topKeys = 20;
+    // 扫描的键数上限, 0 表示遍历完整个键空间
+    qint64 maxKeys = 0;
+};
+
+/**
+ * @brief 单个键的采样结果
+ *
+ * ttlMs 为 -1 表示未设置过期时间
+ */
+struct RedisKeyspaceKeyInfo
+{
+    QString key;
+    QString group;
+    QString type;
+    QString encoding;
+    qint64 bytes = 0;
+    qint64 ttlMs = -1;
+};
+
+/**
+ * @brief 一个分组的统计
+ *
+ * keys 为扫描到的键数, sampledKeys 为实际采样的键数;
+ * bytes 为采样键的 MEMORY USAGE 之和, estimatedBytes 按采样比例推算到全部键。
+ * ttlBuckets 按 ttlBucketLabels() 的区间统计采样键的剩余生存时间
+ */
+struct RedisKeyspaceGroupStats
+{
+    QString group;
+    qint64 keys = 0;
+    qint64 sampledKeys = 0;
+    qint64 bytes = 0;
+    qint64 estimatedBytes = 0;
+    QMap<QString, qint64> types;
+    QMap<QString, qint64> encodings;
+    QVector<qint64> ttlBuckets;
+};
+
+/**
+ * @brief 键空间分析报告, 分组按推算内存从大到小排序
+ */
+struct REDISMODULESHARED_EXPORT RedisKeyspaceReport
+{
+    qint64 scannedKeys = 0;
+    qint64 sampledKeys = 0;
+    qint64 totalBytes = 0;
+    qint64 estimatedBytes = 0;
+    qint64 elapsedMs = 0;
+    bool complete = false;
+    QVector<RedisKeyspaceGroupStats> groups;
+    QVector<RedisKeyspaceKeyInfo> largestKeys;
+
+    static QStringList ttlBucketLabels();
+
+    QString toText() const;
+    QJsonObject toJson() const;
+};
+
+/**
+ * @brief 键空间内存分析器
+ *
+ * 基于 SCAN 增量遍历, 按前缀模式聚合内存、数量、类型、编码(listpack / hashtable 等)
+ * 与 TTL 分布, 并记录内存最大的键。
+ * step() 每次只处理一批键, 可以分散在定时器中执行; analyze() 连续执行到遍历完成。
+ * requestStop() 可从其他线程调用, 使 analyze() 在当前批次结束后返回
+ *
+ * @code
+ * RedisKeyspaceAnalyzerOptions options;
+ * options.groupPatterns = {"img:data:*", "img:meta:*", "img:tag:*"};
+ * options.maxKeysPerSecond = 500;
+ * RedisKeyspaceAnalyzer analyzer(&manager, options);
+ * qDebug().noquote() << analyzer.analyze().toText();
+ * @endcode
+ */
+class REDISMODULESHARED_EXPORT RedisKeyspaceAnalyzer
+{
+public:
+    RedisKeyspaceAnalyzer(RedisManager *manager, const RedisKeyspaceAnalyzerOptions &options);
+
+    /**
+    * @brief 分析控制
+    *
+    * 处理一批键(返回 false 表示已完成或出错),连续分析直到完成,
+    * 请求停止,清空统计并从头开始。
+    * SCAN 或采样流水线失败时游标与统计都不变, 下一次 step() 重新处理同一批
+    */
+    bool step();
+    RedisKeyspaceReport analyze();
+    void requestStop();
+    void reset();
+
+    /**
+    * @brief 分析状态
+    *
+    * 是否已遍历完成,最近一次 SCAN/流水线是否失败,当前统计的报告
+    */
+    bool isComplete() const;
+    bool hasError() const;
+    RedisKeyspaceReport report() const;
+
+    QString groupOf(const QString &key) const;
+
+private:
+    // 流水线读取键信息, 失败时返回 false 且不修改任何统计
+    bool sample(const QVector<QString> &keys, QVector<RedisKeyspaceKeyInfo> &infos);
+    void record(const RedisKeyspaceKeyInfo &info);
+    void throttle();
+
+    static int ttlBucket(qint64 ttlMs);
+
+    RedisManager *manager_;
+    RedisKeyspaceAnalyzerOptions options_;
+    QVector<QRegularExpression> patterns_;
+
+    quint64 cursor_;
+    bool started_;
+    bool complete_;
+    bool error_;
+    std::atomic<bool> stopRequested_;
+
+    qint64 scannedKeys_;
+    qint64 sampledKeys_;
+    QMap<QString, RedisKeyspaceGroupStats> groups_;
+    // 以 bytes 为键的小顶堆, 保留最大的 topKeys 个键
+    std::vector<RedisKeyspaceKeyInfo> largest_;
+
+    QElapsedTimer timer_;
+};
+
+#endif // REDISKEYSPACEANALYZER_H
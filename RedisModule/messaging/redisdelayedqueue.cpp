@@ -0,0 +1,221 @@
+#include "redisdelayedqueue.h"
+#include "../redismanager.h"
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+
+// unpack 受 Lua 栈大小限制, 单次转移数量需有上限
+constexpr int kMaxBatchSize = 1000;
+constexpr int kUnavailableBackoffMs = 100;
+
+// KEYS: 有序集合, 就绪列表; ARGV: 当前毫秒时间戳, 批大小
+// 返回 {转移数量, 下一个到期分数(无则为空)}
+const QString kClaimScript = QStringLiteral(R"(
+local items = redis.call('ZRANGEBYSCORE', KEYS[1], '-inf', ARGV[1], 'LIMIT', 0, tonumber(ARGV[2]))
+if #items > 0 then
+    redis.call('ZREM', KEYS[1], unpack(items))
+    redis.call('RPUSH', KEYS[2], unpack(items))
+end
+local nextDue = redis.call('ZRANGE', KEYS[1], 0, 0, 'WITHSCORES')
+return {tostring(#items), nextDue[2] or ''}
+)");
+
+qint64 nowMs()
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+} // namespace
+
+RedisDelayedQueue::RedisDelayedQueue(RedisManager *manager, const RedisDelayedQueueOptions &options)
+    : manager_(manager)
+    , options_(options)
+    , running_(false)
+    , claimed_(0)
+    , calls_(0)
+    , nextWakeMs_(0)
+{
+    if (options_.readyQueue.isEmpty()) {
+        options_.readyQueue = options_.name + ":ready";
+    }
+    options_.batchSize = std::max(1, std::min(options_.batchSize, kMaxBatchSize));
+    options_.minPollMs = std::max(1, options_.minPollMs);
+    options_.maxPollMs = std::max(options_.minPollMs, options_.maxPollMs);
+}
+
+RedisDelayedQueue::~RedisDelayedQueue()
+{
+    stop();
+}
+
+bool RedisDelayedQueue::schedule(const QString &job, const QDateTime &dueAt)
+{
+    qint64 dueMs = dueAt.toMSecsSinceEpoch();
+    if (!manager_->zAdd(options_.name, static_cast<double>(dueMs), job)) {
+        return false;
+    }
+    wake(dueMs);
+    return true;
+}
+
+bool RedisDelayedQueue::scheduleIn(const QString &job, qint64 delayMs)
+{
+    return schedule(job, QDateTime::fromMSecsSinceEpoch(nowMs() + delayMs));
+}
+
+bool RedisDelayedQueue::scheduleBatch(const QVector<QPair<QString, qint64>> &jobs)
+{
+    if (jobs.isEmpty()) {
+        return true;
+    }
+    QVector<QPair<QString, double>> members;
+    members.reserve(jobs.size());
+    qint64 earliest = jobs.first().second;
+    for (const auto &job : jobs) {
+        members.append(qMakePair(job.first, static_cast<double>(job.second)));
+        earliest = std::min(earliest, job.second);
+    }
+    if (!manager_->zAdd(options_.name, members)) {
+        return false;
+    }
+    wake(earliest);
+    return true;
+}
+
+bool RedisDelayedQueue::cancel(const QString &job)
+{
+    return manager_->zRem(options_.name, job);
+}
+
+int RedisDelayedQueue::claimDue(int maxCount, qint64 *nextDueMs)
+{
+    int batch = maxCount > 0 ? std::min(maxCount, kMaxBatchSize) : options_.batchSize;
+    QVector<QString> result = manager_->evalStrings(kClaimScript, {options_.name, options_.readyQueue},
+                                                    {QString::number(nowMs()), QString::number(batch)});
+    ++calls_;
+
+    int moved = 0;
+    qint64 nextDue = -1;
+    if (result.size() == 2) {
+        moved = result.at(0).toInt();
+        if (!result.at(1).isEmpty()) {
+            nextDue = static_cast<qint64>(result.at(1).toDouble());
+        }
+    }
+    claimed_ += moved;
+    if (nextDueMs) {
+        *nextDueMs = nextDue;
+    }
+    return moved;
+}
+
+bool RedisDelayedQueue::start()
+{
+    if (running_) {
+        return true;
+    }
+    if (!manager_ || options_.name.isEmpty()) {
+        qDebug() << "Delayed queue: invalid options";
+        return false;
+    }
+    running_ = true;
+    worker_ = std::thread(&RedisDelayedQueue::run, this);
+    qDebug() << "Delayed queue started:" << options_.name << "->" << options_.readyQueue;
+    return true;
+}
+
+void RedisDelayedQueue::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = false;
+    }
+    wakeCv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+        qDebug() << "Delayed queue stopped:" << options_.name;
+    }
+}
+
+bool RedisDelayedQueue::isRunning() const
+{
+    return running_;
+}
+
+long long RedisDelayedQueue::pendingCount()
+{
+    return manager_->zCard(options_.name);
+}
+
+int RedisDelayedQueue::readyCount()
+{
+    return manager_->lLen(options_.readyQueue);
+}
+
+qint64 RedisDelayedQueue::claimedCount() const
+{
+    return claimed_;
+}
+
+qint64 RedisDelayedQueue::claimCalls() const
+{
+    return calls_;
+}
+
+QString RedisDelayedQueue::readyQueue() const
+{
+    return options_.readyQueue;
+}
+
+void RedisDelayedQueue::wake(qint64 dueMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        if (!running_ || dueMs >= nextWakeMs_) {
+            return;
+        }
+        nextWakeMs_ = dueMs;
+    }
+    wakeCv_.notify_all();
+}
+
+void RedisDelayedQueue::run()
+{
+    while (running_) {
+        {
+            // 认领期间调度的任务由 wake() 记录到 nextWakeMs_
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            nextWakeMs_ = std::numeric_limits<qint64>::max();
+        }
+
+        qint64 waitMs = options_.maxPollMs;
+        if (!manager_->isAvailable()) {
+            waitMs = kUnavailableBackoffMs;
+        } else {
+            qint64 nextDue = -1;
+            int moved = claimDue(options_.batchSize, &nextDue);
+            if (moved >= options_.batchSize) {
+                // 还有积压的到期任务, 立即继续
+                continue;
+            }
+            if (nextDue >= 0) {
+                waitMs = std::max<qint64>(options_.minPollMs,
+                                          std::min<qint64>(nextDue - nowMs(), options_.maxPollMs));
+            }
+        }
+
+        // 等待期间 wake() 可能把唤醒时间提前, 每次醒来按最新的唤醒时间重新计算
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        nextWakeMs_ = std::min(nextWakeMs_, nowMs() + waitMs);
+        while (running_) {
+            qint64 remaining = nextWakeMs_ - nowMs();
+            if (remaining <= 0) {
+                break;
+            }
+            wakeCv_.wait_for(lock, std::chrono::milliseconds(remaining));
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef REDISDELAYEDQUEUE_H
+#define REDISDELAYEDQUEUE_H
+
+#include <QDateTime>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "../tool/redismodule_export.h"
+
+class RedisManager;
+
+/**
+ * @brief 延迟队列配置
+ *
+ * name 为按到期时间(毫秒时间戳)排序的有序集合键, readyQueue 为到期任务推入的列表键
+ * (为空时使用 <name>:ready, 可直接作为 RedisWorkQueue 的队列名)
+ * batchSize 为单次 Lua 调用最多转移的任务数(上限 1000)
+ * 调度线程按最近到期时间等待, 等待时间限制在 [minPollMs, maxPollMs],
+ * 其他进程新增的更早到期任务最多延迟 maxPollMs 被发现
+ */
+struct RedisDelayedQueueOptions
+{
+    QString name;
+    QString readyQueue;
+    int batchSize = 100;
+    int minPollMs = 1;
+    int maxPollMs = 1000;
+};
+
+/**
+ * @brief 基于有序集合的延迟任务调度器
+ *
+ * 任务以到期时间为分数存入有序集合, 调度线程通过一次原子 Lua 调用
+ * (ZRANGEBYSCORE + ZREM + RPUSH) 将到期任务批量转移到就绪列表, 并取回下一个到期时间;
+ * 同一任务(相同内容)重复调度时只保留最后一次的到期时间
+ *
+ * 到期判断使用调用方时钟, 多进程调度时各主机时钟需要同步
+ */
+class REDISMODULESHARED_EXPORT RedisDelayedQueue
+{
+public:
+    RedisDelayedQueue(RedisManager *manager, const RedisDelayedQueueOptions &options);
+    ~RedisDelayedQueue();
+
+    RedisDelayedQueue(const RedisDelayedQueue &) = delete;
+    RedisDelayedQueue& operator=(const RedisDelayedQueue &) = delete;
+
+    /**
+    * @brief 调度操作
+    *
+    * 在指定时间到期,在 delayMs 毫秒后到期,批量调度(任务, 到期毫秒时间戳),取消调度
+    */
+    bool schedule(const QString &job, const QDateTime &dueAt);
+    bool scheduleIn(const QString &job, qint64 delayMs);
+    bool scheduleBatch(const QVector<QPair<QString, qint64>> &jobs);
+    bool cancel(const QString &job);
+
+    /**
+    * @brief 认领操作
+    *
+    * 将最多 maxCount(<= 0 时使用 batchSize)个已到期任务原子转移到就绪列表, 返回转移数量;
+    * nextDueMs 非空时写入下一个到期时间(无待调度任务时为 -1)
+    */
+    int claimDue(int maxCount = 0, qint64 *nextDueMs = nullptr);
+
+    /**
+    * @brief 调度线程
+    *
+    * 启动后台调度线程, 停止并等待调度线程退出
+    */
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    /**
+    * @brief 统计
+    *
+    * 待调度任务数,就绪任务数,已转移任务数,Lua 调用次数
+    */
+    long long pendingCount();
+    int readyCount();
+    qint64 claimedCount() const;
+    qint64 claimCalls() const;
+
+    QString readyQueue() const;
+
+private:
+    void run();
+    void wake(qint64 dueMs);
+
+    RedisManager *manager_;
+    RedisDelayedQueueOptions options_;
+
+    std::thread worker_;
+    std::atomic<bool> running_;
+    std::atomic<qint64> claimed_;
+    std::atomic<qint64> calls_;
+
+    // 调度线程的下次唤醒时间, 本进程调度了更早的任务时提前唤醒
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    qint64 nextWakeMs_;
+};
+
+#endif // REDISDELAYEDQUEUE_H
@@ -0,0 +1,182 @@
+#include "redisstreamconsumer.h"
+#include "../redismanager.h"
+#include <QDebug>
+#include <chrono>
+
+namespace {
+// 连接不可用时的重试间隔, 避免工作线程空转
+constexpr int kUnavailableBackoffMs = 100;
+}
+
+RedisStreamConsumer::RedisStreamConsumer(RedisManager *manager, const RedisStreamConsumerOptions &options,
+                                         BatchHandler handler)
+    : manager_(manager)
+    , options_(options)
+    , handler_(std::move(handler))
+    , running_(false)
+    , delivered_(0)
+    , acked_(0)
+    , claimed_(0)
+    , claimCursor_("0-0")
+{
+}
+
+RedisStreamConsumer::~RedisStreamConsumer()
+{
+    stop();
+}
+
+bool RedisStreamConsumer::start()
+{
+    if (running_) {
+        return true;
+    }
+    if (!manager_ || !handler_ || options_.batchSize <= 0) {
+        qWarning() << "Stream consumer: invalid options";
+        return false;
+    }
+    if (!manager_->xGroupCreate(options_.stream, options_.group, options_.startId, true)) {
+        qWarning() << "Stream consumer: failed to create group" << options_.group << "on" << options_.stream;
+        return false;
+    }
+
+    running_ = true;
+    worker_ = std::thread(&RedisStreamConsumer::run, this);
+    qDebug() << "Stream consumer started:" << options_.stream << options_.group << options_.consumer;
+    return true;
+}
+
+void RedisStreamConsumer::stop()
+{
+    running_ = false;
+    if (worker_.joinable()) {
+        worker_.join();
+        qDebug() << "Stream consumer stopped:" << options_.stream << options_.group << options_.consumer;
+    }
+}
+
+bool RedisStreamConsumer::isRunning() const
+{
+    return running_;
+}
+
+qint64 RedisStreamConsumer::deliveredCount() const
+{
+    return delivered_;
+}
+
+qint64 RedisStreamConsumer::ackedCount() const
+{
+    return acked_;
+}
+
+qint64 RedisStreamConsumer::claimedCount() const
+{
+    return claimed_;
+}
+
+void RedisStreamConsumer::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 先恢复本消费者上次未确认的消息, 游标随批次推进, 处理失败的消息在本轮不会被反复读取
+    QString pendingCursor = "0";
+    bool recovering = true;
+    Clock::time_point nextClaim = Clock::now();
+    // 有消息被拒绝时, 到期后从 "0" 再扫描一遍本消费者的 PEL
+    bool retryScheduled = false;
+    Clock::time_point nextRetry;
+
+    bool waitingForRedis = false;
+
+    while (running_) {
+        if (!manager_->isAvailable()) {
+            if (!waitingForRedis) {
+                qWarning() << "Stream consumer: Redis unavailable, pausing" << options_.stream << options_.consumer;
+                waitingForRedis = true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(kUnavailableBackoffMs));
+            continue;
+        }
+        if (waitingForRedis) {
+            qWarning() << "Stream consumer: Redis available again, resuming" << options_.stream << options_.consumer;
+            waitingForRedis = false;
+        }
+
+        bool handled = true;
+        if (options_.claimMinIdleMs > 0 && Clock::now() >= nextClaim) {
+            handled = claimIdle();
+            nextClaim = Clock::now() + std::chrono::milliseconds(options_.claimIntervalMs);
+        }
+
+        if (!recovering && retryScheduled && Clock::now() >= nextRetry) {
+            recovering = true;
+            pendingCursor = "0";
+            retryScheduled = false;
+        }
+
+        QVector<RedisStreamEntry> entries;
+        if (recovering) {
+            entries = manager_->xReadGroup(options_.stream, options_.group, options_.consumer,
+                                           options_.batchSize, 0, pendingCursor);
+            if (entries.isEmpty()) {
+                recovering = false;
+            } else {
+                pendingCursor = entries.last().id;
+            }
+        } else {
+            entries = manager_->xReadGroup(options_.stream, options_.group, options_.consumer,
+                                           options_.batchSize, options_.blockMs, ">");
+        }
+
+        if (!entries.isEmpty() && !process(entries)) {
+            handled = false;
+        }
+        if (!handled && options_.retryIntervalMs > 0 && !retryScheduled) {
+            retryScheduled = true;
+            nextRetry = Clock::now() + std::chrono::milliseconds(options_.retryIntervalMs);
+        }
+    }
+}
+
+bool RedisStreamConsumer::process(const QVector<RedisStreamEntry> &entries)
+{
+    delivered_ += entries.size();
+
+    bool handled = false;
+    try {
+        handled = handler_(entries);
+    } catch (const std::exception &e) {
+        qWarning() << "Stream consumer handler error:" << e.what();
+    } catch (...) {
+        qWarning() << "Stream consumer handler error: unknown exception";
+    }
+    if (!handled) {
+        qWarning() << "Stream consumer:" << entries.size() << "entries rejected, left pending from"
+                   << entries.first().id << "on" << options_.stream;
+        return false;
+    }
+
+    QVector<QString> ids;
+    ids.reserve(entries.size());
+    for (const auto &entry : entries) {
+        ids.append(entry.id);
+    }
+    acked_ += manager_->xAck(options_.stream, options_.group, ids);
+    return true;
+}
+
+bool RedisStreamConsumer::claimIdle()
+{
+    // 每轮最多接管一批, 游标回到 "0-0" 表示整个 PEL 已扫描一遍
+    RedisStreamClaimResult result = manager_->xAutoClaim(options_.stream, options_.group, options_.consumer,
+                                                         options_.claimMinIdleMs, claimCursor_,
+                                                         options_.batchSize);
+    claimCursor_ = result.nextId.isEmpty() ? QString("0-0") : result.nextId;
+    if (result.entries.isEmpty()) {
+        return true;
+    }
+
+    claimed_ += result.entries.size();
+    return process(result.entries);
+}
@@ -0,0 +1,96 @@
+#ifndef REDISSTREAMCONSUMER_H
+#define REDISSTREAMCONSUMER_H
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "../operation/redisstreamoperations.h"
+#include "../tool/redismodule_export.h"
+
+class RedisManager;
+
+/**
+ * @brief 流消费者配置
+ *
+ * batchSize 为每次 XREADGROUP 的 COUNT, blockMs 为无新消息时的 BLOCK 等待时间;
+ * 阻塞读取使用 RedisManager 的阻塞专用连接池(大小为 poolSize), 等待期间不占用主连接池,
+ * 同一个 RedisManager 上的消费者数(含工作队列消费线程)超过 poolSize 时阻塞读取互相排队
+ * claimMinIdleMs > 0 时每隔 claimIntervalMs 通过 XAUTOCLAIM 接管其他消费者超时未确认的消息
+ * retryIntervalMs > 0 时, 处理函数拒绝过消息后每隔 retryIntervalMs 从 "0" 重新读取本消费者的未确认消息重试
+ * startId 为消费组不存在时的创建起点("$" 只消费新消息, "0" 从头消费)
+ */
+struct RedisStreamConsumerOptions
+{
+    QString stream;
+    QString group;
+    QString consumer;
+    int batchSize = 100;
+    int blockMs = 1000;
+    qint64 claimMinIdleMs = 0;
+    int claimIntervalMs = 5000;
+    int retryIntervalMs = 5000;
+    QString startId = "$";
+};
+
+/**
+ * @brief 流消费者
+ *
+ * 在工作线程上按批读取消费组消息并交给处理函数, 处理函数返回 true 时整批 XACK 确认;
+ * 返回 false 或抛出异常时消息留在 PEL 中, 经过 retryIntervalMs 后由本消费者重新读取重试,
+ * 也可由其他消费者 XAUTOCLAIM 接管
+ *
+ * 启动时先读取本消费者的未确认消息(ID "0" 起), 处理完后再读取新消息(">")
+ */
+class REDISMODULESHARED_EXPORT RedisStreamConsumer
+{
+public:
+    using BatchHandler = std::function<bool(const QVector<RedisStreamEntry> &entries)>;
+
+    RedisStreamConsumer(RedisManager *manager, const RedisStreamConsumerOptions &options, BatchHandler handler);
+    ~RedisStreamConsumer();
+
+    RedisStreamConsumer(const RedisStreamConsumer &) = delete;
+    RedisStreamConsumer& operator=(const RedisStreamConsumer &) = delete;
+
+    /**
+    * @brief 启停控制
+    *
+    * 启动时创建消费组(已存在视为成功)并启动工作线程, 创建失败返回 false
+    * 停止时等待当前批次处理完成, 最长额外等待一个 blockMs
+    */
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    /**
+    * @brief 统计
+    *
+    * 已交给处理函数的消息数, 已确认的消息数, 通过 XAUTOCLAIM 接管的消息数
+    */
+    qint64 deliveredCount() const;
+    qint64 ackedCount() const;
+    qint64 claimedCount() const;
+
+private:
+    void run();
+    bool process(const QVector<RedisStreamEntry> &entries);
+    bool claimIdle();
+
+    RedisManager *manager_;
+    RedisStreamConsumerOptions options_;
+    BatchHandler handler_;
+
+    std::thread worker_;
+    std::atomic<bool> running_;
+    std::atomic<qint64> delivered_;
+    std::atomic<qint64> acked_;
+    std::atomic<qint64> claimed_;
+
+    // 仅工作线程访问
+    QString claimCursor_;
+};
+
+#endif // REDISSTREAMCONSUMER_H
@@ -0,0 +1,251 @@
+#include "redissubscriber.h"
+#include <QDebug>
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+// consume() 的等待上限, 决定订阅变更和停止请求的最大生效延迟, 不影响消息投递延迟
+constexpr int kPollIntervalMs = 100;
+
+QString toQString(const std::string &value)
+{
+    return QString::fromUtf8(value.data(), static_cast<int>(value.size()));
+}
+
+QByteArray toPayload(const std::string &value)
+{
+    return QByteArray(value.data(), static_cast<int>(value.size()));
+}
+
+std::vector<std::string> toStdVector(const QSet<QString> &names)
+{
+    std::vector<std::string> result;
+    result.reserve(names.size());
+    for (const auto &name : names) {
+        result.push_back(name.toStdString());
+    }
+    return result;
+}
+}
+
+RedisSubscriber::RedisSubscriber(QObject *parent)
+    : QObject(parent)
+    , running_(false)
+    , connected_(false)
+{
+}
+
+RedisSubscriber::~RedisSubscriber()
+{
+    stop();
+}
+
+bool RedisSubscriber::start(const RedisConnectionOptions &options)
+{
+    if (running_) {
+        return true;
+    }
+    options_ = options;
+    running_ = true;
+    worker_ = std::thread(&RedisSubscriber::run, this);
+    return true;
+}
+
+void RedisSubscriber::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    stopCv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool RedisSubscriber::isRunning() const
+{
+    return running_;
+}
+
+bool RedisSubscriber::isConnected() const
+{
+    return connected_;
+}
+
+void RedisSubscriber::subscribe(const QString &channel)
+{
+    enqueue(ChangeType::Subscribe, channel);
+}
+
+void RedisSubscriber::unsubscribe(const QString &channel)
+{
+    enqueue(ChangeType::Unsubscribe, channel);
+}
+
+void RedisSubscriber::psubscribe(const QString &pattern)
+{
+    enqueue(ChangeType::PSubscribe, pattern);
+}
+
+void RedisSubscriber::punsubscribe(const QString &pattern)
+{
+    enqueue(ChangeType::PUnsubscribe, pattern);
+}
+
+void RedisSubscriber::ssubscribe(const QString &channel)
+{
+    enqueue(ChangeType::SSubscribe, channel);
+}
+
+void RedisSubscriber::sunsubscribe(const QString &channel)
+{
+    enqueue(ChangeType::SUnsubscribe, channel);
+}
+
+void RedisSubscriber::enqueue(ChangeType type, const QString &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (type) {
+    case ChangeType::Subscribe:    channels_.insert(name); break;
+    case ChangeType::Unsubscribe:  channels_.remove(name); break;
+    case ChangeType::PSubscribe:   patterns_.insert(name); break;
+    case ChangeType::PUnsubscribe: patterns_.remove(name); break;
+    case ChangeType::SSubscribe:   shardChannels_.insert(name); break;
+    case ChangeType::SUnsubscribe: shardChannels_.remove(name); break;
+    }
+    pending_.append({type, name});
+}
+
+bool RedisSubscriber::waitBackoff(int delayMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopCv_.wait_for(lock, std::chrono::milliseconds(delayMs), [this]() { return !running_; });
+    return running_;
+}
+
+void RedisSubscriber::run()
+{
+    int delayMs = std::max(1, options_.reconnectInitialDelayMs);
+
+    while (running_) {
+        try {
+            sw::redis::ConnectionOptions connectionOptions;
+            connectionOptions.host = options_.host.toStdString();
+            connectionOptions.port = options_.port;
+            connectionOptions.connect_timeout = std::chrono::milliseconds(options_.connectTimeoutMs);
+            connectionOptions.socket_timeout = std::chrono::milliseconds(kPollIntervalMs);
+
+            sw::redis::Redis redis(connectionOptions);
+            sw::redis::Subscriber subscriber = redis.subscriber();
+
+            // 回调在 consume() 内、订阅线程上执行; 分片频道集合仅订阅线程访问
+            QSet<QString> activeShards;
+            subscriber.on_message([this, &activeShards](std::string channel, std::string msg) {
+                QString name = toQString(channel);
+                if (activeShards.contains(name)) {
+                    emit shardMessageReceived(name, toPayload(msg));
+                } else {
+                    emit messageReceived(name, toPayload(msg));
+                }
+            });
+            subscriber.on_pmessage([this](std::string pattern, std::string channel, std::string msg) {
+                emit patternMessageReceived(toQString(pattern), toQString(channel), toPayload(msg));
+            });
+            subscriber.on_meta([this](sw::redis::Subscriber::MsgType type, sw::redis::OptionalString channel,
+                                      long long num) {
+                Q_UNUSED(num);
+                QString name = channel ? toQString(*channel) : QString();
+                switch (type) {
+                case sw::redis::Subscriber::MsgType::SUBSCRIBE:
+                case sw::redis::Subscriber::MsgType::PSUBSCRIBE:
+                case sw::redis::Subscriber::MsgType::SSUBSCRIBE:
+                    emit subscribed(name);
+                    break;
+                case sw::redis::Subscriber::MsgType::UNSUBSCRIBE:
+                case sw::redis::Subscriber::MsgType::PUNSUBSCRIBE:
+                case sw::redis::Subscriber::MsgType::SUNSUBSCRIBE:
+                    emit unsubscribed(name);
+                    break;
+                default:
+                    break;
+                }
+            });
+
+            // (重)连后提交完整订阅集合, 之前排队的变更已反映在集合中
+            std::vector<std::string> channels;
+            std::vector<std::string> patterns;
+            std::vector<std::string> shards;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                channels = toStdVector(channels_);
+                patterns = toStdVector(patterns_);
+                shards = toStdVector(shardChannels_);
+                activeShards = shardChannels_;
+                pending_.clear();
+            }
+            if (!channels.empty()) {
+                subscriber.subscribe(channels.begin(), channels.end());
+            }
+            if (!patterns.empty()) {
+                subscriber.psubscribe(patterns.begin(), patterns.end());
+            }
+            if (!shards.empty()) {
+                subscriber.ssubscribe(shards.begin(), shards.end());
+            }
+
+            connected_ = true;
+            delayMs = std::max(1, options_.reconnectInitialDelayMs);
+            qDebug() << "Subscriber connected:" << options_.host << ":" << options_.port
+                     << "channels" << channels.size() << "patterns" << patterns.size() << "shards" << shards.size();
+            emit connected();
+
+            while (running_) {
+                QVector<Change> changes;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    changes.swap(pending_);
+                }
+                for (const auto &change : changes) {
+                    const std::string name = change.name.toStdString();
+                    switch (change.type) {
+                    case ChangeType::Subscribe:    subscriber.subscribe(name); break;
+                    case ChangeType::Unsubscribe:  subscriber.unsubscribe(name); break;
+                    case ChangeType::PSubscribe:   subscriber.psubscribe(name); break;
+                    case ChangeType::PUnsubscribe: subscriber.punsubscribe(name); break;
+                    case ChangeType::SSubscribe:
+                        activeShards.insert(change.name);
+                        subscriber.ssubscribe(name);
+                        break;
+                    case ChangeType::SUnsubscribe:
+                        activeShards.remove(change.name);
+                        subscriber.sunsubscribe(name);
+                        break;
+                    }
+                }
+
+                try {
+                    subscriber.consume();
+                } catch (const sw::redis::TimeoutError &) {
+                    // 轮询间隔内无消息, 连接仍然有效
+                }
+            }
+        } catch (const sw::redis::Error &e) {
+            if (connected_.exchange(false)) {
+                qDebug() << "Subscriber disconnected:" << e.what();
+                emit disconnected(QString::fromStdString(e.what()));
+            } else {
+                qDebug() << "Subscriber connect failed:" << e.what() << "retry in" << delayMs << "ms";
+            }
+            if (!waitBackoff(delayMs)) {
+                break;
+            }
+            delayMs = std::min(delayMs * 2, std::max(delayMs, options_.reconnectMaxDelayMs));
+        }
+    }
+
+    if (connected_.exchange(false)) {
+        emit disconnected(QString());
+    }
+}
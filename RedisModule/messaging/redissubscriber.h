@@ -0,0 +1,101 @@
+#ifndef REDISSUBSCRIBER_H
+#define REDISSUBSCRIBER_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QSet>
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "../tool/redisconnectionoptions.h"
+#include "../tool/redismodule_export.h"
+
+/**
+ * @brief Pub/Sub 订阅者
+ *
+ * 在独立线程上持有专用的 sw::redis::Subscriber 连接, 收到的消息以信号发出;
+ * 信号在订阅线程上发射, 接收者位于其他线程时按队列连接投递到接收者线程
+ *
+ * 订阅集合由调用方线程修改, 在两次 consume() 之间应用到连接上;
+ * 连接断开后按 RedisConnectionOptions 中的退避参数重连, 并重新订阅全部频道和模式
+ *
+ * 分片订阅(SSUBSCRIBE)需要 Redis 7.0+ 与支持分片 Pub/Sub 的 redis-plus-plus
+ */
+class REDISMODULESHARED_EXPORT RedisSubscriber : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RedisSubscriber(QObject *parent = nullptr);
+    ~RedisSubscriber();
+
+    /**
+    * @brief 启停控制
+    *
+    * 启动订阅线程(立即返回, 连接在订阅线程上建立), 停止并等待订阅线程退出
+    */
+    bool start(const RedisConnectionOptions &options = RedisConnectionOptions());
+    void stop();
+    bool isRunning() const;
+    bool isConnected() const;
+
+    /**
+    * @brief 订阅管理
+    *
+    * 订阅/退订频道, 订阅/退订模式, 订阅/退订分片频道
+    * 可在启动前后任意线程调用, 服务器确认后发出 subscribed 信号
+    */
+    void subscribe(const QString &channel);
+    void unsubscribe(const QString &channel);
+    void psubscribe(const QString &pattern);
+    void punsubscribe(const QString &pattern);
+    void ssubscribe(const QString &channel);
+    void sunsubscribe(const QString &channel);
+
+signals:
+    void messageReceived(const QString &channel, const QByteArray &payload);
+    void patternMessageReceived(const QString &pattern, const QString &channel, const QByteArray &payload);
+    void shardMessageReceived(const QString &channel, const QByteArray &payload);
+
+    void subscribed(const QString &channel);
+    void unsubscribed(const QString &channel);
+
+    /**
+    * @brief 连接状态
+    *
+    * 每次建连(含重连)并重新提交全部订阅后发出 connected, 连接断开时发出 disconnected
+    */
+    void connected();
+    void disconnected(const QString &error);
+
+private:
+    enum class ChangeType { Subscribe, Unsubscribe, PSubscribe, PUnsubscribe, SSubscribe, SUnsubscribe };
+    struct Change
+    {
+        ChangeType type;
+        QString name;
+    };
+
+    void enqueue(ChangeType type, const QString &name);
+    void run();
+    bool waitBackoff(int delayMs);
+
+    RedisConnectionOptions options_;
+    std::thread worker_;
+    std::atomic<bool> running_;
+    std::atomic<bool> connected_;
+
+    // 订阅集合与待应用的变更, 由 mutex_ 保护
+    mutable std::mutex mutex_;
+    std::condition_variable stopCv_;
+    QSet<QString> channels_;
+    QSet<QString> patterns_;
+    QSet<QString> shardChannels_;
+    QVector<Change> pending_;
+};
+
+#endif // REDISSUBSCRIBER_H
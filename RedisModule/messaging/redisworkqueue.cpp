@@ -0,0 +1,264 @@
+#include "redisworkqueue.h"
+#include "../redismanager.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSysInfo>
+#include <chrono>
+
+namespace {
+
+// 连接不可用时的重试间隔, 避免消费线程空转
+constexpr int kUnavailableBackoffMs = 100;
+
+// KEYS: 队列, 处理中列表, 心跳, 消费者集合; ARGV: 批大小, 心跳 TTL(毫秒), 消费者 ID
+const QString kClaimScript = QStringLiteral(R"(
+redis.call('SET', KEYS[3], '1', 'PX', ARGV[2])
+redis.call('SADD', KEYS[4], ARGV[3])
+local items = {}
+for i = 1, tonumber(ARGV[1]) do
+    local item = redis.call('LMOVE', KEYS[1], KEYS[2], 'LEFT', 'RIGHT')
+    if not item then
+        break
+    end
+    items[#items + 1] = item
+end
+return items
+)");
+
+// KEYS: 处理中列表, 心跳; ARGV: 心跳 TTL(毫秒), 任务...
+const QString kAckScript = QStringLiteral(R"(
+redis.call('SET', KEYS[2], '1', 'PX', ARGV[1])
+local removed = 0
+for i = 2, #ARGV do
+    removed = removed + redis.call('LREM', KEYS[1], 1, ARGV[i])
+end
+return removed
+)");
+
+// KEYS: 处理中列表, 队列; ARGV: 任务...
+const QString kRequeueScript = QStringLiteral(R"(
+local requeued = 0
+for i = 1, #ARGV do
+    if redis.call('LREM', KEYS[1], 1, ARGV[i]) > 0 then
+        redis.call('RPUSH', KEYS[2], ARGV[i])
+        requeued = requeued + 1
+    end
+end
+return requeued
+)");
+
+// KEYS: 队列, 消费者集合; ARGV: 队列名, 指定消费者(为空时检查全部消费者的心跳)
+const QString kRecoverScript = QStringLiteral(R"(
+local consumers
+if ARGV[2] ~= '' then
+    consumers = {ARGV[2]}
+else
+    consumers = redis.call('SMEMBERS', KEYS[2])
+end
+local recovered = 0
+for _, consumer in ipairs(consumers) do
+    if ARGV[2] ~= '' or redis.call('EXISTS', ARGV[1] .. ':heartbeat:' .. consumer) == 0 then
+        local processing = ARGV[1] .. ':processing:' .. consumer
+        while redis.call('LMOVE', processing, KEYS[1], 'RIGHT', 'LEFT') do
+            recovered = recovered + 1
+        end
+        redis.call('SREM', KEYS[2], consumer)
+    end
+end
+return recovered
+)");
+
+} // namespace
+
+RedisWorkQueue::RedisWorkQueue(RedisManager *manager, const RedisWorkQueueOptions &options, JobHandler handler)
+    : manager_(manager)
+    , options_(options)
+    , handler_(std::move(handler))
+    , running_(false)
+    , processed_(0)
+    , failed_(0)
+    , recovered_(0)
+{
+    if (options_.consumerName.isEmpty()) {
+        options_.consumerName = QString("%1-%2").arg(QSysInfo::machineHostName())
+                                                .arg(QCoreApplication::applicationPid());
+    }
+}
+
+RedisWorkQueue::~RedisWorkQueue()
+{
+    stop();
+}
+
+bool RedisWorkQueue::enqueue(const QString &job)
+{
+    return manager_->rPush(options_.name, job);
+}
+
+bool RedisWorkQueue::enqueueBatch(const QVector<QString> &jobs)
+{
+    return manager_->rPush(options_.name, jobs);
+}
+
+int RedisWorkQueue::pendingCount()
+{
+    return manager_->lLen(options_.name);
+}
+
+bool RedisWorkQueue::start()
+{
+    if (running_) {
+        return true;
+    }
+    if (!manager_ || !handler_ || options_.name.isEmpty()
+        || options_.consumerCount <= 0 || options_.batchSize <= 0) {
+        qDebug() << "Work queue: invalid options";
+        return false;
+    }
+
+    running_ = true;
+    workers_.reserve(options_.consumerCount);
+    for (int i = 0; i < options_.consumerCount; ++i) {
+        workers_.emplace_back(&RedisWorkQueue::run, this, i);
+    }
+    qDebug() << "Work queue started:" << options_.name << "consumers" << options_.consumerCount
+             << "batch" << options_.batchSize;
+    return true;
+}
+
+void RedisWorkQueue::stop()
+{
+    running_ = false;
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    if (!workers_.empty()) {
+        workers_.clear();
+        qDebug() << "Work queue stopped:" << options_.name;
+    }
+}
+
+bool RedisWorkQueue::isRunning() const
+{
+    return running_;
+}
+
+long long RedisWorkQueue::recoverStale()
+{
+    return recover(QString());
+}
+
+qint64 RedisWorkQueue::processedCount() const
+{
+    return processed_;
+}
+
+qint64 RedisWorkQueue::failedCount() const
+{
+    return failed_;
+}
+
+qint64 RedisWorkQueue::recoveredCount() const
+{
+    return recovered_;
+}
+
+QString RedisWorkQueue::consumerId(int index) const
+{
+    return QString("%1-%2").arg(options_.consumerName).arg(index);
+}
+
+QString RedisWorkQueue::processingKey(const QString &consumer) const
+{
+    return options_.name + ":processing:" + consumer;
+}
+
+QString RedisWorkQueue::heartbeatKey(const QString &consumer) const
+{
+    return options_.name + ":heartbeat:" + consumer;
+}
+
+QString RedisWorkQueue::registryKey() const
+{
+    return options_.name + ":consumers";
+}
+
+long long RedisWorkQueue::recover(const QString &consumer)
+{
+    long long recovered = manager_->evalInteger(kRecoverScript, {options_.name, registryKey()},
+                                                {options_.name, consumer});
+    if (recovered > 0) {
+        recovered_ += recovered;
+        qDebug() << "Work queue" << options_.name << "recovered" << recovered << "in-flight jobs";
+    }
+    return recovered;
+}
+
+void RedisWorkQueue::run(int index)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const QString consumer = consumerId(index);
+    const QString processing = processingKey(consumer);
+    const QVector<QString> claimKeys = {options_.name, processing, heartbeatKey(consumer), registryKey()};
+    const QVector<QString> claimArgs = {QString::number(options_.batchSize),
+                                        QString::number(options_.heartbeatTtlMs), consumer};
+
+    // 同名消费者上次退出时遗留的处理中任务先放回队列
+    recover(consumer);
+    Clock::time_point nextRecovery = Clock::now() + std::chrono::milliseconds(options_.recoveryIntervalMs);
+
+    while (running_) {
+        if (!manager_->isAvailable()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kUnavailableBackoffMs));
+            continue;
+        }
+
+        if (index == 0 && Clock::now() >= nextRecovery) {
+            recoverStale();
+            nextRecovery = Clock::now() + std::chrono::milliseconds(options_.recoveryIntervalMs);
+        }
+
+        QVector<QString> jobs = manager_->evalStrings(kClaimScript, claimKeys, claimArgs);
+        if (jobs.isEmpty()) {
+            QString job = manager_->bLMove(options_.name, processing, RedisListEnd::Left, RedisListEnd::Right,
+                                           options_.blockTimeoutSec);
+            if (job.isEmpty()) {
+                continue;
+            }
+            jobs.append(job);
+        }
+
+        QVector<QString> done;
+        QVector<QString> failed;
+        done.reserve(jobs.size());
+        for (const auto &job : jobs) {
+            bool ok = false;
+            try {
+                ok = handler_(job);
+            } catch (const std::exception &e) {
+                qDebug() << "Work queue handler error:" << e.what();
+            } catch (...) {
+                qDebug() << "Work queue handler error: unknown exception";
+            }
+            (ok ? done : failed).append(job);
+        }
+        finish(consumer, done, failed);
+    }
+}
+
+void RedisWorkQueue::finish(const QString &consumer, const QVector<QString> &done, const QVector<QString> &failed)
+{
+    if (!done.isEmpty()) {
+        QVector<QString> args;
+        args.reserve(done.size() + 1);
+        args.append(QString::number(options_.heartbeatTtlMs));
+        args += done;
+        processed_ += manager_->evalInteger(kAckScript, {processingKey(consumer), heartbeatKey(consumer)}, args);
+    }
+    if (!failed.isEmpty()) {
+        failed_ += manager_->evalInteger(kRequeueScript, {processingKey(consumer), options_.name}, failed);
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef REDISWORKQUEUE_H
+#define REDISWORKQUEUE_H
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "../tool/redismodule_export.h"
+
+class RedisManager;
+
+/**
+ * @brief 工作队列配置
+ *
+ * name 为待处理列表键, 其余键以它为前缀:
+ *   <name>:processing:<consumer>  消费者处理中列表
+ *   <name>:heartbeat:<consumer>   消费者心跳(带 TTL)
+ *   <name>:consumers              已注册消费者集合
+ * consumerCount 为消费线程数, 连接池 poolSize 应不小于 consumerCount + 1
+ * batchSize 为每次往返最多认领的任务数, blockTimeoutSec 为队列为空时的阻塞等待时间
+ * heartbeatTtlMs 必须大于 blockTimeoutSec 与处理一批任务耗时之和, 否则会被误判为失效
+ * consumerName 为空时使用 主机名-进程号
+ */
+struct RedisWorkQueueOptions
+{
+    QString name;
+    QString consumerName;
+    int consumerCount = 1;
+    int batchSize = 10;
+    int blockTimeoutSec = 1;
+    int heartbeatTtlMs = 30000;
+    int recoveryIntervalMs = 5000;
+};
+
+/**
+ * @brief 基于列表的可靠工作队列
+ *
+ * 消费线程通过 Lua 脚本以单次往返把最多 batchSize 个任务 LMOVE 到自己的处理中列表,
+ * 队列为空时退化为 BLMOVE 阻塞等待; 处理成功后从处理中列表删除, 失败则放回队尾
+ *
+ * 消费者崩溃后心跳过期, 其处理中列表的任务由恢复流程放回队首重新投递(至少一次语义);
+ * 恢复脚本在服务器端拼接键名, 不适用于 Redis Cluster
+ *
+ * 任务内容不能为空字符串
+ */
+class REDISMODULESHARED_EXPORT RedisWorkQueue
+{
+public:
+    using JobHandler = std::function<bool(const QString &job)>;
+
+    RedisWorkQueue(RedisManager *manager, const RedisWorkQueueOptions &options, JobHandler handler = JobHandler());
+    ~RedisWorkQueue();
+
+    RedisWorkQueue(const RedisWorkQueue &) = delete;
+    RedisWorkQueue& operator=(const RedisWorkQueue &) = delete;
+
+    /**
+    * @brief 生产操作
+    *
+    * 追加任务,批量追加任务(单次往返),获取待处理任务数
+    */
+    bool enqueue(const QString &job);
+    bool enqueueBatch(const QVector<QString> &jobs);
+    int pendingCount();
+
+    /**
+    * @brief 启停控制
+    *
+    * 启动 consumerCount 个消费线程(需要处理函数), 停止并等待当前批次处理完成
+    */
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    /**
+    * @brief 失效恢复
+    *
+    * 将心跳已过期的消费者的处理中任务放回队首, 返回恢复的任务数;
+    * 运行期间由第一个消费线程按 recoveryIntervalMs 周期调用
+    */
+    long long recoverStale();
+
+    /**
+    * @brief 统计
+    *
+    * 处理成功的任务数, 处理失败放回队列的任务数, 从失效消费者恢复的任务数
+    */
+    qint64 processedCount() const;
+    qint64 failedCount() const;
+    qint64 recoveredCount() const;
+
+    QString consumerId(int index) const;
+
+private:
+    void run(int index);
+    long long recover(const QString &consumer);
+    void finish(const QString &consumer, const QVector<QString> &done, const QVector<QString> &failed);
+
+    QString processingKey(const QString &consumer) const;
+    QString heartbeatKey(const QString &consumer) const;
+    QString registryKey() const;
+
+    RedisManager *manager_;
+    RedisWorkQueueOptions options_;
+    JobHandler handler_;
+
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_;
+    std::atomic<qint64> processed_;
+    std::atomic<qint64> failed_;
+    std::atomic<qint64> recovered_;
+};
+
+#endif // REDISWORKQUEUE_H
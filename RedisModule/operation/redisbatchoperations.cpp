@@ -0,0 +1,111 @@
+#include "redisbatchoperations.h"
+#include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/batch_operations.hpp>
+#include <QDebug>
+#include <vector>
+
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQString;
+using RedisTypeConversion::toQByteArray;
+using RedisTypeConversion::Utf8List;
+
+namespace {
+
+RedisPipelineReply toPipelineReply(const um::Reply &reply)
+{
+    RedisPipelineReply result;
+    result.value = toQByteArray(reply.str);
+    result.integer = reply.integer;
+    result.elements = static_cast<int>(reply.elements);
+    switch (reply.type) {
+    case um::Reply::Type::String:
+        result.type = RedisPipelineReply::Type::String;
+        break;
+    case um::Reply::Type::Integer:
+        result.type = RedisPipelineReply::Type::Integer;
+        break;
+    case um::Reply::Type::Array:
+        result.type = RedisPipelineReply::Type::Array;
+        break;
+    case um::Reply::Type::Error:
+        result.type = RedisPipelineReply::Type::Error;
+        break;
+    case um::Reply::Type::Nil:
+        result.type = RedisPipelineReply::Type::Nil;
+        break;
+    }
+    return result;
+}
+
+} // namespace
+
+RedisBatchOperations::RedisBatchOperations(RedisConnection* connection)
+    : RedisOperationsBase(connection)
+{
+}
+
+RedisBatchOperations::~RedisBatchOperations()
+{
+}
+
+bool RedisBatchOperations::mSet(const QMap<QString, QString> &values)
+{
+    return execute([&]() {
+        if (values.isEmpty()) {
+            return true;
+        }
+        std::vector<QByteArray> storage;
+        std::vector<um::FieldValue> items;
+        storage.reserve(static_cast<std::size_t>(values.size()) * 2);
+        items.reserve(static_cast<std::size_t>(values.size()));
+        for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+            storage.push_back(it.key().toUtf8());
+            storage.push_back(it.value().toUtf8());
+            items.emplace_back(view(storage[storage.size() - 2]), view(storage.back()));
+        }
+        um::BatchOperations(*connection_->redis()).mset(items);
+        qDebug() << "MSET" << values.size() << "个键";
+        return true;
+    }, "MSET", false);
+}
+
+QVector<QString> RedisBatchOperations::mGet(const QVector<QString> &keys)
+{
+    return execute([&]() {
+        Utf8List keyList(keys);
+        auto values = um::BatchOperations(*connection_->redis()).mget(keyList.views());
+        QVector<QString> result;
+        result.reserve(static_cast<int>(values.size()));
+        for (const auto &value : values) {
+            result.append(value ? toQString(*value) : QString());
+        }
+        qDebug() << "MGET" << keys.size() << "个键";
+        return result;
+    }, "MGET", QVector<QString>());
+}
+
+QVector<RedisPipelineReply> RedisBatchOperations::pipeline(const QVector<QVector<QByteArray>> &commands)
+{
+    return execute([&]() {
+        std::vector<um::KeyList> argv;
+        argv.reserve(static_cast<std::size_t>(commands.size()));
+        for (const auto &command : commands) {
+            um::KeyList args;
+            args.reserve(static_cast<std::size_t>(command.size()));
+            for (const auto &arg : command) {
+                args.push_back(view(arg));
+            }
+            argv.push_back(std::move(args));
+        }
+
+        auto replies = um::BatchOperations(*connection_->redis()).pipeline(argv);
+        QVector<RedisPipelineReply> result;
+        result.reserve(static_cast<int>(replies.size()));
+        for (const auto &reply : replies) {
+            result.append(toPipelineReply(reply));
+        }
+        qDebug() << "PIPELINE" << commands.size() << "条命令";
+        return result;
+    }, "PIPELINE", QVector<RedisPipelineReply>());
+}
@@ -0,0 +1,67 @@
+#ifndef REDISBATCHOPERATIONS_H
+#define REDISBATCHOPERATIONS_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include "../tool/redisoperationsbase.h"
+
+/**
+ * @brief 流水线中单条命令的应答
+ *
+ * 字符串与状态应答存入 value, 整数应答存入 integer, 数组应答只记录元素数量,
+ * 服务器错误以 Error 类型返回错误信息
+ */
+struct RedisPipelineReply
+{
+    enum class Type
+    {
+        Nil,
+        String,
+        Integer,
+        Array,
+        Error
+    };
+
+    Type type = Type::Nil;
+    QByteArray value;
+    long long integer = 0;
+    int elements = 0;
+
+    bool isError() const { return type == Type::Error; }
+};
+
+/**
+ * @brief Redis批量操作类
+ *
+ * 多键命令(MSET/MGET)与任意命令的流水线执行, 用于减少网络往返
+ */
+class RedisBatchOperations : public RedisOperationsBase
+{
+public:
+    /**
+    * @brief 构造函数和析构函数
+    */
+    explicit RedisBatchOperations(RedisConnection* connection);
+    ~RedisBatchOperations();
+
+    /**
+    * @brief 多键操作
+    *
+    * 一次往返设置多个键值对,一次往返读取多个键(不存在的键返回空字符串)
+    */
+    bool mSet(const QMap<QString, QString> &values);
+    QVector<QString> mGet(const QVector<QString> &keys);
+
+    /**
+    * @brief 流水线
+    *
+    * 每条命令为完整参数列表(命令名在前, 参数为二进制安全的字节流), 一次写出后按顺序返回应答;
+    * 单条命令的服务器错误只体现在对应应答中, 连接错误时整批失败返回空
+    * 流水线中的命令可能已部分执行, 不做自动重试
+    */
+    QVector<RedisPipelineReply> pipeline(const QVector<QVector<QByteArray>> &commands);
+};
+
+#endif // REDISBATCHOPERATIONS_H
@@ -1,7 +1,13 @@
 #include "redisbytesoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/string_operations.hpp>
+#include <um/operations/generic_operations.hpp>
 #include <QDebug>
 
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQByteArray;
+
 RedisBytesOperations::RedisBytesOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
 {
@@ -14,60 +20,59 @@ RedisBytesOperations::~RedisBytesOperations()
 bool RedisBytesOperations::set(const QString &key, const QByteArray &value)
 {
     return execute([&]() {
-        connection_->redis()->set(key.toStdString(), 
-            std::string(value.constData(), value.size()));
+        // 值直接以 QByteArray 的数据作为视图发送, 不再复制成 std::string
+        um::StringOperations(*connection_->redis()).set(view(key.toUtf8()), view(value));
         qDebug() << "BYTES_SET [设置字节流]" << key << "size=" << value.size();
         return true;
-    }, "BYTES_SET", false);
+    }, "BYTES_SET", {key, value.size()}, false);
 }
 
 QByteArray RedisBytesOperations::get(const QString &key)
 {
     return execute([&]() {
-        auto value = connection_->redis()->get(key.toStdString());
+        auto value = um::StringOperations(*connection_->redis()).get(view(key.toUtf8()));
         if (value) {
-            QByteArray result(value->data(), static_cast<int>(value->size()));
+            QByteArray result = toQByteArray(*value);
             qDebug() << "BYTES_GET [获取字节流]" << key << "size=" << result.size();
             return result;
         }
         qDebug() << "BYTES_GET [获取字节流]" << key << "= (null)";
         return QByteArray();
-    }, "BYTES_GET", QByteArray());
+    }, "BYTES_GET", key, QByteArray());
 }
 
 bool RedisBytesOperations::del(const QString &key)
 {
     return execute([&]() {
-        connection_->redis()->del(key.toStdString());
+        um::GenericOperations(*connection_->redis()).del(view(key.toUtf8()));
         qDebug() << "BYTES_DEL [删除字节流]" << key;
         return true;
-    }, "BYTES_DEL", false);
+    }, "BYTES_DEL", key, false);
 }
 
 bool RedisBytesOperations::exists(const QString &key)
 {
     return execute([&]() {
-        bool result = connection_->redis()->exists(key.toStdString());
+        bool result = um::GenericOperations(*connection_->redis()).exists(view(key.toUtf8()));
         qDebug() << "BYTES_EXISTS [检查字节流]" << key << "=" << result;
         return result;
-    }, "BYTES_EXISTS", false);
+    }, "BYTES_EXISTS", key, false);
 }
 
 bool RedisBytesOperations::append(const QString &key, const QByteArray &value)
 {
     return execute([&]() {
-        connection_->redis()->append(key.toStdString(),
-            std::string(value.constData(), value.size()));
+        um::StringOperations(*connection_->redis()).append(view(key.toUtf8()), view(value));
         qDebug() << "BYTES_APPEND [追加字节流]" << key << "size=" << value.size();
         return true;
-    }, "BYTES_APPEND", false);
+    }, "BYTES_APPEND", {key, value.size()}, false);
 }
 
 int RedisBytesOperations::size(const QString &key)
 {
     return execute([&]() {
-        long long len = connection_->redis()->strlen(key.toStdString());
+        long long len = um::StringOperations(*connection_->redis()).strlen(view(key.toUtf8()));
         qDebug() << "BYTES_SIZE [字节流大小]" << key << "=" << len;
         return static_cast<int>(len);
-    }, "BYTES_SIZE", 0);
+    }, "BYTES_SIZE", key, 0);
 }
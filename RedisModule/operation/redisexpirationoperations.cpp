@@ -1,7 +1,11 @@
 #include "redisexpirationoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/expiration_operations.hpp>
 #include <QDebug>
 
+using RedisTypeConversion::view;
+
 RedisExpirationOperations::RedisExpirationOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
 {
@@ -14,35 +18,35 @@ RedisExpirationOperations::~RedisExpirationOperations()
 bool RedisExpirationOperations::expire(const QString &key, int seconds)
 {
     return execute([&]() {
-        bool result = connection_->redis()->expire(key.toStdString(), seconds);
+        bool result = um::ExpirationOperations(*connection_->redis()).expire(view(key.toUtf8()), seconds);
         qDebug() << "EXPIRE" << key << seconds << "=" << result;
         return result;
-    }, "EXPIRE", false);
+    }, "EXPIRE", key, false);
 }
 
 bool RedisExpirationOperations::expireAt(const QString &key, qint64 timestamp)
 {
     return execute([&]() {
-        bool result = connection_->redis()->expireat(key.toStdString(), timestamp);
+        bool result = um::ExpirationOperations(*connection_->redis()).expireat(view(key.toUtf8()), timestamp);
         qDebug() << "EXPIREAT" << key << timestamp << "=" << result;
         return result;
-    }, "EXPIREAT", false);
+    }, "EXPIREAT", key, false);
 }
 
 int RedisExpirationOperations::ttl(const QString &key)
 {
     return execute([&]() {
-        long long ttlValue = connection_->redis()->ttl(key.toStdString());
+        long long ttlValue = um::ExpirationOperations(*connection_->redis()).ttl(view(key.toUtf8()));
         qDebug() << "TTL" << key << "=" << ttlValue;
         return static_cast<int>(ttlValue);
-    }, "TTL", -1);
+    }, "TTL", key, -1);
 }
 
 bool RedisExpirationOperations::persist(const QString &key)
 {
     return execute([&]() {
-        bool result = connection_->redis()->persist(key.toStdString());
+        bool result = um::ExpirationOperations(*connection_->redis()).persist(view(key.toUtf8()));
         qDebug() << "PERSIST" << key << "=" << result;
         return result;
-    }, "PERSIST", false);
+    }, "PERSIST", key, false);
 }
@@ -1,7 +1,12 @@
 #include "redisgenericoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/generic_operations.hpp>
 #include <QDebug>
 
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQStrings;
+
 RedisGenericOperations::RedisGenericOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
 {
@@ -14,31 +19,39 @@ RedisGenericOperations::~RedisGenericOperations()
 bool RedisGenericOperations::del(const QString &key)
 {
     return execute([&]() {
-        connection_->redis()->del(key.toStdString());
+        um::GenericOperations(*connection_->redis()).del(view(key.toUtf8()));
         qDebug() << "DEL" << key;
         return true;
-    }, "DEL", false);
+    }, "DEL", key, false);
 }
 
 bool RedisGenericOperations::exists(const QString &key)
 {
     return execute([&]() {
-        bool result = connection_->redis()->exists(key.toStdString());
+        bool result = um::GenericOperations(*connection_->redis()).exists(view(key.toUtf8()));
         qDebug() << "EXISTS" << key << "=" << result;
         return result;
-    }, "EXISTS", false);
+    }, "EXISTS", key, false);
 }
 
 QVector<QString> RedisGenericOperations::keys(const QString &pattern)
 {
     return execute([&]() {
-        std::vector<std::string> keys;
-        connection_->redis()->keys(pattern.toStdString(), std::back_inserter(keys));
-        QVector<QString> result;
-        for (const auto &key : keys) {
-            result.append(QString::fromStdString(key));
-        }
+        QVector<QString> result = toQStrings(um::GenericOperations(*connection_->redis()).keys(view(pattern.toUtf8())));
         qDebug() << "KEYS" << pattern << "找到" << result.size() << "个键";
         return result;
     }, "KEYS", QVector<QString>());
 }
+
+RedisScanResult RedisGenericOperations::scan(quint64 cursor, const QString &pattern, int count)
+{
+    return execute([&]() {
+        std::vector<std::string> keys;
+        RedisScanResult result;
+        result.cursor = um::GenericOperations(*connection_->redis())
+                            .scan(cursor, view(pattern.toUtf8()), count, keys);
+        result.keys = toQStrings(keys);
+        qDebug() << "SCAN" << cursor << pattern << "返回" << result.keys.size() << "个键, 下一游标" << result.cursor;
+        return result;
+    }, "SCAN", RedisScanResult());
+}
@@ -5,6 +5,17 @@
 #include <QVector>
 #include "../tool/redisoperationsbase.h"
 
+/**
+ * @brief SCAN 单批结果
+ *
+ * 下一次遍历的游标(0 表示已遍历完)与本批返回的键, 同一个键可能在不同批次中重复出现
+ */
+struct RedisScanResult
+{
+    quint64 cursor = 0;
+    QVector<QString> keys;
+};
+
 class RedisGenericOperations : public RedisOperationsBase
 {
 public:
@@ -24,6 +35,13 @@ public:
     bool del(const QString &key);
     bool exists(const QString &key);
     QVector<QString> keys(const QString &pattern);
+
+    /**
+    * @brief 增量遍历
+    *
+    * 以游标分批遍历符合模式的键, count 为每批建议数量; 不会像 KEYS 一样长时间阻塞服务器
+    */
+    RedisScanResult scan(quint64 cursor, const QString &pattern = "*", int count = 100);
 };
 
 #endif // REDISGENERICOPERATIONS_H
@@ -1,6 +1,13 @@
 #include "redishashoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/hash_operations.hpp>
 #include <QDebug>
+#include <vector>
+
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQString;
+using RedisTypeConversion::toQStrings;
 
 RedisHashOperations::RedisHashOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
@@ -14,77 +21,93 @@ RedisHashOperations::~RedisHashOperations()
 bool RedisHashOperations::hSet(const QString &key, const QString &field, const QString &value)
 {
     return execute([&]() {
-        connection_->redis()->hset(key.toStdString(), field.toStdString(), value.toStdString());
+        um::HashOperations(*connection_->redis()).hset(view(key.toUtf8()), view(field.toUtf8()),
+                                                       view(value.toUtf8()));
         qDebug() << "HSET" << key << field << "=" << value;
         return true;
-    }, "HSET", false);
+    }, "HSET", {key, value.size()}, false);
 }
 
 QString RedisHashOperations::hGet(const QString &key, const QString &field)
 {
     return execute([&]() {
-        auto value = connection_->redis()->hget(key.toStdString(), field.toStdString());
+        auto value = um::HashOperations(*connection_->redis()).hget(view(key.toUtf8()), view(field.toUtf8()));
         if (value) {
-            QString result = QString::fromStdString(*value);
+            QString result = toQString(*value);
             qDebug() << "HGET" << key << field << "=" << result;
             return result;
         }
         qDebug() << "HGET" << key << field << "= (null)";
         return QString();
-    }, "HGET", QString());
+    }, "HGET", key, QString());
 }
 
 QMap<QString, QString> RedisHashOperations::hGetAll(const QString &key)
 {
     return execute([&]() {
-        std::unordered_map<std::string, std::string> hash;
-        connection_->redis()->hgetall(key.toStdString(), std::inserter(hash, hash.begin()));
+        auto hash = um::HashOperations(*connection_->redis()).hgetall(view(key.toUtf8()));
         QMap<QString, QString> result;
         for (const auto &pair : hash) {
-            result.insert(QString::fromStdString(pair.first), QString::fromStdString(pair.second));
+            result.insert(toQString(pair.first), toQString(pair.second));
         }
         qDebug() << "HGETALL" << key << "找到" << result.size() << "个字段";
         return result;
-    }, "HGETALL", QMap<QString, QString>());
+    }, "HGETALL", key, QMap<QString, QString>());
 }
 
 bool RedisHashOperations::hDel(const QString &key, const QString &field)
 {
     return execute([&]() {
-        connection_->redis()->hdel(key.toStdString(), field.toStdString());
+        um::HashOperations(*connection_->redis()).hdel(view(key.toUtf8()), view(field.toUtf8()));
         qDebug() << "HDEL" << key << field;
         return true;
-    }, "HDEL", false);
+    }, "HDEL", key, false);
 }
 
 bool RedisHashOperations::hExists(const QString &key, const QString &field)
 {
     return execute([&]() {
-        bool result = connection_->redis()->hexists(key.toStdString(), field.toStdString());
+        bool result = um::HashOperations(*connection_->redis()).hexists(view(key.toUtf8()), view(field.toUtf8()));
         qDebug() << "HEXISTS" << key << field << "=" << result;
         return result;
-    }, "HEXISTS", false);
+    }, "HEXISTS", key, false);
 }
 
 QVector<QString> RedisHashOperations::hKeys(const QString &key)
 {
     return execute([&]() {
-        std::vector<std::string> keys;
-        connection_->redis()->hkeys(key.toStdString(), std::back_inserter(keys));
-        QVector<QString> result;
-        for (const auto &k : keys) {
-            result.append(QString::fromStdString(k));
-        }
+        QVector<QString> result = toQStrings(um::HashOperations(*connection_->redis()).hkeys(view(key.toUtf8())));
         qDebug() << "HKEYS" << key << "找到" << result.size() << "个键";
         return result;
-    }, "HKEYS", QVector<QString>());
+    }, "HKEYS", key, QVector<QString>());
 }
 
 int RedisHashOperations::hLen(const QString &key)
 {
     return execute([&]() {
-        long long len = connection_->redis()->hlen(key.toStdString());
+        long long len = um::HashOperations(*connection_->redis()).hlen(view(key.toUtf8()));
         qDebug() << "HLEN" << key << "=" << len;
         return static_cast<int>(len);
-    }, "HLEN", 0);
+    }, "HLEN", key, 0);
+}
+
+bool RedisHashOperations::hSet(const QString &key, const QMap<QString, QString> &fields)
+{
+    return execute([&]() {
+        if (fields.isEmpty()) {
+            return true;
+        }
+        std::vector<QByteArray> storage;
+        std::vector<um::FieldValue> items;
+        storage.reserve(static_cast<std::size_t>(fields.size()) * 2);
+        items.reserve(static_cast<std::size_t>(fields.size()));
+        for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
+            storage.push_back(it.key().toUtf8());
+            storage.push_back(it.value().toUtf8());
+            items.emplace_back(view(storage[storage.size() - 2]), view(storage.back()));
+        }
+        long long added = um::HashOperations(*connection_->redis()).hset(view(key.toUtf8()), items);
+        qDebug() << "HSET" << key << "设置" << fields.size() << "个字段, 新建" << added;
+        return true;
+    }, "HSET_MULTI", key, false);
 }
@@ -30,6 +30,13 @@ public:
     bool hExists(const QString &key, const QString &field);
     QVector<QString> hKeys(const QString &key);
     int hLen(const QString &key);
+
+    /**
+    * @brief 批量操作
+    *
+    * 一次往返设置多个字段
+    */
+    bool hSet(const QString &key, const QMap<QString, QString> &fields);
 };
 
 #endif // REDISHASHOPERATIONS_H
@@ -1,6 +1,53 @@
 #include "redislistoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/list_operations.hpp>
 #include <QDebug>
+#include <chrono>
+
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQString;
+using RedisTypeConversion::toQStrings;
+
+namespace {
+
+const char* endName(RedisListEnd end)
+{
+    return end == RedisListEnd::Left ? "LEFT" : "RIGHT";
+}
+
+um::ListEnd coreEnd(RedisListEnd end)
+{
+    return end == RedisListEnd::Left ? um::ListEnd::Left : um::ListEnd::Right;
+}
+
+std::vector<std::string> toStdStrings(const QVector<QString> &keys)
+{
+    std::vector<std::string> result;
+    result.reserve(keys.size());
+    for (const auto &key : keys) {
+        result.push_back(key.toStdString());
+    }
+    return result;
+}
+
+// 解析 LMPOP/BLMPOP 应答: nil 或 [key, [element...]]
+QPair<QString, QVector<QString>> parseMPop(const redisReply *reply)
+{
+    QPair<QString, QVector<QString>> result;
+    if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements < 2) {
+        return result;
+    }
+    result.first = QString::fromUtf8(reply->element[0]->str, static_cast<int>(reply->element[0]->len));
+    const redisReply *elements = reply->element[1];
+    for (size_t i = 0; elements && i < elements->elements; ++i) {
+        result.second.append(QString::fromUtf8(elements->element[i]->str,
+                                               static_cast<int>(elements->element[i]->len)));
+    }
+    return result;
+}
+
+} // namespace
 
 RedisListOperations::RedisListOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
@@ -14,82 +61,202 @@ RedisListOperations::~RedisListOperations()
 bool RedisListOperations::lPush(const QString &key, const QString &value)
 {
     return execute([&]() {
-        connection_->redis()->lpush(key.toStdString(), value.toStdString());
+        um::ListOperations(*connection_->redis()).lpush(view(key.toUtf8()), view(value.toUtf8()));
         qDebug() << "LPUSH" << key << value;
         return true;
-    }, "LPUSH", false);
+    }, "LPUSH", {key, value.size()}, false);
 }
 
 QString RedisListOperations::lPop(const QString &key)
 {
     return execute([&]() {
-        auto value = connection_->redis()->lpop(key.toStdString());
+        auto value = um::ListOperations(*connection_->redis()).lpop(view(key.toUtf8()));
         if (value) {
-            QString result = QString::fromStdString(*value);
+            QString result = toQString(*value);
             qDebug() << "LPOP" << key << "=" << result;
             return result;
         }
         qDebug() << "LPOP" << key << "= (null)";
         return QString();
-    }, "LPOP", QString());
+    }, "LPOP", key, QString());
 }
 
 bool RedisListOperations::rPush(const QString &key, const QString &value)
 {
     return execute([&]() {
-        connection_->redis()->rpush(key.toStdString(), value.toStdString());
+        um::ListOperations(*connection_->redis()).rpush(view(key.toUtf8()), view(value.toUtf8()));
         qDebug() << "RPUSH" << key << value;
         return true;
-    }, "RPUSH", false);
+    }, "RPUSH", {key, value.size()}, false);
 }
 
 QString RedisListOperations::rPop(const QString &key)
 {
     return execute([&]() {
-        auto value = connection_->redis()->rpop(key.toStdString());
+        auto value = um::ListOperations(*connection_->redis()).rpop(view(key.toUtf8()));
         if (value) {
-            QString result = QString::fromStdString(*value);
+            QString result = toQString(*value);
             qDebug() << "RPOP" << key << "=" << result;
             return result;
         }
         qDebug() << "RPOP" << key << "= (null)";
         return QString();
-    }, "RPOP", QString());
+    }, "RPOP", key, QString());
 }
 
 QVector<QString> RedisListOperations::lRange(const QString &key, int start, int stop)
 {
     return execute([&]() {
-        std::vector<std::string> values;
-        connection_->redis()->lrange(key.toStdString(), start, stop, std::back_inserter(values));
-        QVector<QString> result;
-        for (const auto &value : values) {
-            result.append(QString::fromStdString(value));
-        }
+        QVector<QString> result = toQStrings(um::ListOperations(*connection_->redis()).lrange(view(key.toUtf8()),
+                                                                                            start, stop));
         qDebug() << "LRANGE" << key << start << stop << "找到" << result.size() << "个元素";
         return result;
-    }, "LRANGE", QVector<QString>());
+    }, "LRANGE", key, QVector<QString>());
 }
 
 int RedisListOperations::lLen(const QString &key)
 {
     return execute([&]() {
-        long long len = connection_->redis()->llen(key.toStdString());
+        long long len = um::ListOperations(*connection_->redis()).llen(view(key.toUtf8()));
         qDebug() << "LLEN" << key << "=" << len;
         return static_cast<int>(len);
-    }, "LLEN", 0);
+    }, "LLEN", key, 0);
 }
 
 QString RedisListOperations::lIndex(const QString &key, int index)
 {
     return execute([&]() {
-        auto value = connection_->redis()->lindex(key.toStdString(), index);
+        auto value = um::ListOperations(*connection_->redis()).lindex(view(key.toUtf8()), index);
         if (value) {
-            QString result = QString::fromStdString(*value);
+            QString result = toQString(*value);
             qDebug() << "LINDEX" << key << index << "=" << result;
             return result;
         }
         qDebug() << "LINDEX" << key << index << "= (null)";
         return QString();
-    }, "LINDEX", QString());
+    }, "LINDEX", key, QString());
+}
+
+bool RedisListOperations::rPush(const QString &key, const QVector<QString> &values)
+{
+    return execute([&]() {
+        if (values.isEmpty()) {
+            return true;
+        }
+        RedisTypeConversion::Utf8List items(values);
+        long long len = um::ListOperations(*connection_->redis()).rpush(view(key.toUtf8()), items.views());
+        qDebug() << "RPUSH" << key << "推入" << values.size() << "个元素, 长度" << len;
+        return true;
+    }, "RPUSH_MULTI", key, false);
+}
+
+long long RedisListOperations::lRem(const QString &key, long long count, const QString &value)
+{
+    return execute([&]() {
+        long long removed = um::ListOperations(*connection_->redis()).lrem(view(key.toUtf8()), count,
+                                                                           view(value.toUtf8()));
+        qDebug() << "LREM" << key << count << value << "删除" << removed << "个元素";
+        return removed;
+    }, "LREM", key, 0LL);
+}
+
+QString RedisListOperations::lMove(const QString &source, const QString &destination,
+                                   RedisListEnd from, RedisListEnd to)
+{
+    return execute([&]() {
+        auto value = um::ListOperations(*connection_->redis()).lmove(view(source.toUtf8()),
+                                                                     view(destination.toUtf8()),
+                                                                     coreEnd(from), coreEnd(to));
+        if (value) {
+            QString result = toQString(*value);
+            qDebug() << "LMOVE" << source << destination << "=" << result;
+            return result;
+        }
+        qDebug() << "LMOVE" << source << destination << "= (null)";
+        return QString();
+    }, "LMOVE", source, QString());
+}
+
+QPair<QString, QVector<QString>> RedisListOperations::lMPop(const QVector<QString> &keys, RedisListEnd from,
+                                                            long long count)
+{
+    return execute([&]() {
+        std::vector<std::string> args = toStdStrings(keys);
+        args.insert(args.begin(), std::to_string(args.size()));
+        args.insert(args.begin(), "LMPOP");
+        args.push_back(endName(from));
+        args.push_back("COUNT");
+        args.push_back(std::to_string(count));
+        auto reply = connection_->redis()->command(args.begin(), args.end());
+        QPair<QString, QVector<QString>> result = parseMPop(reply.get());
+        qDebug() << "LMPOP" << result.first << "弹出" << result.second.size() << "个元素";
+        return result;
+    }, "LMPOP", QPair<QString, QVector<QString>>());
+}
+
+QPair<QString, QString> RedisListOperations::bLPop(const QVector<QString> &keys, int timeoutSec)
+{
+    return execute([&]() {
+        std::vector<std::string> items = toStdStrings(keys);
+        auto value = connection_->blockingRedis(std::chrono::seconds(timeoutSec))->blpop(
+            items.begin(), items.end(), std::chrono::seconds(timeoutSec));
+        if (value) {
+            QPair<QString, QString> result(QString::fromStdString(value->first), QString::fromStdString(value->second));
+            qDebug() << "BLPOP" << result.first << "=" << result.second;
+            return result;
+        }
+        qDebug() << "BLPOP" << keys << "= (timeout)";
+        return QPair<QString, QString>();
+    }, "BLPOP", QPair<QString, QString>());
+}
+
+QPair<QString, QString> RedisListOperations::bRPop(const QVector<QString> &keys, int timeoutSec)
+{
+    return execute([&]() {
+        std::vector<std::string> items = toStdStrings(keys);
+        auto value = connection_->blockingRedis(std::chrono::seconds(timeoutSec))->brpop(
+            items.begin(), items.end(), std::chrono::seconds(timeoutSec));
+        if (value) {
+            QPair<QString, QString> result(QString::fromStdString(value->first), QString::fromStdString(value->second));
+            qDebug() << "BRPOP" << result.first << "=" << result.second;
+            return result;
+        }
+        qDebug() << "BRPOP" << keys << "= (timeout)";
+        return QPair<QString, QString>();
+    }, "BRPOP", QPair<QString, QString>());
+}
+
+QString RedisListOperations::bLMove(const QString &source, const QString &destination,
+                                    RedisListEnd from, RedisListEnd to, int timeoutSec)
+{
+    return execute([&]() {
+        auto value = connection_->blockingRedis(std::chrono::seconds(timeoutSec))
+            ->command<sw::redis::OptionalString>("BLMOVE", source.toStdString(), destination.toStdString(),
+                                                 endName(from), endName(to), std::to_string(timeoutSec));
+        if (value) {
+            QString result = QString::fromStdString(*value);
+            qDebug() << "BLMOVE" << source << destination << "=" << result;
+            return result;
+        }
+        qDebug() << "BLMOVE" << source << destination << "= (timeout)";
+        return QString();
+    }, "BLMOVE", source, QString());
+}
+
+QPair<QString, QVector<QString>> RedisListOperations::bLMPop(const QVector<QString> &keys, RedisListEnd from,
+                                                             long long count, int timeoutSec)
+{
+    return execute([&]() {
+        std::vector<std::string> args = toStdStrings(keys);
+        args.insert(args.begin(), std::to_string(args.size()));
+        args.insert(args.begin(), std::to_string(timeoutSec));
+        args.insert(args.begin(), "BLMPOP");
+        args.push_back(endName(from));
+        args.push_back("COUNT");
+        args.push_back(std::to_string(count));
+        auto reply = connection_->blockingRedis(std::chrono::seconds(timeoutSec))->command(args.begin(), args.end());
+        QPair<QString, QVector<QString>> result = parseMPop(reply.get());
+        qDebug() << "BLMPOP" << result.first << "弹出" << result.second.size() << "个元素";
+        return result;
+    }, "BLMPOP", QPair<QString, QVector<QString>>());
 }
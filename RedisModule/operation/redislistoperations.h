@@ -3,8 +3,18 @@
 
 #include <QString>
 #include <QVector>
+#include <QPair>
 #include "../tool/redisoperationsbase.h"
 
+/**
+ * @brief 列表端点, 对应 LEFT/RIGHT 参数
+ */
+enum class RedisListEnd
+{
+    Left,
+    Right
+};
+
 class RedisListOperations : public RedisOperationsBase
 {
 public:
@@ -30,6 +40,32 @@ public:
     QVector<QString> lRange(const QString &key, int start, int stop);
     int lLen(const QString &key);
     QString lIndex(const QString &key, int index);
+
+    /**
+    * @brief 批量与移动操作
+    *
+    * 一次往返从右侧推入多个值,按值删除元素(count 含义同 LREM, 返回删除数量)
+    * 从 source 的一端弹出元素并推入 destination 的一端(原子), 列表为空时返回空
+    * 从第一个非空列表的一端弹出最多 count 个元素, 返回(列表键, 元素), 全部为空时返回空
+    */
+    bool rPush(const QString &key, const QVector<QString> &values);
+    long long lRem(const QString &key, long long count, const QString &value);
+    QString lMove(const QString &source, const QString &destination, RedisListEnd from, RedisListEnd to);
+    QPair<QString, QVector<QString>> lMPop(const QVector<QString> &keys, RedisListEnd from, long long count = 1);
+
+    /**
+    * @brief 阻塞操作
+    *
+    * 所有列表为空时阻塞等待最多 timeoutSec 秒(0 为无限等待), 超时返回空
+    * 从第一个非空列表左侧/右侧弹出元素, 返回(列表键, 元素)
+    * 阻塞版本的 lMove 和 lMPop
+    */
+    QPair<QString, QString> bLPop(const QVector<QString> &keys, int timeoutSec);
+    QPair<QString, QString> bRPop(const QVector<QString> &keys, int timeoutSec);
+    QString bLMove(const QString &source, const QString &destination, RedisListEnd from, RedisListEnd to,
+                   int timeoutSec);
+    QPair<QString, QVector<QString>> bLMPop(const QVector<QString> &keys, RedisListEnd from, long long count,
+                                            int timeoutSec);
 };
 
 #endif // REDISLISTOPERATIONS_H
@@ -0,0 +1,230 @@
+#include "redisprobabilisticoperations.h"
+#include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/probabilistic_operations.hpp>
+#include <QDebug>
+
+using RedisTypeConversion::view;
+using RedisTypeConversion::Utf8List;
+
+namespace {
+
+um::BitOperation coreBitOp(RedisBitOp operation)
+{
+    switch (operation) {
+    case RedisBitOp::And:
+        return um::BitOperation::And;
+    case RedisBitOp::Or:
+        return um::BitOperation::Or;
+    case RedisBitOp::Xor:
+        return um::BitOperation::Xor;
+    case RedisBitOp::Not:
+        return um::BitOperation::Not;
+    }
+    return um::BitOperation::And;
+}
+
+QVector<bool> toQBools(const std::vector<bool> &values)
+{
+    QVector<bool> result;
+    result.reserve(static_cast<int>(values.size()));
+    for (bool value : values) {
+        result.append(value);
+    }
+    return result;
+}
+
+} // namespace
+
+RedisProbabilisticOperations::RedisProbabilisticOperations(RedisConnection* connection)
+    : RedisOperationsBase(connection)
+{
+}
+
+RedisProbabilisticOperations::~RedisProbabilisticOperations()
+{
+}
+
+bool RedisProbabilisticOperations::pfAdd(const QString &key, const QString &element)
+{
+    return execute([&]() {
+        bool changed = um::ProbabilisticOperations(*connection_->redis()).pfadd(view(key.toUtf8()),
+                                                                                view(element.toUtf8()));
+        qDebug() << "PFADD" << key << element << (changed ? "(changed)" : "");
+        return true;
+    }, "PFADD", key, false);
+}
+
+bool RedisProbabilisticOperations::pfAdd(const QString &key, const QVector<QString> &elements)
+{
+    return execute([&]() {
+        if (elements.isEmpty()) {
+            return true;
+        }
+        Utf8List items(elements);
+        bool changed = um::ProbabilisticOperations(*connection_->redis()).pfadd(view(key.toUtf8()), items.views());
+        qDebug() << "PFADD" << key << elements.size() << "个元素" << (changed ? "(changed)" : "");
+        return true;
+    }, "PFADD_MULTI", key, false);
+}
+
+long long RedisProbabilisticOperations::pfCount(const QString &key)
+{
+    return execute([&]() {
+        long long count = um::ProbabilisticOperations(*connection_->redis()).pfcount(view(key.toUtf8()));
+        qDebug() << "PFCOUNT" << key << "=" << count;
+        return count;
+    }, "PFCOUNT", key, 0LL);
+}
+
+long long RedisProbabilisticOperations::pfCount(const QVector<QString> &keys)
+{
+    return execute([&]() {
+        Utf8List keyList(keys);
+        long long count = um::ProbabilisticOperations(*connection_->redis()).pfcount(keyList.views());
+        qDebug() << "PFCOUNT" << keys.size() << "个键 =" << count;
+        return count;
+    }, "PFCOUNT_MULTI", 0LL);
+}
+
+bool RedisProbabilisticOperations::pfMerge(const QString &destination, const QVector<QString> &sources)
+{
+    return execute([&]() {
+        Utf8List sourceList(sources);
+        um::ProbabilisticOperations(*connection_->redis()).pfmerge(view(destination.toUtf8()), sourceList.views());
+        qDebug() << "PFMERGE" << destination << "<-" << sources.size() << "个键";
+        return true;
+    }, "PFMERGE", destination, false);
+}
+
+bool RedisProbabilisticOperations::setBit(const QString &key, qint64 offset, bool value)
+{
+    return execute([&]() {
+        um::ProbabilisticOperations(*connection_->redis()).setbit(view(key.toUtf8()), offset, value);
+        qDebug() << "SETBIT" << key << offset << value;
+        return true;
+    }, "SETBIT", key, false);
+}
+
+bool RedisProbabilisticOperations::getBit(const QString &key, qint64 offset)
+{
+    return execute([&]() {
+        bool result = um::ProbabilisticOperations(*connection_->redis()).getbit(view(key.toUtf8()), offset);
+        qDebug() << "GETBIT" << key << offset << "=" << result;
+        return result;
+    }, "GETBIT", key, false);
+}
+
+long long RedisProbabilisticOperations::bitCount(const QString &key, qint64 start, qint64 end)
+{
+    return execute([&]() {
+        long long count = um::ProbabilisticOperations(*connection_->redis()).bitcount(view(key.toUtf8()), start, end);
+        qDebug() << "BITCOUNT" << key << start << end << "=" << count;
+        return count;
+    }, "BITCOUNT", key, 0LL);
+}
+
+long long RedisProbabilisticOperations::bitPos(const QString &key, bool bit, qint64 start, qint64 end)
+{
+    return execute([&]() {
+        long long position = um::ProbabilisticOperations(*connection_->redis()).bitpos(view(key.toUtf8()), bit,
+                                                                                       start, end);
+        qDebug() << "BITPOS" << key << bit << start << end << "=" << position;
+        return position;
+    }, "BITPOS", key, -1LL);
+}
+
+long long RedisProbabilisticOperations::bitOp(RedisBitOp operation, const QString &destination,
+                                              const QVector<QString> &keys)
+{
+    return execute([&]() {
+        Utf8List keyList(keys);
+        long long length = um::ProbabilisticOperations(*connection_->redis()).bitop(coreBitOp(operation),
+                                                                                     view(destination.toUtf8()),
+                                                                                     keyList.views());
+        qDebug() << "BITOP" << static_cast<int>(operation) << destination << "<-" << keys.size() << "个键 ="
+                 << length << "bytes";
+        return length;
+    }, "BITOP", destination, 0LL);
+}
+
+QVector<QVariant> RedisProbabilisticOperations::bitField(const QString &key, const QVector<QString> &subcommands)
+{
+    return execute([&]() {
+        Utf8List items(subcommands);
+        QVector<QVariant> result;
+        for (const auto &value : um::ProbabilisticOperations(*connection_->redis()).bitfield(view(key.toUtf8()),
+                                                                                            items.views())) {
+            result.append(value ? QVariant(static_cast<qint64>(*value)) : QVariant());
+        }
+        qDebug() << "BITFIELD" << key << subcommands << "=" << result;
+        return result;
+    }, "BITFIELD", key, QVector<QVariant>());
+}
+
+QVector<bool> RedisProbabilisticOperations::setBits(const QString &key, const QVector<QPair<qint64, bool>> &bits)
+{
+    return execute([&]() {
+        std::vector<std::pair<long long, bool>> items;
+        items.reserve(static_cast<std::size_t>(bits.size()));
+        for (const auto &bit : bits) {
+            items.emplace_back(bit.first, bit.second);
+        }
+        QVector<bool> result = toQBools(um::ProbabilisticOperations(*connection_->redis()).setbits(
+            view(key.toUtf8()), items));
+        qDebug() << "BITFIELD SET" << key << bits.size() << "个位";
+        return result;
+    }, "BITFIELD_SET", key, QVector<bool>());
+}
+
+QVector<bool> RedisProbabilisticOperations::getBits(const QString &key, const QVector<qint64> &offsets)
+{
+    return execute([&]() {
+        std::vector<long long> items(offsets.begin(), offsets.end());
+        QVector<bool> result = toQBools(um::ProbabilisticOperations(*connection_->redis()).getbits(
+            view(key.toUtf8()), items));
+        qDebug() << "BITFIELD GET" << key << offsets.size() << "个位";
+        return result;
+    }, "BITFIELD_GET", key, QVector<bool>());
+}
+
+bool RedisProbabilisticOperations::pfAddEach(const QVector<QPair<QString, QString>> &keyElements)
+{
+    return execute([&]() {
+        if (keyElements.isEmpty()) {
+            return true;
+        }
+        QVector<QString> keys;
+        QVector<QString> elements;
+        keys.reserve(keyElements.size());
+        elements.reserve(keyElements.size());
+        for (const auto &item : keyElements) {
+            keys.append(item.first);
+            elements.append(item.second);
+        }
+        Utf8List keyList(keys);
+        Utf8List elementList(elements);
+        std::vector<um::FieldValue> items;
+        items.reserve(static_cast<std::size_t>(keyElements.size()));
+        for (std::size_t i = 0; i < keyList.views().size(); ++i) {
+            items.emplace_back(keyList.views()[i], elementList.views()[i]);
+        }
+        um::ProbabilisticOperations(*connection_->redis()).pfaddEach(items);
+        qDebug() << "PFADD" << keyElements.size() << "个(键, 元素)";
+        return true;
+    }, "PFADD_EACH", false);
+}
+
+QVector<long long> RedisProbabilisticOperations::pfCountEach(const QVector<QString> &keys)
+{
+    return execute([&]() {
+        Utf8List keyList(keys);
+        QVector<long long> result;
+        result.reserve(keys.size());
+        for (long long count : um::ProbabilisticOperations(*connection_->redis()).pfcountEach(keyList.views())) {
+            result.append(count);
+        }
+        qDebug() << "PFCOUNT" << keys.size() << "个键(逐个)";
+        return result;
+    }, "PFCOUNT_EACH", QVector<long long>());
+}
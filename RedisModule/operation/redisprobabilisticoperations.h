@@ -0,0 +1,80 @@
+#ifndef REDISPROBABILISTICOPERATIONS_H
+#define REDISPROBABILISTICOPERATIONS_H
+
+#include <QPair>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include "../tool/redisoperationsbase.h"
+
+/**
+ * @brief 位运算, 对应 BITOP 的 AND/OR/XOR/NOT
+ */
+enum class RedisBitOp
+{
+    And,
+    Or,
+    Xor,
+    Not
+};
+
+/**
+ * @brief HyperLogLog 与位图操作类
+ *
+ * HyperLogLog 以至多 12KB 估计去重数量(标准误差 0.81%), 用于替代只用来计数的大集合;
+ * 位图以偏移量为下标记录标志, 每个标志 1 位
+ */
+class RedisProbabilisticOperations : public RedisOperationsBase
+{
+public:
+    /**
+    * @brief 构造函数和析构函数
+    */
+    explicit RedisProbabilisticOperations(RedisConnection* connection);
+    ~RedisProbabilisticOperations();
+
+    /**
+    * @brief HyperLogLog 操作
+    *
+    * 添加元素,一次往返添加多个元素,估计去重数量(失败返回 0),
+    * 估计多个键并集的去重数量,把多个键合并到目标键
+    */
+    bool pfAdd(const QString &key, const QString &element);
+    bool pfAdd(const QString &key, const QVector<QString> &elements);
+    long long pfCount(const QString &key);
+    long long pfCount(const QVector<QString> &keys);
+    bool pfMerge(const QString &destination, const QVector<QString> &sources);
+
+    /**
+    * @brief 位图操作
+    *
+    * 设置位,读取位,统计字节区间[start, end]内为 1 的位数,
+    * 查找字节区间内第一个值为 bit 的位(不存在或失败返回 -1),对多个键做位运算并返回结果长度(字节)
+    */
+    bool setBit(const QString &key, qint64 offset, bool value);
+    bool getBit(const QString &key, qint64 offset);
+    long long bitCount(const QString &key, qint64 start = 0, qint64 end = -1);
+    long long bitPos(const QString &key, bool bit, qint64 start = 0, qint64 end = -1);
+    long long bitOp(RedisBitOp operation, const QString &destination, const QVector<QString> &keys);
+
+    /**
+    * @brief BITFIELD
+    *
+    * subcommands 为子命令参数(如 "INCRBY", "u8", "#0", "1"), 按顺序返回每个 GET/SET/INCRBY 的结果,
+    * OVERFLOW FAIL 时溢出的结果为无效 QVariant; 失败返回空
+    */
+    QVector<QVariant> bitField(const QString &key, const QVector<QString> &subcommands);
+
+    /**
+    * @brief 批量操作
+    *
+    * 一次往返设置同一个键的多个位(返回各位原值)/读取多个位, 失败返回空;
+    * 一次往返向多个键各添加一个元素(键, 元素),分别估计多个键的去重数量
+    */
+    QVector<bool> setBits(const QString &key, const QVector<QPair<qint64, bool>> &bits);
+    QVector<bool> getBits(const QString &key, const QVector<qint64> &offsets);
+    bool pfAddEach(const QVector<QPair<QString, QString>> &keyElements);
+    QVector<long long> pfCountEach(const QVector<QString> &keys);
+};
+
+#endif // REDISPROBABILISTICOPERATIONS_H
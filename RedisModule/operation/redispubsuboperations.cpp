@@ -0,0 +1,32 @@
+#include "redispubsuboperations.h"
+#include "../tool/redisconnection.h"
+#include <QDebug>
+
+RedisPubSubOperations::RedisPubSubOperations(RedisConnection* connection)
+    : RedisOperationsBase(connection)
+{
+}
+
+RedisPubSubOperations::~RedisPubSubOperations()
+{
+}
+
+long long RedisPubSubOperations::publish(const QString &channel, const QByteArray &message)
+{
+    return execute([&]() {
+        long long receivers = connection_->redis()->publish(channel.toStdString(),
+            sw::redis::StringView(message.constData(), static_cast<std::size_t>(message.size())));
+        qDebug() << "PUBLISH" << channel << "size=" << message.size() << "receivers=" << receivers;
+        return receivers;
+    }, "PUBLISH", -1LL);
+}
+
+long long RedisPubSubOperations::sPublish(const QString &channel, const QByteArray &message)
+{
+    return execute([&]() {
+        long long receivers = connection_->redis()->command<long long>("SPUBLISH", channel.toStdString(),
+            sw::redis::StringView(message.constData(), static_cast<std::size_t>(message.size())));
+        qDebug() << "SPUBLISH" << channel << "size=" << message.size() << "receivers=" << receivers;
+        return receivers;
+    }, "SPUBLISH", -1LL);
+}
@@ -0,0 +1,32 @@
+#ifndef REDISPUBSUBOPERATIONS_H
+#define REDISPUBSUBOPERATIONS_H
+
+#include <QString>
+#include <QByteArray>
+#include "../tool/redisoperationsbase.h"
+
+/**
+ * @brief Redis发布操作类
+ *
+ * 负责消息发布, 订阅端见 messaging/redissubscriber.h(订阅需要独占连接, 不走连接池)
+ */
+class RedisPubSubOperations : public RedisOperationsBase
+{
+public:
+    /**
+    * @brief 构造函数和析构函数
+    */
+    explicit RedisPubSubOperations(RedisConnection* connection);
+    ~RedisPubSubOperations();
+
+    /**
+    * @brief 发布操作
+    *
+    * 向频道发布消息,向分片频道发布消息(Redis 7.0+, 集群中只投递到频道所在分片)
+    * 返回收到消息的订阅者数量, 失败返回 -1
+    */
+    long long publish(const QString &channel, const QByteArray &message);
+    long long sPublish(const QString &channel, const QByteArray &message);
+};
+
+#endif // REDISPUBSUBOPERATIONS_H
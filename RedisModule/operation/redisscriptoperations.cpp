@@ -0,0 +1,112 @@
+#include "redisscriptoperations.h"
+#include "../tool/redisconnection.h"
+#include <QDebug>
+
+namespace {
+
+std::vector<std::string> toStdStrings(const QVector<QString> &values)
+{
+    std::vector<std::string> result;
+    result.reserve(values.size());
+    for (const auto &value : values) {
+        result.push_back(value.toStdString());
+    }
+    return result;
+}
+
+bool isNoScript(const sw::redis::ReplyError &e)
+{
+    return std::string(e.what()).compare(0, 8, "NOSCRIPT") == 0;
+}
+
+} // namespace
+
+RedisScriptOperations::RedisScriptOperations(RedisConnection* connection)
+    : RedisOperationsBase(connection)
+{
+}
+
+RedisScriptOperations::~RedisScriptOperations()
+{
+}
+
+QString RedisScriptOperations::scriptLoad(const QString &script)
+{
+    return execute([&]() {
+        QString sha = QString::fromStdString(loadSha(script));
+        qDebug() << "SCRIPT LOAD" << sha;
+        return sha;
+    }, "SCRIPT_LOAD", QString());
+}
+
+QVector<QString> RedisScriptOperations::evalStrings(const QString &script, const QVector<QString> &keys,
+                                                    const QVector<QString> &args)
+{
+    return execute([&]() {
+        std::vector<std::string> keysVec = toStdStrings(keys);
+        std::vector<std::string> argsVec = toStdStrings(args);
+        std::vector<std::string> values = withSha(script, [&](const std::string &sha) {
+            std::vector<std::string> output;
+            connection_->redis()->evalsha(sha, keysVec.begin(), keysVec.end(),
+                                          argsVec.begin(), argsVec.end(), std::back_inserter(output));
+            return output;
+        });
+
+        QVector<QString> result;
+        result.reserve(static_cast<int>(values.size()));
+        for (const auto &value : values) {
+            result.append(QString::fromStdString(value));
+        }
+        qDebug() << "EVALSHA" << keys << "返回" << result.size() << "个元素";
+        return result;
+    }, "EVALSHA", QVector<QString>());
+}
+
+long long RedisScriptOperations::evalInteger(const QString &script, const QVector<QString> &keys,
+                                             const QVector<QString> &args)
+{
+    return execute([&]() {
+        std::vector<std::string> keysVec = toStdStrings(keys);
+        std::vector<std::string> argsVec = toStdStrings(args);
+        long long value = withSha(script, [&](const std::string &sha) {
+            return connection_->redis()->evalsha<long long>(sha, keysVec.begin(), keysVec.end(),
+                                                            argsVec.begin(), argsVec.end());
+        });
+        qDebug() << "EVALSHA" << keys << "=" << value;
+        return value;
+    }, "EVALSHA", 0LL);
+}
+
+std::string RedisScriptOperations::cachedSha(const QString &script)
+{
+    {
+        std::lock_guard<std::mutex> lock(shaMutex_);
+        auto it = shaCache_.constFind(script);
+        if (it != shaCache_.constEnd()) {
+            return it.value();
+        }
+    }
+    return loadSha(script);
+}
+
+std::string RedisScriptOperations::loadSha(const QString &script)
+{
+    std::string sha = connection_->redis()->script_load(script.toStdString());
+    std::lock_guard<std::mutex> lock(shaMutex_);
+    shaCache_.insert(script, sha);
+    return sha;
+}
+
+template<typename Func>
+auto RedisScriptOperations::withSha(const QString &script, Func func) -> decltype(func(std::string()))
+{
+    try {
+        return func(cachedSha(script));
+    } catch (const sw::redis::ReplyError &e) {
+        if (!isNoScript(e)) {
+            throw;
+        }
+        qDebug() << "EVALSHA NOSCRIPT, reloading script";
+        return func(loadSha(script));
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef REDISSCRIPTOPERATIONS_H
+#define REDISSCRIPTOPERATIONS_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <mutex>
+#include "../tool/redisoperationsbase.h"
+
+/**
+ * @brief Redis脚本操作类
+ *
+ * 以 EVALSHA 执行 Lua 脚本, 脚本 SHA1 在首次使用时通过 SCRIPT LOAD 获取并缓存;
+ * 服务器返回 NOSCRIPT(重启或 SCRIPT FLUSH 后)时重新加载并重试一次
+ */
+class RedisScriptOperations : public RedisOperationsBase
+{
+public:
+    /**
+    * @brief 构造函数和析构函数
+    */
+    explicit RedisScriptOperations(RedisConnection* connection);
+    ~RedisScriptOperations();
+
+    /**
+    * @brief 脚本操作
+    *
+    * 加载脚本并返回 SHA1(失败返回空)
+    * 执行返回字符串数组的脚本,执行返回整数的脚本
+    */
+    QString scriptLoad(const QString &script);
+    QVector<QString> evalStrings(const QString &script, const QVector<QString> &keys,
+                                 const QVector<QString> &args = QVector<QString>());
+    long long evalInteger(const QString &script, const QVector<QString> &keys,
+                          const QVector<QString> &args = QVector<QString>());
+
+private:
+    std::string cachedSha(const QString &script);
+    std::string loadSha(const QString &script);
+
+    template<typename Func>
+    auto withSha(const QString &script, Func func) -> decltype(func(std::string()));
+
+    std::mutex shaMutex_;
+    QHash<QString, std::string> shaCache_;
+};
+
+#endif // REDISSCRIPTOPERATIONS_H
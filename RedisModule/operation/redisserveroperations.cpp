@@ -0,0 +1,177 @@
+#include "redisserveroperations.h"
+#include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/server_operations.hpp>
+#include <QDebug>
+#include <QStringList>
+
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQString;
+
+namespace {
+
+// INFO 应答为 "# Section" 标题行与 "field:value" 行, 以 CRLF 分隔
+QMap<QString, QString> parseInfo(const QString &text)
+{
+    QMap<QString, QString> result;
+    for (const QString &line : text.split("\r\n", QString::SkipEmptyParts)) {
+        if (line.startsWith('#')) {
+            continue;
+        }
+        int colon = line.indexOf(':');
+        if (colon > 0) {
+            result.insert(line.left(colon), line.mid(colon + 1));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+RedisServerOperations::RedisServerOperations(RedisConnection* connection)
+    : RedisOperationsBase(connection)
+{
+}
+
+RedisServerOperations::~RedisServerOperations()
+{
+}
+
+QMap<QString, QString> RedisServerOperations::info(const QString &section)
+{
+    return execute([&]() {
+        QMap<QString, QString> result =
+            parseInfo(toQString(um::ServerOperations(*connection_->redis()).info(view(section.toUtf8()))));
+        qDebug() << "INFO" << section << "返回" << result.size() << "个字段";
+        return result;
+    }, "INFO", QMap<QString, QString>());
+}
+
+QString RedisServerOperations::configGet(const QString &parameter)
+{
+    return execute([&]() {
+        auto value = um::ServerOperations(*connection_->redis()).configGet(view(parameter.toUtf8()));
+        QString result = value ? toQString(*value) : QString();
+        qDebug() << "CONFIG GET" << parameter << "=" << result;
+        return result;
+    }, "CONFIG_GET", QString());
+}
+
+bool RedisServerOperations::configSet(const QString &parameter, const QString &value)
+{
+    return execute([&]() {
+        um::ServerOperations(*connection_->redis()).configSet(view(parameter.toUtf8()), view(value.toUtf8()));
+        qDebug() << "CONFIG SET" << parameter << "=" << value;
+        return true;
+    }, "CONFIG_SET", false);
+}
+
+bool RedisServerOperations::bgSave()
+{
+    return execute([&]() {
+        um::ServerOperations(*connection_->redis()).bgsave();
+        qDebug() << "BGSAVE";
+        return true;
+    }, "BGSAVE", false);
+}
+
+bool RedisServerOperations::save()
+{
+    return execute([&]() {
+        um::ServerOperations(*connection_->redis()).save();
+        qDebug() << "SAVE";
+        return true;
+    }, "SAVE", false);
+}
+
+bool RedisServerOperations::bgRewriteAof()
+{
+    return execute([&]() {
+        um::ServerOperations(*connection_->redis()).bgrewriteaof();
+        qDebug() << "BGREWRITEAOF";
+        return true;
+    }, "BGREWRITEAOF", false);
+}
+
+qint64 RedisServerOperations::lastSave()
+{
+    return execute([&]() {
+        qint64 timestamp = um::ServerOperations(*connection_->redis()).lastsave();
+        qDebug() << "LASTSAVE =" << timestamp;
+        return timestamp;
+    }, "LASTSAVE", qint64(-1));
+}
+
+long long RedisServerOperations::dbSize()
+{
+    return execute([&]() {
+        long long size = um::ServerOperations(*connection_->redis()).dbsize();
+        qDebug() << "DBSIZE =" << size;
+        return size;
+    }, "DBSIZE", -1LL);
+}
+
+bool RedisServerOperations::flushDb()
+{
+    return execute([&]() {
+        um::ServerOperations(*connection_->redis()).flushdb();
+        qDebug() << "FLUSHDB";
+        return true;
+    }, "FLUSHDB", false);
+}
+
+bool RedisServerOperations::debugPopulate(long long count, const QString &prefix, int valueSize)
+{
+    return execute([&]() {
+        um::ServerOperations(*connection_->redis()).debugPopulate(count, view(prefix.toUtf8()), valueSize);
+        qDebug() << "DEBUG POPULATE" << count << prefix << valueSize;
+        return true;
+    }, "DEBUG_POPULATE", false);
+}
+
+QVector<RedisServerSlowLogEntry> RedisServerOperations::slowlogGet(int count)
+{
+    return execute([&]() {
+        QVector<RedisServerSlowLogEntry> result;
+        for (const auto &entry : um::ServerOperations(*connection_->redis()).slowlogGet(count)) {
+            RedisServerSlowLogEntry item;
+            item.id = entry.id;
+            item.timestamp = entry.timestamp;
+            item.durationUs = entry.durationUs;
+            for (const auto &arg : entry.args) {
+                item.args.append(toQString(arg));
+            }
+            item.client = toQString(entry.client);
+            item.clientName = toQString(entry.clientName);
+            result.append(item);
+        }
+        qDebug() << "SLOWLOG GET" << count << "返回" << result.size() << "条记录";
+        return result;
+    }, "SLOWLOG_GET", QVector<RedisServerSlowLogEntry>());
+}
+
+bool RedisServerOperations::slowlogReset()
+{
+    return execute([&]() {
+        um::ServerOperations(*connection_->redis()).slowlogReset();
+        qDebug() << "SLOWLOG RESET";
+        return true;
+    }, "SLOWLOG_RESET", false);
+}
+
+QVector<RedisLatencyEvent> RedisServerOperations::latencyLatest()
+{
+    return execute([&]() {
+        QVector<RedisLatencyEvent> result;
+        for (const auto &event : um::ServerOperations(*connection_->redis()).latencyLatest()) {
+            RedisLatencyEvent item;
+            item.event = toQString(event.event);
+            item.timestamp = event.timestamp;
+            item.latestMs = event.latestMs;
+            item.maxMs = event.maxMs;
+            result.append(item);
+        }
+        qDebug() << "LATENCY LATEST 返回" << result.size() << "个事件";
+        return result;
+    }, "LATENCY_LATEST", QVector<RedisLatencyEvent>());
+}
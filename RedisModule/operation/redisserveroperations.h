@@ -0,0 +1,66 @@
+#ifndef REDISSERVEROPERATIONS_H
+#define REDISSERVEROPERATIONS_H
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include "../tool/redisoperationsbase.h"
+#include "../tool/redisslowlog.h"
+
+/**
+ * @brief Redis服务器管理操作类
+ *
+ * INFO/CONFIG、持久化触发与数据集管理, 主要用于运维脚本和持久化压测
+ */
+class RedisServerOperations : public RedisOperationsBase
+{
+public:
+    /**
+    * @brief 构造函数和析构函数
+    */
+    explicit RedisServerOperations(RedisConnection* connection);
+    ~RedisServerOperations();
+
+    /**
+    * @brief 信息与配置
+    *
+    * 获取 INFO 指定段并解析为(字段, 值)(section 为空时为默认段, 失败返回空),
+    * 读取配置项(不存在或失败返回空字符串),修改配置项
+    */
+    QMap<QString, QString> info(const QString &section = QString());
+    QString configGet(const QString &parameter);
+    bool configSet(const QString &parameter, const QString &value);
+
+    /**
+    * @brief 持久化
+    *
+    * 触发后台 RDB 快照,执行阻塞 RDB 快照,触发后台 AOF 重写,
+    * 获取最近一次成功快照的 Unix 时间戳(失败返回 -1)
+    */
+    bool bgSave();
+    bool save();
+    bool bgRewriteAof();
+    qint64 lastSave();
+
+    /**
+    * @brief 数据集
+    *
+    * 获取当前库键数量(失败返回 -1),清空当前库,
+    * 在服务器端生成 count 个 <prefix>:<n> 键(DEBUG POPULATE, 服务器需允许 DEBUG 命令)
+    */
+    long long dbSize();
+    bool flushDb();
+    bool debugPopulate(long long count, const QString &prefix, int valueSize);
+
+    /**
+    * @brief 延迟诊断
+    *
+    * 最近 count 条服务器慢查询(从新到旧, 失败返回空),清空服务器慢查询日志,
+    * 各事件最近一次的延迟尖峰(未开启 latency-monitor-threshold 时为空)
+    */
+    QVector<RedisServerSlowLogEntry> slowlogGet(int count = 128);
+    bool slowlogReset();
+    QVector<RedisLatencyEvent> latencyLatest();
+};
+
+#endif // REDISSERVEROPERATIONS_H
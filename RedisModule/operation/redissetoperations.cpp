@@ -1,7 +1,13 @@
 #include "redissetoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/set_operations.hpp>
 #include <QDebug>
 
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQStrings;
+using RedisTypeConversion::Utf8List;
+
 RedisSetOperations::RedisSetOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
 {
@@ -14,66 +20,53 @@ RedisSetOperations::~RedisSetOperations()
 bool RedisSetOperations::sAdd(const QString &key, const QString &value)
 {
     return execute([&]() {
-        connection_->redis()->sadd(key.toStdString(), value.toStdString());
+        um::SetOperations(*connection_->redis()).sadd(view(key.toUtf8()), view(value.toUtf8()));
         qDebug() << "SADD" << key << value;
         return true;
-    }, "SADD", false);
+    }, "SADD", {key, value.size()}, false);
 }
 
 bool RedisSetOperations::sIsMember(const QString &key, const QString &value)
 {
     return execute([&]() {
-        bool result = connection_->redis()->sismember(key.toStdString(), value.toStdString());
+        bool result = um::SetOperations(*connection_->redis()).sismember(view(key.toUtf8()), view(value.toUtf8()));
         qDebug() << "SISMEMBER" << key << value << "=" << result;
         return result;
-    }, "SISMEMBER", false);
+    }, "SISMEMBER", key, false);
 }
 
 bool RedisSetOperations::sRem(const QString &key, const QString &value)
 {
     return execute([&]() {
-        connection_->redis()->srem(key.toStdString(), value.toStdString());
+        um::SetOperations(*connection_->redis()).srem(view(key.toUtf8()), view(value.toUtf8()));
         qDebug() << "SREM" << key << value;
         return true;
-    }, "SREM", false);
+    }, "SREM", key, false);
 }
 
 QVector<QString> RedisSetOperations::sMembers(const QString &key)
 {
     return execute([&]() {
-        std::unordered_set<std::string> members;
-        connection_->redis()->smembers(key.toStdString(), std::inserter(members, members.begin()));
-        QVector<QString> result;
-        for (const auto &member : members) {
-            result.append(QString::fromStdString(member));
-        }
+        QVector<QString> result = toQStrings(um::SetOperations(*connection_->redis()).smembers(view(key.toUtf8())));
         qDebug() << "SMEMBERS" << key << "找到" << result.size() << "个成员";
         return result;
-    }, "SMEMBERS", QVector<QString>());
+    }, "SMEMBERS", key, QVector<QString>());
 }
 
 int RedisSetOperations::sCard(const QString &key)
 {
     return execute([&]() {
-        long long count = connection_->redis()->scard(key.toStdString());
+        long long count = um::SetOperations(*connection_->redis()).scard(view(key.toUtf8()));
         qDebug() << "SCARD" << key << "=" << count;
         return static_cast<int>(count);
-    }, "SCARD", 0);
+    }, "SCARD", key, 0);
 }
 
 QVector<QString> RedisSetOperations::sUnion(const QVector<QString> &keys)
 {
     return execute([&]() {
-        std::vector<std::string> keysVec;
-        for (const auto &key : keys) {
-            keysVec.push_back(key.toStdString());
-        }
-        std::unordered_set<std::string> members;
-        connection_->redis()->sunion(keysVec.begin(), keysVec.end(), std::inserter(members, members.begin()));
-        QVector<QString> result;
-        for (const auto &member : members) {
-            result.append(QString::fromStdString(member));
-        }
+        Utf8List keyList(keys);
+        QVector<QString> result = toQStrings(um::SetOperations(*connection_->redis()).sunion(keyList.views()));
         qDebug() << "SUNION" << "找到" << result.size() << "个成员";
         return result;
     }, "SUNION", QVector<QString>());
@@ -82,16 +75,8 @@ QVector<QString> RedisSetOperations::sUnion(const QVector<QString> &keys)
 QVector<QString> RedisSetOperations::sInter(const QVector<QString> &keys)
 {
     return execute([&]() {
-        std::vector<std::string> keysVec;
-        for (const auto &key : keys) {
-            keysVec.push_back(key.toStdString());
-        }
-        std::unordered_set<std::string> members;
-        connection_->redis()->sinter(keysVec.begin(), keysVec.end(), std::inserter(members, members.begin()));
-        QVector<QString> result;
-        for (const auto &member : members) {
-            result.append(QString::fromStdString(member));
-        }
+        Utf8List keyList(keys);
+        QVector<QString> result = toQStrings(um::SetOperations(*connection_->redis()).sinter(keyList.views()));
         qDebug() << "SINTER" << "找到" << result.size() << "个成员";
         return result;
     }, "SINTER", QVector<QString>());
@@ -100,17 +85,22 @@ QVector<QString> RedisSetOperations::sInter(const QVector<QString> &keys)
 QVector<QString> RedisSetOperations::sDiff(const QVector<QString> &keys)
 {
     return execute([&]() {
-        std::vector<std::string> keysVec;
-        for (const auto &key : keys) {
-            keysVec.push_back(key.toStdString());
-        }
-        std::unordered_set<std::string> members;
-        connection_->redis()->sdiff(keysVec.begin(), keysVec.end(), std::inserter(members, members.begin()));
-        QVector<QString> result;
-        for (const auto &member : members) {
-            result.append(QString::fromStdString(member));
-        }
+        Utf8List keyList(keys);
+        QVector<QString> result = toQStrings(um::SetOperations(*connection_->redis()).sdiff(keyList.views()));
         qDebug() << "SDIFF" << "找到" << result.size() << "个成员";
         return result;
     }, "SDIFF", QVector<QString>());
 }
+
+bool RedisSetOperations::sAdd(const QString &key, const QVector<QString> &members)
+{
+    return execute([&]() {
+        if (members.isEmpty()) {
+            return true;
+        }
+        Utf8List items(members);
+        long long added = um::SetOperations(*connection_->redis()).sadd(view(key.toUtf8()), items.views());
+        qDebug() << "SADD" << key << "添加" << added << "/" << members.size() << "个成员";
+        return true;
+    }, "SADD_MULTI", key, false);
+}
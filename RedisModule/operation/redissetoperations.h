@@ -30,6 +30,13 @@ public:
     QVector<QString> sUnion(const QVector<QString> &keys);
     QVector<QString> sInter(const QVector<QString> &keys);
     QVector<QString> sDiff(const QVector<QString> &keys);
+
+    /**
+    * @brief 批量操作
+    *
+    * 一次往返添加多个成员
+    */
+    bool sAdd(const QString &key, const QVector<QString> &members);
 };
 
 #endif // REDISSETOPERATIONS_H
@@ -1,7 +1,12 @@
 #include "redissortedsetoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/sorted_set_operations.hpp>
 #include <QDebug>
 
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQStrings;
+
 RedisSortedSetOperations::RedisSortedSetOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
 {
@@ -14,61 +19,98 @@ RedisSortedSetOperations::~RedisSortedSetOperations()
 bool RedisSortedSetOperations::zAdd(const QString &key, double score, const QString &member)
 {
     return execute([&]() {
-        connection_->redis()->zadd(key.toStdString(), member.toStdString(), score);
+        um::SortedSetOperations(*connection_->redis()).zadd(view(key.toUtf8()), score, view(member.toUtf8()));
         qDebug() << "ZADD" << key << score << member;
         return true;
-    }, "ZADD", false);
+    }, "ZADD", {key, member.size()}, false);
 }
 
 QVector<QString> RedisSortedSetOperations::zRange(const QString &key, int start, int stop)
 {
     return execute([&]() {
-        std::vector<std::pair<std::string, double>> elements;
-        connection_->redis()->zrange(key.toStdString(), start, stop, std::back_inserter(elements));
-        QVector<QString> result;
-        for (const auto &element : elements) {
-            result.append(QString::fromStdString(element.first));
-        }
+        // 只取成员, 不再请求 WITHSCORES
+        QVector<QString> result = toQStrings(um::SortedSetOperations(*connection_->redis()).zrange(view(key.toUtf8()),
+                                                                                                 start, stop));
         qDebug() << "ZRANGE" << key << start << stop << "找到" << result.size() << "个元素";
         return result;
-    }, "ZRANGE", QVector<QString>());
+    }, "ZRANGE", key, QVector<QString>());
 }
 
 double RedisSortedSetOperations::zScore(const QString &key, const QString &member)
 {
     return execute([&]() {
-        auto score = connection_->redis()->zscore(key.toStdString(), member.toStdString());
+        auto score = um::SortedSetOperations(*connection_->redis()).zscore(view(key.toUtf8()), view(member.toUtf8()));
         if (score) {
             qDebug() << "ZSCORE" << key << member << "=" << *score;
             return *score;
         }
         qDebug() << "ZSCORE" << key << member << "= (null)";
         return 0.0;
-    }, "ZSCORE", 0.0);
+    }, "ZSCORE", key, 0.0);
 }
 
 long long RedisSortedSetOperations::zRank(const QString &key, const QString &member)
 {
     return execute([&]() -> long long {
-        auto rank = connection_->redis()->zrank(key.toStdString(), member.toStdString());
+        auto rank = um::SortedSetOperations(*connection_->redis()).zrank(view(key.toUtf8()), view(member.toUtf8()));
         if (rank) {
             qDebug() << "ZRANK" << key << member << "=" << *rank;
             return *rank;
         }
         qDebug() << "ZRANK" << key << member << "= (null)";
         return -1;
-    }, "ZRANK", -1);
+    }, "ZRANK", key, -1);
 }
 
 long long RedisSortedSetOperations::zRevRank(const QString &key, const QString &member)
 {
     return execute([&]() -> long long {
-        auto rank = connection_->redis()->zrevrank(key.toStdString(), member.toStdString());
+        auto rank = um::SortedSetOperations(*connection_->redis()).zrevrank(view(key.toUtf8()),
+                                                                            view(member.toUtf8()));
         if (rank) {
             qDebug() << "ZREVRANK" << key << member << "=" << *rank;
             return *rank;
         }
         qDebug() << "ZREVRANK" << key << member << "= (null)";
         return -1;
-    }, "ZREVRANK", -1);
+    }, "ZREVRANK", key, -1);
+}
+
+bool RedisSortedSetOperations::zAdd(const QString &key, const QVector<QPair<QString, double>> &members)
+{
+    return execute([&]() {
+        if (members.isEmpty()) {
+            return true;
+        }
+        std::vector<QByteArray> storage;
+        std::vector<um::ScoredMember> items;
+        storage.reserve(members.size());
+        items.reserve(members.size());
+        for (const auto &member : members) {
+            storage.push_back(member.first.toUtf8());
+            items.emplace_back(view(storage.back()), member.second);
+        }
+        long long added = um::SortedSetOperations(*connection_->redis()).zadd(view(key.toUtf8()), items);
+        qDebug() << "ZADD" << key << "添加" << added << "/" << members.size() << "个成员";
+        return true;
+    }, "ZADD", key, false);
+}
+
+long long RedisSortedSetOperations::zCard(const QString &key)
+{
+    return execute([&]() {
+        long long card = um::SortedSetOperations(*connection_->redis()).zcard(view(key.toUtf8()));
+        qDebug() << "ZCARD" << key << "=" << card;
+        return card;
+    }, "ZCARD", key, 0LL);
+}
+
+bool RedisSortedSetOperations::zRem(const QString &key, const QString &member)
+{
+    return execute([&]() {
+        long long removed = um::SortedSetOperations(*connection_->redis()).zrem(view(key.toUtf8()),
+                                                                                view(member.toUtf8()));
+        qDebug() << "ZREM" << key << member << "删除" << removed;
+        return removed > 0;
+    }, "ZREM", key, false);
 }
@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QVector>
+#include <QPair>
 #include "../tool/redisoperationsbase.h"
 
 class RedisSortedSetOperations : public RedisOperationsBase
@@ -27,6 +28,15 @@ public:
     double zScore(const QString &key, const QString &member);
     long long zRank(const QString &key, const QString &member);
     long long zRevRank(const QString &key, const QString &member);
+
+    /**
+    * @brief 批量与统计操作
+    *
+    * 一次往返添加多个(成员, 分数), 获取有序集合成员数量, 删除成员
+    */
+    bool zAdd(const QString &key, const QVector<QPair<QString, double>> &members);
+    long long zCard(const QString &key);
+    bool zRem(const QString &key, const QString &member);
 };
 
 #endif // REDISSORTEDSETOPERATIONS_H
@@ -0,0 +1,290 @@
+#include "redisstreamoperations.h"
+#include "../tool/redisconnection.h"
+#include <QDebug>
+#include <chrono>
+#include <unordered_map>
+
+namespace {
+
+using StreamAttrs = std::vector<std::pair<std::string, std::string>>;
+using StreamItem = std::pair<std::string, sw::redis::Optional<StreamAttrs>>;
+using StreamItems = std::vector<StreamItem>;
+
+StreamAttrs toAttrs(const QMap<QString, QString> &fields)
+{
+    StreamAttrs attrs;
+    attrs.reserve(fields.size());
+    for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
+        attrs.emplace_back(it.key().toStdString(), it.value().toStdString());
+    }
+    return attrs;
+}
+
+QVector<RedisStreamEntry> toEntries(const StreamItems &items)
+{
+    QVector<RedisStreamEntry> entries;
+    entries.reserve(static_cast<int>(items.size()));
+    for (const auto &item : items) {
+        RedisStreamEntry entry;
+        entry.id = QString::fromStdString(item.first);
+        if (item.second) {
+            for (const auto &attr : *item.second) {
+                entry.fields.insert(QString::fromStdString(attr.first), QString::fromStdString(attr.second));
+            }
+        }
+        entries.append(entry);
+    }
+    return entries;
+}
+
+QString replyString(const redisReply *reply)
+{
+    if (!reply || (reply->type != REDIS_REPLY_STRING && reply->type != REDIS_REPLY_STATUS)) {
+        return QString();
+    }
+    return QString::fromUtf8(reply->str, static_cast<int>(reply->len));
+}
+
+// 解析 [id, [field, value, ...]] 形式的消息, 已删除消息的字段为 nil
+RedisStreamEntry replyEntry(const redisReply *reply)
+{
+    RedisStreamEntry entry;
+    if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements < 2) {
+        return entry;
+    }
+    entry.id = replyString(reply->element[0]);
+    const redisReply *fields = reply->element[1];
+    if (fields && fields->type == REDIS_REPLY_ARRAY) {
+        for (size_t i = 0; i + 1 < fields->elements; i += 2) {
+            entry.fields.insert(replyString(fields->element[i]), replyString(fields->element[i + 1]));
+        }
+    }
+    return entry;
+}
+
+} // namespace
+
+RedisStreamOperations::RedisStreamOperations(RedisConnection* connection)
+    : RedisOperationsBase(connection)
+{
+}
+
+RedisStreamOperations::~RedisStreamOperations()
+{
+}
+
+QString RedisStreamOperations::xAdd(const QString &key, const QMap<QString, QString> &fields,
+                                    const QString &id, long long maxLen, bool approximate)
+{
+    return execute([&]() {
+        StreamAttrs attrs = toAttrs(fields);
+        std::string entryId;
+        if (maxLen > 0) {
+            entryId = connection_->redis()->xadd(key.toStdString(), id.toStdString(),
+                                                 attrs.begin(), attrs.end(), maxLen, approximate);
+        } else {
+            entryId = connection_->redis()->xadd(key.toStdString(), id.toStdString(),
+                                                 attrs.begin(), attrs.end());
+        }
+        QString result = QString::fromStdString(entryId);
+        qDebug() << "XADD" << key << result;
+        return result;
+    }, "XADD", key, QString());
+}
+
+QVector<QString> RedisStreamOperations::xAddBatch(const QString &key, const QVector<QMap<QString, QString>> &entries,
+                                                  long long maxLen, bool approximate)
+{
+    return execute([&]() {
+        QVector<QString> result;
+        if (entries.isEmpty()) {
+            return result;
+        }
+
+        const std::string streamKey = key.toStdString();
+        auto pipe = connection_->redis()->pipeline(false);
+        for (const auto &fields : entries) {
+            StreamAttrs attrs = toAttrs(fields);
+            if (maxLen > 0) {
+                pipe.xadd(streamKey, "*", attrs.begin(), attrs.end(), maxLen, approximate);
+            } else {
+                pipe.xadd(streamKey, "*", attrs.begin(), attrs.end());
+            }
+        }
+        auto replies = pipe.exec();
+
+        result.reserve(entries.size());
+        for (int i = 0; i < entries.size(); ++i) {
+            result.append(QString::fromStdString(replies.get<std::string>(static_cast<std::size_t>(i))));
+        }
+        qDebug() << "XADD(批量)" << key << "写入" << result.size() << "条消息";
+        return result;
+    }, "XADD_BATCH", key, QVector<QString>());
+}
+
+long long RedisStreamOperations::xLen(const QString &key)
+{
+    return execute([&]() {
+        long long len = connection_->redis()->xlen(key.toStdString());
+        qDebug() << "XLEN" << key << "=" << len;
+        return len;
+    }, "XLEN", key, 0LL);
+}
+
+QVector<RedisStreamEntry> RedisStreamOperations::xRange(const QString &key, const QString &start,
+                                                        const QString &end, long long count)
+{
+    return execute([&]() {
+        StreamItems items;
+        if (count > 0) {
+            connection_->redis()->xrange(key.toStdString(), start.toStdString(), end.toStdString(),
+                                         count, std::back_inserter(items));
+        } else {
+            connection_->redis()->xrange(key.toStdString(), start.toStdString(), end.toStdString(),
+                                         std::back_inserter(items));
+        }
+        QVector<RedisStreamEntry> result = toEntries(items);
+        qDebug() << "XRANGE" << key << start << end << "找到" << result.size() << "条消息";
+        return result;
+    }, "XRANGE", key, QVector<RedisStreamEntry>());
+}
+
+bool RedisStreamOperations::xGroupCreate(const QString &key, const QString &group, const QString &id, bool mkStream)
+{
+    return execute([&]() {
+        try {
+            connection_->redis()->xgroup_create(key.toStdString(), group.toStdString(), id.toStdString(), mkStream);
+            qDebug() << "XGROUP CREATE" << key << group << id;
+        } catch (const sw::redis::ReplyError &e) {
+            // 消费组已存在
+            if (std::string(e.what()).find("BUSYGROUP") == std::string::npos) {
+                throw;
+            }
+            qDebug() << "XGROUP CREATE" << key << group << "(已存在)";
+        }
+        return true;
+    }, "XGROUP_CREATE", key, false);
+}
+
+QVector<RedisStreamEntry> RedisStreamOperations::xReadGroup(const QString &key, const QString &group,
+                                                            const QString &consumer, long long count,
+                                                            int blockMs, const QString &id)
+{
+    return execute([&]() {
+        std::unordered_map<std::string, StreamItems> streams;
+        if (blockMs > 0) {
+            connection_->blockingRedis(std::chrono::milliseconds(blockMs))->xreadgroup(
+                group.toStdString(), consumer.toStdString(), key.toStdString(), id.toStdString(),
+                std::chrono::milliseconds(blockMs), count, std::inserter(streams, streams.end()));
+        } else {
+            connection_->redis()->xreadgroup(
+                group.toStdString(), consumer.toStdString(), key.toStdString(), id.toStdString(),
+                count, std::inserter(streams, streams.end()));
+        }
+
+        QVector<RedisStreamEntry> result;
+        auto it = streams.find(key.toStdString());
+        if (it != streams.end()) {
+            result = toEntries(it->second);
+        }
+        qDebug() << "XREADGROUP" << key << group << consumer << id << "读取" << result.size() << "条消息";
+        return result;
+    }, "XREADGROUP", key, QVector<RedisStreamEntry>());
+}
+
+long long RedisStreamOperations::xAck(const QString &key, const QString &group, const QVector<QString> &ids)
+{
+    return execute([&]() {
+        if (ids.isEmpty()) {
+            return 0LL;
+        }
+        std::vector<std::string> idsVec;
+        idsVec.reserve(ids.size());
+        for (const auto &id : ids) {
+            idsVec.push_back(id.toStdString());
+        }
+        long long acked = connection_->redis()->xack(key.toStdString(), group.toStdString(),
+                                                     idsVec.begin(), idsVec.end());
+        qDebug() << "XACK" << key << group << "确认" << acked << "条消息";
+        return acked;
+    }, "XACK", key, 0LL);
+}
+
+RedisStreamClaimResult RedisStreamOperations::xAutoClaim(const QString &key, const QString &group,
+                                                         const QString &consumer, qint64 minIdleMs,
+                                                         const QString &start, long long count)
+{
+    return execute([&]() {
+        auto reply = connection_->redis()->command("XAUTOCLAIM", key.toStdString(), group.toStdString(),
+                                                   consumer.toStdString(), std::to_string(minIdleMs),
+                                                   start.toStdString(), "COUNT", std::to_string(count));
+        // 应答: [下一个起始 ID, [消息...], [已删除 ID...](7.0+)]
+        RedisStreamClaimResult result;
+        if (reply && reply->type == REDIS_REPLY_ARRAY && reply->elements >= 2) {
+            result.nextId = replyString(reply->element[0]);
+            const redisReply *entries = reply->element[1];
+            for (size_t i = 0; entries && i < entries->elements; ++i) {
+                result.entries.append(replyEntry(entries->element[i]));
+            }
+            if (reply->elements >= 3) {
+                const redisReply *deleted = reply->element[2];
+                for (size_t i = 0; deleted && i < deleted->elements; ++i) {
+                    result.deletedIds.append(replyString(deleted->element[i]));
+                }
+            }
+        }
+        qDebug() << "XAUTOCLAIM" << key << group << consumer << "转移" << result.entries.size() << "条消息";
+        return result;
+    }, "XAUTOCLAIM", key, RedisStreamClaimResult());
+}
+
+long long RedisStreamOperations::xPendingCount(const QString &key, const QString &group)
+{
+    return execute([&]() {
+        // 汇总应答: [总数, 最小 ID, 最大 ID, [[消费者, 数量]...]]
+        auto reply = connection_->redis()->command("XPENDING", key.toStdString(), group.toStdString());
+        long long pending = 0;
+        if (reply && reply->type == REDIS_REPLY_ARRAY && reply->elements >= 1
+            && reply->element[0]->type == REDIS_REPLY_INTEGER) {
+            pending = reply->element[0]->integer;
+        }
+        qDebug() << "XPENDING" << key << group << "=" << pending;
+        return pending;
+    }, "XPENDING", key, 0LL);
+}
+
+QVector<RedisStreamPendingEntry> RedisStreamOperations::xPending(const QString &key, const QString &group,
+                                                                 const QString &start, const QString &end,
+                                                                 long long count, const QString &consumer)
+{
+    return execute([&]() {
+        sw::redis::ReplyUPtr reply;
+        if (consumer.isEmpty()) {
+            reply = connection_->redis()->command("XPENDING", key.toStdString(), group.toStdString(),
+                                                  start.toStdString(), end.toStdString(), std::to_string(count));
+        } else {
+            reply = connection_->redis()->command("XPENDING", key.toStdString(), group.toStdString(),
+                                                  start.toStdString(), end.toStdString(), std::to_string(count),
+                                                  consumer.toStdString());
+        }
+
+        // 详情应答: [[id, 消费者, 空闲毫秒, 投递次数]...]
+        QVector<RedisStreamPendingEntry> result;
+        for (size_t i = 0; reply && reply->type == REDIS_REPLY_ARRAY && i < reply->elements; ++i) {
+            const redisReply *item = reply->element[i];
+            if (!item || item->type != REDIS_REPLY_ARRAY || item->elements < 4
+                || !item->element[2] || item->element[2]->type != REDIS_REPLY_INTEGER
+                || !item->element[3] || item->element[3]->type != REDIS_REPLY_INTEGER) {
+                continue;
+            }
+            RedisStreamPendingEntry entry;
+            entry.id = replyString(item->element[0]);
+            entry.consumer = replyString(item->element[1]);
+            entry.idleMs = item->element[2]->integer;
+            entry.deliveryCount = item->element[3]->integer;
+            result.append(entry);
+        }
+        qDebug() << "XPENDING" << key << group << "找到" << result.size() << "条未确认消息";
+        return result;
+    }, "XPENDING", key, QVector<RedisStreamPendingEntry>());
+}
@@ -0,0 +1,104 @@
+#ifndef REDISSTREAMOPERATIONS_H
+#define REDISSTREAMOPERATIONS_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include "../tool/redisoperationsbase.h"
+
+/**
+ * @brief 流中的一条消息
+ */
+struct RedisStreamEntry
+{
+    QString id;
+    QMap<QString, QString> fields;
+};
+
+/**
+ * @brief 消费组中已投递未确认(PEL)的消息
+ */
+struct RedisStreamPendingEntry
+{
+    QString id;
+    QString consumer;
+    qint64 idleMs = 0;
+    qint64 deliveryCount = 0;
+};
+
+/**
+ * @brief XAUTOCLAIM 结果
+ *
+ * 下一次扫描的起始 ID("0-0" 表示已扫描完), 本次转移到当前消费者的消息,
+ * 以及 PEL 中已被删除的消息 ID(Redis 7.0+)
+ */
+struct RedisStreamClaimResult
+{
+    QString nextId;
+    QVector<RedisStreamEntry> entries;
+    QVector<QString> deletedIds;
+};
+
+/**
+ * @brief Redis流操作类
+ *
+ * 基于 Stream 的事件管道: 追加、范围读取、消费组读取与确认、超时消息转移
+ */
+class RedisStreamOperations : public RedisOperationsBase
+{
+public:
+    /**
+    * @brief 构造函数和析构函数
+    *
+    * 构造函数初始化RedisStreamOperations对象,析构函数清理资源
+    */
+    explicit RedisStreamOperations(RedisConnection* connection);
+    ~RedisStreamOperations();
+
+    /**
+    * @brief 写入操作
+    *
+    * 追加消息(返回消息ID, 失败返回空), maxLen > 0 时按 MAXLEN 裁剪, approximate 为 true 时使用 "~" 近似裁剪
+    * 批量追加(单次往返的流水线), 获取流长度
+    */
+    QString xAdd(const QString &key, const QMap<QString, QString> &fields,
+                 const QString &id = "*", long long maxLen = 0, bool approximate = true);
+    QVector<QString> xAddBatch(const QString &key, const QVector<QMap<QString, QString>> &entries,
+                               long long maxLen = 0, bool approximate = true);
+    long long xLen(const QString &key);
+
+    /**
+    * @brief 读取操作
+    *
+    * 按 ID 范围读取消息, count 为 0 时不限制数量
+    */
+    QVector<RedisStreamEntry> xRange(const QString &key, const QString &start = "-",
+                                     const QString &end = "+", long long count = 0);
+
+    /**
+    * @brief 消费组操作
+    *
+    * 创建消费组(已存在视为成功, mkStream 为 true 时自动创建流)
+    * 按消费组读取: id 为 ">" 读取新消息, 为 "0" 重读本消费者未确认的消息; blockMs > 0 时阻塞等待
+    * 确认消息(返回确认数量)
+    */
+    bool xGroupCreate(const QString &key, const QString &group, const QString &id = "$", bool mkStream = true);
+    QVector<RedisStreamEntry> xReadGroup(const QString &key, const QString &group, const QString &consumer,
+                                         long long count, int blockMs = 0, const QString &id = ">");
+    long long xAck(const QString &key, const QString &group, const QVector<QString> &ids);
+
+    /**
+    * @brief 故障恢复
+    *
+    * 将空闲超过 minIdleMs 的未确认消息转移给 consumer
+    * 查询未确认消息总数, 查询未确认消息详情(consumer 为空时查询整个消费组)
+    */
+    RedisStreamClaimResult xAutoClaim(const QString &key, const QString &group, const QString &consumer,
+                                      qint64 minIdleMs, const QString &start = "0-0", long long count = 100);
+    long long xPendingCount(const QString &key, const QString &group);
+    QVector<RedisStreamPendingEntry> xPending(const QString &key, const QString &group,
+                                              const QString &start = "-", const QString &end = "+",
+                                              long long count = 100, const QString &consumer = QString());
+};
+
+#endif // REDISSTREAMOPERATIONS_H
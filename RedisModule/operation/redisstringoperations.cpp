@@ -1,7 +1,12 @@
 #include "redisstringoperations.h"
 #include "../tool/redisconnection.h"
+#include "../tool/redistypeconversion.h"
+#include <um/operations/string_operations.hpp>
 #include <QDebug>
 
+using RedisTypeConversion::view;
+using RedisTypeConversion::toQString;
+
 RedisStringOperations::RedisStringOperations(RedisConnection* connection)
     : RedisOperationsBase(connection)
 {
@@ -14,22 +19,22 @@ RedisStringOperations::~RedisStringOperations()
 bool RedisStringOperations::set(const QString &key, const QString &value)
 {
     return execute([&]() {
-        connection_->redis()->set(key.toStdString(), value.toStdString());
+        um::StringOperations(*connection_->redis()).set(view(key.toUtf8()), view(value.toUtf8()));
         qDebug() << "SET [设置]" << key << "=" << value;
         return true;
-    }, "SET", false);
+    }, "SET", {key, value.size()}, false);
 }
 
 QString RedisStringOperations::get(const QString &key)
 {
     return execute([&]() {
-        auto value = connection_->redis()->get(key.toStdString());
+        auto value = um::StringOperations(*connection_->redis()).get(view(key.toUtf8()));
         if (value) {
-            QString result = QString::fromStdString(*value);
+            QString result = toQString(*value);
             qDebug() << "GET [获取]" << key << "=" << result;
             return result;
         }
         qDebug() << "GET [获取]" << key << "= (null)";
         return QString();
-    }, "GET", QString());
+    }, "GET", key, QString());
 }
@@ -46,5 +46,5 @@ bool RedisTransactionOperations::watch(const QString &key)
         // This is a placeholder - actual transaction implementation requires different approach
         qDebug() << "WATCH" << key << "- 已监视 Key (注意: redis-plus-plus 使用 Transaction 类)";
         return true;
-    }, "WATCH", false);
+    }, "WATCH", key, false);
 }
@@ -1,4 +1,5 @@
 #include "redismanager.h"
+#include <QElapsedTimer>
 
 RedisManager::RedisManager(QObject *parent)
     : QObject(parent)
@@ -12,6 +13,13 @@ RedisManager::RedisManager(QObject *parent)
     , expirationOps_(&connection_)
     , transactionOps_(&connection_)
     , genericOps_(&connection_)
+    , streamOps_(&connection_)
+    , pubSubOps_(&connection_)
+    , scriptOps_(&connection_)
+    , batchOps_(&connection_)
+    , serverOps_(&connection_)
+    , probabilisticOps_(&connection_)
+    , ready_(false)
 {
 }
 
@@ -22,12 +30,34 @@ RedisManager::~RedisManager()
 
 bool RedisManager::connectToServer(const QString &host, int port)
 {
-    return connection_.connectToServer(host, port);
+    RedisConnectionOptions options;
+    options.host = host;
+    options.port = port;
+    return connectToServer(options);
+}
+
+bool RedisManager::connectToServer(const RedisConnectionOptions &options)
+{
+    setReady(false);
+    if (!connection_.connectToServer(options)) {
+        return false;
+    }
+    if (!options.warmUp) {
+        setReady(true);
+        return true;
+    }
+    // 刚建立的连接池尚无其他调用, 可以同时借出全部连接
+    if (!runWarmUp(true).ok) {
+        connection_.disconnect();
+        return false;
+    }
+    return true;
 }
 
 void RedisManager::disconnect()
 {
     connection_.disconnect();
+    setReady(false);
 }
 
 bool RedisManager::isConnected() const
@@ -35,6 +65,154 @@ bool RedisManager::isConnected() const
     return connection_.isConnected();
 }
 
+bool RedisManager::isAvailable() const
+{
+    return connection_.isAvailable();
+}
+
+bool RedisManager::isReconnecting() const
+{
+    return connection_.isReconnecting();
+}
+
+bool RedisManager::isPoolShared() const
+{
+    return connection_.isPoolShared();
+}
+
+QVector<RedisSharedPoolInfo> RedisManager::sharedPools()
+{
+    return RedisConnectionRegistry::instance().pools();
+}
+
+// Warm-up and readiness
+RedisWarmUpReport RedisManager::warmUp()
+{
+    return runWarmUp(false);
+}
+
+RedisWarmUpReport RedisManager::runWarmUp(bool idlePool)
+{
+    RedisWarmUpReport report = connection_.warmUp(idlePool);
+    if (report.ok) {
+        QElapsedTimer timer;
+        timer.start();
+        // 加载结果写入脚本操作的 SHA 缓存, 之后的 EVALSHA 直接命中
+        for (const QString &script : connection_.options().preloadScripts) {
+            if (scriptOps_.scriptLoad(script).isEmpty()) {
+                report.ok = false;
+                report.error = "SCRIPT LOAD failed";
+                break;
+            }
+            ++report.scriptsLoaded;
+        }
+        report.elapsedUs += timer.nsecsElapsed() / 1000;
+    }
+    qDebug().noquote() << report.toText();
+
+    {
+        std::lock_guard<std::mutex> lock(warmUpMutex_);
+        warmUpReport_ = report;
+    }
+    setReady(report.ok);
+    return report;
+}
+
+RedisWarmUpReport RedisManager::warmUpReport() const
+{
+    std::lock_guard<std::mutex> lock(warmUpMutex_);
+    return warmUpReport_;
+}
+
+bool RedisManager::isReady() const
+{
+    return ready_.load() && connection_.isAvailable();
+}
+
+void RedisManager::setReady(bool ready)
+{
+    if (ready_.exchange(ready) != ready) {
+        emit readyChanged(ready);
+    }
+}
+
+RedisCallStatus RedisManager::lastCallStatus() const
+{
+    return RedisCallContext::lastStatus();
+}
+
+// Hot key tracking
+void RedisManager::enableHotKeyTracking(const RedisHotKeyOptions &options)
+{
+    connection_.hotKeys().enable(options);
+}
+
+void RedisManager::disableHotKeyTracking()
+{
+    connection_.hotKeys().disable();
+}
+
+bool RedisManager::isHotKeyTrackingEnabled() const
+{
+    return connection_.hotKeys().isEnabled();
+}
+
+void RedisManager::setHotKeyReportHandler(std::function<void(const RedisHotKeyReport &)> handler)
+{
+    connection_.hotKeys().setReportHandler(std::move(handler));
+}
+
+RedisHotKeyReport RedisManager::hotKeyReport() const
+{
+    return connection_.hotKeys().report();
+}
+
+void RedisManager::resetHotKeys()
+{
+    connection_.hotKeys().reset();
+}
+
+// Client slow log
+void RedisManager::enableSlowLog(const RedisSlowLogOptions &options)
+{
+    connection_.slowLog().enable(options);
+}
+
+void RedisManager::disableSlowLog()
+{
+    connection_.slowLog().disable();
+}
+
+bool RedisManager::isSlowLogEnabled() const
+{
+    return connection_.slowLog().isEnabled();
+}
+
+QVector<RedisSlowLogEntry> RedisManager::slowLogEntries() const
+{
+    return connection_.slowLog().entries();
+}
+
+void RedisManager::clearSlowLog()
+{
+    connection_.slowLog().clear();
+}
+
+RedisSlowLogReport RedisManager::slowLogReport(int serverEntries)
+{
+    // 先取客户端记录, 之后读取服务器日志的调用本身不参与对照
+    const QVector<RedisSlowLogEntry> calls = connection_.slowLog().entries();
+    const QVector<RedisServerSlowLogEntry> server = serverOps_.slowlogGet(serverEntries);
+    const QVector<RedisLatencyEvent> latency = serverOps_.latencyLatest();
+
+    bool ok = false;
+    qint64 thresholdUs = serverOps_.configGet("slowlog-log-slower-than").toLongLong(&ok);
+    if (!ok || thresholdUs < 0) {
+        thresholdUs = -1;
+    }
+    return RedisSlowLog::correlate(calls, server, latency, thresholdUs);
+}
+
 // String operations
 bool RedisManager::set(const QString &key, const QString &value)
 {
@@ -113,6 +291,11 @@ int RedisManager::hLen(const QString &key)
     return hashOps_.hLen(key);
 }
 
+bool RedisManager::hSet(const QString &key, const QMap<QString, QString> &fields)
+{
+    return hashOps_.hSet(key, fields);
+}
+
 // List operations
 bool RedisManager::lPush(const QString &key, const QString &value)
 {
@@ -149,6 +332,48 @@ QString RedisManager::lIndex(const QString &key, int index)
     return listOps_.lIndex(key, index);
 }
 
+bool RedisManager::rPush(const QString &key, const QVector<QString> &values)
+{
+    return listOps_.rPush(key, values);
+}
+
+long long RedisManager::lRem(const QString &key, long long count, const QString &value)
+{
+    return listOps_.lRem(key, count, value);
+}
+
+QString RedisManager::lMove(const QString &source, const QString &destination, RedisListEnd from, RedisListEnd to)
+{
+    return listOps_.lMove(source, destination, from, to);
+}
+
+QPair<QString, QVector<QString>> RedisManager::lMPop(const QVector<QString> &keys, RedisListEnd from, long long count)
+{
+    return listOps_.lMPop(keys, from, count);
+}
+
+QPair<QString, QString> RedisManager::bLPop(const QVector<QString> &keys, int timeoutSec)
+{
+    return listOps_.bLPop(keys, timeoutSec);
+}
+
+QPair<QString, QString> RedisManager::bRPop(const QVector<QString> &keys, int timeoutSec)
+{
+    return listOps_.bRPop(keys, timeoutSec);
+}
+
+QString RedisManager::bLMove(const QString &source, const QString &destination, RedisListEnd from, RedisListEnd to,
+                             int timeoutSec)
+{
+    return listOps_.bLMove(source, destination, from, to, timeoutSec);
+}
+
+QPair<QString, QVector<QString>> RedisManager::bLMPop(const QVector<QString> &keys, RedisListEnd from,
+                                                      long long count, int timeoutSec)
+{
+    return listOps_.bLMPop(keys, from, count, timeoutSec);
+}
+
 // Set operations
 bool RedisManager::sAdd(const QString &key, const QString &value)
 {
@@ -190,6 +415,88 @@ QVector<QString> RedisManager::sDiff(const QVector<QString> &keys)
     return setOps_.sDiff(keys);
 }
 
+bool RedisManager::sAdd(const QString &key, const QVector<QString> &members)
+{
+    return setOps_.sAdd(key, members);
+}
+
+// HyperLogLog operations
+bool RedisManager::pfAdd(const QString &key, const QString &element)
+{
+    return probabilisticOps_.pfAdd(key, element);
+}
+
+bool RedisManager::pfAdd(const QString &key, const QVector<QString> &elements)
+{
+    return probabilisticOps_.pfAdd(key, elements);
+}
+
+long long RedisManager::pfCount(const QString &key)
+{
+    return probabilisticOps_.pfCount(key);
+}
+
+long long RedisManager::pfCount(const QVector<QString> &keys)
+{
+    return probabilisticOps_.pfCount(keys);
+}
+
+bool RedisManager::pfMerge(const QString &destination, const QVector<QString> &sources)
+{
+    return probabilisticOps_.pfMerge(destination, sources);
+}
+
+bool RedisManager::pfAddEach(const QVector<QPair<QString, QString>> &keyElements)
+{
+    return probabilisticOps_.pfAddEach(keyElements);
+}
+
+QVector<long long> RedisManager::pfCountEach(const QVector<QString> &keys)
+{
+    return probabilisticOps_.pfCountEach(keys);
+}
+
+// Bitmap operations
+bool RedisManager::setBit(const QString &key, qint64 offset, bool value)
+{
+    return probabilisticOps_.setBit(key, offset, value);
+}
+
+bool RedisManager::getBit(const QString &key, qint64 offset)
+{
+    return probabilisticOps_.getBit(key, offset);
+}
+
+long long RedisManager::bitCount(const QString &key, qint64 start, qint64 end)
+{
+    return probabilisticOps_.bitCount(key, start, end);
+}
+
+long long RedisManager::bitPos(const QString &key, bool bit, qint64 start, qint64 end)
+{
+    return probabilisticOps_.bitPos(key, bit, start, end);
+}
+
+long long RedisManager::bitOp(RedisBitOp operation, const QString &destination, const QVector<QString> &keys)
+{
+    return probabilisticOps_.bitOp(operation, destination, keys);
+}
+
+QVector<QVariant> RedisManager::bitField(const QString &key, const QVector<QString> &subcommands)
+{
+    return probabilisticOps_.bitField(key, subcommands);
+}
+
+QVector<bool> RedisManager::setBits(const QString &key, const QVector<QPair<qint64, bool>> &bits)
+{
+    return probabilisticOps_.setBits(key, bits);
+}
+
+QVector<bool> RedisManager::getBits(const QString &key, const QVector<qint64> &offsets)
+{
+    return probabilisticOps_.getBits(key, offsets);
+}
+
 // Generic operations
 bool RedisManager::del(const QString &key)
 {
@@ -206,6 +513,11 @@ QVector<QString> RedisManager::keys(const QString &pattern)
     return genericOps_.keys(pattern);
 }
 
+RedisScanResult RedisManager::scan(quint64 cursor, const QString &pattern, int count)
+{
+    return genericOps_.scan(cursor, pattern, count);
+}
+
 // Expiration operations
 bool RedisManager::expire(const QString &key, int seconds)
 {
@@ -253,6 +565,190 @@ long long RedisManager::zRevRank(const QString &key, const QString &member)
     return sortedSetOps_.zRevRank(key, member);
 }
 
+bool RedisManager::zAdd(const QString &key, const QVector<QPair<QString, double>> &members)
+{
+    return sortedSetOps_.zAdd(key, members);
+}
+
+long long RedisManager::zCard(const QString &key)
+{
+    return sortedSetOps_.zCard(key);
+}
+
+bool RedisManager::zRem(const QString &key, const QString &member)
+{
+    return sortedSetOps_.zRem(key, member);
+}
+
+// Stream operations
+QString RedisManager::xAdd(const QString &key, const QMap<QString, QString> &fields,
+                           const QString &id, long long maxLen, bool approximate)
+{
+    return streamOps_.xAdd(key, fields, id, maxLen, approximate);
+}
+
+QVector<QString> RedisManager::xAddBatch(const QString &key, const QVector<QMap<QString, QString>> &entries,
+                                         long long maxLen, bool approximate)
+{
+    return streamOps_.xAddBatch(key, entries, maxLen, approximate);
+}
+
+long long RedisManager::xLen(const QString &key)
+{
+    return streamOps_.xLen(key);
+}
+
+QVector<RedisStreamEntry> RedisManager::xRange(const QString &key, const QString &start,
+                                               const QString &end, long long count)
+{
+    return streamOps_.xRange(key, start, end, count);
+}
+
+bool RedisManager::xGroupCreate(const QString &key, const QString &group, const QString &id, bool mkStream)
+{
+    return streamOps_.xGroupCreate(key, group, id, mkStream);
+}
+
+QVector<RedisStreamEntry> RedisManager::xReadGroup(const QString &key, const QString &group, const QString &consumer,
+                                                   long long count, int blockMs, const QString &id)
+{
+    return streamOps_.xReadGroup(key, group, consumer, count, blockMs, id);
+}
+
+long long RedisManager::xAck(const QString &key, const QString &group, const QVector<QString> &ids)
+{
+    return streamOps_.xAck(key, group, ids);
+}
+
+RedisStreamClaimResult RedisManager::xAutoClaim(const QString &key, const QString &group, const QString &consumer,
+                                                qint64 minIdleMs, const QString &start, long long count)
+{
+    return streamOps_.xAutoClaim(key, group, consumer, minIdleMs, start, count);
+}
+
+long long RedisManager::xPendingCount(const QString &key, const QString &group)
+{
+    return streamOps_.xPendingCount(key, group);
+}
+
+QVector<RedisStreamPendingEntry> RedisManager::xPending(const QString &key, const QString &group,
+                                                        const QString &start, const QString &end,
+                                                        long long count, const QString &consumer)
+{
+    return streamOps_.xPending(key, group, start, end, count, consumer);
+}
+
+// Pub/Sub operations
+long long RedisManager::publish(const QString &channel, const QByteArray &message)
+{
+    return pubSubOps_.publish(channel, message);
+}
+
+long long RedisManager::sPublish(const QString &channel, const QByteArray &message)
+{
+    return pubSubOps_.sPublish(channel, message);
+}
+
+// Script operations
+QString RedisManager::scriptLoad(const QString &script)
+{
+    return scriptOps_.scriptLoad(script);
+}
+
+QVector<QString> RedisManager::evalStrings(const QString &script, const QVector<QString> &keys,
+                                           const QVector<QString> &args)
+{
+    return scriptOps_.evalStrings(script, keys, args);
+}
+
+long long RedisManager::evalInteger(const QString &script, const QVector<QString> &keys,
+                                    const QVector<QString> &args)
+{
+    return scriptOps_.evalInteger(script, keys, args);
+}
+
+// Batch operations
+bool RedisManager::mSet(const QMap<QString, QString> &values)
+{
+    return batchOps_.mSet(values);
+}
+
+QVector<QString> RedisManager::mGet(const QVector<QString> &keys)
+{
+    return batchOps_.mGet(keys);
+}
+
+QVector<RedisPipelineReply> RedisManager::pipeline(const QVector<QVector<QByteArray>> &commands)
+{
+    return batchOps_.pipeline(commands);
+}
+
+// Server operations
+QMap<QString, QString> RedisManager::info(const QString &section)
+{
+    return serverOps_.info(section);
+}
+
+QString RedisManager::configGet(const QString &parameter)
+{
+    return serverOps_.configGet(parameter);
+}
+
+bool RedisManager::configSet(const QString &parameter, const QString &value)
+{
+    return serverOps_.configSet(parameter, value);
+}
+
+bool RedisManager::bgSave()
+{
+    return serverOps_.bgSave();
+}
+
+bool RedisManager::save()
+{
+    return serverOps_.save();
+}
+
+bool RedisManager::bgRewriteAof()
+{
+    return serverOps_.bgRewriteAof();
+}
+
+qint64 RedisManager::lastSave()
+{
+    return serverOps_.lastSave();
+}
+
+long long RedisManager::dbSize()
+{
+    return serverOps_.dbSize();
+}
+
+bool RedisManager::flushDb()
+{
+    return serverOps_.flushDb();
+}
+
+bool RedisManager::debugPopulate(long long count, const QString &prefix, int valueSize)
+{
+    return serverOps_.debugPopulate(count, prefix, valueSize);
+}
+
+QVector<RedisServerSlowLogEntry> RedisManager::slowlogGet(int count)
+{
+    return serverOps_.slowlogGet(count);
+}
+
+bool RedisManager::slowlogReset()
+{
+    return serverOps_.slowlogReset();
+}
+
+QVector<RedisLatencyEvent> RedisManager::latencyLatest()
+{
+    return serverOps_.latencyLatest();
+}
+
 // Transaction operations
 void RedisManager::multi()
 {
@@ -7,6 +7,7 @@
 #include <QVector>
 
 #include "tool/redisconnection.h"
+#include "tool/rediscallcontext.h"
 #include "operation/redisstringoperations.h"
 #include "operation/redisbytesoperations.h"
 #include "operation/redishashoperations.h"
@@ -16,9 +17,25 @@
 #include "operation/redisexpirationoperations.h"
 #include "operation/redistransactionoperations.h"
 #include "operation/redisgenericoperations.h"
+#include "operation/redisstreamoperations.h"
+#include "operation/redispubsuboperations.h"
+#include "operation/redisscriptoperations.h"
+#include "operation/redisbatchoperations.h"
+#include "operation/redisserveroperations.h"
+#include "operation/redisprobabilisticoperations.h"
 
 #include "tool/redismodule_export.h"
 
+/**
+ * @brief Redis 操作入口
+ *
+ * 线程安全: 连接建立后同一个 RedisManager 可以在多个线程(QThread/std::thread)间共享, 操作接口可并发调用。
+ * 各操作对象不保存调用间的状态, 每次调用在连接池借出的连接上执行; 调用路径上只有原子读
+ * (连接/熔断状态、热点键与慢调用开关), 没有全局锁, 调用状态与截止时间均为线程本地。
+ * 并发度受连接池大小限制, 共享给 N 个线程时 poolSize 应不小于 N, 否则线程在连接池上排队。
+ * connectToServer/disconnect 会替换连接池, 须在工作线程开始前/结束后调用, 不能与操作并发;
+ * readyChanged 在调用 connectToServer/warmUp/disconnect 的线程中发出
+ */
 class REDISMODULESHARED_EXPORT RedisManager : public QObject
 {
     Q_OBJECT
@@ -33,9 +50,80 @@ public:
     * 连接到指定主机和端口的Redis服务器, 断开服务器,是否连接到服务器
     */
     bool connectToServer(const QString &host = "127.0.0.1", int port = 6379);
+    bool connectToServer(const RedisConnectionOptions &options);
     void disconnect();
     bool isConnected() const;
 
+    /**
+    * @brief 连接健康状态
+    *
+    * 是否可用(已连接且未熔断),是否正在后台重连
+    * 熔断期间所有操作快速失败并返回默认值
+    */
+    bool isAvailable() const;
+    bool isReconnecting() const;
+
+    /**
+    * @brief 共享连接池
+    *
+    * RedisConnectionOptions::sharedPool 为 true 时, 连接参数相同的 RedisManager 共享
+    * RedisConnectionRegistry 中的同一个连接池, 熔断、热点键与慢调用统计仍各自独立。
+    * sharedPools 为进程内全部共享连接池及其使用方的调用统计
+    */
+    bool isPoolShared() const;
+    static QVector<RedisSharedPoolInfo> sharedPools();
+
+    /**
+    * @brief 连接预热与就绪状态
+    *
+    * RedisConnectionOptions::warmUp 为 true 时 connectToServer 在连接后预热:
+    * 建立连接池中的全部连接并逐个 PING 记录往返时间基线, 加载 preloadScripts, 预热失败时断开并返回 false。
+    * 也可以在连接后手动调用 warmUp(), 此时连接池可能已在使用中, 未设置 poolWaitTimeoutMs 或连接池共享时
+    * 只测量一个连接的往返时间(report.partial); warmUpReport 为最近一次预热结果
+    * 已连接、预热完成(未要求预热时连接即完成)且熔断关闭时就绪, 服务可据此放行流量;
+    * 就绪状态在连接、预热与断开时通过 readyChanged 通知
+    */
+    RedisWarmUpReport warmUp();
+    RedisWarmUpReport warmUpReport() const;
+    bool isReady() const;
+
+    /**
+    * @brief 调用结果状态
+    *
+    * 当前线程最近一次操作的结果状态, 用于区分 nil(Ok 且返回空值)、错误、熔断与截止时间到期
+    * 截止时间通过在调用处构造 RedisCallContext 设置, 作用域内的所有操作共享同一截止时间
+    */
+    RedisCallStatus lastCallStatus() const;
+
+    /**
+    * @brief 热点键统计
+    *
+    * 启用后按采样率记录每次带键调用的(命令, 键), 以 count-min sketch 估计次数并保留每个命令的 top-K 热点键,
+    * 未启用时每次调用只多一次原子读; reportIntervalMs > 0 时后台按周期输出报告(默认 qDebug,
+    * 可设置处理函数)并开始新的统计窗口。获取当前窗口的报告,清空统计
+    */
+    void enableHotKeyTracking(const RedisHotKeyOptions &options = RedisHotKeyOptions());
+    void disableHotKeyTracking();
+    bool isHotKeyTrackingEnabled() const;
+    void setHotKeyReportHandler(std::function<void(const RedisHotKeyReport &)> handler);
+    RedisHotKeyReport hotKeyReport() const;
+    void resetHotKeys();
+
+    /**
+    * @brief 客户端慢调用日志
+    *
+    * 启用后对每次调用(含重试)计时, 超过阈值的调用连同命令、键、值大小、耗时与时间戳写入环形缓冲区;
+    * 未启用时每次调用只多一次原子读。获取记录(从新到旧),清空记录
+    * slowLogReport 读取服务器 SLOWLOG GET(最近 serverEntries 条)、LATENCY LATEST 与 slowlog-log-slower-than,
+    * 与客户端记录逐条对照, 拆分服务器执行时间与网络/客户端耗时
+    */
+    void enableSlowLog(const RedisSlowLogOptions &options = RedisSlowLogOptions());
+    void disableSlowLog();
+    bool isSlowLogEnabled() const;
+    QVector<RedisSlowLogEntry> slowLogEntries() const;
+    void clearSlowLog();
+    RedisSlowLogReport slowLogReport(int serverEntries = 128);
+
     /**
     * @brief 字符串操作
     *
@@ -60,7 +148,7 @@ public:
     * @brief 哈希表操作
     *
     * 设置哈希表字段,获取哈希表字段值,获取哈希表中所有字段和值,删除哈希表字段,检查哈希表字段是否存在
-    * 获取哈希表中所有字段名,获取哈希表中字段数量
+    * 获取哈希表中所有字段名,获取哈希表中字段数量,一次往返设置多个字段
     */
     bool hSet(const QString &key, const QString &field, const QString &value);
     QString hGet(const QString &key, const QString &field);
@@ -69,6 +157,7 @@ public:
     bool hExists(const QString &key, const QString &field);
     QVector<QString> hKeys(const QString &key);
     int hLen(const QString &key);
+    bool hSet(const QString &key, const QMap<QString, QString> &fields);
 
     /**
     * @brief 列表操作
@@ -85,11 +174,28 @@ public:
     int lLen(const QString &key);
     QString lIndex(const QString &key, int index);
 
+    /**
+    * @brief 列表批量、移动与阻塞操作
+    *
+    * 一次往返推入多个值,按值删除元素,原子移动元素,从多个列表弹出多个元素
+    * 阻塞弹出/移动: 列表为空时等待最多 timeoutSec 秒(0 为无限等待), 超时返回空
+    */
+    bool rPush(const QString &key, const QVector<QString> &values);
+    long long lRem(const QString &key, long long count, const QString &value);
+    QString lMove(const QString &source, const QString &destination, RedisListEnd from, RedisListEnd to);
+    QPair<QString, QVector<QString>> lMPop(const QVector<QString> &keys, RedisListEnd from, long long count = 1);
+    QPair<QString, QString> bLPop(const QVector<QString> &keys, int timeoutSec);
+    QPair<QString, QString> bRPop(const QVector<QString> &keys, int timeoutSec);
+    QString bLMove(const QString &source, const QString &destination, RedisListEnd from, RedisListEnd to,
+                   int timeoutSec);
+    QPair<QString, QVector<QString>> bLMPop(const QVector<QString> &keys, RedisListEnd from, long long count,
+                                            int timeoutSec);
+
     /**
     * @brief 集合操作
     *
     * 向集合中添加成员,检查成员是否在集合中,从集合中移除成员,获取集合中所有成员,获取集合中成员数量
-    * 获取多个集合的并集,获取多个集合的交集,获取多个集合的差集
+    * 获取多个集合的并集,获取多个集合的交集,获取多个集合的差集,一次往返添加多个成员
     */
     bool sAdd(const QString &key, const QString &value);
     bool sIsMember(const QString &key, const QString &value);
@@ -100,15 +206,47 @@ public:
     QVector<QString> sUnion(const QVector<QString> &keys);
     QVector<QString> sInter(const QVector<QString> &keys);
     QVector<QString> sDiff(const QVector<QString> &keys);
+    bool sAdd(const QString &key, const QVector<QString> &members);
+
+    /**
+    * @brief HyperLogLog 操作
+    *
+    * 添加元素(单个/一次往返多个),估计去重数量,估计多个键并集的去重数量,合并多个键
+    * 一次往返向多个键各添加一个元素,一次往返分别估计多个键的去重数量
+    * 只需要去重计数时以至多 12KB 代替集合, 误差约 0.81%
+    */
+    bool pfAdd(const QString &key, const QString &element);
+    bool pfAdd(const QString &key, const QVector<QString> &elements);
+    long long pfCount(const QString &key);
+    long long pfCount(const QVector<QString> &keys);
+    bool pfMerge(const QString &destination, const QVector<QString> &sources);
+    bool pfAddEach(const QVector<QPair<QString, QString>> &keyElements);
+    QVector<long long> pfCountEach(const QVector<QString> &keys);
+
+    /**
+    * @brief 位图操作
+    *
+    * 设置位,读取位,统计为 1 的位数,查找第一个值为 bit 的位,多个键的位运算,BITFIELD 子命令
+    * 一次往返设置(返回原值)/读取同一个键的多个位
+    */
+    bool setBit(const QString &key, qint64 offset, bool value);
+    bool getBit(const QString &key, qint64 offset);
+    long long bitCount(const QString &key, qint64 start = 0, qint64 end = -1);
+    long long bitPos(const QString &key, bool bit, qint64 start = 0, qint64 end = -1);
+    long long bitOp(RedisBitOp operation, const QString &destination, const QVector<QString> &keys);
+    QVector<QVariant> bitField(const QString &key, const QVector<QString> &subcommands);
+    QVector<bool> setBits(const QString &key, const QVector<QPair<qint64, bool>> &bits);
+    QVector<bool> getBits(const QString &key, const QVector<qint64> &offsets);
 
     /**
     * @brief 键操作
     *
-    * 删除键,检查键是否存在,查找符合模式的键
+    * 删除键,检查键是否存在,查找符合模式的键,以游标增量遍历键
     */
     bool del(const QString &key);
     bool exists(const QString &key);
     QVector<QString> keys(const QString &pattern);
+    RedisScanResult scan(quint64 cursor, const QString &pattern = "*", int count = 100);
 
     /**
     * @brief 过期操作
@@ -133,6 +271,92 @@ public:
     long long zRank(const QString &key, const QString &member);
     long long zRevRank(const QString &key, const QString &member);
 
+    /**
+    * @brief 有序集合批量与统计操作
+    *
+    * 一次往返添加多个(成员, 分数),获取成员数量,删除成员
+    */
+    bool zAdd(const QString &key, const QVector<QPair<QString, double>> &members);
+    long long zCard(const QString &key);
+    bool zRem(const QString &key, const QString &member);
+
+    /**
+    * @brief 流操作
+    *
+    * 追加消息(支持 MAXLEN ~ 裁剪),批量追加,获取流长度,按范围读取消息
+    * 创建消费组,按消费组读取(支持 COUNT 和 BLOCK),确认消息
+    * 转移超时未确认消息,查询未确认消息
+    */
+    QString xAdd(const QString &key, const QMap<QString, QString> &fields,
+                 const QString &id = "*", long long maxLen = 0, bool approximate = true);
+    QVector<QString> xAddBatch(const QString &key, const QVector<QMap<QString, QString>> &entries,
+                               long long maxLen = 0, bool approximate = true);
+    long long xLen(const QString &key);
+    QVector<RedisStreamEntry> xRange(const QString &key, const QString &start = "-",
+                                     const QString &end = "+", long long count = 0);
+    bool xGroupCreate(const QString &key, const QString &group, const QString &id = "$", bool mkStream = true);
+    QVector<RedisStreamEntry> xReadGroup(const QString &key, const QString &group, const QString &consumer,
+                                         long long count, int blockMs = 0, const QString &id = ">");
+    long long xAck(const QString &key, const QString &group, const QVector<QString> &ids);
+    RedisStreamClaimResult xAutoClaim(const QString &key, const QString &group, const QString &consumer,
+                                      qint64 minIdleMs, const QString &start = "0-0", long long count = 100);
+    long long xPendingCount(const QString &key, const QString &group);
+    QVector<RedisStreamPendingEntry> xPending(const QString &key, const QString &group,
+                                              const QString &start = "-", const QString &end = "+",
+                                              long long count = 100, const QString &consumer = QString());
+
+    /**
+    * @brief 发布操作
+    *
+    * 向频道发布消息,向分片频道发布消息, 返回收到消息的订阅者数量(失败返回 -1)
+    * 订阅需要独占连接, 使用 RedisSubscriber
+    */
+    long long publish(const QString &channel, const QByteArray &message);
+    long long sPublish(const QString &channel, const QByteArray &message);
+
+    /**
+    * @brief 脚本操作
+    *
+    * 加载脚本,执行返回字符串数组/整数的脚本(EVALSHA, 自动处理 NOSCRIPT)
+    */
+    QString scriptLoad(const QString &script);
+    QVector<QString> evalStrings(const QString &script, const QVector<QString> &keys,
+                                 const QVector<QString> &args = QVector<QString>());
+    long long evalInteger(const QString &script, const QVector<QString> &keys,
+                          const QVector<QString> &args = QVector<QString>());
+
+    /**
+    * @brief 批量操作
+    *
+    * 一次往返设置/读取多个键(MSET/MGET)
+    * 流水线执行任意命令(命令名在前的完整参数列表), 按顺序返回每条命令的应答
+    */
+    bool mSet(const QMap<QString, QString> &values);
+    QVector<QString> mGet(const QVector<QString> &keys);
+    QVector<RedisPipelineReply> pipeline(const QVector<QVector<QByteArray>> &commands);
+
+    /**
+    * @brief 服务器操作
+    *
+    * 获取并解析 INFO 段,读取/修改配置项
+    * 触发后台/阻塞 RDB 快照,触发后台 AOF 重写,最近一次成功快照时间
+    * 当前库键数量,清空当前库,服务器端批量生成测试键(DEBUG POPULATE)
+    * 服务器慢查询日志(SLOWLOG GET/RESET),各事件最近一次的延迟尖峰(LATENCY LATEST)
+    */
+    QMap<QString, QString> info(const QString &section = QString());
+    QString configGet(const QString &parameter);
+    bool configSet(const QString &parameter, const QString &value);
+    bool bgSave();
+    bool save();
+    bool bgRewriteAof();
+    qint64 lastSave();
+    long long dbSize();
+    bool flushDb();
+    bool debugPopulate(long long count, const QString &prefix, int valueSize);
+    QVector<RedisServerSlowLogEntry> slowlogGet(int count = 128);
+    bool slowlogReset();
+    QVector<RedisLatencyEvent> latencyLatest();
+
     /**
     * @brief 事务操作
     *
@@ -144,7 +368,13 @@ public:
     void discard();
     bool watch(const QString &key);
 
+signals:
+    void readyChanged(bool ready);
+
 private:
+    void setReady(bool ready);
+    RedisWarmUpReport runWarmUp(bool idlePool);
+
     RedisConnection connection_;
     RedisStringOperations stringOps_;
     RedisBytesOperations bytesOps_;
@@ -155,6 +385,16 @@ private:
     RedisExpirationOperations expirationOps_;
     RedisTransactionOperations transactionOps_;
     RedisGenericOperations genericOps_;
+    RedisStreamOperations streamOps_;
+    RedisPubSubOperations pubSubOps_;
+    RedisScriptOperations scriptOps_;
+    RedisBatchOperations batchOps_;
+    RedisServerOperations serverOps_;
+    RedisProbabilisticOperations probabilisticOps_;
+
+    std::atomic<bool> ready_;
+    mutable std::mutex warmUpMutex_;
+    RedisWarmUpReport warmUpReport_;
 };
 
 #endif // REDISMANAGER_H
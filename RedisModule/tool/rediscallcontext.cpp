@@ -0,0 +1,78 @@
+#include "rediscallcontext.h"
+#include <algorithm>
+
+namespace {
+
+struct ThreadCallState
+{
+    RedisCallContext::Clock::time_point deadline;
+    bool hasDeadline = false;
+    RedisCallStatus lastStatus = RedisCallStatus::Ok;
+};
+
+thread_local ThreadCallState callState;
+
+} // namespace
+
+RedisCallContext::RedisCallContext(int timeoutMs)
+    : RedisCallContext(Clock::now() + std::chrono::milliseconds(std::max(0, timeoutMs)))
+{
+}
+
+RedisCallContext::RedisCallContext(Clock::time_point deadline)
+    : deadline_(deadline)
+    , previousDeadline_(callState.deadline)
+    , previousHasDeadline_(callState.hasDeadline)
+{
+    // 内层上下文不能放宽外层的截止时间
+    if (previousHasDeadline_ && previousDeadline_ < deadline_) {
+        deadline_ = previousDeadline_;
+    }
+    callState.deadline = deadline_;
+    callState.hasDeadline = true;
+}
+
+RedisCallContext::~RedisCallContext()
+{
+    callState.deadline = previousDeadline_;
+    callState.hasDeadline = previousHasDeadline_;
+}
+
+RedisCallContext::Clock::time_point RedisCallContext::deadline() const
+{
+    return deadline_;
+}
+
+bool RedisCallContext::expired() const
+{
+    return Clock::now() >= deadline_;
+}
+
+bool RedisCallContext::hasDeadline()
+{
+    return callState.hasDeadline;
+}
+
+std::chrono::milliseconds RedisCallContext::remaining()
+{
+    if (!callState.hasDeadline) {
+        return std::chrono::milliseconds::max();
+    }
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(callState.deadline - Clock::now());
+    return std::max(left, std::chrono::milliseconds(0));
+}
+
+bool RedisCallContext::deadlineExpired()
+{
+    return callState.hasDeadline && Clock::now() >= callState.deadline;
+}
+
+RedisCallStatus RedisCallContext::lastStatus()
+{
+    return callState.lastStatus;
+}
+
+void RedisCallContext::setLastStatus(RedisCallStatus status)
+{
+    callState.lastStatus = status;
+}
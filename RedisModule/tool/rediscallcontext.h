@@ -0,0 +1,72 @@
+#ifndef REDISCALLCONTEXT_H
+#define REDISCALLCONTEXT_H
+
+#include <chrono>
+
+/**
+ * @brief 单次调用的结果状态
+ *
+ * 操作接口失败时统一返回默认值, 通过状态区分原因:
+ * Ok 表示命令已执行(返回空值即 nil), 其余为未执行或执行失败
+ */
+enum class RedisCallStatus
+{
+    Ok,
+    Error,              // 服务器返回错误或其他异常
+    NotConnected,       // 未连接
+    CircuitOpen,        // 熔断打开, 快速失败
+    DeadlineExceeded    // 调用截止时间已到或等待应答超时
+};
+
+/**
+ * @brief 调用上下文（作用域内生效的截止时间）
+ *
+ * 在栈上构造后, 当前线程在其作用域内发起的所有 Redis 调用共享同一截止时间:
+ * 截止时间已过的调用不再发送, 发送出去的调用使用不超过剩余时间的 socket 超时。
+ * 嵌套时取更早的截止时间, 析构时恢复外层上下文。
+ *
+ * @code
+ * {
+ *     RedisCallContext ctx(50);   // 50ms
+ *     auto fields = manager.hGetAll("big:hash");
+ *     if (RedisCallContext::lastStatus() == RedisCallStatus::DeadlineExceeded) { ... }
+ * }
+ * @endcode
+ */
+class RedisCallContext
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RedisCallContext(int timeoutMs);
+    explicit RedisCallContext(Clock::time_point deadline);
+    ~RedisCallContext();
+
+    RedisCallContext(const RedisCallContext &) = delete;
+    RedisCallContext& operator=(const RedisCallContext &) = delete;
+
+    Clock::time_point deadline() const;
+    bool expired() const;
+
+    /**
+     * @brief 当前线程的截止时间
+     *
+     * 是否存在截止时间,剩余时间(已过期为 0),是否已过期
+     */
+    static bool hasDeadline();
+    static std::chrono::milliseconds remaining();
+    static bool deadlineExpired();
+
+    /**
+     * @brief 当前线程最近一次调用的结果状态
+     */
+    static RedisCallStatus lastStatus();
+    static void setLastStatus(RedisCallStatus status);
+
+private:
+    Clock::time_point deadline_;
+    Clock::time_point previousDeadline_;
+    bool previousHasDeadline_;
+};
+
+#endif // REDISCALLCONTEXT_H
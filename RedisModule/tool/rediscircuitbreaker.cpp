@@ -0,0 +1,47 @@
+#include "rediscircuitbreaker.h"
+
+RedisCircuitBreaker::RedisCircuitBreaker(int failureThreshold)
+    : failureThreshold_(failureThreshold > 0 ? failureThreshold : 1)
+    , consecutiveFailures_(0)
+    , open_(false)
+{
+}
+
+void RedisCircuitBreaker::setFailureThreshold(int threshold)
+{
+    failureThreshold_.store(threshold > 0 ? threshold : 1);
+}
+
+bool RedisCircuitBreaker::isOpen() const
+{
+    return open_.load(std::memory_order_acquire);
+}
+
+void RedisCircuitBreaker::recordSuccess()
+{
+    // 正常情况下计数已为 0, 避免每次调用都写共享缓存行
+    if (consecutiveFailures_.load(std::memory_order_relaxed) != 0) {
+        consecutiveFailures_.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool RedisCircuitBreaker::recordFailure()
+{
+    int failures = consecutiveFailures_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (failures < failureThreshold_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    bool expected = false;
+    return open_.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+}
+
+void RedisCircuitBreaker::reset()
+{
+    consecutiveFailures_.store(0, std::memory_order_relaxed);
+    open_.store(false, std::memory_order_release);
+}
+
+int RedisCircuitBreaker::consecutiveFailures() const
+{
+    return consecutiveFailures_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,47 @@
+#ifndef REDISCIRCUITBREAKER_H
+#define REDISCIRCUITBREAKER_H
+
+#include <atomic>
+
+/**
+ * @brief 熔断器
+ *
+ * 统计连续的传输层失败, 达到阈值后打开; 打开期间调用方应直接失败,
+ * 由后台重连探测成功后再关闭。所有方法线程安全, 成功路径只有一次原子读。
+ */
+class RedisCircuitBreaker
+{
+public:
+    explicit RedisCircuitBreaker(int failureThreshold = 3);
+
+    void setFailureThreshold(int threshold);
+
+    /**
+     * @brief 熔断器是否打开
+     * @return 打开时返回 true, 此时调用应快速失败
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief 记录成功与失败
+     *
+     * 成功时清零连续失败计数; 失败时计数加一,
+     * 本次失败导致熔断器由关闭变为打开时返回 true(仅一个线程会得到 true)
+     */
+    void recordSuccess();
+    bool recordFailure();
+
+    /**
+     * @brief 关闭熔断器并清零计数
+     */
+    void reset();
+
+    int consecutiveFailures() const;
+
+private:
+    std::atomic<int> failureThreshold_;
+    std::atomic<int> consecutiveFailures_;
+    std::atomic<bool> open_;
+};
+
+#endif // REDISCIRCUITBREAKER_H
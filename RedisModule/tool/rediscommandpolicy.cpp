@@ -0,0 +1,42 @@
+#include "rediscommandpolicy.h"
+#include <QSet>
+
+bool RedisCommandPolicy::isRetrySafe(const QString &operation)
+{
+    static const QSet<QString> retrySafe = {
+        // 只读
+        "GET", "BYTES_GET", "BYTES_EXISTS", "BYTES_SIZE",
+        "HGET", "HGETALL", "HEXISTS", "HKEYS", "HLEN",
+        "LRANGE", "LLEN", "LINDEX",
+        "SISMEMBER", "SMEMBERS", "SCARD", "SUNION", "SINTER", "SDIFF",
+        "ZRANGE", "ZSCORE", "ZRANK", "ZREVRANK", "ZCARD",
+        "EXISTS", "KEYS", "SCAN", "TTL", "MGET",
+        "XLEN", "XRANGE", "XPENDING",
+        "INFO", "CONFIG_GET", "LASTSAVE", "DBSIZE", "SLOWLOG_GET", "LATENCY_LATEST",
+        "PFCOUNT", "PFCOUNT_MULTI", "PFCOUNT_EACH", "GETBIT", "BITCOUNT", "BITPOS", "BITFIELD_GET",
+        // 写命令: 重复执行后状态相同, 且操作层返回给调用方的值也相同
+        // (SADD/HDEL/DEL 等操作层只返回是否执行成功, 不返回服务器的计数)
+        "SET", "BYTES_SET", "BYTES_DEL", "MSET",
+        "HSET", "HSET_MULTI", "HDEL",
+        "SADD", "SADD_MULTI", "SREM",
+        "ZADD",
+        "PFADD", "PFADD_MULTI", "PFADD_EACH", "PFMERGE", "SETBIT", "BITOP",
+        "DEL",
+        "EXPIRE", "EXPIREAT",
+        "XGROUP_CREATE",
+        "SCRIPT_LOAD",
+        "CONFIG_SET", "FLUSHDB", "DEBUG_POPULATE", "SLOWLOG_RESET",
+        // 不在此列: PERSIST/ZREM/XACK 返回本次实际改变的数量, BITFIELD_SET 返回旧值,
+        // 丢失应答后重试会得到与首次执行不同的结果
+    };
+    return retrySafe.contains(operation);
+}
+
+QString RedisCommandPolicy::commandName(const QString &operation)
+{
+    QString name = operation;
+    if (name.startsWith("BYTES_")) {
+        name = name.mid(6);
+    }
+    return name.section('_', 0, 0);
+}
@@ -0,0 +1,24 @@
+#ifndef REDISCOMMANDPOLICY_H
+#define REDISCOMMANDPOLICY_H
+
+#include <QString>
+
+/**
+ * @brief 命令重试策略
+ *
+ * 按操作名称(execute 的 operation 参数)区分命令在连接中断后能否自动重试:
+ * 只读命令, 以及重复执行后状态与操作层返回值都不变的写命令(SET/HSET/DEL/EXPIRE 等)可以重试;
+ * 非幂等命令(LPUSH/LPOP/APPEND 等)重试可能重复执行, 返回值依赖执行前状态的命令
+ * (PERSIST/ZREM/XACK/BITFIELD SET) 重试后返回值会与首次执行不同, 均不重试
+ *
+ * commandName 给出操作对应的服务器命令名(BYTES_GET -> GET, HSET_MULTI -> HSET, CONFIG_GET -> CONFIG),
+ * 用于与服务器 SLOWLOG 中的命令对照
+ */
+class RedisCommandPolicy
+{
+public:
+    static bool isRetrySafe(const QString &operation);
+    static QString commandName(const QString &operation);
+};
+
+#endif // REDISCOMMANDPOLICY_H
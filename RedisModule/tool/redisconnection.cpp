@@ -1,10 +1,55 @@
 #include "redisconnection.h"
+#include "rediscallcontext.h"
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 
+const int RedisConnection::kDeadlineBucketsMs[RedisConnection::kDeadlineBucketCount] = {
+    1, 2, 3, 4, 5, 6, 8, 10, 12, 15,
+    20, 25, 30, 40, 50, 60, 80, 100, 120, 150,
+    200, 250, 300, 400, 500, 600, 800, 1000, 1200, 1500,
+    2000, 2500, 3000, 4000, 5000, 6000, 8000, 10000, 12000, 15000,
+    20000, 25000, 30000
+};
+
+QString RedisWarmUpReport::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+    if (!ok) {
+        out << "Warm-up failed after " << elapsedUs / 1000.0 << " ms: " << error;
+        return text;
+    }
+    qint64 connectMaxUs = 0;
+    for (qint64 us : connectUs) {
+        connectMaxUs = std::max(connectMaxUs, us);
+    }
+    out << "Warmed up " << rttUs.size() << "/" << poolSize << " connections in " << elapsedUs / 1000.0 << " ms"
+        << " (connect max " << connectMaxUs << " us, RTT min/median/max " << rttMinUs << "/" << rttMedianUs
+        << "/" << rttMaxUs << " us, " << scriptsLoaded << " scripts loaded)";
+    if (partial) {
+        out << " [partial: pool in use]";
+    }
+    out.flush();
+    return text;
+}
+
 RedisConnection::RedisConnection()
     : connected_(false)
+    , rttBaselineUs_(-1)
+    , reconnecting_(false)
+    , stopReconnect_(false)
 {
+    for (auto &cache : deadlinePoolCache_) {
+        cache.store(nullptr);
+    }
+    for (auto &cache : blockingPoolCache_) {
+        cache.store(nullptr);
+    }
 }
 
 RedisConnection::~RedisConnection()
@@ -14,14 +59,35 @@ RedisConnection::~RedisConnection()
 
 bool RedisConnection::connectToServer(const QString &host, int port)
 {
+    RedisConnectionOptions options;
+    options.host = host;
+    options.port = port;
+    return connectToServer(options);
+}
+
+bool RedisConnection::connectToServer(const RedisConnectionOptions &options)
+{
+    // 重复连接时先停止旧连接上的后台重连
+    disconnect();
+
     try {
-        QString connectionOptions = "tcp://" + host + ":" + QString::number(port);
-        redis_ = std::make_unique<sw::redis::Redis>(connectionOptions.toStdString());
+        options_ = options;
+        redis_ = createConnection(options.socketTimeoutMs, PoolKind::Main, &poolUsage_);
+        breaker_.setFailureThreshold(options.failureThreshold);
+        breaker_.reset();
+
+        // redis-plus-plus 延迟建连, 这里主动 PING 一次确认服务器可达
+        if (!probe()) {
+            throw std::runtime_error("PING failed");
+        }
         connected_ = true;
-        qDebug() << "已连接到 Redis 服务器:" << host << ":" << port;
+        qDebug() << "已连接到 Redis 服务器:" << options.host << ":" << options.port
+                 << (options.sharedPool ? "(共享连接池)" : "");
         return true;
     } catch (const std::exception &e) {
         qCritical() << "Failed to connect to Redis:" << e.what();
+        redis_.reset();
+        poolUsage_.reset();
         connected_ = false;
         return false;
     }
@@ -29,10 +95,26 @@ bool RedisConnection::connectToServer(const QString &host, int port)
 
 void RedisConnection::disconnect()
 {
+    stopReconnect();
+    {
+        std::lock_guard<std::mutex> lock(deadlinePoolsMutex_);
+        for (int i = 0; i < kDeadlineBucketCount; ++i) {
+            deadlinePoolCache_[i].store(nullptr);
+            deadlinePools_[i].reset();
+        }
+        for (int i = 0; i <= kUnboundedPoolIndex; ++i) {
+            blockingPoolCache_[i].store(nullptr);
+            blockingPools_[i].reset();
+        }
+    }
+    // 先归还分档连接池再归还主连接池; 共享连接池在最后一个使用方归还时关闭
     if (redis_) {
         redis_.reset();
     }
+    poolUsage_.reset();
     connected_ = false;
+    rttBaselineUs_.store(-1);
+    breaker_.reset();
 }
 
 bool RedisConnection::isConnected() const
@@ -42,5 +124,348 @@ bool RedisConnection::isConnected() const
 
 sw::redis::Redis* RedisConnection::redis() const
 {
-    return redis_.get();
+    if (!redis_) {
+        return nullptr;
+    }
+    if (!RedisCallContext::hasDeadline()) {
+        return &redis_->redis();
+    }
+    return deadlineRedis(RedisCallContext::remaining());
+}
+
+sw::redis::Redis* RedisConnection::blockingRedis(std::chrono::milliseconds blockTimeout) const
+{
+    if (!redis_) {
+        return nullptr;
+    }
+    // 阻塞命令在服务器端等待期间一直占用连接, 从不使用主连接池与分档连接池, 只按粗档位选择阻塞专用连接池;
+    // 截止时间优先, 阻塞等待在截止时间处被截断
+    if (RedisCallContext::hasDeadline()) {
+        int index = floorBucketIndex(RedisCallContext::remaining().count());
+        while (index > 0 && !isCoarseBucket(index)) {
+            --index;
+        }
+        return blockingPool(index);
+    }
+
+    // 在阻塞时长之外再留出一个常规 socket 超时用于传输; 未设置 socket 超时或无限阻塞时使用无超时的连接池
+    if (options_.socketTimeoutMs > 0 && blockTimeout.count() > 0) {
+        const long long neededMs = blockTimeout.count() + options_.socketTimeoutMs;
+        for (int i = 0; i < kDeadlineBucketCount; ++i) {
+            if (isCoarseBucket(i) && kDeadlineBucketsMs[i] >= neededMs) {
+                return blockingPool(i);
+            }
+        }
+    }
+    return blockingPool(kUnboundedPoolIndex);
+}
+
+bool RedisConnection::hasCallBudget()
+{
+    if (!RedisCallContext::hasDeadline()) {
+        return true;
+    }
+    // 剩余时间不足最小档位时, 任何档位的 socket 超时都会超过截止时间
+    return RedisCallContext::remaining().count() >= kDeadlineBucketsMs[0];
+}
+
+std::shared_ptr<um::Connection> RedisConnection::createConnection(int socketTimeoutMs, PoolKind kind,
+                                                                  std::shared_ptr<RedisPoolUsage> *usage) const
+{
+    um::ConnectionOptions connectionOptions;
+    connectionOptions.host = options_.host.toStdString();
+    connectionOptions.port = options_.port;
+    connectionOptions.socketTimeout = std::chrono::milliseconds(socketTimeoutMs);
+    // 建连同样受 socket 超时约束, 否则服务器不可达时会超出截止时间
+    int connectTimeoutMs = options_.connectTimeoutMs;
+    if (socketTimeoutMs > 0 && (connectTimeoutMs <= 0 || connectTimeoutMs > socketTimeoutMs)) {
+        connectTimeoutMs = socketTimeoutMs;
+    }
+    connectionOptions.connectTimeout = std::chrono::milliseconds(connectTimeoutMs);
+    connectionOptions.poolSize = static_cast<std::size_t>(std::max(1, options_.poolSize));
+    connectionOptions.poolWaitTimeout = std::chrono::milliseconds(options_.poolWaitTimeoutMs);
+    if (kind == PoolKind::DeadlineBucket && options_.deadlinePoolSize > 0) {
+        connectionOptions.poolSize = static_cast<std::size_t>(options_.deadlinePoolSize);
+    }
+    if (kind != PoolKind::Main) {
+        // 档位连接池耗尽时的等待同样不超过档位超时, 否则调用会无限期等待空闲连接
+        if (socketTimeoutMs > 0 && (options_.poolWaitTimeoutMs <= 0 || options_.poolWaitTimeoutMs > socketTimeoutMs)) {
+            connectionOptions.poolWaitTimeout = std::chrono::milliseconds(socketTimeoutMs);
+        }
+    }
+
+    // 阻塞连接池不从注册表借出: 一个使用方的阻塞读取不能占用其他使用方的连接
+    if (!options_.sharedPool || kind == PoolKind::Blocking) {
+        return std::make_shared<um::Connection>(connectionOptions);
+    }
+    RedisPoolLease lease = RedisConnectionRegistry::instance().acquire(connectionOptions, options_.consumerName);
+    if (!lease.connection) {
+        throw std::runtime_error("connection registry is shut down");
+    }
+    if (usage) {
+        *usage = lease.usage;
+    }
+    return lease.connection;
+}
+
+sw::redis::Redis* RedisConnection::deadlineRedis(std::chrono::milliseconds remaining) const
+{
+    const long long remainingMs = remaining.count();
+
+    // 主连接池的 socket 超时已不超过剩余时间, 无需切换
+    if (options_.socketTimeoutMs > 0 && options_.socketTimeoutMs <= remainingMs) {
+        return &redis_->redis();
+    }
+
+    return cappedBucketRedis(floorBucketIndex(remainingMs));
+}
+
+sw::redis::Redis* RedisConnection::cappedBucketRedis(int floorIndex) const
+{
+    sw::redis::Redis *pool = deadlinePoolCache_[floorIndex].load(std::memory_order_acquire);
+    if (pool) {
+        return pool;
+    }
+
+    // 选择与建立在同一把锁内, 并发调用不会同时越过上限
+    std::lock_guard<std::mutex> lock(deadlinePoolsMutex_);
+    int index = floorIndex;
+    if (!deadlinePools_[floorIndex] && options_.maxDeadlinePools > 0) {
+        int open = 0;
+        for (int i = 0; i < kDeadlineBucketCount; ++i) {
+            if (deadlinePools_[i]) {
+                ++open;
+            }
+        }
+        // 达到上限: 向下取到已打开的档位或粗档位, 不同的截止时间不再各自新建连接池
+        if (open >= options_.maxDeadlinePools) {
+            while (index > 0 && !deadlinePools_[index] && !isCoarseBucket(index)) {
+                --index;
+            }
+        }
+    }
+    return openBucketLocked(index);
+}
+
+int RedisConnection::floorBucketIndex(long long remainingMs)
+{
+    // 向下取档, 保证应答等待时间不超过剩余时间; 不足最小档位的调用由 hasCallBudget 拦截
+    int index = 0;
+    for (int i = 0; i < kDeadlineBucketCount && kDeadlineBucketsMs[i] <= remainingMs; ++i) {
+        index = i;
+    }
+    return index;
+}
+
+bool RedisConnection::isCoarseBucket(int index)
+{
+    // 1, 3, 10, 30, 100 ... 30000: 相邻粗档位之比不超过 3.34
+    int ms = kDeadlineBucketsMs[index];
+    while (ms % 10 == 0) {
+        ms /= 10;
+    }
+    return ms == 1 || ms == 3;
+}
+
+sw::redis::Redis* RedisConnection::openBucketLocked(int index) const
+{
+    if (!deadlinePools_[index]) {
+        deadlinePools_[index] = createConnection(kDeadlineBucketsMs[index], PoolKind::DeadlineBucket);
+        deadlinePoolCache_[index].store(&deadlinePools_[index]->redis(), std::memory_order_release);
+    }
+    return &deadlinePools_[index]->redis();
+}
+
+sw::redis::Redis* RedisConnection::blockingPool(int index) const
+{
+    sw::redis::Redis *pool = blockingPoolCache_[index].load(std::memory_order_acquire);
+    if (pool) {
+        return pool;
+    }
+
+    std::lock_guard<std::mutex> lock(deadlinePoolsMutex_);
+    if (!blockingPools_[index]) {
+        int socketTimeoutMs = index == kUnboundedPoolIndex ? 0 : kDeadlineBucketsMs[index];
+        blockingPools_[index] = createConnection(socketTimeoutMs, PoolKind::Blocking);
+        blockingPoolCache_[index].store(&blockingPools_[index]->redis(), std::memory_order_release);
+    }
+    return &blockingPools_[index]->redis();
+}
+
+bool RedisConnection::isAvailable() const
+{
+    return connected_ && !breaker_.isOpen();
+}
+
+bool RedisConnection::isReconnecting() const
+{
+    std::lock_guard<std::mutex> lock(reconnectMutex_);
+    return reconnecting_;
+}
+
+const RedisConnectionOptions& RedisConnection::options() const
+{
+    return options_;
+}
+
+bool RedisConnection::isPoolShared() const
+{
+    return options_.sharedPool && redis_;
+}
+
+RedisWarmUpReport RedisConnection::warmUp(bool idlePool)
+{
+    RedisWarmUpReport report;
+    if (!connected_ || !redis_) {
+        report.error = "not connected";
+        return report;
+    }
+    report.poolSize = std::max(1, options_.poolSize);
+
+    // 连接池可能正被其他调用方占用时不能同时借出全部连接, 否则在等待不限时的连接池上会无限期等待
+    const bool exclusive = !options_.sharedPool
+                           || RedisConnectionRegistry::instance().consumerCount(redis_.get()) <= 1;
+    const bool wholePool = exclusive && (idlePool || options_.poolWaitTimeoutMs > 0);
+    const std::size_t maxConnections = wholePool ? static_cast<std::size_t>(report.poolSize) : 1;
+
+    QElapsedTimer timer;
+    timer.start();
+    try {
+        for (const auto &sample : redis_->warmUp(3, maxConnections)) {
+            report.connectUs.append(sample.connectTime.count());
+            report.rttUs.append(sample.rtt.count());
+        }
+        QVector<qint64> sorted = report.rttUs;
+        std::sort(sorted.begin(), sorted.end());
+        report.rttMinUs = sorted.first();
+        report.rttMedianUs = sorted.at(sorted.size() / 2);
+        report.rttMaxUs = sorted.last();
+        rttBaselineUs_.store(report.rttMedianUs);
+        report.partial = report.rttUs.size() < report.poolSize;
+        report.ok = true;
+    } catch (const std::exception &e) {
+        qCritical() << "Redis warm-up failed:" << e.what();
+        report.error = QString::fromUtf8(e.what());
+    }
+    report.elapsedUs = timer.nsecsElapsed() / 1000;
+    return report;
+}
+
+qint64 RedisConnection::rttBaselineUs() const
+{
+    return rttBaselineUs_.load();
+}
+
+void RedisConnection::reportSuccess()
+{
+    breaker_.recordSuccess();
+    if (poolUsage_) {
+        poolUsage_->calls.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void RedisConnection::reportFailure()
+{
+    if (poolUsage_) {
+        poolUsage_->calls.fetch_add(1, std::memory_order_relaxed);
+        poolUsage_->failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (breaker_.recordFailure()) {
+        qWarning() << "Redis 连续" << breaker_.consecutiveFailures()
+                   << "次传输失败, 熔断打开, 启动后台重连";
+        startReconnect();
+    }
+}
+
+RedisHotKeyTracker& RedisConnection::hotKeys()
+{
+    return hotKeys_;
+}
+
+const RedisHotKeyTracker& RedisConnection::hotKeys() const
+{
+    return hotKeys_;
+}
+
+RedisSlowLog& RedisConnection::slowLog()
+{
+    return slowLog_;
+}
+
+const RedisSlowLog& RedisConnection::slowLog() const
+{
+    return slowLog_;
+}
+
+void RedisConnection::startReconnect()
+{
+    std::lock_guard<std::mutex> lock(reconnectMutex_);
+    if (reconnecting_ || !connected_) {
+        return;
+    }
+    // 上一轮重连线程已结束(reconnecting_ 为 false), 回收后再启动新线程
+    if (reconnectThread_.joinable()) {
+        reconnectThread_.join();
+    }
+    reconnecting_ = true;
+    stopReconnect_ = false;
+    reconnectThread_ = std::thread(&RedisConnection::reconnectLoop, this);
+}
+
+void RedisConnection::stopReconnect()
+{
+    {
+        std::lock_guard<std::mutex> lock(reconnectMutex_);
+        stopReconnect_ = true;
+    }
+    reconnectCv_.notify_all();
+    if (reconnectThread_.joinable()) {
+        reconnectThread_.join();
+    }
+    std::lock_guard<std::mutex> lock(reconnectMutex_);
+    reconnecting_ = false;
+}
+
+void RedisConnection::reconnectLoop()
+{
+    int delayMs = std::max(1, options_.reconnectInitialDelayMs);
+    const int maxDelayMs = std::max(delayMs, options_.reconnectMaxDelayMs);
+    int attempt = 0;
+
+    while (true) {
+        // 加入至多 50% 的随机抖动, 避免多个客户端同时重连
+        int jitterMs = static_cast<int>(QRandomGenerator::global()->bounded(delayMs / 2 + 1));
+        {
+            std::unique_lock<std::mutex> lock(reconnectMutex_);
+            if (reconnectCv_.wait_for(lock, std::chrono::milliseconds(delayMs + jitterMs),
+                                      [this]() { return stopReconnect_; })) {
+                reconnecting_ = false;
+                return;
+            }
+        }
+
+        ++attempt;
+        if (probe()) {
+            breaker_.reset();
+            qDebug() << "Redis 重连成功, 尝试次数:" << attempt;
+            break;
+        }
+        qWarning() << "Redis 重连失败, 尝试次数:" << attempt << "下次间隔(ms):" << std::min(delayMs * 2, maxDelayMs);
+        delayMs = std::min(delayMs * 2, maxDelayMs);
+    }
+
+    std::lock_guard<std::mutex> lock(reconnectMutex_);
+    reconnecting_ = false;
+}
+
+bool RedisConnection::probe() const
+{
+    try {
+        // 直接 PING 主连接池, 探测的就是之后调用使用的连接, 也不为探测另开档位连接池;
+        // 连接池会在取出已断开的连接时以 connectTimeoutMs 为上限重建, PING 成功即说明服务恢复
+        redis_->ping();
+        return true;
+    } catch (const std::exception &) {
+        return false;
+    }
 }
@@ -3,9 +3,57 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
 #include <sw/redis++/redis++.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
+#include <um/connection.hpp>
+
+#include "redisconnectionoptions.h"
+#include "redisconnectionregistry.h"
+#include "rediscircuitbreaker.h"
+#include "redishotkeytracker.h"
+#include "redisslowlog.h"
+#include "redismodule_export.h"
+
+/**
+ * @brief 连接预热结果
+ *
+ * connectUs/rttUs 为每个连接的建连耗时与最小 PING 往返时间(微秒),
+ * rtt* 为各连接往返时间的最小值/中位数/最大值, 中位数作为该连接的往返时间基线
+ */
+struct REDISMODULESHARED_EXPORT RedisWarmUpReport
+{
+    bool ok = false;
+    QString error;
+    qint64 elapsedUs = 0;
+    QVector<qint64> connectUs;
+    QVector<qint64> rttUs;
+    // 主连接池大小; 预热的连接数(rttUs.size())少于它时 partial 为 true
+    int poolSize = 0;
+    bool partial = false;
+    qint64 rttMinUs = 0;
+    qint64 rttMedianUs = 0;
+    qint64 rttMaxUs = 0;
+    int scriptsLoaded = 0;
+
+    QString toText() const;
+};
+
+/**
+ * @brief Redis 连接
+ *
+ * 持有主连接池、按超时分档的连接池、阻塞命令专用连接池、熔断器与诊断统计, 由 RedisManager 的各操作对象共享。
+ * 除 connectToServer/disconnect 外的方法可从任意线程并发调用:
+ * 连接与熔断状态为原子量, 分档连接池首次创建时加锁、之后通过原子指针读取。
+ * RedisConnectionOptions::sharedPool 为 true 时连接池从 RedisConnectionRegistry 借出,
+ * 熔断器与诊断统计仍为每个 RedisConnection 独有
+ */
 class RedisConnection
 {
 public:
@@ -19,13 +67,138 @@ public:
     * 检查是否已连接到Redis服务器,获取Redis客户端指针
     */
     bool connectToServer(const QString &host = "127.0.0.1", int port = 6379);
+    bool connectToServer(const RedisConnectionOptions &options);
     void disconnect();
     bool isConnected() const;
+
+    /**
+    * @brief 获取Redis客户端指针
+    *
+    * 当前线程存在 RedisCallContext 截止时间时, 返回 socket 超时不超过剩余时间的连接池,
+    * 使截止时间落实到网络读写上; 否则返回主连接池
+    * 连接池由核心库 um::Connection 持有, 操作层在其上构造核心库的操作视图
+    */
     sw::redis::Redis* redis() const;
 
+    /**
+    * @brief 获取用于阻塞命令的Redis客户端指针
+    *
+    * 阻塞命令(XREADGROUP BLOCK/BLPOP 等)在服务器端等待期间一直占用连接, 总是使用阻塞专用的连接池
+    * (大小为 poolSize, 不从注册表共享), 不会让主连接池上的其他调用排队等待;
+    * 返回 socket 超时足以覆盖 blockTimeout 的连接池(0 表示无限等待, 未设置 socketTimeoutMs 时不限制);
+    * 存在 RedisCallContext 截止时间时仍以截止时间为准
+    */
+    sw::redis::Redis* blockingRedis(std::chrono::milliseconds blockTimeout) const;
+
+    /**
+    * @brief 健康状态
+    *
+    * 已连接且熔断器关闭时可用; 熔断打开期间调用应快速失败,
+    * 由后台线程按指数退避 PING 服务器, 成功后自动恢复
+    */
+    bool isAvailable() const;
+    bool isReconnecting() const;
+
+    /**
+    * @brief 当前线程的截止时间是否还够发送一次调用
+    *
+    * 没有截止时间, 或剩余时间不少于最小档位的 socket 超时时返回 true;
+    * 否则即使发送也会在应答前超过截止时间, 调用应直接按 DeadlineExceeded 失败
+    */
+    static bool hasCallBudget();
+    const RedisConnectionOptions& options() const;
+
+    /**
+    * @brief 连接池是否从共享注册表借出
+    */
+    bool isPoolShared() const;
+
+    /**
+    * @brief 连接池预热
+    *
+    * redis-plus-plus 的连接池在首次使用时才建立连接, 启动后的第一批请求会承担建连开销;
+    * 预热同时借出主连接池的全部连接(此时建立)并逐个 PING, 记录往返时间基线。
+    * 同时持有全部连接只在连接池不被他人占用时安全: idlePool 为 true(刚连接, 尚无其他调用)
+    * 或设置了 poolWaitTimeoutMs 时整池预热, 借出超时则只报告已预热的部分;
+    * 与其他使用方共享的连接池, 以及等待不限时且可能正被使用的连接池只借出一个连接测量往返时间。
+    * rttBaselineUs 为最近一次预热的往返时间中位数(未预热时为 -1)
+    */
+    RedisWarmUpReport warmUp(bool idlePool = false);
+    qint64 rttBaselineUs() const;
+
+    /**
+    * @brief 调用结果上报
+    *
+    * 由操作层在每次调用后上报, 传输层失败累计到阈值时打开熔断并启动后台重连
+    */
+    void reportSuccess();
+    void reportFailure();
+
+    /**
+    * @brief 热点键统计, 由操作层在每次带键的调用前记录
+    */
+    RedisHotKeyTracker& hotKeys();
+    const RedisHotKeyTracker& hotKeys() const;
+
+    /**
+    * @brief 客户端慢调用日志, 由操作层对每次调用计时后记录
+    */
+    RedisSlowLog& slowLog();
+    const RedisSlowLog& slowLog() const;
+
 private:
-    std::unique_ptr<sw::redis::Redis> redis_;
-    bool connected_;
+    enum class PoolKind
+    {
+        Main,
+        DeadlineBucket,
+        Blocking
+    };
+
+    std::shared_ptr<um::Connection> createConnection(int socketTimeoutMs, PoolKind kind,
+                                                     std::shared_ptr<RedisPoolUsage> *usage = nullptr) const;
+    sw::redis::Redis* deadlineRedis(std::chrono::milliseconds remaining) const;
+    sw::redis::Redis* cappedBucketRedis(int floorIndex) const;
+    sw::redis::Redis* openBucketLocked(int index) const;
+    sw::redis::Redis* blockingPool(int index) const;
+    static int floorBucketIndex(long long remainingMs);
+    static bool isCoarseBucket(int index);
+
+    void startReconnect();
+    void stopReconnect();
+    void reconnectLoop();
+    bool probe() const;
+
+    std::shared_ptr<um::Connection> redis_;
+    // 共享连接池上本使用方的调用计数, 未共享时为空
+    std::shared_ptr<RedisPoolUsage> poolUsage_;
+    std::atomic<bool> connected_;
+    RedisConnectionOptions options_;
+    RedisCircuitBreaker breaker_;
+    RedisHotKeyTracker hotKeys_;
+    RedisSlowLog slowLog_;
+    std::atomic<qint64> rttBaselineUs_;
+
+    // 按超时分档的连接池(socket 超时 = 档位), 首次使用时创建;
+    // 相邻档位之比不超过 1.25(4ms 以上), 向下取档时调用至少保留约 80% 的剩余时间;
+    // 打开的细分档位达到 maxDeadlinePools 后只再打开 1/3/10/30... 粗档位, 此时至少保留约 30% 的剩余时间
+    static constexpr int kDeadlineBucketCount = 43;
+    static const int kDeadlineBucketsMs[kDeadlineBucketCount];
+    mutable std::mutex deadlinePoolsMutex_;
+    mutable std::shared_ptr<um::Connection> deadlinePools_[kDeadlineBucketCount];
+    mutable std::atomic<sw::redis::Redis*> deadlinePoolCache_[kDeadlineBucketCount];
+
+    // 阻塞命令专用连接池, 与分档连接池同样以档位下标索引, 只使用粗档位;
+    // 最后一个槽位是无 socket 超时的连接池, 供无限阻塞与未设置 socket 超时时使用
+    static constexpr int kUnboundedPoolIndex = kDeadlineBucketCount;
+    mutable std::shared_ptr<um::Connection> blockingPools_[kDeadlineBucketCount + 1];
+    mutable std::atomic<sw::redis::Redis*> blockingPoolCache_[kDeadlineBucketCount + 1];
+
+    // 后台重连线程
+    std::thread reconnectThread_;
+    mutable std::mutex reconnectMutex_;
+    std::condition_variable reconnectCv_;
+    bool reconnecting_;
+    bool stopReconnect_;
 };
 
 #endif // REDISCONNECTION_H
@@ -0,0 +1,54 @@
+#ifndef REDISCONNECTIONOPTIONS_H
+#define REDISCONNECTIONOPTIONS_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Redis 连接配置
+ *
+ * 连接地址、超时、连接池以及故障恢复(熔断/重连)相关参数
+ * 超时单位均为毫秒, 0 表示不限制
+ */
+struct RedisConnectionOptions
+{
+    QString host = "127.0.0.1";
+    int port = 6379;
+
+    // 建立 TCP 连接的超时, 服务器不可达时以此为上限而不是系统 TCP 超时
+    int connectTimeoutMs = 1000;
+    // 单条命令 socket 读写超时
+    int socketTimeoutMs = 0;
+
+    // 连接池大小, 以及连接池耗尽时等待空闲连接的超时
+    // 多个线程共享同一个 RedisManager 时, 连接池大小即并发执行的调用数上限;
+    // 阻塞命令(XREADGROUP BLOCK/BLMOVE 等)另用同样大小的专用连接池, 不占用主连接池
+    int poolSize = 1;
+    int poolWaitTimeoutMs = 0;
+
+    // 存在 RedisCallContext 截止时间的调用使用按 socket 超时分档的连接池, 每个用到的档位一个连接池;
+    // 连接在并发使用时才建立, 每个档位连接池最多 deadlinePoolSize 个连接。
+    // 0 表示与 poolSize 相同; 设置较小的值可限制连接数, 档位连接池耗尽时等待不超过该档位的超时
+    int deadlinePoolSize = 0;
+    // 细分档位连接池的数量上限(0 表示不限制); 达到上限后向下取到已打开的档位或 1/3/10/30... 粗档位,
+    // 分档连接池总数不超过 maxDeadlinePools + 10
+    int maxDeadlinePools = 4;
+
+    // 连续传输层失败达到该次数后熔断, 熔断期间所有调用快速失败
+    int failureThreshold = 3;
+    // 后台重连的指数退避区间
+    int reconnectInitialDelayMs = 100;
+    int reconnectMaxDelayMs = 5000;
+
+    // 连接后立即建立连接池中的全部连接并逐个 PING, 记录往返时间基线;
+    // 预热时由 RedisManager 加载的 Lua 脚本, 首次 EVALSHA 不再因 NOSCRIPT 多一次往返
+    bool warmUp = false;
+    QStringList preloadScripts;
+
+    // 从进程级 RedisConnectionRegistry 借出连接池: 地址与连接参数相同的 RedisManager 共享同一组连接,
+    // 引用计数归零时关闭; consumerName 为注册表统计中的使用方名称(为空时自动编号)
+    bool sharedPool = false;
+    QString consumerName;
+};
+
+#endif // REDISCONNECTIONOPTIONS_H
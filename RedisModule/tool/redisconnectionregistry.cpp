@@ -0,0 +1,216 @@
+#include "redisconnectionregistry.h"
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <vector>
+
+struct RedisConnectionRegistry::State
+{
+    struct Consumer
+    {
+        quint64 id = 0;
+        QString name;
+        qint64 acquiredAtMs = 0;
+        std::shared_ptr<RedisPoolUsage> usage;
+    };
+
+    struct Pool
+    {
+        um::ConnectionOptions options;
+        std::shared_ptr<um::Connection> connection;
+        qint64 createdAtMs = 0;
+        quint64 sequence = 0;
+        std::vector<Consumer> consumers;
+    };
+
+    void release(const QString &key, quint64 id);
+
+    mutable std::mutex mutex;
+    std::condition_variable released;
+    std::map<QString, Pool> pools;
+    quint64 nextConsumerId = 0;
+    quint64 nextSequence = 0;
+    int leases = 0;
+    bool shutdown = false;
+};
+
+void RedisConnectionRegistry::State::release(const QString &key, quint64 id)
+{
+    std::shared_ptr<um::Connection> closing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = pools.find(key);
+        if (it != pools.end()) {
+            auto &consumers = it->second.consumers;
+            consumers.erase(std::remove_if(consumers.begin(), consumers.end(),
+                                           [id](const Consumer &consumer) { return consumer.id == id; }),
+                            consumers.end());
+            if (consumers.empty()) {
+                closing = std::move(it->second.connection);
+                pools.erase(it);
+            }
+        }
+    }
+
+    // 在锁外关闭连接池, 关闭完成后才计入归还, shutdown 返回时连接已全部断开
+    if (closing) {
+        closing.reset();
+        qDebug() << "共享连接池已关闭:" << key;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        --leases;
+    }
+    released.notify_all();
+}
+
+RedisConnectionRegistry::RedisConnectionRegistry()
+    : state_(std::make_shared<State>())
+{
+}
+
+RedisConnectionRegistry& RedisConnectionRegistry::instance()
+{
+    static RedisConnectionRegistry registry;
+    return registry;
+}
+
+QString RedisConnectionRegistry::poolKey(const um::ConnectionOptions &options)
+{
+    return QString("%1:%2?pool=%3&socket=%4&connect=%5&wait=%6")
+        .arg(QString::fromStdString(options.host))
+        .arg(options.port)
+        .arg(options.poolSize)
+        .arg(options.socketTimeout.count())
+        .arg(options.connectTimeout.count())
+        .arg(options.poolWaitTimeout.count());
+}
+
+RedisPoolLease RedisConnectionRegistry::acquire(const um::ConnectionOptions &options, const QString &consumer)
+{
+    const QString key = poolKey(options);
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (state_->shutdown) {
+        qWarning() << "Connection registry is shut down, refusing pool for" << key;
+        return RedisPoolLease();
+    }
+
+    auto it = state_->pools.find(key);
+    if (it == state_->pools.end()) {
+        State::Pool pool;
+        pool.options = options;
+        pool.connection = std::make_shared<um::Connection>(options);
+        pool.createdAtMs = QDateTime::currentMSecsSinceEpoch();
+        pool.sequence = state_->nextSequence++;
+        it = state_->pools.emplace(key, std::move(pool)).first;
+        qDebug() << "创建共享连接池:" << key;
+    }
+
+    State::Consumer entry;
+    entry.id = ++state_->nextConsumerId;
+    entry.name = consumer.isEmpty() ? QString("consumer-%1").arg(entry.id) : consumer;
+    entry.acquiredAtMs = QDateTime::currentMSecsSinceEpoch();
+    entry.usage = std::make_shared<RedisPoolUsage>();
+    it->second.consumers.push_back(entry);
+    ++state_->leases;
+
+    // 借出的指针不拥有连接池, 析构时只向注册表归还; 持有 State 使归还不依赖注册表本身的生命周期
+    std::shared_ptr<State> state = state_;
+    const quint64 id = entry.id;
+    RedisPoolLease lease;
+    lease.connection = std::shared_ptr<um::Connection>(it->second.connection.get(),
+                                                       [state, key, id](um::Connection *) {
+                                                           state->release(key, id);
+                                                       });
+    lease.usage = entry.usage;
+    return lease;
+}
+
+QVector<RedisSharedPoolInfo> RedisConnectionRegistry::pools() const
+{
+    std::vector<std::pair<quint64, RedisSharedPoolInfo>> ordered;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        for (const auto &item : state_->pools) {
+            const State::Pool &pool = item.second;
+            RedisSharedPoolInfo info;
+            info.key = item.first;
+            info.host = QString::fromStdString(pool.options.host);
+            info.port = pool.options.port;
+            info.poolSize = static_cast<int>(pool.options.poolSize);
+            info.socketTimeoutMs = static_cast<int>(pool.options.socketTimeout.count());
+            info.createdAtMs = pool.createdAtMs;
+            info.savedConnections = static_cast<int>(pool.consumers.size() - 1) * info.poolSize;
+            for (const auto &consumer : pool.consumers) {
+                RedisPoolConsumerInfo consumerInfo;
+                consumerInfo.id = consumer.id;
+                consumerInfo.name = consumer.name;
+                consumerInfo.acquiredAtMs = consumer.acquiredAtMs;
+                consumerInfo.calls = consumer.usage->calls.load(std::memory_order_relaxed);
+                consumerInfo.failures = consumer.usage->failures.load(std::memory_order_relaxed);
+                info.consumers.append(consumerInfo);
+            }
+            ordered.emplace_back(pool.sequence, info);
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    QVector<RedisSharedPoolInfo> result;
+    result.reserve(static_cast<int>(ordered.size()));
+    for (auto &item : ordered) {
+        result.append(std::move(item.second));
+    }
+    return result;
+}
+
+int RedisConnectionRegistry::poolCount() const
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return static_cast<int>(state_->pools.size());
+}
+
+int RedisConnectionRegistry::consumerCount(const um::Connection *connection) const
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    for (const auto &item : state_->pools) {
+        if (item.second.connection.get() == connection) {
+            return static_cast<int>(item.second.consumers.size());
+        }
+    }
+    return 0;
+}
+
+bool RedisConnectionRegistry::shutdown(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->shutdown = true;
+    if (timeout.count() > 0) {
+        state_->released.wait_for(lock, timeout, [this]() { return state_->leases == 0; });
+    }
+    if (state_->leases > 0) {
+        qWarning() << "Connection registry shut down with" << state_->leases << "pools still in use";
+        for (const auto &item : state_->pools) {
+            for (const auto &consumer : item.second.consumers) {
+                qWarning() << "  " << item.first << "held by" << consumer.name;
+            }
+        }
+        return false;
+    }
+    return true;
+}
+
+bool RedisConnectionRegistry::isShutdown() const
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->shutdown;
+}
+
+void RedisConnectionRegistry::reopen()
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->shutdown = false;
+}
@@ -0,0 +1,122 @@
+#ifndef REDISCONNECTIONREGISTRY_H
+#define REDISCONNECTIONREGISTRY_H
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include <um/connection.hpp>
+
+#include "redismodule_export.h"
+
+/**
+ * @brief 共享连接池的使用方计数
+ *
+ * 由使用方(RedisConnection)在每次调用后累加, 注册表汇总时读取
+ */
+struct RedisPoolUsage
+{
+    std::atomic<qint64> calls{0};
+    std::atomic<qint64> failures{0};
+};
+
+/**
+ * @brief 共享连接池的一个使用方
+ *
+ * calls/failures 为该使用方经主连接池完成的调用数与传输层失败数(分档连接池上的使用方为 0)
+ */
+struct RedisPoolConsumerInfo
+{
+    quint64 id = 0;
+    QString name;
+    qint64 acquiredAtMs = 0;
+    qint64 calls = 0;
+    qint64 failures = 0;
+};
+
+/**
+ * @brief 共享连接池快照
+ *
+ * 连接池按地址与连接参数区分; savedConnections 为共享后少建立的连接数上限,
+ * 即 (使用方数 - 1) * poolSize
+ */
+struct RedisSharedPoolInfo
+{
+    QString key;
+    QString host;
+    int port = 0;
+    int poolSize = 0;
+    int socketTimeoutMs = 0;
+    qint64 createdAtMs = 0;
+    int savedConnections = 0;
+    QVector<RedisPoolConsumerInfo> consumers;
+};
+
+/**
+ * @brief 借出的共享连接池
+ *
+ * connection 析构(最后一个副本释放)时归还给注册表; 使用方全部归还后连接池随之关闭
+ */
+struct RedisPoolLease
+{
+    std::shared_ptr<um::Connection> connection;
+    std::shared_ptr<RedisPoolUsage> usage;
+};
+
+/**
+ * @brief 进程级共享连接注册表
+ *
+ * 连接到同一地址、连接参数相同的 RedisConnection 共享一个 um::Connection 连接池, 按使用方引用计数。
+ * 关闭顺序是确定的: 连接池在最后一个使用方归还时、于归还所在线程关闭;
+ * 注册表内部状态由借出的连接池共同持有, 静态对象的析构顺序不影响归还。
+ * shutdown 之后不再借出连接池, 并等待已借出的连接池全部归还。所有方法线程安全
+ */
+class REDISMODULESHARED_EXPORT RedisConnectionRegistry
+{
+public:
+    static RedisConnectionRegistry& instance();
+
+    RedisConnectionRegistry(const RedisConnectionRegistry &) = delete;
+    RedisConnectionRegistry& operator=(const RedisConnectionRegistry &) = delete;
+
+    /**
+    * @brief 借出连接参数对应的连接池, 不存在时创建; 注册表已关闭时返回空的 RedisPoolLease
+    */
+    RedisPoolLease acquire(const um::ConnectionOptions &options, const QString &consumer);
+
+    /**
+    * @brief 当前共享的连接池(按创建顺序)与连接池数
+    */
+    QVector<RedisSharedPoolInfo> pools() const;
+    int poolCount() const;
+
+    /**
+    * @brief 借出 connection 的连接池当前的使用方数(不是共享连接池时返回 0)
+    */
+    int consumerCount(const um::Connection *connection) const;
+
+    /**
+    * @brief 关闭注册表
+    *
+    * 之后的 acquire 返回空; 等待已借出的连接池全部归还, 超时返回 false(0 表示不等待)
+    */
+    bool shutdown(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    bool isShutdown() const;
+
+    /**
+    * @brief 重新开放已关闭的注册表
+    */
+    void reopen();
+
+    static QString poolKey(const um::ConnectionOptions &options);
+
+private:
+    RedisConnectionRegistry();
+
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
+#endif // REDISCONNECTIONREGISTRY_H
@@ -0,0 +1,305 @@
+#include "redishotkeytracker.h"
+#include <QDebug>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+
+namespace {
+
+constexpr int kMaxSketchWidth = 1 << 20;
+constexpr int kMaxSketchDepth = 8;
+
+/**
+ * @brief 线程本地的采样状态
+ *
+ * countdown 减到 0 时采样一次, 之后在 [1, 2 × 周期 - 1] 中随机取下一个间隔,
+ * 避免固定间隔与调用方的访问模式同步而总是采到同一个键
+ */
+struct SampleState
+{
+    int countdown = 0;
+    quint32 rng = 0;
+};
+
+thread_local SampleState sampleState;
+
+int nextInterval(SampleState &state, int period)
+{
+    if (period <= 1) {
+        return 1;
+    }
+    if (state.rng == 0) {
+        state.rng = static_cast<quint32>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+    }
+    // xorshift32
+    state.rng ^= state.rng << 13;
+    state.rng ^= state.rng >> 17;
+    state.rng ^= state.rng << 5;
+    return 1 + static_cast<int>(state.rng % static_cast<quint32>(2 * period - 1));
+}
+
+quint32 roundUpPowerOfTwo(int value)
+{
+    quint32 result = 1;
+    while (result < static_cast<quint32>(value)) {
+        result <<= 1;
+    }
+    return result;
+}
+
+bool moreCalls(const RedisHotKey &a, const RedisHotKey &b)
+{
+    return a.estimatedCalls > b.estimatedCalls;
+}
+
+} // namespace
+
+QString RedisHotKeyReport::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+    out << "Hot keys over " << windowMs << " ms (1/" << samplePeriod << " sampling, " << sampledCalls
+        << " sampled, ~" << estimatedCalls << " calls)\n";
+    for (const auto &key : topKeys) {
+        out << "  " << QString::number(key.share * 100.0, 'f', 1).rightJustified(5) << "%  ~"
+            << key.estimatedCalls << "  " << key.key << "\n";
+    }
+    for (const auto &command : commands) {
+        out << command.operation << " ~" << command.estimatedCalls << " calls\n";
+        for (const auto &key : command.hotKeys) {
+            out << "  " << QString::number(key.share * 100.0, 'f', 1).rightJustified(5) << "%  ~"
+                << key.estimatedCalls << "  " << key.key << "\n";
+        }
+    }
+    out.flush();
+    return text;
+}
+
+RedisHotKeyTracker::RedisHotKeyTracker()
+    : enabled_(false)
+    , samplePeriod_(1)
+    , widthMask_(0)
+    , sampledCalls_(0)
+    , reporting_(false)
+{
+}
+
+RedisHotKeyTracker::~RedisHotKeyTracker()
+{
+    disable();
+}
+
+void RedisHotKeyTracker::enable(const RedisHotKeyOptions &options)
+{
+    stopReporting();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+        options_.topK = std::max(1, options_.topK);
+        options_.sketchDepth = std::max(1, std::min(options_.sketchDepth, kMaxSketchDepth));
+        const quint32 width = roundUpPowerOfTwo(std::max(16, std::min(options_.sketchWidth, kMaxSketchWidth)));
+        options_.sketchWidth = static_cast<int>(width);
+        widthMask_ = width - 1;
+        sketch_.assign(static_cast<std::size_t>(width) * options_.sketchDepth, 0);
+        clear();
+
+        double rate = options_.sampleRate > 0.0 ? std::min(options_.sampleRate, 1.0) : 1.0;
+        samplePeriod_.store(std::max(1, qRound(1.0 / rate)), std::memory_order_relaxed);
+    }
+    enabled_.store(true, std::memory_order_release);
+    if (options.reportIntervalMs > 0) {
+        startReporting();
+    }
+    qDebug() << "Hot key tracking enabled: 1 /" << samplePeriod_.load() << "sampling, top"
+             << options_.topK << "per command";
+}
+
+void RedisHotKeyTracker::disable()
+{
+    enabled_.store(false, std::memory_order_release);
+    stopReporting();
+}
+
+bool RedisHotKeyTracker::isEnabled() const
+{
+    return enabled_.load(std::memory_order_acquire);
+}
+
+void RedisHotKeyTracker::setReportHandler(std::function<void(const RedisHotKeyReport &)> handler)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    reportHandler_ = std::move(handler);
+}
+
+void RedisHotKeyTracker::record(const QString &operation, const QString &key)
+{
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    // 线程本地的间隔可能来自之前更低的采样率, 全量记录时不再等待
+    const int period = samplePeriod_.load(std::memory_order_relaxed);
+    if (period > 1) {
+        SampleState &state = sampleState;
+        if (--state.countdown > 0) {
+            return;
+        }
+        state.countdown = nextInterval(state, period);
+    }
+    recordSampled(operation, key);
+}
+
+RedisHotKeyReport RedisHotKeyTracker::report() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buildReport();
+}
+
+void RedisHotKeyTracker::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    clear();
+}
+
+void RedisHotKeyTracker::recordSampled(const QString &operation, const QString &key)
+{
+    // 两个独立哈希组合出各行的下标(Kirsch-Mitzenmacher)
+    const uint h1 = qHash(key, qHash(operation));
+    const uint h2 = qHash(key, h1 ^ 0x9E3779B9u) | 1u;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sketch_.empty()) {
+        return;
+    }
+
+    quint32 estimate = std::numeric_limits<quint32>::max();
+    const std::size_t width = static_cast<std::size_t>(widthMask_) + 1;
+    for (int row = 0; row < options_.sketchDepth; ++row) {
+        quint32 &counter = sketch_[row * width + ((h1 + static_cast<uint>(row) * h2) & widthMask_)];
+        estimate = std::min(estimate, ++counter);
+    }
+    ++sampledCalls_;
+    ++commandCalls_[operation];
+
+    QVector<Counter> &top = topKeys_[operation];
+    int smallest = -1;
+    for (int i = 0; i < top.size(); ++i) {
+        if (top[i].key == key) {
+            top[i].count = estimate;
+            return;
+        }
+        if (smallest < 0 || top[i].count < top[smallest].count) {
+            smallest = i;
+        }
+    }
+    if (top.size() < options_.topK) {
+        top.append({key, estimate});
+    } else if (estimate > top[smallest].count) {
+        top[smallest] = {key, estimate};
+    }
+}
+
+RedisHotKeyReport RedisHotKeyTracker::buildReport() const
+{
+    RedisHotKeyReport report;
+    const int period = samplePeriod_.load(std::memory_order_relaxed);
+    report.windowMs = window_.isValid() ? window_.elapsed() : 0;
+    report.samplePeriod = period;
+    report.sampledCalls = sampledCalls_;
+    report.estimatedCalls = sampledCalls_ * period;
+
+    QHash<QString, qint64> merged;
+    for (auto it = commandCalls_.constBegin(); it != commandCalls_.constEnd(); ++it) {
+        RedisHotKeyCommandStats command;
+        command.operation = it.key();
+        command.estimatedCalls = it.value() * period;
+        for (const auto &counter : topKeys_.value(it.key())) {
+            RedisHotKey hotKey;
+            hotKey.key = counter.key;
+            hotKey.estimatedCalls = static_cast<qint64>(counter.count) * period;
+            hotKey.share = std::min(1.0, static_cast<double>(counter.count) / it.value());
+            command.hotKeys.append(hotKey);
+            merged[counter.key] += counter.count;
+        }
+        std::sort(command.hotKeys.begin(), command.hotKeys.end(), moreCalls);
+        report.commands.append(command);
+    }
+    std::sort(report.commands.begin(), report.commands.end(),
+              [](const RedisHotKeyCommandStats &a, const RedisHotKeyCommandStats &b) {
+                  return a.estimatedCalls > b.estimatedCalls;
+              });
+
+    for (auto it = merged.constBegin(); it != merged.constEnd(); ++it) {
+        RedisHotKey hotKey;
+        hotKey.key = it.key();
+        hotKey.estimatedCalls = it.value() * period;
+        hotKey.share = sampledCalls_ > 0 ? std::min(1.0, static_cast<double>(it.value()) / sampledCalls_) : 0.0;
+        report.topKeys.append(hotKey);
+    }
+    std::sort(report.topKeys.begin(), report.topKeys.end(), moreCalls);
+    if (report.topKeys.size() > options_.topK) {
+        report.topKeys.resize(options_.topK);
+    }
+    return report;
+}
+
+void RedisHotKeyTracker::clear()
+{
+    std::fill(sketch_.begin(), sketch_.end(), 0);
+    sampledCalls_ = 0;
+    commandCalls_.clear();
+    topKeys_.clear();
+    window_.start();
+}
+
+void RedisHotKeyTracker::startReporting()
+{
+    std::lock_guard<std::mutex> lock(reportMutex_);
+    if (reporting_) {
+        return;
+    }
+    reporting_ = true;
+    reportThread_ = std::thread(&RedisHotKeyTracker::reportLoop, this);
+}
+
+void RedisHotKeyTracker::stopReporting()
+{
+    {
+        std::lock_guard<std::mutex> lock(reportMutex_);
+        reporting_ = false;
+    }
+    reportCv_.notify_all();
+    if (reportThread_.joinable()) {
+        reportThread_.join();
+    }
+}
+
+void RedisHotKeyTracker::reportLoop()
+{
+    std::unique_lock<std::mutex> lock(reportMutex_);
+    while (reporting_) {
+        const int intervalMs = options_.reportIntervalMs;
+        reportCv_.wait_for(lock, std::chrono::milliseconds(intervalMs), [this]() { return !reporting_; });
+        if (!reporting_) {
+            break;
+        }
+        lock.unlock();
+
+        RedisHotKeyReport report;
+        std::function<void(const RedisHotKeyReport &)> handler;
+        {
+            std::lock_guard<std::mutex> stateLock(mutex_);
+            report = buildReport();
+            clear();
+            handler = reportHandler_;
+        }
+        if (handler) {
+            handler(report);
+        } else {
+            qDebug().noquote() << report.toText();
+        }
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef REDISHOTKEYTRACKER_H
+#define REDISHOTKEYTRACKER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "redismodule_export.h"
+
+/**
+ * @brief 热点键统计参数
+ *
+ * sampleRate 为记录调用的比例(默认 1/64), 估计次数按比例放大;
+ * count-min sketch 的宽度向上取 2 的幂, 单个计数的高估不超过 e/宽度 × 窗口内采样总数(概率 1 - e^-深度)。
+ * reportIntervalMs > 0 时后台线程按周期输出报告并开始新的统计窗口
+ */
+struct RedisHotKeyOptions
+{
+    double sampleRate = 1.0 / 64;
+    int topK = 10;
+    int sketchWidth = 2048;
+    int sketchDepth = 4;
+    int reportIntervalMs = 0;
+};
+
+/**
+ * @brief 热点键及其估计调用次数, share 为占所属命令(或全部调用)的比例
+ */
+struct RedisHotKey
+{
+    QString key;
+    qint64 estimatedCalls = 0;
+    double share = 0.0;
+};
+
+/**
+ * @brief 单个命令的调用次数与热点键
+ */
+struct RedisHotKeyCommandStats
+{
+    QString operation;
+    qint64 estimatedCalls = 0;
+    QVector<RedisHotKey> hotKeys;
+};
+
+/**
+ * @brief 一个统计窗口的热点键报告
+ *
+ * commands 按调用次数从多到少排序, topKeys 为合并各命令后的热点键
+ */
+struct REDISMODULESHARED_EXPORT RedisHotKeyReport
+{
+    qint64 windowMs = 0;
+    int samplePeriod = 0;
+    qint64 sampledCalls = 0;
+    qint64 estimatedCalls = 0;
+    QVector<RedisHotKeyCommandStats> commands;
+    QVector<RedisHotKey> topKeys;
+
+    QString toText() const;
+};
+
+/**
+ * @brief 客户端热点键统计
+ *
+ * 由 RedisOperationsBase::execute 对每次带键的调用调用 record()。
+ * 未启用时只有一次原子读; 启用后按线程本地的随机间隔采样(平均每 1/sampleRate 次一次),
+ * 只有被采样的调用才计算哈希、更新 count-min sketch 与每个命令的 top-K 列表。
+ * 所有方法线程安全
+ */
+class REDISMODULESHARED_EXPORT RedisHotKeyTracker
+{
+public:
+    RedisHotKeyTracker();
+    ~RedisHotKeyTracker();
+
+    RedisHotKeyTracker(const RedisHotKeyTracker &) = delete;
+    RedisHotKeyTracker& operator=(const RedisHotKeyTracker &) = delete;
+
+    /**
+    * @brief 开关统计
+    *
+    * 启用时清空已有统计并按参数重建 sketch, 关闭时停止周期报告
+    */
+    void enable(const RedisHotKeyOptions &options);
+    void disable();
+    bool isEnabled() const;
+
+    /**
+    * @brief 周期报告的处理函数, 未设置时以 qDebug 输出文本报告
+    */
+    void setReportHandler(std::function<void(const RedisHotKeyReport &)> handler);
+
+    void record(const QString &operation, const QString &key);
+
+    /**
+    * @brief 当前窗口的报告, 清空统计开始新的窗口
+    */
+    RedisHotKeyReport report() const;
+    void reset();
+
+private:
+    struct Counter
+    {
+        QString key;
+        quint32 count = 0;
+    };
+
+    void recordSampled(const QString &operation, const QString &key);
+    RedisHotKeyReport buildReport() const;
+    void clear();
+
+    void startReporting();
+    void stopReporting();
+    void reportLoop();
+
+    std::atomic<bool> enabled_;
+    std::atomic<int> samplePeriod_;
+
+    mutable std::mutex mutex_;
+    RedisHotKeyOptions options_;
+    quint32 widthMask_;
+    std::vector<quint32> sketch_;
+    qint64 sampledCalls_;
+    QHash<QString, qint64> commandCalls_;
+    QHash<QString, QVector<Counter>> topKeys_;
+    QElapsedTimer window_;
+    std::function<void(const RedisHotKeyReport &)> reportHandler_;
+
+    // 周期报告线程
+    std::thread reportThread_;
+    std::mutex reportMutex_;
+    std::condition_variable reportCv_;
+    bool reporting_;
+};
+
+#endif // REDISHOTKEYTRACKER_H
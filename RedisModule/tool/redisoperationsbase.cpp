@@ -15,7 +15,61 @@ bool RedisOperationsBase::checkConnection() const
 {
     if (!connection_ || !connection_->isConnected() || !connection_->redis()) {
         qWarning() << "Not connected to Redis";
+        RedisCallContext::setLastStatus(RedisCallStatus::NotConnected);
+        return false;
+    }
+    // 熔断打开: 不再等待 socket 超时, 直接失败
+    if (!connection_->isAvailable()) {
+        RedisCallContext::setLastStatus(RedisCallStatus::CircuitOpen);
+        return false;
+    }
+    // 剩余时间已不足一次往返的最小 socket 超时, 发送出去也只会在截止时间之后超时
+    if (RedisCallContext::deadlineExpired() || !RedisConnection::hasCallBudget()) {
+        RedisCallContext::setLastStatus(RedisCallStatus::DeadlineExceeded);
         return false;
     }
     return true;
 }
+
+void RedisOperationsBase::recordKey(const QString& operation, const QString& key) const
+{
+    if (connection_) {
+        connection_->hotKeys().record(operation, key);
+    }
+}
+
+RedisSlowLog* RedisOperationsBase::slowLog() const
+{
+    return connection_ ? &connection_->slowLog() : nullptr;
+}
+
+void RedisOperationsBase::reportSuccess() const
+{
+    connection_->reportSuccess();
+    RedisCallContext::setLastStatus(RedisCallStatus::Ok);
+}
+
+void RedisOperationsBase::reportError(const QString& operation, const std::exception& e) const
+{
+    qCritical() << operation << "error:" << e.what();
+    RedisCallContext::setLastStatus(RedisCallStatus::Error);
+}
+
+bool RedisOperationsBase::handleTransportError(const QString& operation, const std::exception& e, bool retryAllowed) const
+{
+    qCritical() << operation << "transport error:" << e.what();
+    RedisCallContext::setLastStatus(RedisCallStatus::Error);
+    connection_->reportFailure();
+    return retryAllowed && connection_->isAvailable() && !RedisCallContext::deadlineExpired();
+}
+
+bool RedisOperationsBase::handleTimeout(const QString& operation, const std::exception& e, bool retryAllowed) const
+{
+    if (!RedisCallContext::hasDeadline()) {
+        return handleTransportError(operation, e, retryAllowed);
+    }
+    // 调用方给定的时间预算耗尽, 不代表服务器故障, 不计入熔断统计
+    qWarning() << operation << "deadline exceeded:" << e.what();
+    RedisCallContext::setLastStatus(RedisCallStatus::DeadlineExceeded);
+    return false;
+}
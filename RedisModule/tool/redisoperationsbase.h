@@ -4,6 +4,12 @@
 #include <QString>
 #include <QDebug>
 #include <functional>
+#include <utility>
+#include <sw/redis++/errors.h>
+
+#include "rediscallcontext.h"
+#include "rediscommandpolicy.h"
+#include "redisslowlog.h"
 
 class RedisConnection;
 
@@ -16,12 +22,19 @@ public:
 protected:
     /**
      * @brief 检查连接是否有效
-     * @return 连接有效返回 true
+     * @return 连接有效、熔断器关闭且截止时间未到返回 true; 否则直接返回 false(快速失败)
      */
     bool checkConnection() const;
 
     /**
      * @brief 执行 Redis 操作（有返回值版本）
+     *
+     * 传输层错误(断线/超时)会上报给连接做健康统计;
+     * 对可安全重试的命令(见 RedisCommandPolicy), 首次传输失败后在熔断未打开时重试一次。
+     * 当前线程存在 RedisCallContext 时, 截止时间已过的调用不再发送,
+     * 等待应答超时记为 DeadlineExceeded 且不计入熔断统计。
+     * 结果状态可通过 RedisCallContext::lastStatus() 获取
+     *
      * @tparam Func 操作函数类型
      * @tparam Default 默认值类型
      * @param func 实际执行的操作
@@ -32,15 +45,51 @@ protected:
     template<typename Func, typename Default>
     auto execute(Func&& func, const QString& operation, Default defaultValue) -> decltype(func())
     {
-        if (!checkConnection()) {
-            return defaultValue;
+        return execute(std::forward<Func>(func), operation, RedisCommandArgs(), std::move(defaultValue));
+    }
+
+    /**
+     * @brief 执行针对单个键的 Redis 操作
+     *
+     * args 可直接传键, 写入值的命令传 {键, 值字节数}。
+     * 先把 (operation, key) 交给连接的热点键统计(未启用时只有一次原子读);
+     * 慢调用日志启用时对整个调用(含重试)计时, 超过阈值的调用连同键与参数大小写入日志
+     */
+    template<typename Func, typename Default>
+    auto execute(Func&& func, const QString& operation, const RedisCommandArgs& args, Default defaultValue)
+        -> decltype(func())
+    {
+        if (args.hasKey) {
+            recordKey(operation, args.key);
         }
+        RedisSlowCallTimer timer(slowLog(), operation, args);
+        bool retryAllowed = RedisCommandPolicy::isRetrySafe(operation);
+        while (true) {
+            if (!checkConnection()) {
+                return defaultValue;
+            }
 
-        try {
-            return func();
-        } catch (const std::exception &e) {
-            qCritical() << operation << "error:" << e.what();
-            return defaultValue;
+            try {
+                auto result = func();
+                reportSuccess();
+                return result;
+            } catch (const sw::redis::TimeoutError &e) {
+                if (!handleTimeout(operation, e, retryAllowed)) {
+                    return defaultValue;
+                }
+            } catch (const sw::redis::IoError &e) {
+                if (!handleTransportError(operation, e, retryAllowed)) {
+                    return defaultValue;
+                }
+            } catch (const sw::redis::ClosedError &e) {
+                if (!handleTransportError(operation, e, retryAllowed)) {
+                    return defaultValue;
+                }
+            } catch (const std::exception &e) {
+                reportError(operation, e);
+                return defaultValue;
+            }
+            retryAllowed = false;
         }
     }
 
@@ -53,18 +102,61 @@ protected:
     template<typename Func>
     void executeVoid(Func&& func, const QString& operation)
     {
-        if (!checkConnection()) {
-            return;
+        executeVoid(std::forward<Func>(func), operation, RedisCommandArgs());
+    }
+
+    template<typename Func>
+    void executeVoid(Func&& func, const QString& operation, const RedisCommandArgs& args)
+    {
+        if (args.hasKey) {
+            recordKey(operation, args.key);
         }
+        RedisSlowCallTimer timer(slowLog(), operation, args);
+        bool retryAllowed = RedisCommandPolicy::isRetrySafe(operation);
+        while (true) {
+            if (!checkConnection()) {
+                return;
+            }
 
-        try {
-            func();
-        } catch (const std::exception &e) {
-            qCritical() << operation << "error:" << e.what();
+            try {
+                func();
+                reportSuccess();
+                return;
+            } catch (const sw::redis::TimeoutError &e) {
+                if (!handleTimeout(operation, e, retryAllowed)) {
+                    return;
+                }
+            } catch (const sw::redis::IoError &e) {
+                if (!handleTransportError(operation, e, retryAllowed)) {
+                    return;
+                }
+            } catch (const sw::redis::ClosedError &e) {
+                if (!handleTransportError(operation, e, retryAllowed)) {
+                    return;
+                }
+            } catch (const std::exception &e) {
+                reportError(operation, e);
+                return;
+            }
+            retryAllowed = false;
         }
     }
 
     RedisConnection* connection_;
+
+private:
+    /**
+     * @brief 调用记录与结果上报
+     *
+     * recordKey 记录热点键统计, slowLog 为连接的慢调用日志;
+     * handleTransportError/handleTimeout 记录一次失败并返回是否应重试本次调用
+     */
+    void recordKey(const QString& operation, const QString& key) const;
+    RedisSlowLog* slowLog() const;
+    void reportSuccess() const;
+    void reportError(const QString& operation, const std::exception& e) const;
+    bool handleTransportError(const QString& operation, const std::exception& e, bool retryAllowed) const;
+    bool handleTimeout(const QString& operation, const std::exception& e, bool retryAllowed) const;
 };
 
 #endif // REDISOPERATIONSBASE_H
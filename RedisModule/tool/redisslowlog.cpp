@@ -0,0 +1,223 @@
+#include "redisslowlog.h"
+#include "rediscommandpolicy.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QTextStream>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const char *statusName(RedisCallStatus status)
+{
+    switch (status) {
+    case RedisCallStatus::Ok:
+        return "ok";
+    case RedisCallStatus::Error:
+        return "error";
+    case RedisCallStatus::NotConnected:
+        return "not connected";
+    case RedisCallStatus::CircuitOpen:
+        return "circuit open";
+    case RedisCallStatus::DeadlineExceeded:
+        return "deadline exceeded";
+    }
+    return "unknown";
+}
+
+QString formatUs(qint64 us)
+{
+    if (us >= 1000) {
+        return QString::number(us / 1000.0, 'f', 1) + "ms";
+    }
+    return QString::number(us) + "us";
+}
+
+// 服务器把超过 128 字节的参数截断为 "<前缀>... (N more bytes)"
+bool sameKey(const QString &serverArg, const QString &key)
+{
+    if (serverArg == key) {
+        return true;
+    }
+    const int truncated = serverArg.indexOf("... (");
+    return truncated > 0 && serverArg.endsWith(" more bytes)") && key.startsWith(serverArg.left(truncated));
+}
+
+} // namespace
+
+QString RedisSlowLogReport::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+    out << calls.size() << " slow calls, " << serverEntries.size() << " server SLOWLOG entries";
+    if (serverThresholdUs >= 0) {
+        out << " (slowlog-log-slower-than " << formatUs(serverThresholdUs) << ")";
+    }
+    out << "\n";
+    for (const auto &breakdown : calls) {
+        const RedisSlowLogEntry &call = breakdown.call;
+        out << QDateTime::fromMSecsSinceEpoch(call.timestampMs).toString("hh:mm:ss.zzz") << "  "
+            << call.operation;
+        if (!call.key.isEmpty()) {
+            out << " " << call.key;
+        }
+        out << "  client " << formatUs(call.latencyUs);
+        if (breakdown.serverExact) {
+            out << ", server " << formatUs(breakdown.serverUs) << ", network/client "
+                << formatUs(breakdown.outsideServerUs);
+        } else if (breakdown.serverUs >= 0) {
+            out << ", server <" << formatUs(breakdown.serverUs) << ", network/client >"
+                << formatUs(breakdown.outsideServerUs);
+        } else {
+            out << ", server time unknown";
+        }
+        if (call.status != RedisCallStatus::Ok) {
+            out << " [" << statusName(call.status) << "]";
+        }
+        for (const auto &event : breakdown.latencyEvents) {
+            out << " {" << event.event << " " << event.latestMs << "ms}";
+        }
+        out << "\n";
+    }
+    out.flush();
+    return text;
+}
+
+RedisSlowLog::RedisSlowLog()
+    : enabled_(false)
+    , thresholdUs_(0)
+    , next_(0)
+    , nextId_(0)
+{
+}
+
+void RedisSlowLog::enable(const RedisSlowLogOptions &options)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<RedisSlowLogEntry>().swap(ring_);
+        ring_.reserve(static_cast<std::size_t>(std::max(1, options.capacity)));
+        next_ = 0;
+    }
+    thresholdUs_.store(std::max<qint64>(0, options.thresholdUs), std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_release);
+    qDebug() << "Client slow log enabled: threshold" << options.thresholdUs << "us, capacity"
+             << std::max(1, options.capacity);
+}
+
+void RedisSlowLog::disable()
+{
+    enabled_.store(false, std::memory_order_release);
+}
+
+void RedisSlowLog::record(const QString &operation, const RedisCommandArgs &args,
+                          std::chrono::steady_clock::time_point start)
+{
+    const qint64 latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    if (latencyUs < thresholdUs_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    RedisSlowLogEntry entry;
+    entry.operation = operation;
+    if (args.hasKey) {
+        entry.key = args.key;
+        entry.keyBytes = args.key.toUtf8().size();
+    }
+    entry.valueSize = args.valueSize;
+    entry.latencyUs = latencyUs;
+    entry.timestampMs = QDateTime::currentMSecsSinceEpoch() - latencyUs / 1000;
+    entry.status = RedisCallContext::lastStatus();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_.capacity() == 0) {
+        return;
+    }
+    entry.id = nextId_++;
+    if (ring_.size() < ring_.capacity()) {
+        ring_.push_back(std::move(entry));
+    } else {
+        ring_[next_] = std::move(entry);
+    }
+    next_ = (next_ + 1) % ring_.capacity();
+}
+
+QVector<RedisSlowLogEntry> RedisSlowLog::entries() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    QVector<RedisSlowLogEntry> result;
+    result.reserve(static_cast<int>(ring_.size()));
+    // next_ 之前为较新的记录, 从 next_ - 1 向前回绕遍历
+    for (std::size_t i = 0; i < ring_.size(); ++i) {
+        result.append(ring_[(next_ + ring_.size() - 1 - i) % ring_.size()]);
+    }
+    return result;
+}
+
+void RedisSlowLog::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_.clear();
+    next_ = 0;
+}
+
+RedisSlowLogReport RedisSlowLog::correlate(const QVector<RedisSlowLogEntry> &calls,
+                                           const QVector<RedisServerSlowLogEntry> &serverEntries,
+                                           const QVector<RedisLatencyEvent> &latencyEvents,
+                                           qint64 serverThresholdUs, int toleranceSec)
+{
+    RedisSlowLogReport report;
+    report.serverThresholdUs = serverThresholdUs;
+    report.serverEntries = serverEntries;
+    report.latencyEvents = latencyEvents;
+
+    QVector<bool> used(serverEntries.size(), false);
+    for (const auto &call : calls) {
+        RedisSlowCallBreakdown breakdown;
+        breakdown.call = call;
+        const qint64 firstSec = call.timestampMs / 1000 - toleranceSec;
+        const qint64 lastSec = (call.timestampMs + call.latencyUs / 1000) / 1000 + toleranceSec;
+        const QString command = RedisCommandPolicy::commandName(call.operation);
+
+        // 时间最接近的候选优先, 其次取服务器耗时更长的
+        int best = -1;
+        qint64 bestDistance = std::numeric_limits<qint64>::max();
+        for (int i = 0; i < serverEntries.size(); ++i) {
+            const RedisServerSlowLogEntry &server = serverEntries.at(i);
+            if (used.at(i) || server.args.isEmpty() || server.timestamp < firstSec || server.timestamp > lastSec
+                || server.args.first().compare(command, Qt::CaseInsensitive) != 0) {
+                continue;
+            }
+            if (!call.key.isEmpty() && (server.args.size() < 2 || !sameKey(server.args.at(1), call.key))) {
+                continue;
+            }
+            const qint64 distance = qAbs(server.timestamp - call.timestampMs / 1000);
+            if (distance < bestDistance
+                || (distance == bestDistance && server.durationUs > serverEntries.at(best).durationUs)) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+
+        if (best >= 0) {
+            used[best] = true;
+            breakdown.server = serverEntries.at(best);
+            breakdown.serverExact = true;
+            breakdown.serverUs = breakdown.server.durationUs;
+        } else if (serverThresholdUs >= 0) {
+            breakdown.serverUs = std::min(serverThresholdUs, call.latencyUs);
+        }
+        if (breakdown.serverUs >= 0) {
+            breakdown.outsideServerUs = std::max<qint64>(0, call.latencyUs - breakdown.serverUs);
+        }
+
+        for (const auto &event : latencyEvents) {
+            if (event.timestamp >= firstSec && event.timestamp <= lastSec) {
+                breakdown.latencyEvents.append(event);
+            }
+        }
+        report.calls.append(breakdown);
+    }
+    return report;
+}
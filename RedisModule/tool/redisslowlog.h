@@ -0,0 +1,200 @@
+#ifndef REDISSLOWLOG_H
+#define REDISSLOWLOG_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "rediscallcontext.h"
+#include "redismodule_export.h"
+
+/**
+ * @brief 一次调用的目标键与参数大小
+ *
+ * 由操作层传给 RedisOperationsBase::execute; 可由键隐式构造,
+ * 写入单个值的命令再给出值的大小(字节数组为字节数, 字符串为字符数)。默认构造表示调用不针对单个键
+ */
+struct RedisCommandArgs
+{
+    RedisCommandArgs() = default;
+    RedisCommandArgs(const QString &key, qint64 valueSize = 0)
+        : key(key), hasKey(true), valueSize(valueSize) {}
+
+    QString key;
+    bool hasKey = false;
+    qint64 valueSize = 0;
+};
+
+/**
+ * @brief 客户端慢调用日志参数
+ *
+ * 客户端测得的耗时(含重试、排队与网络往返)不低于 thresholdUs 的调用写入环形缓冲区,
+ * 缓冲区满后覆盖最早的记录
+ */
+struct RedisSlowLogOptions
+{
+    qint64 thresholdUs = 10000;
+    int capacity = 128;
+};
+
+/**
+ * @brief 客户端慢调用记录
+ *
+ * timestampMs 为调用开始的本机时间(Unix 毫秒), latencyUs 为客户端测得的总耗时
+ */
+struct RedisSlowLogEntry
+{
+    qint64 id = 0;
+    QString operation;
+    QString key;
+    qint64 keyBytes = 0;
+    qint64 valueSize = 0;
+    qint64 latencyUs = 0;
+    qint64 timestampMs = 0;
+    RedisCallStatus status = RedisCallStatus::Ok;
+};
+
+/**
+ * @brief 服务器 SLOWLOG GET 记录, timestamp 为服务器时钟的 Unix 秒
+ */
+struct RedisServerSlowLogEntry
+{
+    qint64 id = 0;
+    qint64 timestamp = 0;
+    qint64 durationUs = 0;
+    QStringList args;
+    QString client;
+    QString clientName;
+};
+
+/**
+ * @brief 服务器 LATENCY LATEST 事件
+ */
+struct RedisLatencyEvent
+{
+    QString event;
+    qint64 timestamp = 0;
+    qint64 latestMs = 0;
+    qint64 maxMs = 0;
+};
+
+/**
+ * @brief 单个慢调用的耗时拆分
+ *
+ * 在服务器慢查询日志中找到对应记录时 serverExact 为 true, serverUs 为服务器执行时间;
+ * 找不到时说明服务器执行时间低于 slowlog-log-slower-than, serverUs 为该阈值(上界, 未知时为 -1)。
+ * outsideServerUs = latencyUs - serverUs, 即网络、排队与客户端耗时(serverExact 为 false 时为下界)。
+ * latencyEvents 为同一时间段内服务器记录的延迟尖峰(fork、aof-fsync 等)
+ */
+struct RedisSlowCallBreakdown
+{
+    RedisSlowLogEntry call;
+    bool serverExact = false;
+    qint64 serverUs = -1;
+    qint64 outsideServerUs = -1;
+    RedisServerSlowLogEntry server;
+    QVector<RedisLatencyEvent> latencyEvents;
+};
+
+/**
+ * @brief 客户端慢调用与服务器慢查询日志的对照报告
+ */
+struct REDISMODULESHARED_EXPORT RedisSlowLogReport
+{
+    qint64 serverThresholdUs = -1;
+    QVector<RedisSlowCallBreakdown> calls;
+    QVector<RedisServerSlowLogEntry> serverEntries;
+    QVector<RedisLatencyEvent> latencyEvents;
+
+    QString toText() const;
+};
+
+/**
+ * @brief 客户端慢调用日志
+ *
+ * 由 RedisOperationsBase::execute 计时, 未启用时只有一次原子读;
+ * 只有超过阈值的调用才加锁写入环形缓冲区。所有方法线程安全
+ */
+class REDISMODULESHARED_EXPORT RedisSlowLog
+{
+public:
+    RedisSlowLog();
+
+    RedisSlowLog(const RedisSlowLog &) = delete;
+    RedisSlowLog& operator=(const RedisSlowLog &) = delete;
+
+    /**
+    * @brief 开关记录, 启用时按新的容量清空已有记录
+    */
+    void enable(const RedisSlowLogOptions &options);
+    void disable();
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void record(const QString &operation, const RedisCommandArgs &args,
+                std::chrono::steady_clock::time_point start);
+
+    /**
+    * @brief 已记录的慢调用(从新到旧),清空记录
+    */
+    QVector<RedisSlowLogEntry> entries() const;
+    void clear();
+
+    /**
+    * @brief 把客户端记录与服务器 SLOWLOG/LATENCY LATEST 对照
+    *
+    * 服务器记录的命令名、键与客户端调用一致, 且时间戳落在调用时间 ± toleranceSec 秒内时视为同一次调用,
+    * 每条服务器记录最多对应一次调用; serverThresholdUs 为服务器 slowlog-log-slower-than(未知时为 -1)
+    */
+    static RedisSlowLogReport correlate(const QVector<RedisSlowLogEntry> &calls,
+                                        const QVector<RedisServerSlowLogEntry> &serverEntries,
+                                        const QVector<RedisLatencyEvent> &latencyEvents,
+                                        qint64 serverThresholdUs, int toleranceSec = 1);
+
+private:
+    std::atomic<bool> enabled_;
+    std::atomic<qint64> thresholdUs_;
+
+    mutable std::mutex mutex_;
+    std::vector<RedisSlowLogEntry> ring_;
+    std::size_t next_;
+    qint64 nextId_;
+};
+
+/**
+ * @brief 调用计时(RAII)
+ *
+ * 在 execute 入口构造, 析构时把耗时交给慢调用日志; 日志未启用时不读取时钟
+ */
+class RedisSlowCallTimer
+{
+public:
+    RedisSlowCallTimer(RedisSlowLog *log, const QString &operation, const RedisCommandArgs &args)
+        : log_(log && log->isEnabled() ? log : nullptr), operation_(operation), args_(args)
+    {
+        if (log_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~RedisSlowCallTimer()
+    {
+        if (log_) {
+            log_->record(operation_, args_, start_);
+        }
+    }
+
+    RedisSlowCallTimer(const RedisSlowCallTimer &) = delete;
+    RedisSlowCallTimer& operator=(const RedisSlowCallTimer &) = delete;
+
+private:
+    RedisSlowLog *log_;
+    const QString &operation_;
+    const RedisCommandArgs &args_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#endif // REDISSLOWLOG_H
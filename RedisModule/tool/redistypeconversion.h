@@ -0,0 +1,71 @@
+#ifndef REDISTYPECONVERSION_H
+#define REDISTYPECONVERSION_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <um/types.hpp>
+
+/**
+ * @brief Qt 类型与核心库类型之间的转换
+ *
+ * QString 先编码为 UTF-8 的 QByteArray, 再以 std::string_view 借给核心库, 不再额外拷贝成 std::string;
+ * 作为调用实参的临时 QByteArray 会存活到整条语句结束, 例如 ops.set(view(key.toUtf8()), ...) 是安全的
+ */
+namespace RedisTypeConversion {
+
+inline std::string_view view(const QByteArray &bytes)
+{
+    return std::string_view(bytes.constData(), static_cast<std::size_t>(bytes.size()));
+}
+
+inline QString toQString(const std::string &value)
+{
+    return QString::fromUtf8(value.data(), static_cast<int>(value.size()));
+}
+
+inline QByteArray toQByteArray(const std::string &value)
+{
+    return QByteArray(value.data(), static_cast<int>(value.size()));
+}
+
+inline QVector<QString> toQStrings(const std::vector<std::string> &values)
+{
+    QVector<QString> result;
+    result.reserve(static_cast<int>(values.size()));
+    for (const auto &value : values) {
+        result.append(toQString(value));
+    }
+    return result;
+}
+
+/**
+ * @brief 多个 QString 参数的 UTF-8 编码及其视图, 视图在对象存活期间有效
+ */
+class Utf8List
+{
+public:
+    explicit Utf8List(const QVector<QString> &values)
+    {
+        storage_.reserve(static_cast<std::size_t>(values.size()));
+        views_.reserve(static_cast<std::size_t>(values.size()));
+        for (const auto &value : values) {
+            storage_.push_back(value.toUtf8());
+            views_.push_back(view(storage_.back()));
+        }
+    }
+
+    const um::KeyList& views() const { return views_; }
+
+private:
+    std::vector<QByteArray> storage_;
+    um::KeyList views_;
+};
+
+} // namespace RedisTypeConversion
+
+#endif // REDISTYPECONVERSION_H
@@ -7,5 +7,9 @@ option(BUILD_BASE_EXAMPLES "Build base examples" ON)
 # Redis Examples 编译选项（默认启用）- 新的分层架构示例
 option(BUILD_REDIS_EXAMPLES "Build redis examples (layered architecture)" ON)
 
+# 命令行工具编译选项（默认启用）- 负载生成器等
+option(BUILD_TOOLS "Build command line tools (redismodule_loadgen)" ON)
+
 message(STATUS "Build base examples: ${BUILD_BASE_EXAMPLES}")
 message(STATUS "Build redis examples: ${BUILD_REDIS_EXAMPLES}")
+message(STATUS "Build tools: ${BUILD_TOOLS}")
@@ -45,6 +45,9 @@ static const QList<MenuItem> MENU_ITEMS = {
     {"", "", "", nullptr},  // 分隔线
     {"17", "统计信息", "显示图片库统计信息", ImageScenarios::showStatistics},
     {"18", "完整演示", "运行完整工作流演示", ImageScenarios::completeWorkflow},
+    {"19", "浏览统计", "模拟浏览并统计去重浏览人数", ImageScenarios::trackUniqueViews},
+    {"20", "冷热分层", "冷数据移到本地 pack 文件并压缩", ImageScenarios::manageStorageTiers},
+    {"21", "批量加载", "流水线读取并在线程池中并行解码", ImageScenarios::loadImagesInParallel},
 };
 
 // ============ 命令行映射 ============
@@ -67,6 +70,9 @@ static const QMap<QString, std::function<void(ImageRepository&)>> COMMAND_MAP =
     {"clear", ImageScenarios::clearAllImages},
     {"stats", ImageScenarios::showStatistics},
     {"demo", ImageScenarios::completeWorkflow},
+    {"views", ImageScenarios::trackUniqueViews},
+    {"tiers", ImageScenarios::manageStorageTiers},
+    {"load", ImageScenarios::loadImagesInParallel},
 };
 
 // ============ 函数声明 ============
@@ -75,6 +81,7 @@ void printMenu();
 void printHelp();
 void runInteractiveMode();
 void runCommandMode(const QString& command);
+void configureRepository(ImageRepository& repo);
 
 // ============ 主函数 ============
 int main(int argc, char *argv[])
@@ -138,7 +145,7 @@ void printMenu()
     qDebug() << "│ [0]  退出程序                                                │";
     qDebug() << "└─────────────────────────────────────────────────────────────┘";
     qDebug() << "";
-    std::cout << "请选择功能 (0-18): ";
+    std::cout << "请选择功能 (0-21): ";
 }
 
 void printHelp()
@@ -166,6 +173,9 @@ void printHelp()
     qDebug() << "  clear        清空所有图片";
     qDebug() << "  stats        显示统计信息";
     qDebug() << "  demo         运行完整演示";
+    qDebug() << "  views        模拟浏览并统计去重浏览人数";
+    qDebug() << "  tiers        冷数据移到本地 pack 文件并压缩";
+    qDebug() << "  load         流水线读取并在线程池中并行解码";
     qDebug() << "";
     qDebug() << "  --help, -h   显示此帮助信息";
 }
@@ -184,6 +194,7 @@ void runInteractiveMode()
     qDebug() << "";
     
     ImageRepository repo(redis);
+    configureRepository(repo);
     
     bool running = true;
     while (running) {
@@ -229,6 +240,7 @@ void runCommandMode(const QString& command)
     }
     
     ImageRepository repo(redis);
+    configureRepository(repo);
     
     // 查找并执行命令
     auto it = COMMAND_MAP.find(command);
@@ -241,3 +253,11 @@ void runCommandMode(const QString& command)
     
     redis.disconnect();
 }
+
+void configureRepository(ImageRepository& repo)
+{
+    // 列表与分页浏览使用 128/64 像素的缩略图, 上传时在后台预先生成
+    ImageThumbnailOptions thumbnails;
+    thumbnails.eagerSizes = {64, 128};
+    repo.setThumbnailOptions(thumbnails);
+}
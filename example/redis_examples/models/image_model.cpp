@@ -1,5 +1,120 @@
 #include "image_model.h"
 #include <QDebug>
+#include <cstring>
+
+namespace {
+
+const char kBinaryMagic[] = {'I', 'M'};
+const int kHeaderSize = 3;
+
+// 内容哈希: 0 为空, 1 为 32 字节原始 SHA-256, 2 为其他格式的 UTF-8 字符串
+enum HashEncoding : quint8 { HashEmpty = 0, HashSha256 = 1, HashText = 2 };
+
+void writeVarint(QByteArray& out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+void writeBytes(QByteArray& out, const QByteArray& bytes)
+{
+    writeVarint(out, static_cast<quint64>(bytes.size()));
+    out.append(bytes);
+}
+
+void writeInt64(QByteArray& out, qint64 value)
+{
+    for (int i = 0; i < 8; ++i) {
+        out.append(static_cast<char>((static_cast<quint64>(value) >> (8 * i)) & 0xff));
+    }
+}
+
+// 越界时返回 false, 不抛异常也不读取缓冲区之外的内存
+class BinaryReader
+{
+public:
+    BinaryReader(const char* begin, const char* end) : m_pos(begin), m_end(end) {}
+
+    bool readByte(quint8& value)
+    {
+        if (m_pos >= m_end) {
+            return false;
+        }
+        value = static_cast<quint8>(*m_pos++);
+        return true;
+    }
+
+    bool readVarint(quint64& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            quint8 byte = 0;
+            if (!readByte(byte)) {
+                return false;
+            }
+            value |= static_cast<quint64>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readInt64(qint64& value)
+    {
+        if (m_end - m_pos < 8) {
+            return false;
+        }
+        quint64 bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<quint64>(static_cast<quint8>(m_pos[i])) << (8 * i);
+        }
+        m_pos += 8;
+        value = static_cast<qint64>(bits);
+        return true;
+    }
+
+    bool readRaw(quint64 length, const char*& data)
+    {
+        if (static_cast<quint64>(m_end - m_pos) < length) {
+            return false;
+        }
+        data = m_pos;
+        m_pos += length;
+        return true;
+    }
+
+    bool readString(QString& value)
+    {
+        quint64 length = 0;
+        const char* data = nullptr;
+        if (!readVarint(length) || !readRaw(length, data)) {
+            return false;
+        }
+        value = QString::fromUtf8(data, static_cast<int>(length));
+        return true;
+    }
+
+    template <typename Int>
+    bool readInt(Int& value)
+    {
+        quint64 raw = 0;
+        if (!readVarint(raw)) {
+            return false;
+        }
+        value = static_cast<Int>(raw);
+        return true;
+    }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+};
+
+} // namespace
 
 // ============ Data 结构体的静态成员初始化 ============
 const QString ImageModel::Data::FIELD_ID = "id";
@@ -10,6 +125,7 @@ const QString ImageModel::Data::FIELD_UPLOAD_TIME = "upload_time";
 const QString ImageModel::Data::FIELD_WIDTH = "width";
 const QString ImageModel::Data::FIELD_HEIGHT = "height";
 const QString ImageModel::Data::FIELD_TAGS = "tags";
+const QString ImageModel::Data::FIELD_CONTENT_HASH = "content_hash";
 
 // ============ Data 结构体实现 ============
 ImageModel::Data::Data()
@@ -51,6 +167,9 @@ ImageModel::Data ImageModel::Data::fromVariantMap(const QVariantMap& map)
         QString tagsStr = map.value(FIELD_TAGS).toString();
         data.tags = tagsStr.split(",", Qt::SkipEmptyParts);
     }
+    if (map.contains(FIELD_CONTENT_HASH)) {
+        data.contentHash = map.value(FIELD_CONTENT_HASH).toString();
+    }
 
     return data;
 }
@@ -66,6 +185,7 @@ QVariantMap ImageModel::Data::toVariantMap() const
     map[FIELD_HEIGHT] = height;
     map[FIELD_UPLOAD_TIME] = uploadTime.toMSecsSinceEpoch();
     map[FIELD_TAGS] = tags.join(",");
+    map[FIELD_CONTENT_HASH] = contentHash;
     return map;
 }
 
@@ -191,6 +311,13 @@ bool ImageModel::setTags(const QStringList& tags)
     return true;
 }
 
+bool ImageModel::setContentHash(const QString& hash)
+{
+    d = std::make_shared<Data>(*d);
+    d->contentHash = hash;
+    return true;
+}
+
 // ============ Tag 管理 ============
 bool ImageModel::addTag(const QString& tag)
 {
@@ -285,6 +412,102 @@ QVariantMap ImageModel::toVariantMap() const
     return d->toVariantMap();
 }
 
+QByteArray ImageModel::toBinary() const
+{
+    QByteArray out;
+    out.reserve(64 + d->id.size() + d->filename.size() + d->mimeType.size() + d->tags.size() * 16);
+    out.append(kBinaryMagic, sizeof(kBinaryMagic));
+    out.append(static_cast<char>(BINARY_VERSION));
+
+    writeBytes(out, d->id.toUtf8());
+    writeBytes(out, d->filename.toUtf8());
+    writeBytes(out, d->mimeType.toUtf8());
+    writeVarint(out, static_cast<quint64>(d->size));
+    writeInt64(out, d->uploadTime.toMSecsSinceEpoch());
+    writeVarint(out, static_cast<quint64>(d->width));
+    writeVarint(out, static_cast<quint64>(d->height));
+    writeVarint(out, static_cast<quint64>(d->tags.size()));
+    for (const QString& tag : d->tags) {
+        writeBytes(out, tag.toUtf8());
+    }
+
+    const QByteArray hash = QByteArray::fromHex(d->contentHash.toLatin1());
+    if (d->contentHash.isEmpty()) {
+        out.append(static_cast<char>(HashEmpty));
+    } else if (hash.size() == 32 && QString::fromLatin1(hash.toHex()) == d->contentHash) {
+        out.append(static_cast<char>(HashSha256));
+        out.append(hash);
+    } else {
+        out.append(static_cast<char>(HashText));
+        writeBytes(out, d->contentHash.toUtf8());
+    }
+    return out;
+}
+
+ImageModel ImageModel::fromBinary(const QByteArray& data, bool* ok)
+{
+    if (ok) {
+        *ok = false;
+    }
+    if (binaryVersion(data) < 1) {
+        return ImageModel();
+    }
+
+    Data result;
+    BinaryReader reader(data.constData() + kHeaderSize, data.constData() + data.size());
+    qint64 uploadMs = 0;
+    quint64 tagCount = 0;
+    quint8 hashEncoding = HashEmpty;
+    bool valid = reader.readString(result.id)
+                 && reader.readString(result.filename)
+                 && reader.readString(result.mimeType)
+                 && reader.readInt(result.size)
+                 && reader.readInt64(uploadMs)
+                 && reader.readInt(result.width)
+                 && reader.readInt(result.height)
+                 && reader.readVarint(tagCount)
+                 && tagCount <= static_cast<quint64>(data.size());
+    for (quint64 i = 0; valid && i < tagCount; ++i) {
+        QString tag;
+        valid = reader.readString(tag);
+        result.tags.append(tag);
+    }
+    valid = valid && reader.readByte(hashEncoding);
+    if (valid && hashEncoding == HashSha256) {
+        const char* hash = nullptr;
+        valid = reader.readRaw(32, hash);
+        if (valid) {
+            result.contentHash = QString::fromLatin1(QByteArray::fromRawData(hash, 32).toHex());
+        }
+    } else if (valid && hashEncoding == HashText) {
+        valid = reader.readString(result.contentHash);
+    } else {
+        valid = valid && hashEncoding == HashEmpty;
+    }
+    // 更高版本追加的末尾字段忽略
+
+    if (!valid) {
+        qWarning() << "Corrupted binary ImageModel, version" << binaryVersion(data);
+        return ImageModel();
+    }
+    result.uploadTime = QDateTime::fromMSecsSinceEpoch(uploadMs);
+
+    ImageModel model;
+    model.d = std::make_shared<Data>(std::move(result));
+    if (ok) {
+        *ok = true;
+    }
+    return model;
+}
+
+int ImageModel::binaryVersion(const QByteArray& data)
+{
+    if (data.size() < kHeaderSize || std::memcmp(data.constData(), kBinaryMagic, sizeof(kBinaryMagic)) != 0) {
+        return -1;
+    }
+    return static_cast<quint8>(data.at(2));
+}
+
 // ============ 比较运算符 ============
 bool ImageModel::operator==(const ImageModel& other) const
 {
@@ -298,7 +521,8 @@ bool ImageModel::operator==(const ImageModel& other) const
            d->width == other.d->width &&
            d->height == other.d->height &&
            d->uploadTime == other.d->uploadTime &&
-           d->tags == other.d->tags;
+           d->tags == other.d->tags &&
+           d->contentHash == other.d->contentHash;
 }
 
 bool ImageModel::operator!=(const ImageModel& other) const
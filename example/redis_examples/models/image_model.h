@@ -34,6 +34,7 @@ public:
         int width;
         int height;
         QStringList tags;
+        QString contentHash;
 
         // Redis Hash field names
         static const QString FIELD_ID;
@@ -44,6 +45,7 @@ public:
         static const QString FIELD_WIDTH;
         static const QString FIELD_HEIGHT;
         static const QString FIELD_TAGS;
+        static const QString FIELD_CONTENT_HASH;
 
         Data();
         static Data fromVariantMap(const QVariantMap& map);
@@ -59,6 +61,7 @@ public:
     int getWidth() const { return d->width; }
     int getHeight() const { return d->height; }
     QStringList getTags() const { return d->tags; }
+    QString getContentHash() const { return d->contentHash; }
 
     // ============ Setters（带验证）============
     bool setId(const QString& id);
@@ -69,6 +72,7 @@ public:
     bool setWidth(int width);
     bool setHeight(int height);
     bool setTags(const QStringList& tags);
+    bool setContentHash(const QString& hash);
 
     // ============ Tag 管理 ============
     bool addTag(const QString& tag);
@@ -88,6 +92,31 @@ public:
     static ImageModel fromVariantMap(const QVariantMap& map);
     QVariantMap toVariantMap() const;
 
+    /**
+     * @brief 紧凑二进制编码
+     *
+     * 格式: "IM" + 版本号(1 字节) + 各字段; 整数为 varint, 上传时间为 8 字节小端毫秒时间戳,
+     * 字符串为 varint 长度 + UTF-8, 内容哈希为 32 字节原始 SHA-256
+     * 新版本只在末尾追加字段, 解码时忽略不认识的末尾字段
+     */
+    static constexpr quint8 BINARY_VERSION = 1;
+    QByteArray toBinary() const;
+
+    /**
+     * @brief 从紧凑二进制编码解码（不经过 QVariant）
+     * @param data 编码数据
+     * @param ok 是否成功，可为空
+     * @return ImageModel，失败返回空模型
+     */
+    static ImageModel fromBinary(const QByteArray& data, bool* ok = nullptr);
+
+    /**
+     * @brief 获取二进制编码的版本号
+     * @param data 编码数据
+     * @return 版本号，不是二进制编码时返回 -1
+     */
+    static int binaryVersion(const QByteArray& data);
+
     // ============ Redis 字段名访问器 ============
     static QString FIELD_ID() { return Data::FIELD_ID; }
     static QString FIELD_FILENAME() { return Data::FIELD_FILENAME; }
@@ -97,6 +126,7 @@ public:
     static QString FIELD_WIDTH() { return Data::FIELD_WIDTH; }
     static QString FIELD_HEIGHT() { return Data::FIELD_HEIGHT; }
     static QString FIELD_TAGS() { return Data::FIELD_TAGS; }
+    static QString FIELD_CONTENT_HASH() { return Data::FIELD_CONTENT_HASH; }
 
     // ============ 比较运算符 ============
     bool operator==(const ImageModel& other) const;
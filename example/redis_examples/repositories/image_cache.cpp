@@ -0,0 +1,185 @@
+#include "image_cache.h"
+#include <QMutexLocker>
+#include <QStringList>
+#include <exception>
+#include <limits>
+
+namespace {
+
+// QCache 的成本为 int
+int costOf(qint64 bytes)
+{
+    return static_cast<int>(qBound<qint64>(1, bytes, std::numeric_limits<int>::max()));
+}
+
+} // namespace
+
+ImageCache::ImageCache(qint64 maxBytes)
+    : m_cache(costOf(maxBytes))
+    , m_hits(0)
+    , m_misses(0)
+    , m_coalesced(0)
+    , m_generation(0)
+{
+}
+
+QImage ImageCache::get(const QString& id, const QSize& variant, const std::function<QImage()>& load)
+{
+    return get(id, QString(), variant, load);
+}
+
+QImage ImageCache::get(const QString& id, const QString& tag, const QSize& variant,
+                       const std::function<QImage()>& load)
+{
+    const QString key = cacheKey(id, tag, variant);
+    std::shared_ptr<Pending> pending;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (QImage* cached = m_cache.object(key)) {
+            m_hits++;
+            return *cached;
+        }
+
+        auto it = m_pending.find(key);
+        if (it != m_pending.end()) {
+            m_coalesced++;
+            std::shared_future<QImage> future = it.value()->future;
+            locker.unlock();
+            return future.get();
+        }
+
+        m_misses++;
+        pending = std::make_shared<Pending>();
+        pending->future = pending->promise.get_future().share();
+        m_pending.insert(key, pending);
+    }
+
+    // 读取与解码在锁外进行; 抛出异常时同样撤下等待项, 否则之后的请求会一直等待这次读取
+    QImage image;
+    try {
+        image = load();
+    } catch (...) {
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_pending.value(key) == pending) {
+                m_pending.remove(key);
+            }
+        }
+        pending->promise.set_exception(std::current_exception());
+        throw;
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!pending->stale && !image.isNull()) {
+            m_cache.insert(key, new QImage(image), costOf(image.sizeInBytes()));
+        }
+        if (m_pending.value(key) == pending) {
+            m_pending.remove(key);
+        }
+    }
+    pending->promise.set_value(image);
+    return image;
+}
+
+QImage ImageCache::find(const QString& id, const QSize& variant)
+{
+    QMutexLocker locker(&m_mutex);
+    if (QImage* cached = m_cache.object(cacheKey(id, QString(), variant))) {
+        m_hits++;
+        return *cached;
+    }
+    m_misses++;
+    return QImage();
+}
+
+quint64 ImageCache::generation() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_generation;
+}
+
+void ImageCache::insert(const QString& id, const QSize& variant, const QImage& image, quint64 generation)
+{
+    if (image.isNull()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    // 不记录每张图片的失效, 读取期间任意图片失效都放弃写入, 代价只是之后多一次未命中
+    if (generation != m_generation) {
+        return;
+    }
+    m_cache.insert(cacheKey(id, QString(), variant), new QImage(image), costOf(image.sizeInBytes()));
+}
+
+void ImageCache::invalidate(const QString& id)
+{
+    const QString prefix = keyPrefix(id);
+    QMutexLocker locker(&m_mutex);
+    m_generation++;
+
+    const QList<QString> keys = m_cache.keys();
+    for (const QString& key : keys) {
+        if (key.startsWith(prefix)) {
+            m_cache.remove(key);
+        }
+    }
+
+    // 正在读取的旧数据不写入缓存, 之后的请求重新读取
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it.key().startsWith(prefix)) {
+            it.value()->stale = true;
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ImageCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_generation++;
+    m_cache.clear();
+    for (const auto& pending : m_pending) {
+        pending->stale = true;
+    }
+    m_pending.clear();
+}
+
+void ImageCache::setMaxBytes(qint64 maxBytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.setMaxCost(costOf(maxBytes));
+}
+
+ImageCacheStats ImageCache::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    ImageCacheStats result;
+    result.hits = m_hits;
+    result.misses = m_misses;
+    result.coalesced = m_coalesced;
+    result.count = m_cache.count();
+    result.bytes = m_cache.totalCost();
+    result.maxBytes = m_cache.maxCost();
+    return result;
+}
+
+QString ImageCache::cacheKey(const QString& id, const QString& tag, const QSize& variant)
+{
+    // 形式标记放在尺寸之前, 同一图片的所有键仍以 keyPrefix(id) 开头, invalidate 一并清除
+    QString key = keyPrefix(id);
+    if (!tag.isEmpty()) {
+        key += tag + ':';
+    }
+    if (variant.isValid()) {
+        key += QString("%1x%2").arg(variant.width()).arg(variant.height());
+    }
+    return key;
+}
+
+QString ImageCache::keyPrefix(const QString& id)
+{
+    // 图片ID为 UUID, 不含 '@'
+    return id + '@';
+}
@@ -0,0 +1,132 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <functional>
+#include <future>
+#include <memory>
+
+/**
+ * @brief 解码图片缓存统计
+ */
+struct ImageCacheStats
+{
+    qint64 hits = 0;
+    qint64 misses = 0;
+    // 等待其他线程正在进行的读取与解码, 未重复读取的请求数
+    qint64 coalesced = 0;
+    int count = 0;
+    qint64 bytes = 0;
+    qint64 maxBytes = 0;
+};
+
+/**
+ * @brief 进程内解码图片 LRU 缓存
+ *
+ * 以 (图片ID, 形式, 尺寸) 为键缓存解码后的 QImage, 按 QImage::sizeInBytes() 计入字节预算,
+ * 超出预算时淘汰最久未使用的图片; 线程安全
+ * 同一个键同时只有一个线程执行读取与解码, 其余线程等待其结果
+ */
+class ImageCache
+{
+public:
+    explicit ImageCache(qint64 maxBytes = 64LL * 1024 * 1024);
+
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    /**
+     * @brief 获取图片, 未缓存时调用 load 读取并解码
+     * @param id 图片ID
+     * @param variant 尺寸, 无效尺寸表示原图
+     * @param load 读取并解码, 返回空图像时不缓存; 抛出的异常传给本次调用与等待中的调用, 之后的请求重新读取
+     * @return QImage
+     */
+    QImage get(const QString& id, const QSize& variant, const std::function<QImage()>& load);
+
+    /**
+     * @brief 获取同一图片的其他形式(如缩略图), 与 get(id, variant) 的同尺寸结果分开缓存
+     * @param id 图片ID
+     * @param tag 形式标记, 空字符串等同于 get(id, variant, load)
+     * @param variant 尺寸, 无效尺寸表示原尺寸
+     * @param load 读取并解码, 规则同 get(id, variant, load)
+     * @return QImage
+     */
+    QImage get(const QString& id, const QString& tag, const QSize& variant, const std::function<QImage()>& load);
+
+    /**
+     * @brief 只查找缓存, 不读取
+     * @param id 图片ID
+     * @param variant 尺寸, 无效尺寸表示原图
+     * @return 已缓存的 QImage，未缓存时返回空图像（计入未命中）
+     */
+    QImage find(const QString& id, const QSize& variant);
+
+    /**
+     * @brief 当前失效代数, 每次 invalidate/clear 加一
+     *
+     * 调用方自行读取前取得, 写入时交给 insert; 读取期间发生过失效时不写入
+     * @return 失效代数
+     */
+    quint64 generation() const;
+
+    /**
+     * @brief 写入由调用方读取并解码的图片
+     * @param id 图片ID
+     * @param variant 尺寸, 无效尺寸表示原图
+     * @param image 解码结果, 空图像不写入
+     * @param generation 读取数据之前取得的 generation(), 之后有过失效时不写入, 避免已删除图片的旧结果写回缓存
+     */
+    void insert(const QString& id, const QSize& variant, const QImage& image, quint64 generation);
+
+    /**
+     * @brief 使图片的所有尺寸与形式失效
+     *
+     * 正在进行的读取结果不再写入缓存
+     * @param id 图片ID
+     */
+    void invalidate(const QString& id);
+
+    /**
+     * @brief 清空缓存
+     */
+    void clear();
+
+    /**
+     * @brief 设置字节预算, 超出部分立即淘汰
+     * @param maxBytes 字节数
+     */
+    void setMaxBytes(qint64 maxBytes);
+
+    /**
+     * @brief 获取统计信息
+     * @return 统计信息
+     */
+    ImageCacheStats stats() const;
+
+private:
+    struct Pending
+    {
+        std::promise<QImage> promise;
+        std::shared_future<QImage> future;
+        bool stale = false;
+    };
+
+    static QString cacheKey(const QString& id, const QString& tag, const QSize& variant);
+    static QString keyPrefix(const QString& id);
+
+    mutable QMutex m_mutex;
+    QCache<QString, QImage> m_cache;
+    QHash<QString, std::shared_ptr<Pending>> m_pending;
+    qint64 m_hits;
+    qint64 m_misses;
+    qint64 m_coalesced;
+    quint64 m_generation;
+};
+
+#endif // IMAGE_CACHE_H
@@ -0,0 +1,264 @@
+#include "image_pack_store.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+#include <QDebug>
+#include <QMutexLocker>
+#include <QHash>
+#include <algorithm>
+
+namespace {
+
+const QString kPackPrefix = QStringLiteral("pack-");
+const QString kPackSuffix = QStringLiteral(".dat");
+
+// 目录下已有的 pack 文件编号, 升序
+QList<int> listPacks(const QString& directory)
+{
+    QList<int> packs;
+    const QStringList names = QDir(directory).entryList({kPackPrefix + "*" + kPackSuffix}, QDir::Files);
+    for (const QString& name : names) {
+        bool ok = false;
+        int pack = name.mid(kPackPrefix.size(), name.size() - kPackPrefix.size() - kPackSuffix.size()).toInt(&ok);
+        if (ok && pack >= 0) {
+            packs.append(pack);
+        }
+    }
+    std::sort(packs.begin(), packs.end());
+    return packs;
+}
+
+} // namespace
+
+// ============ ImagePackLocator ============
+
+QString ImagePackLocator::toString() const
+{
+    return QString("%1:%2:%3").arg(pack).arg(offset).arg(length);
+}
+
+ImagePackLocator ImagePackLocator::fromString(const QString& text)
+{
+    ImagePackLocator locator;
+    const QStringList parts = text.split(':');
+    if (parts.size() != 3) {
+        return locator;
+    }
+    bool packOk = false, offsetOk = false, lengthOk = false;
+    locator.pack = parts[0].toInt(&packOk);
+    locator.offset = parts[1].toLongLong(&offsetOk);
+    locator.length = parts[2].toLongLong(&lengthOk);
+    if (!packOk || !offsetOk || !lengthOk) {
+        return ImagePackLocator();
+    }
+    return locator;
+}
+
+// ============ 构造函数与析构函数 ============
+
+ImagePackStore::ImagePackStore(const QString& directory, qint64 maxPackBytes)
+    : m_directory(directory)
+    , m_maxPackBytes(maxPackBytes)
+    , m_currentPack(0)
+{
+    QDir().mkpath(m_directory);
+
+    // 继续写入最后一个文件, 已写满时换新文件
+    const QList<int> packs = listPacks(m_directory);
+    int pack = packs.isEmpty() ? 0 : packs.last();
+    if (QFileInfo(packPath(pack)).size() >= m_maxPackBytes) {
+        ++pack;
+    }
+    openWriter(pack);
+}
+
+ImagePackStore::~ImagePackStore()
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto& entry : m_mapped) {
+        entry.second.file->unmap(entry.second.data);
+    }
+    m_mapped.clear();
+    m_writer.close();
+}
+
+// ============ 读写 ============
+
+ImagePackLocator ImagePackStore::append(const QByteArray& data)
+{
+    QMutexLocker locker(&m_mutex);
+    return appendLocked(data);
+}
+
+QByteArray ImagePackStore::read(const ImagePackLocator& locator)
+{
+    if (!locator.isValid()) {
+        return QByteArray();
+    }
+
+    QMutexLocker locker(&m_mutex);
+    const uchar* base = mapLocked(locator.pack, locator.offset + locator.length);
+    if (!base) {
+        return QByteArray();
+    }
+    return QByteArray(reinterpret_cast<const char*>(base + locator.offset), static_cast<int>(locator.length));
+}
+
+// ============ 压缩 ============
+
+ImagePackCompaction ImagePackStore::compact(const QMap<QString, ImagePackLocator>& live, double minLiveRatio)
+{
+    QMutexLocker locker(&m_mutex);
+    ImagePackCompaction result;
+
+    QHash<int, qint64> liveBytes;
+    for (const auto& locator : live) {
+        liveBytes[locator.pack] += locator.length;
+    }
+
+    // 复制存活数据可能换新文件, 只压缩开始时当前文件之前的文件; 当前文件中可能有 live 之后才写入的数据
+    const int startPack = m_currentPack;
+    for (int pack : listPacks(m_directory)) {
+        if (pack >= startPack) {
+            continue;
+        }
+        const qint64 size = QFileInfo(packPath(pack)).size();
+        const qint64 used = liveBytes.value(pack, 0);
+        if (size > 0 && static_cast<double>(used) / size >= minLiveRatio) {
+            continue;
+        }
+
+        // 存活数据复制到当前文件; 任一条复制失败时保留该文件
+        bool copied = true;
+        for (auto it = live.begin(); it != live.end() && copied; ++it) {
+            if (it.value().pack != pack) {
+                continue;
+            }
+            const uchar* base = mapLocked(pack, it.value().offset + it.value().length);
+            ImagePackLocator moved;
+            if (base) {
+                moved = appendLocked(QByteArray(reinterpret_cast<const char*>(base + it.value().offset),
+                                                static_cast<int>(it.value().length)));
+            }
+            copied = moved.isValid();
+            if (copied) {
+                result.moved.insert(it.key(), moved);
+            }
+        }
+        if (copied) {
+            result.reclaimablePacks.append(pack);
+            result.packReclaimedBytes.insert(pack, size - used);
+            result.reclaimedBytes += size - used;
+        } else {
+            qWarning() << "Failed to compact pack file:" << packPath(pack);
+        }
+    }
+
+    return result;
+}
+
+void ImagePackStore::removePacks(const QList<int>& packs)
+{
+    QMutexLocker locker(&m_mutex);
+    for (int pack : packs) {
+        if (pack == m_currentPack) {
+            continue;
+        }
+        unmapLocked(pack);
+        if (!QFile::remove(packPath(pack))) {
+            qWarning() << "Failed to remove pack file:" << packPath(pack);
+        }
+    }
+}
+
+qint64 ImagePackStore::diskUsage() const
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 total = 0;
+    for (int pack : listPacks(m_directory)) {
+        total += QFileInfo(packPath(pack)).size();
+    }
+    return total;
+}
+
+// ============ 内部辅助方法 ============
+
+QString ImagePackStore::packPath(int pack) const
+{
+    return QDir(m_directory).filePath(QString("%1%2%3").arg(kPackPrefix).arg(pack, 6, 10, QChar('0')).arg(kPackSuffix));
+}
+
+bool ImagePackStore::openWriter(int pack)
+{
+    m_writer.close();
+    m_writer.setFileName(packPath(pack));
+    m_currentPack = pack;
+    if (!m_writer.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "Failed to open pack file:" << m_writer.fileName();
+        return false;
+    }
+    return true;
+}
+
+ImagePackLocator ImagePackStore::appendLocked(const QByteArray& data)
+{
+    if (data.isEmpty()) {
+        return ImagePackLocator();
+    }
+    if (m_writer.size() > 0 && m_writer.size() + data.size() > m_maxPackBytes) {
+        openWriter(m_currentPack + 1);
+    }
+    if (!m_writer.isOpen()) {
+        return ImagePackLocator();
+    }
+
+    ImagePackLocator locator;
+    locator.pack = m_currentPack;
+    locator.offset = m_writer.size();
+    locator.length = data.size();
+
+    // 写入后立即 flush, 之后的内存映射才能看到这段数据
+    if (m_writer.write(data) != data.size() || !m_writer.flush()) {
+        qWarning() << "Failed to append to pack file:" << m_writer.fileName();
+        return ImagePackLocator();
+    }
+    return locator;
+}
+
+const uchar* ImagePackStore::mapLocked(int pack, qint64 end)
+{
+    auto it = m_mapped.find(pack);
+    if (it != m_mapped.end() && it->second.size >= end) {
+        return it->second.data;
+    }
+
+    // 未映射, 或文件在映射后继续增长
+    unmapLocked(pack);
+    MappedPack mapped;
+    mapped.file.reset(new QFile(packPath(pack)));
+    if (!mapped.file->open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    mapped.size = mapped.file->size();
+    if (mapped.size < end) {
+        return nullptr;
+    }
+    mapped.data = mapped.file->map(0, mapped.size);
+    if (!mapped.data) {
+        qWarning() << "Failed to map pack file:" << mapped.file->fileName();
+        return nullptr;
+    }
+    const uchar* data = mapped.data;
+    m_mapped.emplace(pack, std::move(mapped));
+    return data;
+}
+
+void ImagePackStore::unmapLocked(int pack)
+{
+    auto it = m_mapped.find(pack);
+    if (it == m_mapped.end()) {
+        return;
+    }
+    it->second.file->unmap(it->second.data);
+    m_mapped.erase(it);
+}
@@ -0,0 +1,122 @@
+#ifndef IMAGE_PACK_STORE_H
+#define IMAGE_PACK_STORE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QMap>
+#include <QList>
+#include <QMutex>
+#include <QFile>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @brief 图片数据在 pack 文件中的位置
+ *
+ * 以 "pack:offset:length" 字符串形式保存在 Redis 中
+ */
+struct ImagePackLocator
+{
+    int pack = -1;
+    qint64 offset = 0;
+    qint64 length = 0;
+
+    bool isValid() const { return pack >= 0 && offset >= 0 && length > 0; }
+    QString toString() const;
+    static ImagePackLocator fromString(const QString& text);
+};
+
+/**
+ * @brief 一次压缩的结果
+ *
+ * moved 为需要写回 Redis 的新位置, 写回完成后再调用 removePacks 删除 reclaimablePacks;
+ * 位置未能写回的文件应从 reclaimablePacks 中去掉并按 packReclaimedBytes 扣减 reclaimedBytes
+ */
+struct ImagePackCompaction
+{
+    QMap<QString, ImagePackLocator> moved;
+    QList<int> reclaimablePacks;
+    QMap<int, qint64> packReclaimedBytes;
+    qint64 reclaimedBytes = 0;
+};
+
+/**
+ * @brief 本地 pack 文件存储
+ *
+ * 冷数据追加写入目录下的 pack-NNNNNN.dat 文件, 单个文件达到 maxPackBytes 后换新文件;
+ * 读取通过 QFile::map 内存映射, 映射按文件缓存, 文件增长后重新映射
+ * 删除只发生在压缩时: 存活数据比例低的文件被整体复制到当前文件后删除
+ * pack 文件是本机文件, Redis 中的位置只对写入它的主机有效
+ */
+class ImagePackStore
+{
+public:
+    ImagePackStore(const QString& directory, qint64 maxPackBytes);
+    ~ImagePackStore();
+
+    ImagePackStore(const ImagePackStore&) = delete;
+    ImagePackStore& operator=(const ImagePackStore&) = delete;
+
+    /**
+     * @brief 追加一段数据
+     * @param data 数据
+     * @return 数据位置，失败返回无效位置
+     */
+    ImagePackLocator append(const QByteArray& data);
+
+    /**
+     * @brief 读取一段数据
+     * @param locator 数据位置
+     * @return 数据，文件不存在或越界时返回空 QByteArray
+     */
+    QByteArray read(const ImagePackLocator& locator);
+
+    /**
+     * @brief 压缩 pack 文件
+     *
+     * 统计各文件中存活数据的比例, 低于 minLiveRatio 的文件中存活数据复制到当前文件;
+     * 开始时正在写入的文件及之后的文件不参与压缩, 其中可能有 live 快照之后追加的数据
+     * @param live 内容哈希 -> 当前位置
+     * @param minLiveRatio 存活比例下限
+     * @return 压缩结果
+     */
+    ImagePackCompaction compact(const QMap<QString, ImagePackLocator>& live, double minLiveRatio = 0.5);
+
+    /**
+     * @brief 删除 pack 文件
+     * @param packs 文件编号
+     */
+    void removePacks(const QList<int>& packs);
+
+    /**
+     * @brief 所有 pack 文件占用的磁盘大小
+     * @return 字节数
+     */
+    qint64 diskUsage() const;
+
+    QString directory() const { return m_directory; }
+
+private:
+    struct MappedPack
+    {
+        std::unique_ptr<QFile> file;
+        uchar* data = nullptr;
+        qint64 size = 0;
+    };
+
+    QString packPath(int pack) const;
+    bool openWriter(int pack);
+    ImagePackLocator appendLocked(const QByteArray& data);
+    const uchar* mapLocked(int pack, qint64 end);
+    void unmapLocked(int pack);
+
+    QString m_directory;
+    qint64 m_maxPackBytes;
+
+    mutable QMutex m_mutex;
+    QFile m_writer;
+    int m_currentPack;
+    std::unordered_map<int, MappedPack> m_mapped;
+};
+
+#endif // IMAGE_PACK_STORE_H
@@ -7,44 +7,493 @@
 #include <QFile>
 #include <QDebug>
 #include <QSet>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFuture>
+#include <QtConcurrent>
+#include <QThread>
+#include <algorithm>
+
+namespace {
+
+// 内容存储: 热数据在 Redis 的 img:blob:<sha256>, 冷数据在本地 pack 文件, Redis 只保留位置
+// KEYS: 引用计数哈希, 数据键, 统计哈希, 冷数据位置哈希, 冷数据访问次数有序集合, 热数据最近访问时间有序集合
+// 引用计数/位置均以内容哈希为字段; 实际保存的数据大小累计在统计哈希的 stored_size 字段
+
+// ARGV: 内容哈希; 内容已存在(热或冷)时引用计数加一并返回新计数, 否则返回 0
+const QString kLinkBlobScript = QStringLiteral(R"(
+if redis.call('EXISTS', KEYS[2]) == 1 or redis.call('HEXISTS', KEYS[4], ARGV[1]) == 1 then
+    return redis.call('HINCRBY', KEYS[1], ARGV[1], 1)
+end
+return 0
+)");
+
+// ARGV: 内容哈希, 数据(冷数据为空), 数据字节数, pack 位置(热数据为空), 当前毫秒时间戳
+// 写入数据或位置(已被并发上传写入时保留原值)并增加引用计数, 返回新计数
+const QString kStoreBlobScript = QStringLiteral(R"(
+if redis.call('EXISTS', KEYS[2]) == 0 and redis.call('HEXISTS', KEYS[4], ARGV[1]) == 0 then
+    if ARGV[4] ~= '' then
+        redis.call('HSET', KEYS[4], ARGV[1], ARGV[4])
+    else
+        redis.call('SET', KEYS[2], ARGV[2])
+        redis.call('ZADD', KEYS[6], ARGV[5], ARGV[1])
+    end
+    redis.call('HINCRBY', KEYS[3], 'stored_size', ARGV[3])
+end
+return redis.call('HINCRBY', KEYS[1], ARGV[1], 1)
+)");
+
+// ARGV: 内容哈希, 数据字节数; 引用计数减一, 归零时删除数据/位置与访问记录, 返回剩余计数
+const QString kUnlinkBlobScript = QStringLiteral(R"(
+local refs = redis.call('HINCRBY', KEYS[1], ARGV[1], -1)
+if refs <= 0 then
+    redis.call('HDEL', KEYS[1], ARGV[1])
+    local removed = redis.call('DEL', KEYS[2]) + redis.call('HDEL', KEYS[4], ARGV[1])
+    redis.call('ZREM', KEYS[5], ARGV[1])
+    redis.call('ZREM', KEYS[6], ARGV[1])
+    if removed > 0 then
+        redis.call('HINCRBY', KEYS[3], 'stored_size', -tonumber(ARGV[2]))
+    end
+end
+return refs
+)");
+
+// ARGV: 内容哈希, 当前毫秒时间戳
+// 冷数据: 访问次数加一, 返回 {访问次数, 位置, ''}; 热数据: 记录访问时间, 返回 {'0', '', 数据}
+const QString kReadBlobScript = QStringLiteral(R"(
+local locator = redis.call('HGET', KEYS[4], ARGV[1])
+if locator then
+    return {tostring(redis.call('ZINCRBY', KEYS[5], 1, ARGV[1])), locator, ''}
+end
+local data = redis.call('GET', KEYS[2])
+if not data then
+    return {'0', '', ''}
+end
+redis.call('ZADD', KEYS[6], ARGV[2], ARGV[1])
+return {'0', '', data}
+)");
+
+// ARGV: 内容哈希, 数据, 读取时的位置, 当前毫秒时间戳; 位置未变化时把冷数据提升回 Redis
+const QString kPromoteBlobScript = QStringLiteral(R"(
+if redis.call('HGET', KEYS[4], ARGV[1]) ~= ARGV[3] then
+    return 0
+end
+redis.call('SET', KEYS[2], ARGV[2])
+redis.call('HDEL', KEYS[4], ARGV[1])
+redis.call('ZREM', KEYS[5], ARGV[1])
+redis.call('ZADD', KEYS[6], ARGV[4], ARGV[1])
+return 1
+)");
+
+// ARGV: 内容哈希, pack 位置; 热数据仍存在时改为冷数据, 访问次数从零开始
+const QString kDemoteBlobScript = QStringLiteral(R"(
+if redis.call('EXISTS', KEYS[2]) == 0 then
+    return 0
+end
+redis.call('HSET', KEYS[4], ARGV[1], ARGV[2])
+redis.call('DEL', KEYS[2])
+redis.call('ZREM', KEYS[5], ARGV[1])
+redis.call('ZREM', KEYS[6], ARGV[1])
+return 1
+)");
+
+// KEYS: 热数据最近访问时间有序集合; ARGV: 截止时间戳, 数量上限
+const QString kIdleBlobsScript = QStringLiteral(R"(
+return redis.call('ZRANGEBYSCORE', KEYS[1], '-inf', ARGV[1], 'LIMIT', 0, tonumber(ARGV[2]))
+)");
+
+// KEYS: 冷数据位置哈希; ARGV: 内容哈希, 原位置, 新位置; 压缩后位置未被并发修改时更新
+const QString kRelocateBlobScript = QStringLiteral(R"(
+if redis.call('HGET', KEYS[1], ARGV[1]) ~= ARGV[2] then
+    return 0
+end
+redis.call('HSET', KEYS[1], ARGV[1], ARGV[3])
+return 1
+)");
+
+// KEYS: 元数据键, 缩略图键, 已生成尺寸集合; ARGV: 编码后的缩略图, 尺寸, 过期秒数
+// 图片已删除时不写入, 避免后台生成的缩略图在 remove() 之后重新出现; 写入返回 1, 否则返回 0
+const QByteArray kStoreThumbnailScript = QByteArrayLiteral(R"(
+if redis.call('EXISTS', KEYS[1]) == 0 then
+    return 0
+end
+redis.call('SET', KEYS[2], ARGV[1], 'EX', ARGV[3])
+redis.call('SADD', KEYS[3], ARGV[2])
+redis.call('EXPIRE', KEYS[3], ARGV[3])
+return 1
+)");
+
+QString nowMsString()
+{
+    return QString::number(QDateTime::currentMSecsSinceEpoch());
+}
+
+// 二进制编码的元数据保存在 img:meta:<id> 的该字段中, 与逐字段格式的字段名不冲突
+const QByteArray kMetaBinaryField = QByteArrayLiteral("bin");
+
+// 逐字段格式的全部字段名, 写入二进制编码时据此删除旧字段
+const QVector<QByteArray>& metaFieldNames()
+{
+    static const QVector<QByteArray> names{
+        ImageModel::FIELD_ID().toUtf8(),
+        ImageModel::FIELD_FILENAME().toUtf8(),
+        ImageModel::FIELD_MIME_TYPE().toUtf8(),
+        ImageModel::FIELD_SIZE().toUtf8(),
+        ImageModel::FIELD_UPLOAD_TIME().toUtf8(),
+        ImageModel::FIELD_WIDTH().toUtf8(),
+        ImageModel::FIELD_HEIGHT().toUtf8(),
+        ImageModel::FIELD_TAGS().toUtf8(),
+        ImageModel::FIELD_CONTENT_HASH().toUtf8(),
+    };
+    return names;
+}
+
+} // namespace
 
 // ============ 构造函数与析构函数 ============
 
 ImageRepository::ImageRepository(RedisManager& redisManager)
     : m_redis(redisManager)
+    , m_inFlightBudget(64LL * 1024 * 1024)
+    , m_metadataEncoding(ImageMetadataEncoding::Fields)
 {
 }
 
 ImageRepository::~ImageRepository()
 {
+    // 后台生成缩略图的任务引用 this
+    m_thumbnailPool.waitForDone();
+    m_decodePool.waitForDone();
+}
+
+// ============ 冷热分层 ============
+
+void ImageRepository::setTierOptions(const ImageTierOptions& options)
+{
+    m_tier = options;
+    m_packs.reset();
+    if (!m_tier.packDirectory.isEmpty()) {
+        m_packs.reset(new ImagePackStore(m_tier.packDirectory, m_tier.maxPackBytes));
+    }
+}
+
+int ImageRepository::demoteIdle(int limit)
+{
+    if (!m_packs) {
+        return 0;
+    }
+
+    const QString cutoff = QString::number(QDateTime::currentMSecsSinceEpoch() - m_tier.idleMs);
+    QVector<QString> hashes = m_redis.evalStrings(kIdleBlobsScript, {keyBlobAccessTime()},
+                                                  {cutoff, QString::number(limit)});
+    int demoted = 0;
+    for (const QString& hash : hashes) {
+        QString hexData = m_redis.get(keyBlob(hash));
+        if (hexData.isEmpty()) {
+            continue;
+        }
+        // 先写入 pack 再切换位置; 切换失败时写入的数据在压缩时回收
+        ImagePackLocator locator = m_packs->append(QByteArray::fromHex(hexData.toLatin1()));
+        if (locator.isValid()
+            && m_redis.evalInteger(kDemoteBlobScript, blobKeys(hash), {hash, locator.toString()}) > 0) {
+            demoted++;
+        }
+    }
+
+    if (demoted > 0) {
+        qDebug() << "Demoted" << demoted << "idle image blobs to" << m_packs->directory();
+    }
+    return demoted;
+}
+
+qint64 ImageRepository::compactPacks(double minLiveRatio)
+{
+    if (!m_packs) {
+        return 0;
+    }
+
+    QMap<QString, ImagePackLocator> live;
+    const QMap<QString, QString> locators = m_redis.hGetAll(keyBlobLocators());
+    for (auto it = locators.begin(); it != locators.end(); ++it) {
+        ImagePackLocator locator = ImagePackLocator::fromString(it.value());
+        if (locator.isValid()) {
+            live.insert(it.key(), locator);
+        }
+    }
+
+    ImagePackCompaction compaction = m_packs->compact(live, minLiveRatio);
+    // 位置未被并发修改时更新; 返回 0 表示已被提升或删除, 旧位置不再被引用, 可以删除。
+    // 调用失败时不确定位置是否已写回, 旧文件必须保留, 复制出的数据在之后的压缩中回收
+    QSet<int> unconfirmed;
+    for (auto it = compaction.moved.begin(); it != compaction.moved.end(); ++it) {
+        const ImagePackLocator from = live.value(it.key());
+        m_redis.evalInteger(kRelocateBlobScript, {keyBlobLocators()},
+                            {it.key(), from.toString(), it.value().toString()});
+        if (m_redis.lastCallStatus() != RedisCallStatus::Ok) {
+            unconfirmed.insert(from.pack);
+        }
+    }
+    for (int pack : unconfirmed) {
+        compaction.reclaimablePacks.removeAll(pack);
+        compaction.reclaimedBytes -= compaction.packReclaimedBytes.value(pack);
+        qWarning() << "Keeping pack file" << pack << "after failed relocation";
+    }
+    // 位置全部写回后才删除旧文件
+    m_packs->removePacks(compaction.reclaimablePacks);
+
+    qDebug() << "Compacted" << compaction.reclaimablePacks.size() << "pack files, reclaimed"
+             << compaction.reclaimedBytes << "bytes";
+    return compaction.reclaimedBytes;
+}
+
+// ============ 元数据编码 ============
+
+void ImageRepository::setMetadataEncoding(ImageMetadataEncoding encoding)
+{
+    m_metadataEncoding = encoding;
+}
+
+int ImageRepository::migrateMetadata(int limit)
+{
+    int migrated = 0;
+    const QVector<QString> ids = m_redis.sMembers(keyAllIds());
+    for (const QString& id : ids) {
+        if (limit > 0 && migrated >= limit) {
+            break;
+        }
+
+        int version = -1;
+        ImageModel model = readBinaryMetadata(id, &version);
+        const bool binary = version >= 0;
+        const bool upToDate = m_metadataEncoding == ImageMetadataEncoding::Binary
+                                  ? binary && version == ImageModel::BINARY_VERSION
+                                  : !binary;
+        if (upToDate) {
+            continue;
+        }
+        if (!binary) {
+            model = findById(id);
+        }
+
+        if (!model.isValid()) {
+            qWarning() << "Skipping unreadable metadata:" << id;
+            continue;
+        }
+        if (saveMetadata(id, model)) {
+            migrated++;
+        }
+    }
+
+    qDebug() << "Migrated" << migrated << "metadata records";
+    return migrated;
+}
+
+// ============ 批量读取 ============
+
+void ImageRepository::setInFlightBudget(qint64 maxBytes)
+{
+    m_inFlightBudget = qMax<qint64>(1, maxBytes);
+}
+
+QList<QByteArray> ImageRepository::getImagesData(const QStringList& ids)
+{
+    QList<QByteArray> results;
+    results.reserve(ids.size());
+    for (int i = 0; i < ids.size(); ++i) {
+        results.append(QByteArray());
+    }
+
+    QVector<BlobRef> refs = resolveBlobs(ids);
+    QList<int> indexes;
+    for (int i = 0; i < ids.size(); ++i) {
+        if (refs[i].exists) {
+            indexes.append(i);
+        }
+    }
+
+    for (const QList<int>& batch : planBatches(indexes, refs)) {
+        QList<QByteArray> data = fetchBlobs(ids, refs, batch);
+        for (int i = 0; i < batch.size(); ++i) {
+            results[batch[i]] = data[i];
+        }
+    }
+    return results;
+}
+
+QList<QImage> ImageRepository::getImagesAsQImage(const QStringList& ids, const QSize& size,
+                                                 const ImageLoadProgress& progress)
+{
+    const int total = ids.size();
+    QList<QImage> results;
+    results.reserve(total);
+    for (int i = 0; i < total; ++i) {
+        results.append(QImage());
+    }
+
+    int completed = 0;
+    auto report = [&](int index) {
+        ++completed;
+        if (progress) {
+            progress(completed, total, index, results[index]);
+        }
+    };
+
+    // 已缓存的直接返回
+    QList<int> pending;
+    for (int i = 0; i < total; ++i) {
+        results[i] = m_imageCache.find(ids[i], size);
+        if (results[i].isNull()) {
+            pending.append(i);
+        } else {
+            report(i);
+        }
+    }
+    if (pending.isEmpty()) {
+        return results;
+    }
+
+    // 读取数据之前取得失效代数, 读取期间被删除或更新的图片不写回缓存
+    const quint64 generation = m_imageCache.generation();
+    QVector<BlobRef> refs = resolveBlobs(ids);
+    QList<int> fetchable;
+    for (int index : pending) {
+        if (refs[index].exists) {
+            fetchable.append(index);
+        } else {
+            report(index);
+        }
+    }
+
+    struct DecodeTask
+    {
+        int index;
+        qint64 bytes;
+        QFuture<QImage> future;
+    };
+    QList<DecodeTask> decoding;
+    qint64 inFlight = 0;
+    auto finishOldest = [&]() {
+        DecodeTask task = decoding.takeFirst();
+        results[task.index] = task.future.result();
+        inFlight -= task.bytes;
+        m_imageCache.insert(ids[task.index], size, results[task.index], generation);
+        report(task.index);
+    };
+
+    for (const QList<int>& batch : planBatches(fetchable, refs)) {
+        // 读取下一批前, 按提交顺序等待解码完成直到在途字节数回到预算内
+        qint64 batchBytes = 0;
+        for (int index : batch) {
+            batchBytes += refs[index].size;
+        }
+        while (!decoding.isEmpty() && inFlight + batchBytes > m_inFlightBudget) {
+            finishOldest();
+        }
+
+        QList<QByteArray> data = fetchBlobs(ids, refs, batch);
+        for (int i = 0; i < batch.size(); ++i) {
+            const QByteArray encoded = data[i];
+            inFlight += encoded.size();
+            decoding.append({batch[i], encoded.size(), QtConcurrent::run(&m_decodePool, [encoded, size]() {
+                return decodeScaled(encoded, size);
+            })});
+        }
+    }
+    while (!decoding.isEmpty()) {
+        finishOldest();
+    }
+
+    return results;
+}
+
+// ============ 缩略图 ============
+
+void ImageRepository::setThumbnailOptions(const ImageThumbnailOptions& options)
+{
+    m_thumbnailOptions = options;
+    m_thumbnailPool.setMaxThreadCount(options.maxThreads > 0 ? options.maxThreads : QThread::idealThreadCount());
+}
+
+QImage ImageRepository::getThumbnail(const QString& id, int maxSize)
+{
+    if (maxSize <= 0) {
+        return QImage();
+    }
+    return QtConcurrent::run(&m_thumbnailPool, [this, id, maxSize]() {
+        return cachedThumbnail(id, maxSize);
+    }).result();
+}
+
+QList<QImage> ImageRepository::getThumbnails(const QStringList& ids, int maxSize)
+{
+    QList<QImage> results;
+    if (maxSize <= 0) {
+        return results;
+    }
+
+    QList<QFuture<QImage>> futures;
+    for (const QString& id : ids) {
+        futures.append(QtConcurrent::run(&m_thumbnailPool, [this, id, maxSize]() {
+            return cachedThumbnail(id, maxSize);
+        }));
+    }
+    for (auto& future : futures) {
+        results.append(future.result());
+    }
+    return results;
+}
+
+// ============ 解码缓存 ============
+
+void ImageRepository::setImageCacheBudget(qint64 maxBytes)
+{
+    m_imageCache.setMaxBytes(maxBytes);
+}
+
+ImageCacheStats ImageRepository::imageCacheStats() const
+{
+    return m_imageCache.stats();
 }
 
 // ============ 增删改查 ============
 
 QString ImageRepository::create(const ImageModel& model, const QByteArray& imageData)
 {
-    if (imageData.isEmpty() || !model.isValid()) {
+    // 新图片的ID在保存时才分配, 按分配ID后的模型校验
+    ImageModel candidate = model;
+    candidate.setId(model.getId().isEmpty() ? QStringLiteral("new") : model.getId());
+    if (imageData.isEmpty() || !candidate.isValid()) {
         qWarning() << "Cannot create image: empty data or invalid model";
         return QString();
     }
 
-    QString id = generateId();
-
-    // 保存图片数据
-    QString dataKey = keyImageData(id);
-    if (!m_redis.set(dataKey, QString::fromLatin1(imageData.toHex()))) {
-        qWarning() << "Failed to save image data for ID:" << id;
+    // 相同内容已存在时只增加引用计数, 不再传输图片数据
+    QString hash = contentHash(imageData);
+    if (!linkBlob(hash) && !storeBlob(hash, imageData)) {
+        qWarning() << "Failed to save image data for hash:" << hash;
         return QString();
     }
 
+    QString id = createRecord(model, hash, imageData.size());
+    if (!id.isEmpty()) {
+        scheduleThumbnails(id, imageData);
+    }
+    return id;
+}
+
+QString ImageRepository::createRecord(const ImageModel& model, const QString& contentHash, qint64 size)
+{
+    QString id = generateId();
+
     // 准备并保存元数据
     ImageModel newModel = model;
     newModel.setId(id);
-    newModel.setSize(imageData.size());
+    newModel.setSize(size);
+    newModel.setContentHash(contentHash);
 
     if (!saveMetadata(id, newModel)) {
         qWarning() << "Failed to save metadata for ID:" << id;
-        m_redis.del(dataKey);
+        unlinkBlob(contentHash, size);
         return QString();
     }
 
@@ -55,7 +504,7 @@ QString ImageRepository::create(const ImageModel& model, const QByteArray& image
     addToGlobalSet(id);
 
     // 更新统计
-    updateStatistics(1, imageData.size());
+    updateStatistics(1, size);
 
     qDebug() << "Image created successfully:" << newModel.toString();
     return id;
@@ -63,12 +512,25 @@ QString ImageRepository::create(const ImageModel& model, const QByteArray& image
 
 ImageModel ImageRepository::findById(const QString& id)
 {
+    // 先按当前编码读取, 迁移期间两种编码的记录并存
+    if (m_metadataEncoding == ImageMetadataEncoding::Binary) {
+        int version = -1;
+        ImageModel model = readBinaryMetadata(id, &version);
+        if (version >= 0) {
+            return model;
+        }
+    }
+
     QString metaKey = keyImageMeta(id);
     QMap<QString, QString> fields = m_redis.hGetAll(metaKey);
 
     if (fields.isEmpty()) {
         return ImageModel();
     }
+    if (fields.contains(QString::fromLatin1(kMetaBinaryField))) {
+        // hGetAll 按 UTF-8 转换字段值, 二进制编码需重新读取原始字节
+        return readBinaryMetadata(id, nullptr);
+    }
 
     QVariantMap variantMap;
     for (auto it = fields.begin(); it != fields.end(); ++it) {
@@ -80,24 +542,71 @@ ImageModel ImageRepository::findById(const QString& id)
 
 QByteArray ImageRepository::getImageData(const QString& id)
 {
-    QString dataKey = keyImageData(id);
-    QString hexData = m_redis.get(dataKey);
-    
-    if (hexData.isEmpty()) {
-        qWarning() << "Failed to retrieve image data for ID:" << id;
-        return QByteArray();
+    // 未记录内容哈希的旧数据仍按图片ID存储
+    QString hash = readContentHash(id);
+    if (hash.isEmpty()) {
+        QString hexData = m_redis.get(keyImageData(id));
+        if (hexData.isEmpty()) {
+            qWarning() << "Failed to retrieve image data for ID:" << id;
+            return QByteArray();
+        }
+        return QByteArray::fromHex(hexData.toLatin1());
+    }
+
+    // 读取位置后 pack 文件可能恰好被压缩删除, 此时按新位置再读一次
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        QVector<QString> reply = m_redis.evalStrings(kReadBlobScript, blobKeys(hash), {hash, nowMsString()});
+        if (reply.size() != 3) {
+            break;
+        }
+        if (reply[1].isEmpty()) {
+            if (!reply[2].isEmpty()) {
+                return QByteArray::fromHex(reply[2].toLatin1());
+            }
+            break;
+        }
+
+        ImagePackLocator locator = ImagePackLocator::fromString(reply[1]);
+        QByteArray data = m_packs ? m_packs->read(locator) : QByteArray();
+        if (data.isEmpty()) {
+            continue;
+        }
+        // 经常访问的小图片回到 Redis; 超过大小阈值的始终留在 pack 中
+        if (m_tier.promoteHits > 0 && reply[0].toLongLong() >= m_tier.promoteHits
+            && data.size() < m_tier.spillSizeBytes) {
+            m_redis.evalInteger(kPromoteBlobScript, blobKeys(hash),
+                                {hash, QString::fromLatin1(data.toHex()), reply[1], nowMsString()});
+        }
+        return data;
     }
 
-    return QByteArray::fromHex(hexData.toLatin1());
+    qWarning() << "Failed to retrieve image data for ID:" << id;
+    return QByteArray();
+}
+
+QImage ImageRepository::getImageAsQImage(const QString& id, const QSize& size)
+{
+    return m_imageCache.get(id, size, [&]() {
+        QByteArray data = getImageData(id);
+        if (data.isEmpty()) {
+            return QImage();
+        }
+        return decodeScaled(data, size);
+    });
 }
 
-QImage ImageRepository::getImageAsQImage(const QString& id)
+QImage ImageRepository::getImageScaled(const QString& id, const QSize& targetSize, const QRect& clipRect)
 {
+    if (!clipRect.isValid()) {
+        return getImageAsQImage(id, targetSize);
+    }
+
+    // 裁剪结果不进入缓存
     QByteArray data = getImageData(id);
     if (data.isEmpty()) {
         return QImage();
     }
-    return QImage::fromData(data);
+    return decodeScaled(data, targetSize, clipRect);
 }
 
 bool ImageRepository::update(const ImageModel& model)
@@ -109,12 +618,18 @@ bool ImageRepository::update(const ImageModel& model)
 
     QString id = model.getId();
     ImageModel oldModel = findById(id);
+    m_imageCache.invalidate(id);
+
+    // 内容哈希与大小在上传时确定, 只改元数据的调用方不一定带上, 覆盖后 remove 将无法释放内容引用
+    ImageModel newModel = model;
+    newModel.setContentHash(oldModel.getContentHash());
+    newModel.setSize(oldModel.getSize());
     
     // 更新标签索引
-    updateTagIndex(id, oldModel.getTags(), model.getTags());
+    updateTagIndex(id, oldModel.getTags(), newModel.getTags());
 
     // 保存新元数据
-    return saveMetadata(id, model);
+    return saveMetadata(id, newModel);
 }
 
 bool ImageRepository::remove(const QString& id)
@@ -127,9 +642,16 @@ bool ImageRepository::remove(const QString& id)
     ImageModel model = findById(id);
     qint64 size = model.getSize();
 
-    // 删除数据
-    m_redis.del(keyImageData(id));
+    // 删除数据: 共享内容只释放引用, 最后一个引用释放时删除
+    if (model.getContentHash().isEmpty()) {
+        m_redis.del(keyImageData(id));
+    } else {
+        unlinkBlob(model.getContentHash(), size);
+    }
     m_redis.del(keyImageMeta(id));
+    m_redis.del(keyViewers(id));
+    removeThumbnails(id);
+    m_imageCache.invalidate(id);
 
     // 更新标签索引
     updateTagIndex(id, model.getTags(), QStringList());
@@ -291,6 +813,41 @@ bool ImageRepository::updateTags(const QString& id, const QStringList& tags)
     return saveMetadata(id, model);
 }
 
+// ============ 浏览统计 ============
+
+bool ImageRepository::recordView(const QString& id, const QString& viewerId)
+{
+    return m_redis.pfAdd(keyViewers(id), viewerId);
+}
+
+bool ImageRepository::recordViews(const QList<QPair<QString, QString>>& views)
+{
+    QVector<QPair<QString, QString>> keyElements;
+    keyElements.reserve(views.size());
+    for (const auto& view : views) {
+        keyElements.append(qMakePair(keyViewers(view.first), view.second));
+    }
+    return m_redis.pfAddEach(keyElements);
+}
+
+qint64 ImageRepository::uniqueViewers(const QString& id)
+{
+    return m_redis.pfCount(keyViewers(id));
+}
+
+qint64 ImageRepository::uniqueViewers(const QStringList& ids)
+{
+    if (ids.isEmpty()) {
+        return 0;
+    }
+    QVector<QString> keys;
+    keys.reserve(ids.size());
+    for (const QString& id : ids) {
+        keys.append(keyViewers(id));
+    }
+    return m_redis.pfCount(keys);
+}
+
 // ============ 统计与工具 ============
 
 int ImageRepository::count()
@@ -305,28 +862,48 @@ qint64 ImageRepository::getTotalSize()
     return sizeStr.isEmpty() ? 0 : sizeStr.toLongLong();
 }
 
+qint64 ImageRepository::getStoredSize()
+{
+    QString sizeStr = m_redis.hGet(keyStats(), "stored_size");
+    return sizeStr.isEmpty() ? 0 : sizeStr.toLongLong();
+}
+
+int ImageRepository::blobReferences(const QString& contentHash)
+{
+    QString refs = m_redis.hGet(keyBlobRefs(), contentHash);
+    return refs.isEmpty() ? 0 : refs.toInt();
+}
+
 QString ImageRepository::getStatistics()
 {
     int imageCount = count();
-    qint64 totalSize = getTotalSize();
-
-    QString sizeStr;
-    if (totalSize < 1024) {
-        sizeStr = QString("%1 B").arg(totalSize);
-    } else if (totalSize < 1024 * 1024) {
-        sizeStr = QString("%1 KB").arg(totalSize / 1024.0, 0, 'f', 2);
-    } else if (totalSize < 1024 * 1024 * 1024) {
-        sizeStr = QString("%1 MB").arg(totalSize / (1024.0 * 1024.0), 0, 'f', 2);
-    } else {
-        sizeStr = QString("%1 GB").arg(totalSize / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
-    }
 
-    return QString("Total Images: %1, Total Size: %2").arg(imageCount).arg(sizeStr);
+    auto formatSize = [](qint64 totalSize) {
+        if (totalSize < 1024) {
+            return QString("%1 B").arg(totalSize);
+        } else if (totalSize < 1024 * 1024) {
+            return QString("%1 KB").arg(totalSize / 1024.0, 0, 'f', 2);
+        } else if (totalSize < 1024 * 1024 * 1024) {
+            return QString("%1 MB").arg(totalSize / (1024.0 * 1024.0), 0, 'f', 2);
+        }
+        return QString("%1 GB").arg(totalSize / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+    };
+
+    QString statistics = QString("Total Images: %1, Total Size: %2, Stored Size: %3")
+                         .arg(imageCount)
+                         .arg(formatSize(getTotalSize()))
+                         .arg(formatSize(getStoredSize()));
+    if (m_packs) {
+        statistics += QString(", Cold Blobs: %1, Pack Files: %2")
+                      .arg(m_redis.hLen(keyBlobLocators()))
+                      .arg(formatSize(m_packs->diskUsage()));
+    }
+    return statistics;
 }
 
 bool ImageRepository::exists(const QString& id)
 {
-    return m_redis.exists(keyImageData(id));
+    return m_redis.exists(keyImageMeta(id));
 }
 
 bool ImageRepository::clearAll()
@@ -373,29 +950,48 @@ QString ImageRepository::uploadFromFile(const QString& filePath, const QStringLi
         return QString();
     }
 
-    QByteArray imageData = file.readAll();
-    file.close();
-
-    if (imageData.isEmpty()) {
+    if (file.size() == 0) {
         qWarning() << "File is empty:" << filePath;
         return QString();
     }
 
+    // 分块读取计算哈希, 不把整个文件读入内存
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    if (!hasher.addData(&file)) {
+        qWarning() << "Failed to read file:" << filePath;
+        return QString();
+    }
+    QString hash = QString::fromLatin1(hasher.result().toHex());
+
     QString mimeType = getMimeTypeFromExtension(fileInfo.suffix());
-    
-    // 尝试获取图片尺寸
-    QImage image = QImage::fromData(imageData);
-    int width = image.isNull() ? 0 : image.width();
-    int height = image.isNull() ? 0 : image.height();
+
+    // 尝试获取图片尺寸（只读取文件头）
+    QSize size = QImageReader(filePath).size();
 
     ImageModel model;
     model.setFilename(fileInfo.fileName());
     model.setMimeType(mimeType);
-    model.setWidth(width);
-    model.setHeight(height);
+    model.setWidth(size.isValid() ? size.width() : 0);
+    model.setHeight(size.isValid() ? size.height() : 0);
     model.setTags(tags);
 
-    return create(model, imageData);
+    // 重复上传只需一次哈希查找; 内容不存在时才读取并写入文件数据
+    QByteArray imageData;
+    if (!linkBlob(hash)) {
+        file.seek(0);
+        imageData = file.readAll();
+        if (imageData.size() != fileInfo.size() || !storeBlob(hash, imageData)) {
+            qWarning() << "Failed to save image data for file:" << filePath;
+            return QString();
+        }
+    }
+    file.close();
+
+    QString id = createRecord(model, hash, fileInfo.size());
+    if (!id.isEmpty()) {
+        scheduleThumbnails(id, imageData);
+    }
+    return id;
 }
 
 QString ImageRepository::uploadFromQImage(const QString& filename, const QImage& image,
@@ -458,20 +1054,339 @@ QString ImageRepository::keyStats() const
     return "img:stats";
 }
 
+QString ImageRepository::keyViewers(const QString& id) const
+{
+    return QString("img:viewers:%1").arg(id);
+}
+
+QString ImageRepository::keyBlob(const QString& contentHash) const
+{
+    return QString("img:blob:%1").arg(contentHash);
+}
+
+QString ImageRepository::keyThumbnail(const QString& id, int maxSize) const
+{
+    return QString("img:thumb:%1:%2").arg(id).arg(maxSize);
+}
+
+QString ImageRepository::keyThumbnailSizes(const QString& id) const
+{
+    return QString("img:thumb:%1:sizes").arg(id);
+}
+
+QString ImageRepository::keyBlobRefs() const
+{
+    return "img:blob:refs";
+}
+
+QString ImageRepository::keyBlobLocators() const
+{
+    return "img:blob:loc";
+}
+
+QString ImageRepository::keyBlobHits() const
+{
+    return "img:blob:hits";
+}
+
+QString ImageRepository::keyBlobAccessTime() const
+{
+    return "img:blob:atime";
+}
+
+QVector<QString> ImageRepository::blobKeys(const QString& contentHash) const
+{
+    return {keyBlobRefs(), keyBlob(contentHash), keyStats(), keyBlobLocators(), keyBlobHits(), keyBlobAccessTime()};
+}
+
+// ============ 内容存储 ============
+
+bool ImageRepository::linkBlob(const QString& contentHash)
+{
+    return m_redis.evalInteger(kLinkBlobScript, blobKeys(contentHash), {contentHash}) > 0;
+}
+
+bool ImageRepository::storeBlob(const QString& contentHash, const QByteArray& imageData)
+{
+    // 超过大小阈值的图片直接写入 pack 文件, Redis 只保存位置
+    if (m_packs && imageData.size() >= m_tier.spillSizeBytes) {
+        ImagePackLocator locator = m_packs->append(imageData);
+        if (locator.isValid()) {
+            return m_redis.evalInteger(kStoreBlobScript, blobKeys(contentHash),
+                                       {contentHash, QString(), QString::number(imageData.size()),
+                                        locator.toString(), nowMsString()}) > 0;
+        }
+        qWarning() << "Failed to spill image data to pack file, keeping it in Redis:" << contentHash;
+    }
+
+    return m_redis.evalInteger(kStoreBlobScript, blobKeys(contentHash),
+                               {contentHash, QString::fromLatin1(imageData.toHex()),
+                                QString::number(imageData.size()), QString(), nowMsString()}) > 0;
+}
+
+void ImageRepository::unlinkBlob(const QString& contentHash, qint64 size)
+{
+    m_redis.evalInteger(kUnlinkBlobScript, blobKeys(contentHash), {contentHash, QString::number(size)});
+}
+
+// ============ 缩略图 ============
+
+QImage ImageRepository::cachedThumbnail(const QString& id, int maxSize)
+{
+    // 缩略图是重新编码后的图像, 与同尺寸的 getImageAsQImage 解码结果分开缓存
+    return m_imageCache.get(id, QStringLiteral("thumb"), QSize(maxSize, maxSize), [&]() {
+        return loadThumbnail(id, maxSize);
+    });
+}
+
+QImage ImageRepository::loadThumbnail(const QString& id, int maxSize)
+{
+    QByteArray encoded = m_redis.bytesGet(keyThumbnail(id, maxSize));
+    if (!encoded.isEmpty()) {
+        QImage thumbnail = QImage::fromData(encoded);
+        if (!thumbnail.isNull()) {
+            return thumbnail;
+        }
+    }
+
+    // 首次访问: 由原图生成
+    QImage thumbnail = decodeScaled(getImageData(id), QSize(maxSize, maxSize));
+    if (thumbnail.isNull()) {
+        return QImage();
+    }
+    storeThumbnail(id, maxSize, thumbnail);
+    return thumbnail;
+}
+
+bool ImageRepository::storeThumbnail(const QString& id, int maxSize, const QImage& thumbnail)
+{
+    // 有透明通道的保存为 PNG, 否则保存为体积更小的 JPEG
+    QByteArray encoded;
+    QBuffer buffer(&encoded);
+    buffer.open(QIODevice::WriteOnly);
+    bool saved = thumbnail.hasAlphaChannel() ? thumbnail.save(&buffer, "PNG")
+                                             : thumbnail.save(&buffer, "JPEG", 85);
+    buffer.close();
+    if (!saved) {
+        qWarning() << "Failed to encode thumbnail for ID:" << id;
+        return false;
+    }
+
+    // 记录已生成的尺寸, 删除图片时据此删除全部缩略图; 与元数据是否存在的检查在同一脚本中原子执行
+    // 缩略图为二进制数据, 经流水线 EVAL 按字节传参
+    QVector<RedisPipelineReply> replies = m_redis.pipeline({
+        {"EVAL", kStoreThumbnailScript, "3",
+         keyImageMeta(id).toUtf8(), keyThumbnail(id, maxSize).toUtf8(), keyThumbnailSizes(id).toUtf8(),
+         encoded, QByteArray::number(maxSize), QByteArray::number(m_thumbnailOptions.ttlSeconds)},
+    });
+    if (replies.size() != 1 || replies.first().isError()) {
+        qWarning() << "Failed to store thumbnail for ID:" << id;
+        return false;
+    }
+    if (replies.first().integer == 0) {
+        qDebug() << "Image removed, thumbnail discarded for ID:" << id;
+        return false;
+    }
+    return true;
+}
+
+void ImageRepository::scheduleThumbnails(const QString& id, const QByteArray& imageData)
+{
+    if (m_thumbnailOptions.eagerSizes.isEmpty()) {
+        return;
+    }
+
+    // 按最大尺寸缩放解码一次, 各尺寸分别作为一个任务缩放、编码与写入
+    QtConcurrent::run(&m_thumbnailPool, [this, id, imageData]() {
+        const int largest = *std::max_element(m_thumbnailOptions.eagerSizes.begin(),
+                                              m_thumbnailOptions.eagerSizes.end());
+        QImage image = decodeScaled(imageData.isEmpty() ? getImageData(id) : imageData,
+                                    QSize(largest, largest));
+        if (image.isNull()) {
+            return;
+        }
+        for (int maxSize : m_thumbnailOptions.eagerSizes) {
+            QtConcurrent::run(&m_thumbnailPool, [this, id, image, maxSize]() {
+                storeThumbnail(id, maxSize,
+                               image.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+            });
+        }
+    });
+}
+
+void ImageRepository::removeThumbnails(const QString& id)
+{
+    QVector<QString> sizes = m_redis.sMembers(keyThumbnailSizes(id));
+    for (const QString& size : sizes) {
+        m_redis.del(keyThumbnail(id, size.toInt()));
+    }
+    m_redis.del(keyThumbnailSizes(id));
+}
+
+// ============ 批量读取 ============
+
+QVector<ImageRepository::BlobRef> ImageRepository::resolveBlobs(const QStringList& ids)
+{
+    QVector<BlobRef> refs(ids.size());
+    if (ids.isEmpty()) {
+        return refs;
+    }
+
+    const QByteArray hashField = ImageModel::FIELD_CONTENT_HASH().toUtf8();
+    const QByteArray sizeField = ImageModel::FIELD_SIZE().toUtf8();
+    // 每张图片读取两种编码的字段, 不论记录是哪种编码都只需一次往返
+    QVector<QVector<QByteArray>> commands;
+    commands.reserve(ids.size() * 3);
+    for (const QString& id : ids) {
+        const QByteArray metaKey = keyImageMeta(id).toUtf8();
+        commands.append({"HGET", metaKey, hashField});
+        commands.append({"HGET", metaKey, sizeField});
+        commands.append({"HGET", metaKey, kMetaBinaryField});
+    }
+
+    QVector<RedisPipelineReply> replies = m_redis.pipeline(commands);
+    if (replies.size() != commands.size()) {
+        qWarning() << "Failed to read metadata for" << ids.size() << "images";
+        return refs;
+    }
+    for (int i = 0; i < ids.size(); ++i) {
+        const RedisPipelineReply& binary = replies[3 * i + 2];
+        if (binary.type == RedisPipelineReply::Type::String) {
+            bool ok = false;
+            ImageModel model = ImageModel::fromBinary(binary.value, &ok);
+            refs[i].exists = ok;
+            refs[i].hash = model.getContentHash();
+            refs[i].size = model.getSize();
+            continue;
+        }
+        const RedisPipelineReply& size = replies[3 * i + 1];
+        refs[i].exists = size.type == RedisPipelineReply::Type::String;
+        refs[i].hash = QString::fromUtf8(replies[3 * i].value);
+        refs[i].size = size.value.toLongLong();
+    }
+    return refs;
+}
+
+QList<QList<int>> ImageRepository::planBatches(const QList<int>& indexes, const QVector<BlobRef>& refs) const
+{
+    QList<QList<int>> batches;
+    QList<int> batch;
+    qint64 batchBytes = 0;
+    for (int index : indexes) {
+        if (!batch.isEmpty() && batchBytes + refs[index].size > m_inFlightBudget) {
+            batches.append(batch);
+            batch.clear();
+            batchBytes = 0;
+        }
+        batch.append(index);
+        batchBytes += refs[index].size;
+    }
+    if (!batch.isEmpty()) {
+        batches.append(batch);
+    }
+    return batches;
+}
+
+QList<QByteArray> ImageRepository::fetchBlobs(const QStringList& ids, const QVector<BlobRef>& refs,
+                                              const QList<int>& batch)
+{
+    const QByteArray now = QByteArray::number(QDateTime::currentMSecsSinceEpoch());
+    const QByteArray accessKey = keyBlobAccessTime().toUtf8();
+    QVector<QVector<QByteArray>> commands;
+    QVector<int> getReply;
+    for (int index : batch) {
+        const BlobRef& ref = refs[index];
+        getReply.append(commands.size());
+        if (ref.hash.isEmpty()) {
+            commands.append({"GET", keyImageData(ids[index]).toUtf8()});
+        } else {
+            // 与单张读取一样记录热数据的访问时间; XX 不为冷数据或已删除的内容新增记录
+            commands.append({"GET", keyBlob(ref.hash).toUtf8()});
+            commands.append({"ZADD", accessKey, "XX", now, ref.hash.toUtf8()});
+        }
+    }
+
+    QVector<RedisPipelineReply> replies = m_redis.pipeline(commands);
+    const bool ok = replies.size() == commands.size();
+    QList<QByteArray> results;
+    for (int i = 0; i < batch.size(); ++i) {
+        const int index = batch[i];
+        if (ok && replies[getReply[i]].type == RedisPipelineReply::Type::String) {
+            results.append(QByteArray::fromHex(replies[getReply[i]].value));
+        } else if (!refs[index].hash.isEmpty()) {
+            // 冷数据在 Redis 中只有位置, 逐张读取
+            results.append(getImageData(ids[index]));
+        } else {
+            results.append(QByteArray());
+        }
+    }
+    return results;
+}
+
 // ============ 内部辅助方法 ============
 
-bool ImageRepository::saveMetadata(const QString& id, const ImageModel& model)
+ImageModel ImageRepository::readBinaryMetadata(const QString& id, int* version)
 {
-    QString metaKey = keyImageMeta(id);
-    QVariantMap variantMap = model.toVariantMap();
+    if (version) {
+        *version = -1;
+    }
+    QVector<RedisPipelineReply> replies = m_redis.pipeline({{"HGET", keyImageMeta(id).toUtf8(), kMetaBinaryField}});
+    if (replies.size() != 1 || replies[0].type != RedisPipelineReply::Type::String) {
+        return ImageModel();
+    }
+    if (version) {
+        *version = ImageModel::binaryVersion(replies[0].value);
+    }
+
+    bool ok = false;
+    ImageModel model = ImageModel::fromBinary(replies[0].value, &ok);
+    if (!ok) {
+        qWarning() << "Failed to decode binary metadata:" << id;
+    }
+    return model;
+}
+
+QString ImageRepository::readContentHash(const QString& id)
+{
+    const QByteArray metaKey = keyImageMeta(id).toUtf8();
+    QVector<RedisPipelineReply> replies = m_redis.pipeline({
+        {"HGET", metaKey, ImageModel::FIELD_CONTENT_HASH().toUtf8()},
+        {"HGET", metaKey, kMetaBinaryField},
+    });
+    if (replies.size() != 2) {
+        return QString();
+    }
+    if (replies[1].type == RedisPipelineReply::Type::String) {
+        return ImageModel::fromBinary(replies[1].value).getContentHash();
+    }
+    return QString::fromUtf8(replies[0].value);
+}
 
-    for (auto it = variantMap.begin(); it != variantMap.end(); ++it) {
-        if (!m_redis.hSet(metaKey, it.key(), it.value().toString())) {
-            qWarning() << "Failed to set field" << it.key() << "for metadata:" << id;
-            return false;
+bool ImageRepository::saveMetadata(const QString& id, const ImageModel& model)
+{
+    const QByteArray metaKey = keyImageMeta(id).toUtf8();
+
+    // 先写入当前编码, 再删除另一种编码的字段; 两种字段并存时读取以二进制字段为准,
+    // 中间状态读到的也是完整的一条记录
+    QVector<QByteArray> write{"HSET", metaKey};
+    QVector<QByteArray> drop{"HDEL", metaKey};
+    if (m_metadataEncoding == ImageMetadataEncoding::Binary) {
+        write << kMetaBinaryField << model.toBinary();
+        drop << metaFieldNames();
+    } else {
+        const QVariantMap variantMap = model.toVariantMap();
+        for (auto it = variantMap.begin(); it != variantMap.end(); ++it) {
+            write << it.key().toUtf8() << it.value().toString().toUtf8();
         }
+        drop << kMetaBinaryField;
     }
 
+    QVector<RedisPipelineReply> replies = m_redis.pipeline({write, drop});
+    if (replies.size() != 2 || replies[0].type == RedisPipelineReply::Type::Error
+        || replies[1].type == RedisPipelineReply::Type::Error) {
+        qWarning() << "Failed to save metadata:" << id;
+        return false;
+    }
     return true;
 }
 
@@ -521,6 +1436,39 @@ bool ImageRepository::updateStatistics(int countChange, qint64 sizeChange)
 
 // ============ 工具方法 ============
 
+QImage ImageRepository::decodeScaled(const QByteArray& imageData, const QSize& targetSize, const QRect& clipRect)
+{
+    QBuffer buffer;
+    buffer.setData(imageData);
+    if (imageData.isEmpty() || !buffer.open(QIODevice::ReadOnly)) {
+        return QImage();
+    }
+
+    QImageReader reader(&buffer);
+    QSize sourceSize = reader.size();
+    if (clipRect.isValid()) {
+        reader.setClipRect(clipRect);
+        sourceSize = clipRect.size();
+    }
+
+    // 只缩小不放大; 解码器在读取时直接按目标尺寸输出（JPEG 为 DCT 域缩放）
+    if (targetSize.isValid() && sourceSize.isValid()
+        && (sourceSize.width() > targetSize.width() || sourceSize.height() > targetSize.height())) {
+        reader.setScaledSize(sourceSize.scaled(targetSize, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Failed to decode image:" << reader.errorString();
+    }
+    return image;
+}
+
+QString ImageRepository::contentHash(const QByteArray& imageData)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(imageData, QCryptographicHash::Sha256).toHex());
+}
+
 QString ImageRepository::generateId()
 {
     return QUuid::createUuid().toString(QUuid::WithoutBraces);
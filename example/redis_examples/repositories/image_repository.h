@@ -4,12 +4,71 @@
 #include <QString>
 #include <QByteArray>
 #include <QImage>
+#include <QRect>
 #include <QStringList>
 #include <QList>
+#include <QVector>
+#include <QThreadPool>
+#include <memory>
+#include <functional>
 #include "../models/image_model.h"
+#include "image_pack_store.h"
+#include "image_cache.h"
 
 class RedisManager;
 
+/**
+ * @brief 批量加载进度回调
+ *
+ * 在调用线程中每完成一张图片调用一次; index 为图片在 ids 中的位置, 失败时 image 为空图像
+ */
+using ImageLoadProgress = std::function<void(int completed, int total, int index, const QImage& image)>;
+
+/**
+ * @brief 缩略图配置
+ */
+struct ImageThumbnailOptions
+{
+    // 上传时立即在后台生成的尺寸(最长边像素), 默认不预先生成; 其余尺寸在首次访问时生成
+    QList<int> eagerSizes;
+    // 缩略图在 Redis 中的过期时间
+    int ttlSeconds = 7 * 24 * 3600;
+    // 生成缩略图的工作线程数, 0 表示 CPU 核数
+    int maxThreads = 0;
+};
+
+/**
+ * @brief 元数据在 Redis 中的编码
+ *
+ * Fields: 每个属性一个哈希字段, 便于在 redis-cli 中查看
+ * Binary: ImageModel::toBinary 编码后保存在一个哈希字段中, 占用更少内存, 解码不经过 QVariant
+ * 读取时两种编码都能识别, 切换编码后可用 migrateMetadata 重写已有记录
+ */
+enum class ImageMetadataEncoding
+{
+    Fields,
+    Binary
+};
+
+/**
+ * @brief 图片数据冷热分层配置
+ *
+ * packDirectory 为空时不分层, 所有图片数据都保存在 Redis 中
+ */
+struct ImageTierOptions
+{
+    // 冷数据 pack 文件所在的本地目录
+    QString packDirectory;
+    // 达到该大小的图片上传时直接写入 pack 文件
+    qint64 spillSizeBytes = 1024 * 1024;
+    // demoteIdle 把超过该时间未访问的热数据移到 pack 文件
+    qint64 idleMs = 24LL * 3600 * 1000;
+    // 冷数据被访问达到该次数后回到 Redis, 0 表示不提升
+    int promoteHits = 3;
+    // 单个 pack 文件大小上限
+    qint64 maxPackBytes = 256LL * 1024 * 1024;
+};
+
 /**
  * @brief 图片仓库类
  *
@@ -22,10 +81,130 @@ public:
     explicit ImageRepository(RedisManager& redisManager);
     ~ImageRepository();
 
+    // ============ 冷热分层 ============
+
+    /**
+     * @brief 设置冷热分层配置
+     *
+     * 元数据与经常访问的图片数据留在 Redis; 大图片与长时间未访问的图片数据移到本地
+     * 追加写入的 pack 文件, 通过内存映射读取, Redis 中只保留其位置
+     * @param options 分层配置
+     */
+    void setTierOptions(const ImageTierOptions& options);
+
+    /**
+     * @brief 把超过 idleMs 未访问的热数据移到 pack 文件
+     * @param limit 本次最多处理的数量
+     * @return 移动的数量
+     */
+    int demoteIdle(int limit = 100);
+
+    /**
+     * @brief 压缩 pack 文件
+     *
+     * 存活数据比例低于 minLiveRatio 的 pack 文件中的存活数据复制到当前文件, 更新位置后删除旧文件
+     * @param minLiveRatio 存活比例下限
+     * @return 回收的字节数
+     */
+    qint64 compactPacks(double minLiveRatio = 0.5);
+
+    // ============ 元数据编码 ============
+
+    /**
+     * @brief 设置新写入元数据的编码
+     * @param encoding 编码
+     */
+    void setMetadataEncoding(ImageMetadataEncoding encoding);
+    ImageMetadataEncoding metadataEncoding() const { return m_metadataEncoding; }
+
+    /**
+     * @brief 按当前编码重写已有元数据
+     *
+     * 逐字段格式或较旧版本二进制格式的记录解码后按当前编码写回
+     * @param limit 本次最多重写的数量, 0 表示不限
+     * @return 重写的数量
+     */
+    int migrateMetadata(int limit = 0);
+
+    // ============ 批量读取 ============
+
+    /**
+     * @brief 设置批量读取的在途字节预算
+     *
+     * 按元数据中的图片大小分批读取, 已读取但尚未解码的数据不超过该预算(单张超过预算时单独一批)
+     * @param maxBytes 字节数
+     */
+    void setInFlightBudget(qint64 maxBytes);
+
+    /**
+     * @brief 批量获取图片二进制数据
+     *
+     * 一次流水线读取全部元数据, 再按在途字节预算分批以流水线读取数据; 冷数据逐张从 pack 文件读取
+     * @param ids 图片ID列表
+     * @return 与 ids 一一对应的数据列表，失败的位置为空 QByteArray
+     */
+    QList<QByteArray> getImagesData(const QStringList& ids);
+
+    /**
+     * @brief 批量获取图片并在线程池中并行解码
+     *
+     * 已缓存的图片直接返回; 其余按批读取, 每批提交到解码线程池, 在途字节超出预算时先等待之前的解码完成
+     * @param ids 图片ID列表
+     * @param size 缩放到该尺寸以内（解码时缩放），无效尺寸表示原图
+     * @param progress 每完成一张图片的回调
+     * @return 与 ids 一一对应的 QImage 列表，失败的位置为空图像
+     */
+    QList<QImage> getImagesAsQImage(const QStringList& ids, const QSize& size = QSize(),
+                                    const ImageLoadProgress& progress = ImageLoadProgress());
+
+    // ============ 缩略图 ============
+
+    /**
+     * @brief 设置缩略图配置
+     * @param options 缩略图配置
+     */
+    void setThumbnailOptions(const ImageThumbnailOptions& options);
+
+    /**
+     * @brief 获取缩略图
+     *
+     * 缩略图以编码后的字节保存在 img:thumb:<id>:<size> 并带过期时间, 不存在时在工作线程池中
+     * 由原图生成并写入(图片已删除时不写入); 解码结果缓存在进程内, 与同尺寸的 getImageAsQImage 结果互不混用
+     * @param id 图片ID
+     * @param maxSize 最长边像素
+     * @return QImage，失败返回空图像
+     */
+    QImage getThumbnail(const QString& id, int maxSize);
+
+    /**
+     * @brief 并行获取多张图片的缩略图
+     * @param ids 图片ID列表
+     * @param maxSize 最长边像素
+     * @return 与 ids 一一对应的 QImage 列表，失败的位置为空图像
+     */
+    QList<QImage> getThumbnails(const QStringList& ids, int maxSize);
+
+    // ============ 解码缓存 ============
+
+    /**
+     * @brief 设置解码图片缓存的字节预算（按 QImage::sizeInBytes() 计算）
+     * @param maxBytes 字节数，0 表示不缓存
+     */
+    void setImageCacheBudget(qint64 maxBytes);
+
+    /**
+     * @brief 获取解码图片缓存统计
+     * @return 统计信息
+     */
+    ImageCacheStats imageCacheStats() const;
+
     // ============ 增删改查 ============
     
     /**
      * @brief 创建图片（上传）
+     *
+     * 图片数据按内容哈希（SHA-256）存储: 相同内容只保存一份, 元数据记录引用该内容,
+     * 已存在的内容只增加引用计数而不再写入数据
      * @param model 图片元数据
      * @param imageData 图片二进制数据
      * @return 图片ID，失败返回空字符串
@@ -48,10 +227,25 @@ public:
     
     /**
      * @brief 获取图片作为 QImage
+     *
+     * 指定尺寸时在解码时缩放(见 getImageScaled); 解码结果按 (ID, 尺寸) 缓存在进程内, update/remove 时失效;
+     * 多个线程同时请求同一张图片时只读取并解码一次
+     * @param id 图片ID
+     * @param size 缩放到该尺寸以内（保持宽高比），无效尺寸表示原图
+     * @return QImage，失败返回空图像
+     */
+    QImage getImageAsQImage(const QString& id, const QSize& size = QSize());
+
+    /**
+     * @brief 按目标尺寸解码图片
+     *
+     * 通过 QImageReader::setScaledSize/setClipRect 在解码时缩放与裁剪, 不先解码出原尺寸像素
      * @param id 图片ID
+     * @param targetSize 缩放到该尺寸以内（保持宽高比，只缩小不放大）
+     * @param clipRect 原图坐标中的裁剪区域，无效时不裁剪；裁剪结果不缓存
      * @return QImage，失败返回空图像
      */
-    QImage getImageAsQImage(const QString& id);
+    QImage getImageScaled(const QString& id, const QSize& targetSize, const QRect& clipRect = QRect());
     
     /**
      * @brief 更新图片元数据
@@ -131,6 +325,40 @@ public:
      */
     bool updateTags(const QString& id, const QStringList& tags);
 
+    // ============ 浏览统计 ============
+
+    /**
+     * @brief 记录一次浏览
+     *
+     * 浏览者按图片以 HyperLogLog 去重计数, 每张图片至多占用 12KB,
+     * 不随浏览者数量增长（代价为约 0.81% 的估计误差）
+     * @param id 图片ID
+     * @param viewerId 浏览者ID
+     * @return 是否成功
+     */
+    bool recordView(const QString& id, const QString& viewerId);
+
+    /**
+     * @brief 批量记录浏览（一次往返）
+     * @param views (图片ID, 浏览者ID) 列表
+     * @return 是否成功
+     */
+    bool recordViews(const QList<QPair<QString, QString>>& views);
+
+    /**
+     * @brief 获取图片的去重浏览人数（估计值）
+     * @param id 图片ID
+     * @return 浏览人数
+     */
+    qint64 uniqueViewers(const QString& id);
+
+    /**
+     * @brief 获取多张图片合计的去重浏览人数（估计值，同一浏览者只计一次）
+     * @param ids 图片ID列表
+     * @return 浏览人数
+     */
+    qint64 uniqueViewers(const QStringList& ids);
+
     // ============ 统计与工具 ============
     
     /**
@@ -141,9 +369,39 @@ public:
     
     /**
      * @brief 获取总存储大小
-     * @return 总字节数
+     * @return 总字节数（按图片记录累计, 重复内容重复计算）
      */
     qint64 getTotalSize();
+
+    /**
+     * @brief 获取去重后实际保存的图片数据大小
+     * @return 总字节数
+     */
+    qint64 getStoredSize();
+
+    /**
+     * @brief 获取内容被多少条图片记录引用
+     * @param contentHash 内容哈希（十六进制 SHA-256）
+     * @return 引用数，内容不存在时返回 0
+     */
+    int blobReferences(const QString& contentHash);
+
+    /**
+     * @brief 计算图片数据的内容哈希
+     * @param imageData 图片二进制数据
+     * @return 十六进制 SHA-256
+     */
+    static QString contentHash(const QByteArray& imageData);
+
+    /**
+     * @brief 按目标尺寸解码图片数据
+     * @param imageData 编码后的图片数据
+     * @param targetSize 缩放到该尺寸以内，无效尺寸表示原图
+     * @param clipRect 原图坐标中的裁剪区域，无效时不裁剪
+     * @return QImage，失败返回空图像
+     */
+    static QImage decodeScaled(const QByteArray& imageData, const QSize& targetSize,
+                               const QRect& clipRect = QRect());
     
     /**
      * @brief 获取统计信息字符串
@@ -196,6 +454,14 @@ public:
 
 private:
     RedisManager& m_redis;
+    ImageTierOptions m_tier;
+    std::unique_ptr<ImagePackStore> m_packs;
+    ImageCache m_imageCache;
+    ImageThumbnailOptions m_thumbnailOptions;
+    QThreadPool m_thumbnailPool;
+    qint64 m_inFlightBudget;
+    QThreadPool m_decodePool;
+    ImageMetadataEncoding m_metadataEncoding;
 
     // Redis key 生成
     QString keyImageData(const QString& id) const;
@@ -203,6 +469,43 @@ private:
     QString keyTagIndex(const QString& tag) const;
     QString keyAllIds() const;
     QString keyStats() const;
+    QString keyViewers(const QString& id) const;
+    QString keyBlob(const QString& contentHash) const;
+    QString keyThumbnail(const QString& id, int maxSize) const;
+    QString keyThumbnailSizes(const QString& id) const;
+    QString keyBlobRefs() const;
+    QString keyBlobLocators() const;
+    QString keyBlobHits() const;
+    QString keyBlobAccessTime() const;
+    QVector<QString> blobKeys(const QString& contentHash) const;
+
+    // 内容存储: 引用已有内容 / 写入新内容 / 释放引用, 均为单条 Lua 脚本; 新内容按大小写入 Redis 或 pack 文件
+    bool linkBlob(const QString& contentHash);
+    bool storeBlob(const QString& contentHash, const QByteArray& imageData);
+    void unlinkBlob(const QString& contentHash, qint64 size);
+    QString createRecord(const ImageModel& model, const QString& contentHash, qint64 size);
+
+    // 批量读取: 元数据中的内容哈希与大小, 按预算分批, 一批数据一次流水线读取
+    struct BlobRef
+    {
+        bool exists = false;
+        QString hash;
+        qint64 size = 0;
+    };
+    QVector<BlobRef> resolveBlobs(const QStringList& ids);
+    QList<QList<int>> planBatches(const QList<int>& indexes, const QVector<BlobRef>& refs) const;
+    QList<QByteArray> fetchBlobs(const QStringList& ids, const QVector<BlobRef>& refs, const QList<int>& batch);
+
+    // 缩略图: 读取或生成, 编码写入 Redis, 上传后在线程池中预生成(imageData 为空时从 Redis 读取原图)
+    QImage loadThumbnail(const QString& id, int maxSize);
+    QImage cachedThumbnail(const QString& id, int maxSize);
+    bool storeThumbnail(const QString& id, int maxSize, const QImage& thumbnail);
+    void scheduleThumbnails(const QString& id, const QByteArray& imageData);
+    void removeThumbnails(const QString& id);
+
+    // 元数据: 读取二进制编码字段(version 为编码版本, 字段不存在时为 -1), 读取内容哈希
+    ImageModel readBinaryMetadata(const QString& id, int* version);
+    QString readContentHash(const QString& id);
 
     // 内部辅助方法
     bool saveMetadata(const QString& id, const ImageModel& model);
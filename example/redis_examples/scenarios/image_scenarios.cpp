@@ -5,6 +5,7 @@
 #include <QImage>
 #include <QPainter>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QTextStream>
 #include <iostream>
 
@@ -287,6 +288,13 @@ void ImageScenarios::listAllImages(ImageRepository& repo)
 
     qDebug() << "共找到" << images.size() << "张图片:";
     qDebug() << "";
+
+    // 列表只需要预览图, 并行获取缩略图而不是下载原图
+    QStringList ids;
+    for (const auto& model : images) {
+        ids << model.getId();
+    }
+    QList<QImage> thumbnails = repo.getThumbnails(ids, 128);
     
     for (int i = 0; i < images.size(); ++i) {
         const ImageModel& model = images[i];
@@ -296,6 +304,8 @@ void ImageScenarios::listAllImages(ImageRepository& repo)
         qDebug() << "    类型:" << model.getMimeType();
         qDebug() << "    大小:" << model.getSizeFormatted();
         qDebug() << "    尺寸:" << model.getDimensionsString();
+        qDebug() << "    缩略图:" << (thumbnails[i].isNull() ? QString("无")
+                                   : QString("%1x%2").arg(thumbnails[i].width()).arg(thumbnails[i].height()));
         qDebug() << "    标签:" << model.getTags().join(", ");
         qDebug() << "    上传时间:" << model.getUploadTime().toString("yyyy-MM-dd hh:mm:ss");
         qDebug() << "";
@@ -608,6 +618,15 @@ void ImageScenarios::showStatistics(ImageRepository& repo)
     printHeader("场景：统计信息");
 
     qDebug() << repo.getStatistics();
+
+    ImageCacheStats cache = repo.imageCacheStats();
+    qDebug() << QString("解码缓存: %1 张, %2 / %3 KB, 命中 %4, 未命中 %5, 合并请求 %6")
+                .arg(cache.count)
+                .arg(cache.bytes / 1024)
+                .arg(cache.maxBytes / 1024)
+                .arg(cache.hits)
+                .arg(cache.misses)
+                .arg(cache.coalesced);
     
     int count = repo.count();
     if (count > 0) {
@@ -631,6 +650,109 @@ void ImageScenarios::showStatistics(ImageRepository& repo)
     waitForEnter();
 }
 
+void ImageScenarios::trackUniqueViews(ImageRepository& repo)
+{
+    printHeader("场景：去重浏览统计");
+
+    QList<ImageModel> images = repo.findAll();
+    if (images.isEmpty()) {
+        qDebug() << "当前没有图片，请先上传";
+        waitForEnter();
+        return;
+    }
+
+    int viewers = readInt("模拟浏览者数量", 1000);
+    viewers = qMax(1, viewers);
+
+    // 每个浏览者浏览前几张图片, 部分浏览者重复浏览, 重复浏览不增加计数
+    QList<QPair<QString, QString>> views;
+    for (int v = 0; v < viewers; ++v) {
+        QString viewerId = QString("viewer-%1").arg(v);
+        for (int i = 0; i <= v % images.size(); ++i) {
+            views.append(qMakePair(images[i].getId(), viewerId));
+            if (v % 3 == 0) {
+                views.append(qMakePair(images[i].getId(), viewerId));
+            }
+        }
+    }
+    if (!repo.recordViews(views)) {
+        qDebug() << "记录浏览失败";
+        waitForEnter();
+        return;
+    }
+    qDebug() << "已记录" << views.size() << "次浏览";
+
+    QStringList ids;
+    for (const auto& model : images) {
+        ids << model.getId();
+        qDebug() << QString("  %1 (%2): 约 %3 人浏览")
+                    .arg(model.getId().left(8))
+                    .arg(model.getFilename())
+                    .arg(repo.uniqueViewers(model.getId()));
+    }
+    qDebug() << "所有图片合计去重浏览人数: 约" << repo.uniqueViewers(ids) << "(实际" << viewers << ")";
+
+    waitForEnter();
+}
+
+void ImageScenarios::manageStorageTiers(ImageRepository& repo)
+{
+    printHeader("场景：冷热分层");
+
+    ImageTierOptions options;
+    options.packDirectory = QDir(QDir::tempPath()).filePath("redis_examples_packs");
+    options.idleMs = readInt("超过多少秒未访问的图片移到 pack 文件", 0) * 1000LL;
+    options.spillSizeBytes = readInt("上传时直接写入 pack 文件的大小阈值 (KB)", 1024) * 1024LL;
+    repo.setTierOptions(options);
+    qDebug() << "pack 目录:" << options.packDirectory;
+
+    int demoted = repo.demoteIdle(readInt("本次最多移动的数量", 100));
+    qDebug() << "已移动" << demoted << "个图片数据到 pack 文件";
+
+    qint64 reclaimed = repo.compactPacks();
+    qDebug() << "压缩回收" << reclaimed << "字节";
+    qDebug() << repo.getStatistics();
+
+    waitForEnter();
+}
+
+void ImageScenarios::loadImagesInParallel(ImageRepository& repo)
+{
+    printHeader("场景：批量加载图片");
+
+    QStringList ids = repo.findIdsPaginated(0, readInt("加载数量", 50));
+    if (ids.isEmpty()) {
+        qDebug() << "当前没有图片，请先上传";
+        waitForEnter();
+        return;
+    }
+    int budgetMb = qMax(1, readInt("在途字节预算 (MB)", 64));
+    repo.setInFlightBudget(budgetMb * 1024LL * 1024);
+
+    // 逐张读取与批量读取的对比; 之前已解码缓存的原图在批量读取中直接返回
+    QElapsedTimer timer;
+    timer.start();
+    for (const QString& id : ids) {
+        QImage::fromData(repo.getImageData(id));
+    }
+    qint64 sequentialMs = timer.elapsed();
+
+    timer.restart();
+    QList<QImage> images = repo.getImagesAsQImage(ids, QSize(), [](int completed, int total, int, const QImage& image) {
+        qDebug() << QString("  [%1/%2] %3x%4").arg(completed).arg(total).arg(image.width()).arg(image.height());
+    });
+    qint64 parallelMs = timer.elapsed();
+
+    int loaded = 0;
+    for (const QImage& image : images) {
+        loaded += image.isNull() ? 0 : 1;
+    }
+    qDebug() << "成功加载" << loaded << "/" << ids.size() << "张";
+    qDebug() << "逐张读取并解码:" << sequentialMs << "ms, 批量读取并行解码:" << parallelMs << "ms";
+
+    waitForEnter();
+}
+
 // ============ 完整工作流场景 ============
 
 void ImageScenarios::completeWorkflow(ImageRepository& repo)
@@ -775,13 +897,16 @@ void ImageScenarios::browseWithPagination(ImageRepository& repo)
 
         printHeader(QString("第 %1/%2 页 (共 %3 张图片)").arg(currentPage + 1).arg(totalPages).arg(totalCount));
 
+        QList<QImage> thumbnails = repo.getThumbnails(pageIds, 64);
         for (int i = 0; i < pageIds.size(); ++i) {
             ImageModel model = repo.findById(pageIds[i]);
-            qDebug() << QString("[%1] %2 - %3 (%4)")
+            qDebug() << QString("[%1] %2 - %3 (%4, 缩略图 %5x%6)")
                         .arg(offset + i + 1)
                         .arg(model.getId().left(8))
                         .arg(model.getFilename())
-                        .arg(model.getSizeFormatted());
+                        .arg(model.getSizeFormatted())
+                        .arg(thumbnails[i].width())
+                        .arg(thumbnails[i].height());
         }
 
         qDebug() << "";
@@ -128,6 +128,24 @@ public:
      */
     static void showStatistics(ImageRepository& repo);
 
+    /**
+     * @brief 场景：模拟浏览并统计去重浏览人数（HyperLogLog）
+     * @param repo 图片仓库
+     */
+    static void trackUniqueViews(ImageRepository& repo);
+
+    /**
+     * @brief 场景：冷热分层（冷数据移到本地 pack 文件并压缩）
+     * @param repo 图片仓库
+     */
+    static void manageStorageTiers(ImageRepository& repo);
+
+    /**
+     * @brief 场景：批量加载全部图片（流水线读取 + 线程池并行解码）
+     * @param repo 图片仓库
+     */
+    static void loadImagesInParallel(ImageRepository& repo);
+
     // ============ 完整工作流场景 ============
     
     /**
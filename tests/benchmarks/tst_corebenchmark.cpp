@@ -0,0 +1,204 @@
+/*
+ * 核心库与 Qt 接口的单次操作 CPU 开销对比
+ * 同一命令分别通过 um 核心库(std::string_view 入参, std::string 出参)
+ * 和 RedisManager(QString/QByteArray 入参出参)执行, 用进程 CPU 时间计算每次操作的客户端开销
+ *
+ * Qt 接口每次调用都会输出 qDebug 日志, 测量期间丢弃调试输出以免终端 I/O 掩盖转换开销,
+ * 日志格式化本身仍计入 Qt 接口的开销
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <um/client.hpp>
+#include "../fixtures/redistestfixture.h"
+
+namespace {
+
+QtMessageHandler previousHandler = nullptr;
+
+void dropDebugMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type != QtDebugMsg && previousHandler) {
+        previousHandler(type, context, message);
+    }
+}
+
+qint64 processCpuNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+struct Sample
+{
+    double cpuNsPerOp = 0.0;
+    double wallUsPerOp = 0.0;
+};
+
+Sample measure(int iterations, const std::function<void()> &operation)
+{
+    QElapsedTimer wall;
+    wall.start();
+    qint64 cpuStart = processCpuNs();
+    for (int i = 0; i < iterations; ++i) {
+        operation();
+    }
+    Sample sample;
+    sample.cpuNsPerOp = static_cast<double>(processCpuNs() - cpuStart) / iterations;
+    sample.wallUsPerOp = static_cast<double>(wall.nsecsElapsed()) / 1000.0 / iterations;
+    return sample;
+}
+
+} // namespace
+
+class CoreBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    CoreBenchmark() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void testCoreMatchesFacade();
+
+    void benchmarkCpuPerOp_data();
+    void benchmarkCpuPerOp();
+
+private:
+    RedisTestFixture *fixture_;
+    um::Client client_;
+    QString key_;
+
+    static constexpr int ITERATIONS = 20000;
+    static constexpr int WARMUP = 1000;
+    static constexpr int HASH_FIELDS = 100;
+};
+
+void CoreBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+    QVERIFY2(client_.connect(), client_.lastError().c_str());
+}
+
+void CoreBenchmark::cleanupTestCase()
+{
+    client_.disconnect();
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void CoreBenchmark::init()
+{
+    key_ = RedisTestFixture::generateUniqueKey("core");
+}
+
+void CoreBenchmark::cleanup()
+{
+    if (fixture_ && fixture_->manager()) {
+        fixture_->manager()->del(key_);
+    }
+}
+
+void CoreBenchmark::testCoreMatchesFacade()
+{
+    const std::string key = key_.toStdString();
+    RedisManager *manager = fixture_->manager();
+
+    // 非 ASCII 文本: Qt 接口写入, 核心库按 UTF-8 读出
+    const QString text = QString::fromUtf8("图片-缓存-✓");
+    QVERIFY(manager->set(key_, text));
+    um::OptionalString stored = client_.get(key);
+    QVERIFY(stored.has_value());
+    QCOMPARE(QString::fromUtf8(stored->data(), static_cast<int>(stored->size())), text);
+
+    // 二进制数据: 核心库写入(含 \0), Qt 接口按字节读出
+    const std::string binary("\x00\x01" "core" "\xff", 7);
+    QVERIFY(client_.setBytes(key, binary));
+    QCOMPARE(manager->bytesGet(key_), QByteArray(binary.data(), static_cast<int>(binary.size())));
+
+    QVERIFY(client_.del(key));
+    QVERIFY(!manager->exists(key_));
+    QVERIFY(!client_.get(key).has_value());
+}
+
+void CoreBenchmark::benchmarkCpuPerOp_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<int>("valueSize");
+    QTest::newRow("set_64B") << "set" << 64;
+    QTest::newRow("get_64B") << "get" << 64;
+    QTest::newRow("bytes_set_4KB") << "bytes_set" << 4096;
+    QTest::newRow("bytes_get_4KB") << "bytes_get" << 4096;
+    QTest::newRow("bytes_get_256KB") << "bytes_get" << 262144;
+    QTest::newRow("hgetall_100") << "hgetall" << 32;
+}
+
+void CoreBenchmark::benchmarkCpuPerOp()
+{
+    QFETCH(QString, operation);
+    QFETCH(int, valueSize);
+
+    RedisManager *manager = fixture_->manager();
+    const std::string key = key_.toStdString();
+    const std::string value(static_cast<std::size_t>(valueSize), 'v');
+    const QString qValue(valueSize, QLatin1Char('v'));
+    const QByteArray qBytes(valueSize, 'v');
+    um::StringOperations strings = client_.strings();
+    um::HashOperations hashes = client_.hashes();
+
+    std::function<void()> coreOp;
+    std::function<void()> qtOp;
+    if (operation == "set") {
+        coreOp = [&]() { strings.set(key, value); };
+        qtOp = [&]() { manager->set(key_, qValue); };
+    } else if (operation == "get") {
+        strings.set(key, value);
+        coreOp = [&]() { strings.get(key); };
+        qtOp = [&]() { manager->get(key_); };
+    } else if (operation == "bytes_set") {
+        coreOp = [&]() { strings.set(key, value); };
+        qtOp = [&]() { manager->bytesSet(key_, qBytes); };
+    } else if (operation == "bytes_get") {
+        strings.set(key, value);
+        coreOp = [&]() { strings.get(key); };
+        qtOp = [&]() { manager->bytesGet(key_); };
+    } else if (operation == "hgetall") {
+        for (int i = 0; i < HASH_FIELDS; ++i) {
+            hashes.hset(key, "field-" + std::to_string(i), value);
+        }
+        coreOp = [&]() { hashes.hgetall(key); };
+        qtOp = [&]() { manager->hGetAll(key_); };
+    }
+    QVERIFY(coreOp && qtOp);
+
+    const int iterations = valueSize > 65536 ? ITERATIONS / 10 : ITERATIONS;
+    Sample core;
+    Sample qt;
+    previousHandler = qInstallMessageHandler(dropDebugMessages);
+    QBENCHMARK_ONCE {
+        measure(WARMUP, coreOp);
+        measure(WARMUP, qtOp);
+        core = measure(iterations, coreOp);
+        qt = measure(iterations, qtOp);
+    }
+    qInstallMessageHandler(previousHandler);
+
+    qDebug() << "RESULT:" << operation << valueSize << "B"
+             << "core" << qRound64(core.cpuNsPerOp) << "ns cpu/op" << core.wallUsPerOp << "us wall/op,"
+             << "qt" << qRound64(qt.cpuNsPerOp) << "ns cpu/op" << qt.wallUsPerOp << "us wall/op,"
+             << "facade overhead" << qRound64(qt.cpuNsPerOp - core.cpuNsPerOp) << "ns/op";
+}
+
+QTEST_APPLESS_MAIN(CoreBenchmark)
+#include "tst_corebenchmark.moc"
@@ -0,0 +1,159 @@
+/*
+ * 过期操作基准测试
+ * 1. 10 ~ 1M 个成员的集合键上 EXPIRE/EXPIREAT/TTL/PERSIST 的吞吐与延迟分位(应与规模无关)
+ * 2. 不同值大小的字符串键上的 EXPIRE/TTL
+ * 结果写入 benchmark_results/expiration.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QDateTime>
+#include <QHash>
+#include <algorithm>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class ExpirationBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    ExpirationBenchmark() : fixture_(nullptr), reporter_("expiration") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkPointOps_data();
+    void benchmarkPointOps();
+    void benchmarkValueSize_data();
+    void benchmarkValueSize();
+
+private:
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QHash<qint64, QString> keys_;
+    QString valueKey_;
+
+    static constexpr int ITERATIONS = 2000;
+    static constexpr int PRELOAD_CHUNK = 10000;
+    static constexpr int EXPIRE_SECONDS = 3600;
+};
+
+void ExpirationBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        const QString key = RedisTestFixture::generateUniqueKey(QString("expire_%1").arg(cardinality));
+        for (qint64 offset = 0; offset < cardinality; offset += PRELOAD_CHUNK) {
+            QVector<QString> members;
+            for (qint64 i = offset; i < std::min(cardinality, offset + PRELOAD_CHUNK); ++i) {
+                members.append(QString("m-%1").arg(i));
+            }
+            QVERIFY(fixture_->manager()->sAdd(key, members));
+        }
+        keys_.insert(cardinality, key);
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    valueKey_ = RedisTestFixture::generateUniqueKey("expire_value");
+}
+
+void ExpirationBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+        fixture_->manager()->del(valueKey_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void ExpirationBenchmark::benchmarkPointOps_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"expire", "expireAt", "ttl", "persist"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                << QString(operation) << cardinality;
+        }
+    }
+}
+
+void ExpirationBenchmark::benchmarkPointOps()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    const qint64 expireAt = QDateTime::currentSecsSinceEpoch() + EXPIRE_SECONDS;
+
+    BenchmarkResult result;
+    QBENCHMARK_ONCE {
+        if (operation == "expire") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->expire(key, EXPIRE_SECONDS + i); });
+        } else if (operation == "expireAt") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->expireAt(key, expireAt + i); });
+        } else if (operation == "ttl") {
+            manager->expire(key, EXPIRE_SECONDS);
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int) { manager->ttl(key); });
+        } else if (operation == "persist") {
+            // 每次先设置过期时间, 使 PERSIST 总有过期时间可移除
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS, [&](int) {
+                manager->expire(key, EXPIRE_SECONDS);
+                manager->persist(key);
+            });
+        }
+    }
+    QVERIFY(result.iterations > 0);
+    // 恢复为永久键, 避免基准运行期间过期
+    manager->persist(key);
+    QCOMPARE(manager->ttl(key), -1);
+}
+
+void ExpirationBenchmark::benchmarkValueSize_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<int>("valueSize");
+    for (const char *operation : {"expire", "ttl"}) {
+        for (int valueSize : {16, 1024, 65536, 1048576}) {
+            QTest::newRow(qPrintable(QString("%1_%2B").arg(operation).arg(valueSize)))
+                << QString(operation) << valueSize;
+        }
+    }
+}
+
+void ExpirationBenchmark::benchmarkValueSize()
+{
+    QFETCH(QString, operation);
+    QFETCH(int, valueSize);
+    RedisManager *manager = fixture_->manager();
+    QVERIFY(manager->bytesSet(valueKey_, QByteArray(valueSize, 'v')));
+
+    QBENCHMARK_ONCE {
+        if (operation == "expire") {
+            reporter_.measure(operation, 1, valueSize, ITERATIONS,
+                              [&](int i) { manager->expire(valueKey_, EXPIRE_SECONDS + i); });
+        } else {
+            manager->expire(valueKey_, EXPIRE_SECONDS);
+            reporter_.measure(operation, 1, valueSize, ITERATIONS,
+                              [&](int) { manager->ttl(valueKey_); });
+        }
+    }
+    QVERIFY(manager->ttl(valueKey_) > 0);
+}
+
+QTEST_APPLESS_MAIN(ExpirationBenchmark)
+#include "tst_expirationbenchmark.moc"
@@ -0,0 +1,215 @@
+/*
+ * 键操作基准测试
+ * 1. 10 ~ 100k 个键的键空间上 EXISTS(命中/未命中) 与 KEYS 模式匹配的开销
+ * 2. DEL 不同规模集合(10 ~ 1M 个成员)的延迟, 大键删除会阻塞服务器
+ * 3. 不同值大小的字符串键上的 DEL
+ * 结果写入 benchmark_results/generic.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QHash>
+#include <algorithm>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class GenericBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    GenericBenchmark() : fixture_(nullptr), reporter_("generic") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkKeyspace_data();
+    void benchmarkKeyspace();
+    void benchmarkDelCollection_data();
+    void benchmarkDelCollection();
+    void benchmarkValueSize_data();
+    void benchmarkValueSize();
+
+private:
+    QString keyspaceKey(qint64 cardinality, qint64 index) const;
+    bool preloadSet(const QString &key, qint64 cardinality);
+
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QString prefix_;
+    QVector<qint64> keyspaces_;
+
+    static constexpr int ITERATIONS = 2000;
+    static constexpr int PRELOAD_CHUNK = 10000;
+    static constexpr qint64 KEYSPACE_LIMIT = 100000;
+};
+
+QString GenericBenchmark::keyspaceKey(qint64 cardinality, qint64 index) const
+{
+    return QString("%1:%2:%3").arg(prefix_).arg(cardinality).arg(index);
+}
+
+bool GenericBenchmark::preloadSet(const QString &key, qint64 cardinality)
+{
+    for (qint64 offset = 0; offset < cardinality; offset += PRELOAD_CHUNK) {
+        QVector<QString> members;
+        for (qint64 i = offset; i < std::min(cardinality, offset + PRELOAD_CHUNK); ++i) {
+            members.append(QString("m-%1").arg(i));
+        }
+        if (!fixture_->manager()->sAdd(key, members)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GenericBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+    prefix_ = RedisTestFixture::generateUniqueKey("generic");
+
+    // 每个规模使用独立前缀的字符串键, KEYS 只匹配对应规模的键
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        if (cardinality > KEYSPACE_LIMIT) {
+            continue;
+        }
+        for (qint64 i = 0; i < cardinality; ++i) {
+            QVERIFY(fixture_->manager()->set(keyspaceKey(cardinality, i), "v"));
+        }
+        keyspaces_.append(cardinality);
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+}
+
+void GenericBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        BenchmarkReporter::suppressDebugOutput(true);
+        for (qint64 cardinality : keyspaces_) {
+            for (qint64 i = 0; i < cardinality; ++i) {
+                fixture_->manager()->del(keyspaceKey(cardinality, i));
+            }
+        }
+        BenchmarkReporter::suppressDebugOutput(false);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void GenericBenchmark::benchmarkKeyspace_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"existsHit", "existsMiss", "keysPattern"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            if (cardinality <= KEYSPACE_LIMIT) {
+                QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                    << QString(operation) << cardinality;
+            }
+        }
+    }
+}
+
+void GenericBenchmark::benchmarkKeyspace()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+
+    int matched = 0;
+    QBENCHMARK_ONCE {
+        if (operation == "existsHit") {
+            reporter_.measure(operation, cardinality, 0, ITERATIONS, [&](int i) {
+                matched += manager->exists(keyspaceKey(cardinality, (static_cast<qint64>(i) * 7919) % cardinality));
+            });
+        } else if (operation == "existsMiss") {
+            reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                              [&](int i) { manager->exists(keyspaceKey(cardinality, cardinality + i)); });
+            matched = ITERATIONS;
+        } else {
+            // KEYS 遍历整个键空间, 与数据库中的总键数成正比
+            const int iterations = static_cast<int>(std::max<qint64>(5, std::min<qint64>(200, 200000 / cardinality)));
+            const QString pattern = QString("%1:%2:*").arg(prefix_).arg(cardinality);
+            reporter_.measure(operation, cardinality, 0, iterations,
+                              [&](int) { matched = manager->keys(pattern).size(); });
+            QCOMPARE(static_cast<qint64>(matched), cardinality);
+        }
+    }
+    QVERIFY(matched > 0);
+}
+
+void GenericBenchmark::benchmarkDelCollection_data()
+{
+    QTest::addColumn<qint64>("cardinality");
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        QTest::newRow(qPrintable(QString("delSet_%1").arg(cardinality))) << cardinality;
+    }
+}
+
+void GenericBenchmark::benchmarkDelCollection()
+{
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    // 每次迭代删除一个预先构建的集合, 构建时间不计入
+    const int iterations = cardinality >= 100000 ? 3 : 100;
+    QVector<QString> keys;
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (int i = 0; i < iterations; ++i) {
+        keys.append(QString("%1:del:%2:%3").arg(prefix_).arg(cardinality).arg(i));
+        QVERIFY(preloadSet(keys.last(), cardinality));
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+
+    QBENCHMARK_ONCE {
+        reporter_.measure("delSet", cardinality, 0, iterations, [&](int i) { manager->del(keys.at(i)); });
+    }
+    for (const auto &key : keys) {
+        QVERIFY(!manager->exists(key));
+    }
+}
+
+void GenericBenchmark::benchmarkValueSize_data()
+{
+    QTest::addColumn<int>("valueSize");
+    for (int valueSize : {16, 1024, 65536, 1048576}) {
+        QTest::newRow(qPrintable(QString("delString_%1B").arg(valueSize))) << valueSize;
+    }
+}
+
+void GenericBenchmark::benchmarkValueSize()
+{
+    QFETCH(int, valueSize);
+    RedisManager *manager = fixture_->manager();
+    const QByteArray value(valueSize, 'v');
+    const QString key = QString("%1:value:%2").arg(prefix_).arg(valueSize);
+    const int iterations = valueSize >= 1048576 ? ITERATIONS / 10 : ITERATIONS;
+
+    // 每次迭代先写入再删除, 只统计 DEL 的开销
+    QVector<qint64> latenciesNs;
+    latenciesNs.reserve(iterations);
+    qint64 elapsedNs = 0;
+    BenchmarkReporter::suppressDebugOutput(true);
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < iterations; ++i) {
+            manager->bytesSet(key, value);
+            QElapsedTimer timer;
+            timer.start();
+            manager->del(key);
+            latenciesNs.append(timer.nsecsElapsed());
+            elapsedNs += latenciesNs.last();
+        }
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    reporter_.record(BenchmarkReporter::summarize("delString", 1, valueSize, latenciesNs, elapsedNs));
+    QVERIFY(!manager->exists(key));
+}
+
+QTEST_APPLESS_MAIN(GenericBenchmark)
+#include "tst_genericbenchmark.moc"
@@ -0,0 +1,216 @@
+/*
+ * 哈希表基准测试
+ * 1. 10 ~ 1M 个字段的哈希表上 HSET/HGET/HEXISTS/HLEN/HDEL 的吞吐与延迟分位
+ * 2. 不同值大小下的 HSET/HGET
+ * 3. HGETALL/HKEYS 全量读取随字段数增长的开销
+ * 结果写入 benchmark_results/hash.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QHash>
+#include <QMap>
+#include <algorithm>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class HashBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    HashBenchmark() : fixture_(nullptr), reporter_("hash") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkPointOps_data();
+    void benchmarkPointOps();
+    void benchmarkValueSize_data();
+    void benchmarkValueSize();
+    void benchmarkFullRead_data();
+    void benchmarkFullRead();
+
+private:
+    static QString field(qint64 index) { return QString("f-%1").arg(index); }
+
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QHash<qint64, QString> keys_;
+    QString valueKey_;
+
+    static constexpr int ITERATIONS = 2000;
+    static constexpr int PRELOAD_CHUNK = 10000;
+    static constexpr int FIELD_VALUE_SIZE = 16;
+    static constexpr qint64 FULL_READ_LIMIT = 100000;
+};
+
+void HashBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    const QString value(FIELD_VALUE_SIZE, QLatin1Char('v'));
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        const QString key = RedisTestFixture::generateUniqueKey(QString("hash_%1").arg(cardinality));
+        for (qint64 offset = 0; offset < cardinality; offset += PRELOAD_CHUNK) {
+            QMap<QString, QString> fields;
+            for (qint64 i = offset; i < std::min(cardinality, offset + PRELOAD_CHUNK); ++i) {
+                fields.insert(field(i), value);
+            }
+            QVERIFY(fixture_->manager()->hSet(key, fields));
+        }
+        keys_.insert(cardinality, key);
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    for (auto it = keys_.constBegin(); it != keys_.constEnd(); ++it) {
+        QCOMPARE(static_cast<qint64>(fixture_->manager()->hLen(it.value())), it.key());
+    }
+    valueKey_ = RedisTestFixture::generateUniqueKey("hash_values");
+}
+
+void HashBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+        fixture_->manager()->del(valueKey_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void HashBenchmark::benchmarkPointOps_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"hSet", "hGet", "hExists", "hLen", "hDel"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                << QString(operation) << cardinality;
+        }
+    }
+}
+
+void HashBenchmark::benchmarkPointOps()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    const QString value(FIELD_VALUE_SIZE, QLatin1Char('u'));
+    // 按质数步长访问, 避免总是命中同一字段
+    auto fieldAt = [cardinality](int i) { return field((static_cast<qint64>(i) * 7919) % cardinality); };
+
+    BenchmarkResult result;
+    QBENCHMARK_ONCE {
+        if (operation == "hSet") {
+            result = reporter_.measure(operation, cardinality, FIELD_VALUE_SIZE, ITERATIONS,
+                                       [&](int i) { manager->hSet(key, fieldAt(i), value); });
+        } else if (operation == "hGet") {
+            result = reporter_.measure(operation, cardinality, FIELD_VALUE_SIZE, ITERATIONS,
+                                       [&](int i) { manager->hGet(key, fieldAt(i)); });
+        } else if (operation == "hExists") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->hExists(key, fieldAt(i)); });
+        } else if (operation == "hLen") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int) { manager->hLen(key); });
+        } else if (operation == "hDel") {
+            // 删除后补回, 保持字段数不变
+            const int count = static_cast<int>(std::min<qint64>(ITERATIONS, cardinality));
+            result = reporter_.measure(operation, cardinality, 0, count,
+                                       [&](int i) { manager->hDel(key, field(i)); });
+            QMap<QString, QString> restored;
+            for (int i = 0; i < count; ++i) {
+                restored.insert(field(i), value);
+            }
+            QVERIFY(manager->hSet(key, restored));
+        }
+    }
+    QVERIFY(result.iterations > 0);
+    QCOMPARE(static_cast<qint64>(manager->hLen(key)), cardinality);
+}
+
+void HashBenchmark::benchmarkValueSize_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<int>("valueSize");
+    for (const char *operation : {"hSet", "hGet"}) {
+        for (int valueSize : {16, 1024, 16384, 262144}) {
+            QTest::newRow(qPrintable(QString("%1_%2B").arg(operation).arg(valueSize)))
+                << QString(operation) << valueSize;
+        }
+    }
+}
+
+void HashBenchmark::benchmarkValueSize()
+{
+    QFETCH(QString, operation);
+    QFETCH(int, valueSize);
+    RedisManager *manager = fixture_->manager();
+    const QString value(valueSize, QLatin1Char('v'));
+    const int fieldCount = 100;
+    const int iterations = valueSize >= 262144 ? ITERATIONS / 10 : ITERATIONS;
+
+    for (int i = 0; i < fieldCount; ++i) {
+        manager->hSet(valueKey_, field(i), value);
+    }
+    BenchmarkResult result;
+    QBENCHMARK_ONCE {
+        if (operation == "hSet") {
+            result = reporter_.measure(operation, fieldCount, valueSize, iterations,
+                                       [&](int i) { manager->hSet(valueKey_, field(i % fieldCount), value); });
+        } else {
+            result = reporter_.measure(operation, fieldCount, valueSize, iterations,
+                                       [&](int i) { manager->hGet(valueKey_, field(i % fieldCount)); });
+        }
+    }
+    QCOMPARE(manager->hGet(valueKey_, field(0)).size(), valueSize);
+}
+
+void HashBenchmark::benchmarkFullRead_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"hGetAll", "hKeys"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            if (cardinality <= FULL_READ_LIMIT) {
+                QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                    << QString(operation) << cardinality;
+            }
+        }
+    }
+}
+
+void HashBenchmark::benchmarkFullRead()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    // 全量读取开销与字段数成正比, 按规模缩减迭代次数
+    const int iterations = static_cast<int>(std::max<qint64>(5, std::min<qint64>(ITERATIONS, 2000000 / cardinality)));
+
+    int lastSize = 0;
+    QBENCHMARK_ONCE {
+        if (operation == "hGetAll") {
+            reporter_.measure(operation, cardinality, FIELD_VALUE_SIZE, iterations,
+                              [&](int) { lastSize = manager->hGetAll(key).size(); });
+        } else {
+            reporter_.measure(operation, cardinality, 0, iterations,
+                              [&](int) { lastSize = manager->hKeys(key).size(); });
+        }
+    }
+    QCOMPARE(static_cast<qint64>(lastSize), cardinality);
+}
+
+QTEST_APPLESS_MAIN(HashBenchmark)
+#include "tst_hashbenchmark.moc"
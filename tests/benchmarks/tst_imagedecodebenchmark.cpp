@@ -0,0 +1,206 @@
+/*
+ * 图片缩放解码基准测试
+ * 1. QImageReader::setScaledSize/setClipRect 解码的尺寸正确: 保持宽高比, 只缩小不放大, 裁剪后再缩放
+ * 2. 24MP JPEG 生成 256px 预览: 全尺寸解码后缩放 与 解码时缩放 的耗时对比(内存数据 / 经 Redis 读取)
+ * 3. 两种方式的峰值 RSS 增量对比(Linux: /proc/self/status 的 VmHWM, 每次测量前经 clear_refs 重置)
+ * 结果写入 benchmark_results/imagedecode.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QFile>
+#include <QBuffer>
+#include <QImage>
+#include <functional>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+#include "../../example/redis_examples/repositories/image_repository.h"
+
+class ImageDecodeBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImageDecodeBenchmark() : fixture_(nullptr), repo_(nullptr), reporter_("imagedecode") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testScaledSize();
+    void benchmarkDecodeTime();
+    void benchmarkPeakRss();
+
+private:
+    static QImage fullDecode(const QByteArray &data);
+    static bool resetPeakRss();
+    static qint64 statusKb(const QByteArray &field);
+
+    RedisTestFixture *fixture_;
+    ImageRepository *repo_;
+    BenchmarkReporter reporter_;
+    QByteArray jpeg_;
+    QString id_;
+
+    // 24MP, 与常见相机原图相当
+    static constexpr int WIDTH = 6000;
+    static constexpr int HEIGHT = 4000;
+    static constexpr int PREVIEW = 256;
+    static constexpr int ITERATIONS = 10;
+};
+
+QImage ImageDecodeBenchmark::fullDecode(const QByteArray &data)
+{
+    // 改造前 getImageAsQImage 的做法: 解码出全部像素后再缩放
+    return QImage::fromData(data).scaled(PREVIEW, PREVIEW, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+bool ImageDecodeBenchmark::resetPeakRss()
+{
+    // 写入 5 把 VmHWM 重置为当前 RSS (Linux 4.0+)
+    QFile file("/proc/self/clear_refs");
+    return file.open(QIODevice::WriteOnly) && file.write("5") == 1;
+}
+
+qint64 ImageDecodeBenchmark::statusKb(const QByteArray &field)
+{
+    QFile file("/proc/self/status");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    for (const QByteArray &line : file.readAll().split('\n')) {
+        if (line.startsWith(field + ':')) {
+            return line.mid(field.size() + 1).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+
+void ImageDecodeBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    // 关闭解码缓存与上传时生成缩略图, 每次读取都实际解码
+    repo_ = new ImageRepository(*fixture_->manager());
+    repo_->setImageCacheBudget(0);
+    ImageThumbnailOptions thumbnails;
+    thumbnails.eagerSizes.clear();
+    repo_->setThumbnailOptions(thumbnails);
+
+    // 带噪声的渐变, 使 JPEG 大小接近真实照片
+    QImage image(WIDTH, HEIGHT, QImage::Format_RGB32);
+    quint32 seed = 12345;
+    for (int y = 0; y < HEIGHT; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < WIDTH; ++x) {
+            seed = seed * 1103515245 + 12345;
+            const int noise = (seed >> 16) & 0x1f;
+            line[x] = qRgb((x * 255 / WIDTH + noise) & 0xff, (y * 255 / HEIGHT + noise) & 0xff, ((x + y) / 32) & 0xff);
+        }
+    }
+    QBuffer buffer(&jpeg_);
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(image.save(&buffer, "JPEG", 90));
+    buffer.close();
+
+    ImageModel model;
+    model.setFilename("decode_benchmark.jpg");
+    model.setMimeType("image/jpeg");
+    model.setWidth(WIDTH);
+    model.setHeight(HEIGHT);
+    id_ = repo_->create(model, jpeg_);
+    QVERIFY(!id_.isEmpty());
+    qDebug() << "RESULT: source" << WIDTH << "x" << HEIGHT << "JPEG" << jpeg_.size() << "bytes";
+}
+
+void ImageDecodeBenchmark::cleanupTestCase()
+{
+    if (repo_ && !id_.isEmpty()) {
+        repo_->remove(id_);
+    }
+    delete repo_;
+    repo_ = nullptr;
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void ImageDecodeBenchmark::testScaledSize()
+{
+    // 保持宽高比缩小到目标尺寸以内
+    QImage preview = ImageRepository::decodeScaled(jpeg_, QSize(PREVIEW, PREVIEW));
+    QCOMPARE(preview.size(), QSize(PREVIEW, PREVIEW * HEIGHT / WIDTH));
+
+    // 不放大
+    QCOMPARE(ImageRepository::decodeScaled(jpeg_, QSize(WIDTH * 2, HEIGHT * 2)).size(), QSize(WIDTH, HEIGHT));
+    QCOMPARE(ImageRepository::decodeScaled(jpeg_, QSize()).size(), QSize(WIDTH, HEIGHT));
+
+    // 裁剪, 以及裁剪后再缩放
+    QCOMPARE(ImageRepository::decodeScaled(jpeg_, QSize(), QRect(100, 200, 600, 400)).size(), QSize(600, 400));
+    QCOMPARE(ImageRepository::decodeScaled(jpeg_, QSize(150, 150), QRect(100, 200, 600, 400)).size(),
+             QSize(150, 100));
+
+    // 经仓库读取
+    QCOMPARE(repo_->getImageScaled(id_, QSize(PREVIEW, PREVIEW)).size(), preview.size());
+    QCOMPARE(repo_->getImageScaled(id_, QSize(300, 300), QRect(0, 0, 1200, 1200)).size(), QSize(300, 300));
+    QCOMPARE(fullDecode(jpeg_).size(), preview.size());
+
+    QVERIFY(ImageRepository::decodeScaled(QByteArray("not an image"), QSize(PREVIEW, PREVIEW)).isNull());
+}
+
+void ImageDecodeBenchmark::benchmarkDecodeTime()
+{
+    const qint64 pixels = static_cast<qint64>(WIDTH) * HEIGHT;
+    const QSize target(PREVIEW, PREVIEW);
+
+    BenchmarkResult full = reporter_.measure("decodeFull", pixels, jpeg_.size(), ITERATIONS, [&](int) {
+        fullDecode(jpeg_);
+    });
+    BenchmarkResult scaled = reporter_.measure("decodeScaled", pixels, jpeg_.size(), ITERATIONS, [&](int) {
+        ImageRepository::decodeScaled(jpeg_, target);
+    });
+    BenchmarkResult getFull = reporter_.measure("getFullThenScale", pixels, jpeg_.size(), ITERATIONS, [&](int) {
+        fullDecode(repo_->getImageData(id_));
+    });
+    BenchmarkResult getScaled = reporter_.measure("getScaled", pixels, jpeg_.size(), ITERATIONS, [&](int) {
+        repo_->getImageScaled(id_, target);
+    });
+
+    qDebug() << "RESULT: decode p50" << full.p50Us / 1000 << "ms full," << scaled.p50Us / 1000 << "ms scaled;"
+             << "via Redis" << getFull.p50Us / 1000 << "ms full," << getScaled.p50Us / 1000 << "ms scaled";
+    QVERIFY2(scaled.p50Us < full.p50Us,
+             qPrintable(QString("scaled %1us, full %2us").arg(scaled.p50Us).arg(full.p50Us)));
+    QVERIFY(getScaled.p50Us < getFull.p50Us);
+}
+
+void ImageDecodeBenchmark::benchmarkPeakRss()
+{
+    if (!resetPeakRss() || statusKb("VmHWM") < 0) {
+        QSKIP("Peak RSS reset requires Linux /proc/self/clear_refs");
+    }
+
+    // 每种方式前重置峰值, 峰值减去开始时的 RSS 即解码期间的内存增量
+    auto peakDeltaKb = [](const std::function<QImage()> &decode) {
+        resetPeakRss();
+        const qint64 before = statusKb("VmRSS");
+        QImage image = decode();
+        const qint64 peak = statusKb("VmHWM");
+        return image.isNull() ? -1 : peak - before;
+    };
+
+    const qint64 fullKb = peakDeltaKb([&]() { return fullDecode(jpeg_); });
+    const qint64 scaledKb = peakDeltaKb([&]() { return ImageRepository::decodeScaled(jpeg_, QSize(PREVIEW, PREVIEW)); });
+
+    qDebug() << "RESULT: peak RSS delta" << fullKb << "KB full decode," << scaledKb << "KB scaled decode";
+    QVERIFY(fullKb > 0);
+    QVERIFY(scaledKb >= 0);
+    // 全尺寸 ARGB32 像素约 96MB, 缩放解码应远小于此
+    QVERIFY2(scaledKb * 4 < fullKb, qPrintable(QString("scaled %1 KB, full %2 KB").arg(scaledKb).arg(fullKb)));
+}
+
+QTEST_GUILESS_MAIN(ImageDecodeBenchmark)
+#include "tst_imagedecodebenchmark.moc"
@@ -0,0 +1,296 @@
+/*
+ * 图片元数据编码基准测试
+ * 1. ImageModel 二进制编码往返一致, 截断/非法数据解码失败, 更高版本追加的末尾字段被忽略
+ * 2. 逐字段格式与二进制格式互相迁移后记录不变, 图片数据与批量读取仍可用
+ * 3. 编码/解码吞吐(模型/秒): 逐字段格式(QVariantMap 与字符串转换) 与 二进制格式
+ * 4. 每条记录在 Redis 中的内存(MEMORY USAGE)与 findById 延迟
+ * 结果写入 benchmark_results/imagemetadata.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QBuffer>
+#include <QImage>
+#include <QCryptographicHash>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+#include "../../example/redis_examples/repositories/image_repository.h"
+
+class ImageMetadataBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImageMetadataBenchmark() : fixture_(nullptr), repo_(nullptr), reporter_("imagemetadata") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testBinaryRoundTrip();
+    void testMigration();
+    void benchmarkEncodeDecode();
+    void benchmarkRedisBytes();
+
+private:
+    static ImageModel sampleModel(int index);
+    static QString metaKey(const QString &id) { return "img:meta:" + id; }
+    qint64 memoryUsage(const QString &key);
+    qint64 totalMemoryUsage(const QStringList &ids);
+    QString createImage(const ImageModel &model);
+
+    RedisTestFixture *fixture_;
+    ImageRepository *repo_;
+    BenchmarkReporter reporter_;
+    QByteArray png_;
+    QList<ImageModel> models_;
+    QStringList ids_;
+
+    static constexpr int MODELS = 1000;
+    static constexpr int ROUNDS = 20;
+};
+
+ImageModel ImageMetadataBenchmark::sampleModel(int index)
+{
+    ImageModel model(QString("7f3c9a52-1d4e-4b8a-9c61-%1").arg(index, 12, 10, QChar('0')),
+                     QString("IMG_%1_假期照片.jpg").arg(index), "image/jpeg", 2400000 + index, 6000, 4000);
+    model.setUploadTime(QDateTime::fromMSecsSinceEpoch(1700000000000LL + index * 1000LL));
+    model.setTags({"travel", "2024", QString("album-%1").arg(index % 20)});
+    model.setContentHash(QString::fromLatin1(
+        QCryptographicHash::hash(QByteArray::number(index), QCryptographicHash::Sha256).toHex()));
+    return model;
+}
+
+qint64 ImageMetadataBenchmark::memoryUsage(const QString &key)
+{
+    QVector<RedisPipelineReply> replies = fixture_->manager()->pipeline(
+        {{"MEMORY", "USAGE", key.toUtf8(), "SAMPLES", "0"}});
+    return replies.isEmpty() ? -1 : replies.first().integer;
+}
+
+qint64 ImageMetadataBenchmark::totalMemoryUsage(const QStringList &ids)
+{
+    qint64 total = 0;
+    for (const QString &id : ids) {
+        total += memoryUsage(metaKey(id));
+    }
+    return total;
+}
+
+QString ImageMetadataBenchmark::createImage(const ImageModel &model)
+{
+    // 所有图片数据相同, 去重后只保存一份, 测得的只是元数据的开销
+    const QString id = repo_->create(model, png_);
+    if (!id.isEmpty()) {
+        ids_.append(id);
+    }
+    return id;
+}
+
+void ImageMetadataBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    repo_ = new ImageRepository(*fixture_->manager());
+    repo_->setImageCacheBudget(0);
+    ImageThumbnailOptions thumbnails;
+    thumbnails.eagerSizes.clear();
+    repo_->setThumbnailOptions(thumbnails);
+
+    QImage image(4, 4, QImage::Format_RGB32);
+    image.fill(Qt::darkCyan);
+    QBuffer buffer(&png_);
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(image.save(&buffer, "PNG"));
+    buffer.close();
+
+    for (int i = 0; i < MODELS; ++i) {
+        models_.append(sampleModel(i));
+    }
+}
+
+void ImageMetadataBenchmark::cleanupTestCase()
+{
+    if (repo_) {
+        for (const QString &id : ids_) {
+            repo_->remove(id);
+        }
+    }
+    delete repo_;
+    repo_ = nullptr;
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void ImageMetadataBenchmark::testBinaryRoundTrip()
+{
+    for (const ImageModel &model : models_.mid(0, 50)) {
+        bool ok = false;
+        QCOMPARE(ImageModel::fromBinary(model.toBinary(), &ok), model);
+        QVERIFY(ok);
+    }
+
+    // 空标签/空哈希, 以及不是 SHA-256 的哈希
+    ImageModel minimal("id-1", "a.png", "image/png", 1);
+    minimal.setUploadTime(QDateTime::fromMSecsSinceEpoch(0));
+    QCOMPARE(ImageModel::fromBinary(minimal.toBinary()), minimal);
+    minimal.setContentHash("ABCDEF");
+    QCOMPARE(ImageModel::fromBinary(minimal.toBinary()).getContentHash(), QString("ABCDEF"));
+
+    // 36 字节 ID + 32 字节原始哈希 + 其余字段
+    const QByteArray binary = models_.first().toBinary();
+    QCOMPARE(ImageModel::binaryVersion(binary), int(ImageModel::BINARY_VERSION));
+    QVERIFY2(binary.size() < 200, qPrintable(QString::number(binary.size())));
+
+    // 截断与非法数据
+    for (int length = 0; length < binary.size(); ++length) {
+        bool ok = true;
+        QVERIFY(!ImageModel::fromBinary(binary.left(length), &ok).isValid());
+        QVERIFY(!ok);
+    }
+    QCOMPARE(ImageModel::binaryVersion("{\"id\":1}"), -1);
+
+    // 更高版本只在末尾追加字段, 当前版本的解码器读取已知字段
+    QByteArray future = binary + QByteArray("\x05" "extra", 6);
+    future[2] = static_cast<char>(ImageModel::BINARY_VERSION + 1);
+    bool ok = false;
+    QCOMPARE(ImageModel::fromBinary(future, &ok), models_.first());
+    QVERIFY(ok);
+}
+
+void ImageMetadataBenchmark::testMigration()
+{
+    repo_->setMetadataEncoding(ImageMetadataEncoding::Fields);
+    QStringList ids;
+    for (int i = 0; i < 3; ++i) {
+        const QString id = createImage(sampleModel(i));
+        QVERIFY(!id.isEmpty());
+        ids.append(id);
+    }
+    const ImageModel before = repo_->findById(ids.first());
+    QVERIFY(before.isValid());
+    const int fieldCount = fixture_->manager()->hLen(metaKey(ids.first()));
+    QVERIFY(fieldCount > 1);
+
+    // 切换编码后旧记录仍可读取, 迁移后每条记录只有一个字段
+    repo_->setMetadataEncoding(ImageMetadataEncoding::Binary);
+    QCOMPARE(repo_->findById(ids.first()), before);
+    QVERIFY(repo_->migrateMetadata() >= ids.size());
+    for (const QString &id : ids) {
+        QCOMPARE(fixture_->manager()->hLen(metaKey(id)), 1);
+    }
+    QCOMPARE(repo_->findById(ids.first()), before);
+    QCOMPARE(repo_->migrateMetadata(), 0);
+    QCOMPARE(repo_->getImageData(ids.first()), png_);
+    const QList<QByteArray> batch = repo_->getImagesData(ids);
+    QCOMPARE(batch.size(), ids.size());
+    for (const QByteArray &data : batch) {
+        QCOMPARE(data, png_);
+    }
+
+    // 二进制记录的更新
+    QVERIFY(repo_->addTag(ids.first(), "migrated"));
+    QVERIFY(repo_->findById(ids.first()).hasTag("migrated"));
+    QCOMPARE(fixture_->manager()->hLen(metaKey(ids.first())), 1);
+
+    // 迁移回逐字段格式
+    repo_->setMetadataEncoding(ImageMetadataEncoding::Fields);
+    QVERIFY(repo_->findById(ids.first()).hasTag("migrated"));
+    QVERIFY(repo_->migrateMetadata() >= ids.size());
+    QCOMPARE(fixture_->manager()->hLen(metaKey(ids.first())), fieldCount);
+    QVERIFY(repo_->findById(ids.first()).hasTag("migrated"));
+    QCOMPARE(repo_->getImageData(ids.last()), png_);
+}
+
+void ImageMetadataBenchmark::benchmarkEncodeDecode()
+{
+    // 逐字段格式: saveMetadata 写入的字符串字段, findById 读取时经 QVariantMap 转换
+    QList<QMap<QString, QString>> fields;
+    QList<QByteArray> binaries;
+    for (const ImageModel &model : models_) {
+        QMap<QString, QString> map;
+        const QVariantMap variantMap = model.toVariantMap();
+        for (auto it = variantMap.begin(); it != variantMap.end(); ++it) {
+            map.insert(it.key(), it.value().toString());
+        }
+        fields.append(map);
+        binaries.append(model.toBinary());
+    }
+
+    const int valueSize = binaries.first().size();
+    BenchmarkResult encodeFields = reporter_.measure("encodeFields", MODELS, valueSize, ROUNDS, [&](int) {
+        for (const ImageModel &model : models_) {
+            const QVariantMap variantMap = model.toVariantMap();
+            QMap<QString, QString> map;
+            for (auto it = variantMap.begin(); it != variantMap.end(); ++it) {
+                map.insert(it.key(), it.value().toString());
+            }
+        }
+    });
+    BenchmarkResult encodeBinary = reporter_.measure("encodeBinary", MODELS, valueSize, ROUNDS, [&](int) {
+        for (const ImageModel &model : models_) {
+            model.toBinary();
+        }
+    });
+    BenchmarkResult decodeFields = reporter_.measure("decodeFields", MODELS, valueSize, ROUNDS, [&](int) {
+        for (const auto &map : fields) {
+            QVariantMap variantMap;
+            for (auto it = map.begin(); it != map.end(); ++it) {
+                variantMap[it.key()] = it.value();
+            }
+            ImageModel::fromVariantMap(variantMap);
+        }
+    });
+    BenchmarkResult decodeBinary = reporter_.measure("decodeBinary", MODELS, valueSize, ROUNDS, [&](int) {
+        for (const QByteArray &binary : binaries) {
+            ImageModel::fromBinary(binary);
+        }
+    });
+
+    // 每次迭代处理 MODELS 个模型
+    qDebug() << "RESULT: models/sec encode" << encodeFields.opsPerSec * MODELS << "fields,"
+             << encodeBinary.opsPerSec * MODELS << "binary; decode" << decodeFields.opsPerSec * MODELS
+             << "fields," << decodeBinary.opsPerSec * MODELS << "binary";
+    QVERIFY2(decodeBinary.p50Us < decodeFields.p50Us,
+             qPrintable(QString("binary %1us, fields %2us").arg(decodeBinary.p50Us).arg(decodeFields.p50Us)));
+    QVERIFY(encodeBinary.p50Us < encodeFields.p50Us);
+}
+
+void ImageMetadataBenchmark::benchmarkRedisBytes()
+{
+    repo_->setMetadataEncoding(ImageMetadataEncoding::Fields);
+    QStringList ids;
+    for (const ImageModel &model : models_) {
+        const QString id = createImage(model);
+        QVERIFY(!id.isEmpty());
+        ids.append(id);
+    }
+    const qint64 fieldsBytes = totalMemoryUsage(ids);
+
+    BenchmarkResult findFields = reporter_.measure("findByIdFields", MODELS, 0, MODELS, [&](int i) {
+        repo_->findById(ids[i]);
+    });
+
+    repo_->setMetadataEncoding(ImageMetadataEncoding::Binary);
+    QVERIFY(repo_->migrateMetadata() >= MODELS);
+    const qint64 binaryBytes = totalMemoryUsage(ids);
+
+    BenchmarkResult findBinary = reporter_.measure("findByIdBinary", MODELS, 0, MODELS, [&](int i) {
+        repo_->findById(ids[i]);
+    });
+    repo_->setMetadataEncoding(ImageMetadataEncoding::Fields);
+
+    qDebug() << "RESULT: bytes/model in Redis" << fieldsBytes / MODELS << "fields," << binaryBytes / MODELS
+             << "binary; findById p50" << findFields.p50Us << "us fields," << findBinary.p50Us << "us binary";
+    QVERIFY(fieldsBytes > 0);
+    QVERIFY2(binaryBytes < fieldsBytes,
+             qPrintable(QString("binary %1 bytes, fields %2 bytes").arg(binaryBytes).arg(fieldsBytes)));
+}
+
+QTEST_GUILESS_MAIN(ImageMetadataBenchmark)
+#include "tst_imagemetadatabenchmark.moc"
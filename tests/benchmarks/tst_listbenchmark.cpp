@@ -0,0 +1,192 @@
+/*
+ * 列表基准测试
+ * 1. 10 ~ 1M 个元素的列表上两端推入/弹出、LINDEX(头部与中部)、LRANGE 前 100 个、LLEN 的吞吐与延迟分位
+ * 2. 不同值大小下的 RPUSH + LPOP
+ * 3. LRANGE 0 -1 全量读取随长度增长的开销
+ * 结果写入 benchmark_results/list.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QHash>
+#include <algorithm>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class ListBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    ListBenchmark() : fixture_(nullptr), reporter_("list") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkPointOps_data();
+    void benchmarkPointOps();
+    void benchmarkValueSize_data();
+    void benchmarkValueSize();
+    void benchmarkFullRead_data();
+    void benchmarkFullRead();
+
+private:
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QHash<qint64, QString> keys_;
+    QString valueKey_;
+
+    static constexpr int ITERATIONS = 2000;
+    static constexpr int PRELOAD_CHUNK = 10000;
+    static constexpr int ELEMENT_SIZE = 16;
+    static constexpr qint64 FULL_READ_LIMIT = 100000;
+};
+
+void ListBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        const QString key = RedisTestFixture::generateUniqueKey(QString("list_%1").arg(cardinality));
+        for (qint64 offset = 0; offset < cardinality; offset += PRELOAD_CHUNK) {
+            QVector<QString> values;
+            for (qint64 i = offset; i < std::min(cardinality, offset + PRELOAD_CHUNK); ++i) {
+                values.append(QString("e-%1").arg(i).leftJustified(ELEMENT_SIZE, QLatin1Char('.')));
+            }
+            QVERIFY(fixture_->manager()->rPush(key, values));
+        }
+        keys_.insert(cardinality, key);
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    for (auto it = keys_.constBegin(); it != keys_.constEnd(); ++it) {
+        QCOMPARE(static_cast<qint64>(fixture_->manager()->lLen(it.value())), it.key());
+    }
+    valueKey_ = RedisTestFixture::generateUniqueKey("list_values");
+}
+
+void ListBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+        fixture_->manager()->del(valueKey_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void ListBenchmark::benchmarkPointOps_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"lPushRPop", "rPushLPop", "lIndexHead", "lIndexMiddle", "lRange100", "lLen"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                << QString(operation) << cardinality;
+        }
+    }
+}
+
+void ListBenchmark::benchmarkPointOps()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    const QString element = QString("bench").leftJustified(ELEMENT_SIZE, QLatin1Char('.'));
+    const int middle = static_cast<int>(cardinality / 2);
+
+    // 推入/弹出成对执行, 列表长度保持不变
+    BenchmarkResult result;
+    QBENCHMARK_ONCE {
+        if (operation == "lPushRPop") {
+            result = reporter_.measure(operation, cardinality, ELEMENT_SIZE, ITERATIONS, [&](int) {
+                manager->lPush(key, element);
+                manager->rPop(key);
+            });
+        } else if (operation == "rPushLPop") {
+            result = reporter_.measure(operation, cardinality, ELEMENT_SIZE, ITERATIONS, [&](int) {
+                manager->rPush(key, element);
+                manager->lPop(key);
+            });
+        } else if (operation == "lIndexHead") {
+            result = reporter_.measure(operation, cardinality, ELEMENT_SIZE, ITERATIONS,
+                                       [&](int) { manager->lIndex(key, 0); });
+        } else if (operation == "lIndexMiddle") {
+            // LINDEX 为 O(N), 长列表上缩减迭代次数
+            const int iterations = cardinality >= 1000000 ? ITERATIONS / 10 : ITERATIONS;
+            result = reporter_.measure(operation, cardinality, ELEMENT_SIZE, iterations,
+                                       [&](int) { manager->lIndex(key, middle); });
+        } else if (operation == "lRange100") {
+            result = reporter_.measure(operation, cardinality, ELEMENT_SIZE, ITERATIONS,
+                                       [&](int) { manager->lRange(key, 0, 99); });
+        } else if (operation == "lLen") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int) { manager->lLen(key); });
+        }
+    }
+    QVERIFY(result.iterations > 0);
+    QCOMPARE(static_cast<qint64>(manager->lLen(key)), cardinality);
+}
+
+void ListBenchmark::benchmarkValueSize_data()
+{
+    QTest::addColumn<int>("valueSize");
+    for (int valueSize : {16, 1024, 16384, 262144}) {
+        QTest::newRow(qPrintable(QString("rPushLPop_%1B").arg(valueSize))) << valueSize;
+    }
+}
+
+void ListBenchmark::benchmarkValueSize()
+{
+    QFETCH(int, valueSize);
+    RedisManager *manager = fixture_->manager();
+    const QString value(valueSize, QLatin1Char('v'));
+    const int iterations = valueSize >= 262144 ? ITERATIONS / 10 : ITERATIONS;
+
+    QString popped;
+    QBENCHMARK_ONCE {
+        reporter_.measure("rPushLPop", 1, valueSize, iterations, [&](int) {
+            manager->rPush(valueKey_, value);
+            popped = manager->lPop(valueKey_);
+        });
+    }
+    QCOMPARE(popped.size(), valueSize);
+    QCOMPARE(manager->lLen(valueKey_), 0);
+}
+
+void ListBenchmark::benchmarkFullRead_data()
+{
+    QTest::addColumn<qint64>("cardinality");
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        if (cardinality <= FULL_READ_LIMIT) {
+            QTest::newRow(qPrintable(QString("lRangeAll_%1").arg(cardinality))) << cardinality;
+        }
+    }
+}
+
+void ListBenchmark::benchmarkFullRead()
+{
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    const int iterations = static_cast<int>(std::max<qint64>(5, std::min<qint64>(ITERATIONS, 2000000 / cardinality)));
+
+    int lastSize = 0;
+    QBENCHMARK_ONCE {
+        reporter_.measure("lRangeAll", cardinality, ELEMENT_SIZE, iterations,
+                          [&](int) { lastSize = manager->lRange(key, 0, -1).size(); });
+    }
+    QCOMPARE(static_cast<qint64>(lastSize), cardinality);
+}
+
+QTEST_APPLESS_MAIN(ListBenchmark)
+#include "tst_listbenchmark.moc"
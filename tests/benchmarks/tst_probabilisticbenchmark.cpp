@@ -0,0 +1,305 @@
+/*
+ * HyperLogLog 与位图基准测试
+ * 1. 去重计数: 10K ~ 10M 个浏览者分别写入集合(SADD)与 HyperLogLog(PFADD), 对比内存占用与写入吞吐,
+ *    并检查 PFCOUNT 的估计误差
+ * 2. 每日活跃标志: 同样规模的用户编号写入集合与位图(BITFIELD SET u1), 对比内存占用
+ * 3. 单键操作(PFADD/PFCOUNT/SETBIT/GETBIT/BITCOUNT)与批量变体(多键 PFADD/PFCOUNT、多位 BITFIELD)的延迟
+ * 规模受 BENCHMARK_MAX_CARDINALITY 限制, ctest 中设为 10M; 结果写入 benchmark_results/probabilistic.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <algorithm>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class ProbabilisticBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    ProbabilisticBenchmark() : fixture_(nullptr), reporter_("probabilistic") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testOperations();
+    void benchmarkUniqueCountMemory_data();
+    void benchmarkUniqueCountMemory();
+    void benchmarkActiveFlagsMemory_data();
+    void benchmarkActiveFlagsMemory();
+    void benchmarkPointOps();
+
+private:
+    static QString viewer(qint64 index) { return QString("viewer-%1").arg(index); }
+    qint64 memoryUsage(const QString &key);
+    void addMemoryRows();
+
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QStringList keys_;
+
+    static constexpr int CHUNK = 10000;
+    static constexpr int ITERATIONS = 2000;
+    static constexpr int BATCH = 100;
+    // HyperLogLog 标准误差 0.81%, 允许约 3 倍
+    static constexpr double MAX_HLL_ERROR = 0.025;
+    // 稠密编码的 HyperLogLog 为 12KB 寄存器加键本身的开销
+    static constexpr qint64 MAX_HLL_BYTES = 16 * 1024;
+};
+
+qint64 ProbabilisticBenchmark::memoryUsage(const QString &key)
+{
+    // SAMPLES 0 统计全部元素, 集合的结果为精确值
+    QVector<RedisPipelineReply> replies = fixture_->manager()->pipeline(
+        {{"MEMORY", "USAGE", key.toUtf8(), "SAMPLES", "0"}});
+    return replies.isEmpty() ? -1 : replies.first().integer;
+}
+
+void ProbabilisticBenchmark::addMemoryRows()
+{
+    QTest::addColumn<qint64>("members");
+    for (qint64 members : {10000LL, 100000LL, 1000000LL, 10000000LL}) {
+        if (members <= BenchmarkReporter::maxCardinality()) {
+            QTest::newRow(qPrintable(QString("n%1").arg(members))) << members;
+        }
+    }
+}
+
+void ProbabilisticBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+}
+
+void ProbabilisticBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void ProbabilisticBenchmark::testOperations()
+{
+    RedisManager *manager = fixture_->manager();
+    const QString a = RedisTestFixture::generateUniqueKey("hll_a");
+    const QString b = RedisTestFixture::generateUniqueKey("hll_b");
+    const QString merged = RedisTestFixture::generateUniqueKey("hll_merged");
+    const QString bits = RedisTestFixture::generateUniqueKey("bits");
+    const QString other = RedisTestFixture::generateUniqueKey("bits_other");
+    const QString result = RedisTestFixture::generateUniqueKey("bits_result");
+    const QString counters = RedisTestFixture::generateUniqueKey("bitfield");
+    keys_ << a << b << merged << bits << other << result << counters;
+
+    // HyperLogLog: 小基数时估计值精确
+    QVERIFY(manager->pfAdd(a, "x"));
+    QVERIFY(manager->pfAdd(a, QVector<QString>{"x", "y", "z"}));
+    QCOMPARE(manager->pfCount(a), 3LL);
+    QVERIFY(manager->pfAddEach({{b, "z"}, {b, "w"}, {a, "x"}}));
+    QCOMPARE(manager->pfCount(b), 2LL);
+    QCOMPARE(manager->pfCount(QVector<QString>{a, b}), 4LL);
+    QCOMPARE(manager->pfCountEach({a, b}), (QVector<long long>{3, 2}));
+    QVERIFY(manager->pfMerge(merged, {a, b}));
+    QCOMPARE(manager->pfCount(merged), 4LL);
+
+    // 位图
+    QVERIFY(manager->setBit(bits, 7, true));
+    QVERIFY(manager->getBit(bits, 7));
+    QVERIFY(!manager->getBit(bits, 6));
+    QCOMPARE(manager->bitCount(bits), 1LL);
+    QCOMPARE(manager->bitPos(bits, true), 7LL);
+    QCOMPARE(manager->setBits(bits, {{7, false}, {100, true}, {101, true}}), (QVector<bool>{true, false, false}));
+    QCOMPARE(manager->getBits(bits, {7, 100, 101, 102}), (QVector<bool>{false, true, true, false}));
+    QCOMPARE(manager->bitCount(bits), 2LL);
+    QCOMPARE(manager->bitCount(bits, 12, 12), 2LL);
+
+    QVERIFY(manager->setBit(other, 100, true));
+    QCOMPARE(manager->bitOp(RedisBitOp::And, result, {bits, other}), 13LL);
+    QCOMPARE(manager->bitCount(result), 1LL);
+    QVERIFY(manager->getBit(result, 100));
+
+    // BITFIELD: 饱和与溢出失败
+    QVector<QVariant> values = manager->bitField(counters, {"INCRBY", "u8", "#0", "200",
+                                                            "OVERFLOW", "SAT", "INCRBY", "u8", "#0", "100",
+                                                            "OVERFLOW", "FAIL", "INCRBY", "u8", "#0", "1",
+                                                            "GET", "u8", "#0"});
+    QCOMPARE(values.size(), 4);
+    QCOMPARE(values.at(0).toLongLong(), 200LL);
+    QCOMPARE(values.at(1).toLongLong(), 255LL);
+    QVERIFY(!values.at(2).isValid());
+    QCOMPARE(values.at(3).toLongLong(), 255LL);
+}
+
+void ProbabilisticBenchmark::benchmarkUniqueCountMemory_data()
+{
+    addMemoryRows();
+}
+
+void ProbabilisticBenchmark::benchmarkUniqueCountMemory()
+{
+    QFETCH(qint64, members);
+    RedisManager *manager = fixture_->manager();
+    const QString setKey = RedisTestFixture::generateUniqueKey("viewers_set");
+    const QString hllKey = RedisTestFixture::generateUniqueKey("viewers_hll");
+    keys_ << setKey << hllKey;
+
+    QVector<qint64> setNs;
+    QVector<qint64> hllNs;
+    qint64 setTotalNs = 0;
+    qint64 hllTotalNs = 0;
+    bool ok = true;
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 offset = 0; offset < members && ok; offset += CHUNK) {
+        QVector<QString> chunk;
+        chunk.reserve(CHUNK);
+        for (qint64 i = offset; i < std::min(members, offset + CHUNK); ++i) {
+            chunk.append(viewer(i));
+        }
+        QElapsedTimer timer;
+        timer.start();
+        ok = manager->sAdd(setKey, chunk);
+        setNs.append(timer.nsecsElapsed());
+        timer.restart();
+        ok = ok && manager->pfAdd(hllKey, chunk);
+        hllNs.append(timer.nsecsElapsed());
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    QVERIFY(ok);
+    for (qint64 ns : setNs) {
+        setTotalNs += ns;
+    }
+    for (qint64 ns : hllNs) {
+        hllTotalNs += ns;
+    }
+
+    const qint64 setBytes = memoryUsage(setKey);
+    const qint64 hllBytes = memoryUsage(hllKey);
+    const long long estimate = manager->pfCount(hllKey);
+    const double error = qAbs(static_cast<double>(estimate - members)) / members;
+    QCOMPARE(static_cast<qint64>(manager->sCard(setKey)), members);
+    // 写入后即删除大集合, 避免下一个规模时内存叠加
+    manager->del(setKey);
+
+    reporter_.record(BenchmarkReporter::summarize("saddChunk", members, CHUNK, setNs, setTotalNs));
+    reporter_.record(BenchmarkReporter::summarize("pfaddChunk", members, CHUNK, hllNs, hllTotalNs));
+    qDebug() << "RESULT:" << members << "viewers: set" << setBytes << "bytes"
+             << members * 1e9 / setTotalNs << "adds/s, HLL" << hllBytes << "bytes"
+             << members * 1e9 / hllTotalNs << "adds/s, estimate" << estimate
+             << QString("(error %1%)").arg(error * 100, 0, 'f', 3);
+
+    QVERIFY2(hllBytes > 0 && hllBytes <= MAX_HLL_BYTES, qPrintable(QString("HLL uses %1 bytes").arg(hllBytes)));
+    QVERIFY2(error <= MAX_HLL_ERROR, qPrintable(QString("estimate %1 for %2 members").arg(estimate).arg(members)));
+    if (members >= 100000) {
+        QVERIFY2(setBytes > hllBytes * 100, qPrintable(QString("set %1 bytes, HLL %2 bytes").arg(setBytes).arg(hllBytes)));
+    }
+}
+
+void ProbabilisticBenchmark::benchmarkActiveFlagsMemory_data()
+{
+    addMemoryRows();
+}
+
+void ProbabilisticBenchmark::benchmarkActiveFlagsMemory()
+{
+    QFETCH(qint64, members);
+    RedisManager *manager = fixture_->manager();
+    const QString setKey = RedisTestFixture::generateUniqueKey("active_set");
+    const QString bitmapKey = RedisTestFixture::generateUniqueKey("active_bitmap");
+    keys_ << setKey << bitmapKey;
+
+    // 每 2 个用户中 1 个当天活跃, 用户编号即位偏移
+    QVector<qint64> setNs;
+    QVector<qint64> bitmapNs;
+    qint64 setTotalNs = 0;
+    qint64 bitmapTotalNs = 0;
+    qint64 active = 0;
+    bool ok = true;
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 offset = 0; offset < members && ok; offset += CHUNK * 2) {
+        QVector<QString> ids;
+        QVector<QPair<qint64, bool>> bits;
+        for (qint64 i = offset; i < std::min(members, offset + CHUNK * 2); i += 2) {
+            ids.append(QString::number(i));
+            bits.append(qMakePair(i, true));
+        }
+        active += ids.size();
+        QElapsedTimer timer;
+        timer.start();
+        ok = manager->sAdd(setKey, ids);
+        setNs.append(timer.nsecsElapsed());
+        timer.restart();
+        ok = ok && manager->setBits(bitmapKey, bits).size() == bits.size();
+        bitmapNs.append(timer.nsecsElapsed());
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    QVERIFY(ok);
+    for (qint64 ns : setNs) {
+        setTotalNs += ns;
+    }
+    for (qint64 ns : bitmapNs) {
+        bitmapTotalNs += ns;
+    }
+
+    const qint64 setBytes = memoryUsage(setKey);
+    const qint64 bitmapBytes = memoryUsage(bitmapKey);
+    QCOMPARE(manager->bitCount(bitmapKey), static_cast<long long>(active));
+    QCOMPARE(static_cast<qint64>(manager->sCard(setKey)), active);
+    manager->del(setKey);
+
+    reporter_.record(BenchmarkReporter::summarize("saddActiveChunk", members, CHUNK, setNs, setTotalNs));
+    reporter_.record(BenchmarkReporter::summarize("bitfieldSetChunk", members, CHUNK, bitmapNs, bitmapTotalNs));
+    qDebug() << "RESULT:" << members << "users," << active << "active: set" << setBytes << "bytes, bitmap"
+             << bitmapBytes << "bytes";
+
+    // 位图大小由最大偏移决定: members / 8 字节加上 SDS 预分配
+    QVERIFY2(bitmapBytes <= members / 8 * 2 + 1024, qPrintable(QString("bitmap uses %1 bytes").arg(bitmapBytes)));
+    if (members >= 100000) {
+        QVERIFY(setBytes > bitmapBytes * 4);
+    }
+}
+
+void ProbabilisticBenchmark::benchmarkPointOps()
+{
+    RedisManager *manager = fixture_->manager();
+    const QString hllKey = RedisTestFixture::generateUniqueKey("point_hll");
+    const QString bitmapKey = RedisTestFixture::generateUniqueKey("point_bitmap");
+    keys_ << hllKey << bitmapKey;
+    QVector<QString> hllKeys;
+    for (int i = 0; i < BATCH; ++i) {
+        hllKeys.append(RedisTestFixture::generateUniqueKey("point_hll_each"));
+        keys_ << hllKeys.last();
+    }
+
+    reporter_.measure("pfadd", 0, 0, ITERATIONS, [&](int i) { manager->pfAdd(hllKey, viewer(i)); });
+    reporter_.measure("pfcount", 0, 0, ITERATIONS, [&](int) { manager->pfCount(hllKey); });
+    reporter_.measure("setbit", 0, 0, ITERATIONS, [&](int i) { manager->setBit(bitmapKey, i * 7, true); });
+    reporter_.measure("getbit", 0, 0, ITERATIONS, [&](int i) { manager->getBit(bitmapKey, i * 7); });
+    reporter_.measure("bitcount", 0, 0, ITERATIONS, [&](int) { manager->bitCount(bitmapKey); });
+
+    // 批量变体: 每次调用处理 BATCH 个元素/位/键
+    QVector<QPair<QString, QString>> views;
+    QVector<qint64> offsets;
+    for (int i = 0; i < BATCH; ++i) {
+        views.append(qMakePair(hllKeys.at(i), viewer(i)));
+        offsets.append(i * 7);
+    }
+    BenchmarkResult each = reporter_.measure("pfaddEach", BATCH, 0, ITERATIONS / 10,
+                                             [&](int) { manager->pfAddEach(views); });
+    reporter_.measure("pfcountEach", BATCH, 0, ITERATIONS / 10, [&](int) { manager->pfCountEach(hllKeys); });
+    BenchmarkResult getBits = reporter_.measure("getbits", BATCH, 0, ITERATIONS / 10,
+                                                [&](int) { manager->getBits(bitmapKey, offsets); });
+    qDebug() << "RESULT: pfaddEach" << each.opsPerSec * BATCH << "elements/s, getbits"
+             << getBits.opsPerSec * BATCH << "bits/s";
+}
+
+QTEST_APPLESS_MAIN(ProbabilisticBenchmark)
+#include "tst_probabilisticbenchmark.moc"
@@ -0,0 +1,193 @@
+/*
+ * Pub/Sub 延迟基准测试
+ * 测量 PUBLISH 到 RedisSubscriber 信号到达的端到端延迟:
+ * 1. direct: 在订阅线程上直接处理信号(网络 + 解析)
+ * 2. queued: 经队列连接投递到主线程事件循环(应用实际收到的延迟)
+ * 以及断线重连后自动重新订阅
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QSignalSpy>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include "../fixtures/redistestfixture.h"
+#include "../../RedisModule/messaging/redissubscriber.h"
+
+class PubSubBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    PubSubBenchmark() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    void benchmarkPublishToReceive_data();
+    void benchmarkPublishToReceive();
+
+    void testPatternSubscription();
+    void testResubscribeAfterReconnect();
+
+private:
+    static qint64 nowNs();
+    bool waitForSubscribed(QSignalSpy &spy, int count, int timeoutMs = 2000);
+
+    RedisTestFixture *fixture_;
+    QString channel_;
+
+    static constexpr int SAMPLE_COUNT = 1000;
+    static constexpr int RECEIVE_TIMEOUT_MS = 1000;
+};
+
+void PubSubBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+}
+
+void PubSubBenchmark::cleanupTestCase()
+{
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void PubSubBenchmark::init()
+{
+    channel_ = RedisTestFixture::generateUniqueKey("pubsub");
+}
+
+qint64 PubSubBenchmark::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool PubSubBenchmark::waitForSubscribed(QSignalSpy &spy, int count, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (spy.count() < count && timer.elapsed() < timeoutMs) {
+        spy.wait(50);
+    }
+    return spy.count() >= count;
+}
+
+void PubSubBenchmark::benchmarkPublishToReceive_data()
+{
+    QTest::addColumn<bool>("queued");
+    QTest::newRow("direct") << false;
+    QTest::newRow("queued") << true;
+}
+
+void PubSubBenchmark::benchmarkPublishToReceive()
+{
+    QFETCH(bool, queued);
+    RedisManager *manager = fixture_->manager();
+
+    RedisSubscriber subscriber;
+    QSignalSpy subscribedSpy(&subscriber, &RedisSubscriber::subscribed);
+    subscriber.subscribe(channel_);
+    QVERIFY(subscriber.start());
+    QVERIFY2(waitForSubscribed(subscribedSpy, 1), "Subscription was not confirmed");
+
+    // 负载为发布时刻, 接收端计算差值
+    std::vector<qint64> latencies;
+    latencies.reserve(SAMPLE_COUNT);
+    std::atomic<int> received(0);
+    auto onMessage = [&latencies, &received](const QString &, const QByteArray &payload) {
+        qint64 sentNs = 0;
+        memcpy(&sentNs, payload.constData(), sizeof(sentNs));
+        latencies.push_back(nowNs() - sentNs);
+        ++received;
+    };
+    QMetaObject::Connection connection = queued
+        ? connect(&subscriber, &RedisSubscriber::messageReceived, this, onMessage, Qt::QueuedConnection)
+        : connect(&subscriber, &RedisSubscriber::messageReceived, onMessage);
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < SAMPLE_COUNT; ++i) {
+            qint64 sentNs = nowNs();
+            QByteArray payload(reinterpret_cast<const char *>(&sentNs), sizeof(sentNs));
+            manager->publish(channel_, payload);
+
+            // 逐条等待, 测量的是单条延迟而非吞吐
+            QElapsedTimer timer;
+            timer.start();
+            while (received.load() <= i && timer.elapsed() < RECEIVE_TIMEOUT_MS) {
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+            }
+        }
+    }
+
+    disconnect(connection);
+    subscriber.stop();
+
+    QCOMPARE(received.load(), SAMPLE_COUNT);
+    std::sort(latencies.begin(), latencies.end());
+    qint64 p50 = latencies[latencies.size() / 2] / 1000;
+    qint64 p99 = latencies[(latencies.size() * 99) / 100] / 1000;
+    qint64 maxUs = latencies.back() / 1000;
+    qDebug() << "RESULT:" << (queued ? "queued" : "direct") << "publish-to-receive"
+             << "p50" << p50 << "us, p99" << p99 << "us, max" << maxUs << "us";
+}
+
+void PubSubBenchmark::testPatternSubscription()
+{
+    RedisManager *manager = fixture_->manager();
+
+    RedisSubscriber subscriber;
+    QSignalSpy subscribedSpy(&subscriber, &RedisSubscriber::subscribed);
+    QSignalSpy messageSpy(&subscriber, &RedisSubscriber::patternMessageReceived);
+    subscriber.psubscribe(channel_ + ":*");
+    QVERIFY(subscriber.start());
+    QVERIFY(waitForSubscribed(subscribedSpy, 1));
+
+    QByteArray payload("\x00\x01" "binary" "\xff", 9);
+    QCOMPARE(manager->publish(channel_ + ":a", payload), 1LL);
+    QVERIFY(messageSpy.wait(RECEIVE_TIMEOUT_MS));
+
+    QList<QVariant> arguments = messageSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toString(), channel_ + ":*");
+    QCOMPARE(arguments.at(1).toString(), channel_ + ":a");
+    QCOMPARE(arguments.at(2).toByteArray(), payload);
+}
+
+void PubSubBenchmark::testResubscribeAfterReconnect()
+{
+    RedisManager *manager = fixture_->manager();
+
+    RedisConnectionOptions options;
+    options.reconnectInitialDelayMs = 50;
+    options.reconnectMaxDelayMs = 200;
+
+    RedisSubscriber subscriber;
+    QSignalSpy connectedSpy(&subscriber, &RedisSubscriber::connected);
+    QSignalSpy subscribedSpy(&subscriber, &RedisSubscriber::subscribed);
+    QSignalSpy messageSpy(&subscriber, &RedisSubscriber::messageReceived);
+    subscriber.subscribe(channel_);
+    QVERIFY(subscriber.start(options));
+    QVERIFY(waitForSubscribed(subscribedSpy, 1));
+
+    // 从服务器侧断开所有 Pub/Sub 客户端连接
+    QCOMPARE(QProcess::execute("redis-cli", {"CLIENT", "KILL", "TYPE", "pubsub"}), 0);
+
+    QVERIFY2(waitForSubscribed(subscribedSpy, 2, 5000), "Subscription was not restored after reconnect");
+    QVERIFY(connectedSpy.count() >= 2);
+
+    QCOMPARE(manager->publish(channel_, "after-reconnect"), 1LL);
+    QVERIFY(messageSpy.wait(RECEIVE_TIMEOUT_MS));
+    QCOMPARE(messageSpy.takeFirst().at(1).toByteArray(), QByteArray("after-reconnect"));
+}
+
+QTEST_GUILESS_MAIN(PubSubBenchmark)
+#include "tst_pubsubbenchmark.moc"
@@ -0,0 +1,221 @@
+/*
+ * 集合基准测试
+ * 1. 10 ~ 1M 个成员的集合上 SADD/SREM、SISMEMBER(命中/未命中)、SCARD 的吞吐与延迟分位
+ * 2. 不同成员大小下的 SADD/SISMEMBER
+ * 3. SMEMBERS 全量读取, 以及与 100 个成员的小集合做 SINTER/SUNION 随规模增长的开销
+ * 结果写入 benchmark_results/set.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QHash>
+#include <algorithm>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class SetBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    SetBenchmark() : fixture_(nullptr), reporter_("set") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkPointOps_data();
+    void benchmarkPointOps();
+    void benchmarkValueSize_data();
+    void benchmarkValueSize();
+    void benchmarkFullRead_data();
+    void benchmarkFullRead();
+
+private:
+    static QString member(qint64 index) { return QString("m-%1").arg(index); }
+
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QHash<qint64, QString> keys_;
+    QString smallKey_;
+    QString valueKey_;
+
+    static constexpr int ITERATIONS = 2000;
+    static constexpr int PRELOAD_CHUNK = 10000;
+    static constexpr int SMALL_SET_SIZE = 100;
+    static constexpr qint64 FULL_READ_LIMIT = 100000;
+};
+
+void SetBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        const QString key = RedisTestFixture::generateUniqueKey(QString("set_%1").arg(cardinality));
+        for (qint64 offset = 0; offset < cardinality; offset += PRELOAD_CHUNK) {
+            QVector<QString> members;
+            for (qint64 i = offset; i < std::min(cardinality, offset + PRELOAD_CHUNK); ++i) {
+                members.append(member(i));
+            }
+            QVERIFY(fixture_->manager()->sAdd(key, members));
+        }
+        keys_.insert(cardinality, key);
+    }
+
+    // 小集合的一半成员与各规模集合重叠
+    smallKey_ = RedisTestFixture::generateUniqueKey("set_small");
+    QVector<QString> small;
+    for (int i = 0; i < SMALL_SET_SIZE; ++i) {
+        small.append(i % 2 == 0 ? member(i) : QString("other-%1").arg(i));
+    }
+    QVERIFY(fixture_->manager()->sAdd(smallKey_, small));
+    BenchmarkReporter::suppressDebugOutput(false);
+
+    for (auto it = keys_.constBegin(); it != keys_.constEnd(); ++it) {
+        QCOMPARE(static_cast<qint64>(fixture_->manager()->sCard(it.value())), it.key());
+    }
+    valueKey_ = RedisTestFixture::generateUniqueKey("set_values");
+}
+
+void SetBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+        fixture_->manager()->del(smallKey_);
+        fixture_->manager()->del(valueKey_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void SetBenchmark::benchmarkPointOps_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"sAddSRem", "sIsMemberHit", "sIsMemberMiss", "sCard"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                << QString(operation) << cardinality;
+        }
+    }
+}
+
+void SetBenchmark::benchmarkPointOps()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    auto memberAt = [cardinality](int i) { return member((static_cast<qint64>(i) * 7919) % cardinality); };
+
+    BenchmarkResult result;
+    QBENCHMARK_ONCE {
+        if (operation == "sAddSRem") {
+            // 添加新成员后立即移除, 集合大小保持不变
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS, [&](int i) {
+                const QString extra = QString("extra-%1").arg(i);
+                manager->sAdd(key, extra);
+                manager->sRem(key, extra);
+            });
+        } else if (operation == "sIsMemberHit") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->sIsMember(key, memberAt(i)); });
+        } else if (operation == "sIsMemberMiss") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->sIsMember(key, QString("absent-%1").arg(i)); });
+        } else if (operation == "sCard") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int) { manager->sCard(key); });
+        }
+    }
+    QVERIFY(result.iterations > 0);
+    QCOMPARE(static_cast<qint64>(manager->sCard(key)), cardinality);
+}
+
+void SetBenchmark::benchmarkValueSize_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<int>("valueSize");
+    for (const char *operation : {"sAdd", "sIsMember"}) {
+        for (int valueSize : {16, 1024, 16384}) {
+            QTest::newRow(qPrintable(QString("%1_%2B").arg(operation).arg(valueSize)))
+                << QString(operation) << valueSize;
+        }
+    }
+}
+
+void SetBenchmark::benchmarkValueSize()
+{
+    QFETCH(QString, operation);
+    QFETCH(int, valueSize);
+    RedisManager *manager = fixture_->manager();
+    const int memberCount = 100;
+    auto sizedMember = [valueSize](int i) {
+        return QString::number(i).rightJustified(valueSize, QLatin1Char('0'));
+    };
+
+    manager->del(valueKey_);
+    QBENCHMARK_ONCE {
+        if (operation == "sAdd") {
+            reporter_.measure(operation, memberCount, valueSize, ITERATIONS,
+                              [&](int i) { manager->sAdd(valueKey_, sizedMember(i % memberCount)); });
+        } else {
+            for (int i = 0; i < memberCount; ++i) {
+                manager->sAdd(valueKey_, sizedMember(i));
+            }
+            reporter_.measure(operation, memberCount, valueSize, ITERATIONS,
+                              [&](int i) { manager->sIsMember(valueKey_, sizedMember(i % memberCount)); });
+        }
+    }
+    QCOMPARE(manager->sCard(valueKey_), memberCount);
+}
+
+void SetBenchmark::benchmarkFullRead_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"sMembers", "sInter", "sUnion"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            if (cardinality <= FULL_READ_LIMIT) {
+                QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                    << QString(operation) << cardinality;
+            }
+        }
+    }
+}
+
+void SetBenchmark::benchmarkFullRead()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    const QVector<QString> pair = {key, smallKey_};
+    const int iterations = static_cast<int>(std::max<qint64>(5, std::min<qint64>(ITERATIONS, 2000000 / cardinality)));
+
+    int lastSize = 0;
+    QBENCHMARK_ONCE {
+        if (operation == "sMembers") {
+            reporter_.measure(operation, cardinality, 0, iterations,
+                              [&](int) { lastSize = manager->sMembers(key).size(); });
+        } else if (operation == "sInter") {
+            reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                              [&](int) { lastSize = manager->sInter(pair).size(); });
+        } else {
+            reporter_.measure(operation, cardinality, 0, iterations,
+                              [&](int) { lastSize = manager->sUnion(pair).size(); });
+        }
+    }
+    QVERIFY(lastSize > 0);
+}
+
+QTEST_APPLESS_MAIN(SetBenchmark)
+#include "tst_setbenchmark.moc"
@@ -0,0 +1,201 @@
+/*
+ * 有序集合基准测试
+ * 1. 10 ~ 1M 个成员的有序集合上 ZADD(更新分数)、ZSCORE、ZRANK/ZREVRANK、ZRANGE 前 100 个、ZCARD
+ *    的吞吐与延迟分位
+ * 2. 不同成员大小下的 ZADD/ZSCORE
+ * 3. ZRANGE 0 -1 全量读取随规模增长的开销
+ * 结果写入 benchmark_results/sortedset.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QHash>
+#include <algorithm>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class SortedSetBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    SortedSetBenchmark() : fixture_(nullptr), reporter_("sortedset") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkPointOps_data();
+    void benchmarkPointOps();
+    void benchmarkValueSize_data();
+    void benchmarkValueSize();
+    void benchmarkFullRead_data();
+    void benchmarkFullRead();
+
+private:
+    static QString member(qint64 index) { return QString("m-%1").arg(index); }
+
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QHash<qint64, QString> keys_;
+    QString valueKey_;
+
+    static constexpr int ITERATIONS = 2000;
+    static constexpr int PRELOAD_CHUNK = 10000;
+    static constexpr qint64 FULL_READ_LIMIT = 100000;
+};
+
+void SortedSetBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        const QString key = RedisTestFixture::generateUniqueKey(QString("zset_%1").arg(cardinality));
+        for (qint64 offset = 0; offset < cardinality; offset += PRELOAD_CHUNK) {
+            QVector<QPair<QString, double>> members;
+            for (qint64 i = offset; i < std::min(cardinality, offset + PRELOAD_CHUNK); ++i) {
+                members.append(qMakePair(member(i), static_cast<double>(i)));
+            }
+            QVERIFY(fixture_->manager()->zAdd(key, members));
+        }
+        keys_.insert(cardinality, key);
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    for (auto it = keys_.constBegin(); it != keys_.constEnd(); ++it) {
+        QCOMPARE(fixture_->manager()->zCard(it.value()), it.key());
+    }
+    valueKey_ = RedisTestFixture::generateUniqueKey("zset_values");
+}
+
+void SortedSetBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+        fixture_->manager()->del(valueKey_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void SortedSetBenchmark::benchmarkPointOps_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<qint64>("cardinality");
+    for (const char *operation : {"zAddUpdate", "zScore", "zRank", "zRevRank", "zRange100", "zCard"}) {
+        for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+            QTest::newRow(qPrintable(QString("%1_%2").arg(operation).arg(cardinality)))
+                << QString(operation) << cardinality;
+        }
+    }
+}
+
+void SortedSetBenchmark::benchmarkPointOps()
+{
+    QFETCH(QString, operation);
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    auto indexAt = [cardinality](int i) { return (static_cast<qint64>(i) * 7919) % cardinality; };
+
+    BenchmarkResult result;
+    QBENCHMARK_ONCE {
+        if (operation == "zAddUpdate") {
+            // 更新已有成员的分数, 触发跳表重新定位但不改变成员数
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS, [&](int i) {
+                qint64 index = indexAt(i);
+                manager->zAdd(key, static_cast<double>(cardinality - index), member(index));
+            });
+        } else if (operation == "zScore") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->zScore(key, member(indexAt(i))); });
+        } else if (operation == "zRank") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->zRank(key, member(indexAt(i))); });
+        } else if (operation == "zRevRank") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int i) { manager->zRevRank(key, member(indexAt(i))); });
+        } else if (operation == "zRange100") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int) { manager->zRange(key, 0, 99); });
+        } else if (operation == "zCard") {
+            result = reporter_.measure(operation, cardinality, 0, ITERATIONS,
+                                       [&](int) { manager->zCard(key); });
+        }
+    }
+    QVERIFY(result.iterations > 0);
+    QCOMPARE(manager->zCard(key), cardinality);
+}
+
+void SortedSetBenchmark::benchmarkValueSize_data()
+{
+    QTest::addColumn<QString>("operation");
+    QTest::addColumn<int>("valueSize");
+    for (const char *operation : {"zAdd", "zScore"}) {
+        for (int valueSize : {16, 1024, 16384}) {
+            QTest::newRow(qPrintable(QString("%1_%2B").arg(operation).arg(valueSize)))
+                << QString(operation) << valueSize;
+        }
+    }
+}
+
+void SortedSetBenchmark::benchmarkValueSize()
+{
+    QFETCH(QString, operation);
+    QFETCH(int, valueSize);
+    RedisManager *manager = fixture_->manager();
+    const int memberCount = 100;
+    auto sizedMember = [valueSize](int i) {
+        return QString::number(i).rightJustified(valueSize, QLatin1Char('0'));
+    };
+
+    manager->del(valueKey_);
+    QBENCHMARK_ONCE {
+        if (operation == "zAdd") {
+            reporter_.measure(operation, memberCount, valueSize, ITERATIONS,
+                              [&](int i) { manager->zAdd(valueKey_, i, sizedMember(i % memberCount)); });
+        } else {
+            for (int i = 0; i < memberCount; ++i) {
+                manager->zAdd(valueKey_, i, sizedMember(i));
+            }
+            reporter_.measure(operation, memberCount, valueSize, ITERATIONS,
+                              [&](int i) { manager->zScore(valueKey_, sizedMember(i % memberCount)); });
+        }
+    }
+    QCOMPARE(manager->zCard(valueKey_), static_cast<long long>(memberCount));
+}
+
+void SortedSetBenchmark::benchmarkFullRead_data()
+{
+    QTest::addColumn<qint64>("cardinality");
+    for (qint64 cardinality : BenchmarkReporter::cardinalities()) {
+        if (cardinality <= FULL_READ_LIMIT) {
+            QTest::newRow(qPrintable(QString("zRangeAll_%1").arg(cardinality))) << cardinality;
+        }
+    }
+}
+
+void SortedSetBenchmark::benchmarkFullRead()
+{
+    QFETCH(qint64, cardinality);
+    RedisManager *manager = fixture_->manager();
+    const QString key = keys_.value(cardinality);
+    const int iterations = static_cast<int>(std::max<qint64>(5, std::min<qint64>(ITERATIONS, 2000000 / cardinality)));
+
+    int lastSize = 0;
+    QBENCHMARK_ONCE {
+        reporter_.measure("zRangeAll", cardinality, 0, iterations,
+                          [&](int) { lastSize = manager->zRange(key, 0, -1).size(); });
+    }
+    QCOMPARE(static_cast<qint64>(lastSize), cardinality);
+}
+
+QTEST_APPLESS_MAIN(SortedSetBenchmark)
+#include "tst_sortedsetbenchmark.moc"
@@ -0,0 +1,272 @@
+/*
+ * 启动与连接预热基准测试
+ * 1. 预热建立连接池中的全部连接、记录往返时间基线并预加载脚本; 连接池可能被占用时只预热一个连接
+ * 2. 就绪状态与 readyChanged 信号(连接、预热失败、断开)
+ * 3. 冷启动与预热启动下的连接耗时, 以及启动后第一批并发请求与稳定后请求的延迟
+ * 结果写入 benchmark_results/startup.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QSignalSpy>
+#include <atomic>
+#include <numeric>
+#include <mutex>
+#include <thread>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+class StartupBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    StartupBenchmark() : fixture_(nullptr), reporter_("startup") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testWarmUpOpensPool();
+    void testPreloadScripts();
+    void testReadiness();
+    void benchmarkStartup_data();
+    void benchmarkStartup();
+
+private:
+    RedisConnectionOptions options(int poolSize, bool warmUp) const;
+    qint64 connectedClients();
+    QVector<qint64> concurrentRequests(RedisManager *manager, int threads, int requestsPerThread,
+                                       qint64 *elapsedNs);
+
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QString key_;
+
+    static constexpr int ROUNDS = 20;
+    static constexpr int FIRST_REQUESTS = 4;
+    static constexpr int STEADY_REQUESTS = 50;
+};
+
+RedisConnectionOptions StartupBenchmark::options(int poolSize, bool warmUp) const
+{
+    RedisConnectionOptions result;
+    result.poolSize = poolSize;
+    result.poolWaitTimeoutMs = 5000;
+    result.warmUp = warmUp;
+    return result;
+}
+
+qint64 StartupBenchmark::connectedClients()
+{
+    return fixture_->manager()->info("clients").value("connected_clients").toLongLong();
+}
+
+QVector<qint64> StartupBenchmark::concurrentRequests(RedisManager *manager, int threads, int requestsPerThread,
+                                                     qint64 *elapsedNs)
+{
+    QVector<qint64> latenciesNs;
+    std::mutex mutex;
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            QVector<qint64> local;
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < requestsPerThread; ++i) {
+                QElapsedTimer timer;
+                timer.start();
+                manager->get(key_);
+                local.append(timer.nsecsElapsed());
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            latenciesNs += local;
+        });
+    }
+
+    QElapsedTimer total;
+    total.start();
+    start.store(true);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    *elapsedNs = total.nsecsElapsed();
+    return latenciesNs;
+}
+
+void StartupBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+    key_ = RedisTestFixture::generateUniqueKey("startup");
+    QVERIFY(fixture_->manager()->set(key_, "v"));
+}
+
+void StartupBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        fixture_->manager()->del(key_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void StartupBenchmark::testWarmUpOpensPool()
+{
+    const int poolSize = 8;
+
+    // 不预热时连接后只有连接探测打开的连接, 预热额外建立整个连接池
+    RedisManager cold;
+    const qint64 before = connectedClients();
+    QVERIFY(cold.connectToServer(options(poolSize, false)));
+    const qint64 afterCold = connectedClients();
+    QCOMPARE(cold.warmUpReport().rttUs.size(), 0);
+
+    RedisManager warm;
+    QVERIFY(warm.connectToServer(options(poolSize, true)));
+    const qint64 afterWarm = connectedClients();
+    QCOMPARE(afterWarm - afterCold, afterCold - before + poolSize);
+
+    RedisWarmUpReport report = warm.warmUpReport();
+    QVERIFY(report.ok);
+    QCOMPARE(report.rttUs.size(), poolSize);
+    QCOMPARE(report.connectUs.size(), poolSize);
+    QVERIFY(report.rttMinUs > 0);
+    QVERIFY(report.rttMinUs <= report.rttMedianUs && report.rttMedianUs <= report.rttMaxUs);
+    qDebug().noquote() << report.toText();
+
+    QVERIFY(!report.partial);
+
+    // 再次预热时连接都已建立, 连接数不变
+    QVERIFY(warm.warmUp().ok);
+    QCOMPARE(connectedClients(), afterWarm);
+
+    // 等待空闲连接不限时, 连接后的手动预热只借出一个连接, 连接池被占用时也不会无限期等待
+    RedisConnectionOptions unbounded = options(poolSize, true);
+    unbounded.poolWaitTimeoutMs = 0;
+    RedisManager busy;
+    QVERIFY(busy.connectToServer(unbounded));
+    QCOMPARE(busy.warmUpReport().rttUs.size(), poolSize);
+    RedisWarmUpReport manual = busy.warmUp();
+    QVERIFY(manual.ok);
+    QVERIFY(manual.partial);
+    QCOMPARE(manual.rttUs.size(), 1);
+}
+
+void StartupBenchmark::testPreloadScripts()
+{
+    const QString script = "return tonumber(ARGV[1]) + 1";
+    RedisConnectionOptions opts = options(2, true);
+    opts.preloadScripts = QStringList{script, "return 1"};
+
+    RedisManager manager;
+    QVERIFY(manager.connectToServer(opts));
+    QCOMPARE(manager.warmUpReport().scriptsLoaded, 2);
+
+    // 脚本已在服务器缓存中, SHA 由预热写入本地缓存
+    QCOMPARE(manager.evalInteger(script, {}, {"41"}), 42LL);
+    QCOMPARE(manager.lastCallStatus(), RedisCallStatus::Ok);
+
+    // 语法错误的脚本使预热失败, 连接随之断开
+    RedisManager broken;
+    opts.preloadScripts = QStringList{"return ("};
+    QVERIFY(!broken.connectToServer(opts));
+    QVERIFY(!broken.isConnected());
+    QVERIFY(!broken.isReady());
+    QVERIFY(!broken.warmUpReport().ok);
+}
+
+void StartupBenchmark::testReadiness()
+{
+    RedisManager manager;
+    QSignalSpy spy(&manager, &RedisManager::readyChanged);
+    QVERIFY(!manager.isReady());
+
+    QVERIFY(manager.connectToServer(options(4, true)));
+    QVERIFY(manager.isReady());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toBool(), true);
+
+    // 重复预热不改变就绪状态, 不再发出信号
+    QVERIFY(manager.warmUp().ok);
+    QCOMPARE(spy.count(), 1);
+
+    manager.disconnect();
+    QVERIFY(!manager.isReady());
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(1).at(0).toBool(), false);
+
+    // 服务器不可达时不会就绪
+    RedisConnectionOptions unreachable = options(4, true);
+    unreachable.port = 1;
+    unreachable.connectTimeoutMs = 200;
+    QVERIFY(!manager.connectToServer(unreachable));
+    QVERIFY(!manager.isReady());
+    QCOMPARE(spy.count(), 2);
+}
+
+void StartupBenchmark::benchmarkStartup_data()
+{
+    QTest::addColumn<int>("poolSize");
+    QTest::addColumn<bool>("warmUp");
+    QTest::newRow("pool4_cold") << 4 << false;
+    QTest::newRow("pool4_warm") << 4 << true;
+    QTest::newRow("pool16_cold") << 16 << false;
+    QTest::newRow("pool16_warm") << 16 << true;
+}
+
+void StartupBenchmark::benchmarkStartup()
+{
+    QFETCH(int, poolSize);
+    QFETCH(bool, warmUp);
+    const QString mode = warmUp ? "warm" : "cold";
+
+    QVector<qint64> connectNs;
+    QVector<qint64> firstNs;
+    QVector<qint64> steadyNs;
+    qint64 firstElapsedNs = 0;
+    qint64 steadyElapsedNs = 0;
+
+    BenchmarkReporter::suppressDebugOutput(true);
+    for (int round = 0; round < ROUNDS; ++round) {
+        RedisManager manager;
+        QElapsedTimer timer;
+        timer.start();
+        const bool connected = manager.connectToServer(options(poolSize, warmUp));
+        connectNs.append(timer.nsecsElapsed());
+        if (!connected) {
+            BenchmarkReporter::suppressDebugOutput(false);
+            QFAIL("Failed to connect to Redis server");
+        }
+
+        // 启动后第一批并发请求: 冷启动时由这些请求建立连接池中的连接
+        qint64 elapsedNs = 0;
+        firstNs += concurrentRequests(&manager, poolSize, FIRST_REQUESTS, &elapsedNs);
+        firstElapsedNs += elapsedNs;
+        steadyNs += concurrentRequests(&manager, poolSize, STEADY_REQUESTS, &elapsedNs);
+        steadyElapsedNs += elapsedNs;
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+
+    const qint64 connectTotalNs = std::accumulate(connectNs.begin(), connectNs.end(), 0LL);
+    BenchmarkResult connect = BenchmarkReporter::summarize("connect_" + mode, poolSize, 0, connectNs, connectTotalNs);
+    BenchmarkResult first = BenchmarkReporter::summarize("firstRequests_" + mode, poolSize, 0, firstNs, firstElapsedNs);
+    BenchmarkResult steady = BenchmarkReporter::summarize("steadyRequests_" + mode, poolSize, 0, steadyNs,
+                                                          steadyElapsedNs);
+    reporter_.record(connect);
+    reporter_.record(first);
+    reporter_.record(steady);
+
+    qDebug() << "RESULT:" << QTest::currentDataTag() << "connect p50" << connect.p50Us << "us,"
+             << "first requests p99" << first.p99Us << "us max" << first.maxUs << "us,"
+             << "steady p99" << steady.p99Us << "us";
+}
+
+QTEST_APPLESS_MAIN(StartupBenchmark)
+#include "tst_startupbenchmark.moc"
@@ -0,0 +1,235 @@
+/*
+ * Stream 吞吐基准测试
+ * 按批大小 1/10/100/1000 测量:
+ * 1. 生产: XADD 流水线批量写入
+ * 2. 消费: XREADGROUP COUNT + XACK 循环
+ * 3. 端到端: RedisStreamConsumer 工作线程读取并确认
+ * 结果以 events/sec 输出
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QThread>
+#include <atomic>
+#include "../fixtures/redistestfixture.h"
+#include "../../RedisModule/messaging/redisstreamconsumer.h"
+
+class StreamBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    StreamBenchmark() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void benchmarkProduce_data();
+    void benchmarkProduce();
+
+    void benchmarkConsume_data();
+    void benchmarkConsume();
+
+    void benchmarkConsumer_data();
+    void benchmarkConsumer();
+
+private:
+    void addBatchSizes();
+    QVector<QMap<QString, QString>> makeEvents(int count, int offset) const;
+    void preload(int count);
+    static void reportThroughput(const char *phase, int batchSize, int events, qint64 elapsedMs);
+
+    RedisTestFixture *fixture_;
+    QString streamKey_;
+
+    static constexpr int EVENT_COUNT = 10000;
+    static constexpr int PRELOAD_CHUNK = 1000;
+    static constexpr int CONSUMER_TIMEOUT_MS = 60000;
+};
+
+void StreamBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+}
+
+void StreamBenchmark::cleanupTestCase()
+{
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void StreamBenchmark::init()
+{
+    streamKey_ = RedisTestFixture::generateUniqueKey("stream");
+}
+
+void StreamBenchmark::cleanup()
+{
+    if (fixture_ && fixture_->manager()) {
+        fixture_->manager()->del(streamKey_);
+    }
+}
+
+void StreamBenchmark::addBatchSizes()
+{
+    QTest::addColumn<int>("batchSize");
+    QTest::newRow("batch_1") << 1;
+    QTest::newRow("batch_10") << 10;
+    QTest::newRow("batch_100") << 100;
+    QTest::newRow("batch_1000") << 1000;
+}
+
+QVector<QMap<QString, QString>> StreamBenchmark::makeEvents(int count, int offset) const
+{
+    QVector<QMap<QString, QString>> events;
+    events.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QMap<QString, QString> fields;
+        fields.insert("seq", QString::number(offset + i));
+        fields.insert("type", "benchmark");
+        fields.insert("payload", QString(64, QChar('x')));
+        events.append(fields);
+    }
+    return events;
+}
+
+void StreamBenchmark::preload(int count)
+{
+    for (int offset = 0; offset < count; offset += PRELOAD_CHUNK) {
+        int chunk = qMin(PRELOAD_CHUNK, count - offset);
+        QCOMPARE(fixture_->manager()->xAddBatch(streamKey_, makeEvents(chunk, offset)).size(), chunk);
+    }
+}
+
+void StreamBenchmark::reportThroughput(const char *phase, int batchSize, int events, qint64 elapsedMs)
+{
+    double eventsPerSec = elapsedMs > 0 ? events * 1000.0 / elapsedMs : 0.0;
+    qDebug() << "RESULT:" << phase << "batch" << batchSize << "events" << events
+             << "elapsed" << elapsedMs << "ms," << qRound64(eventsPerSec) << "events/sec";
+}
+
+// 生产: 每批一次流水线往返
+void StreamBenchmark::benchmarkProduce_data()
+{
+    addBatchSizes();
+}
+
+void StreamBenchmark::benchmarkProduce()
+{
+    QFETCH(int, batchSize);
+    RedisManager *manager = fixture_->manager();
+
+    QVector<QVector<QMap<QString, QString>>> batches;
+    for (int offset = 0; offset < EVENT_COUNT; offset += batchSize) {
+        batches.append(makeEvents(qMin(batchSize, EVENT_COUNT - offset), offset));
+    }
+
+    qint64 elapsedMs = 0;
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto &batch : batches) {
+            if (batch.size() == 1) {
+                manager->xAdd(streamKey_, batch.first());
+            } else {
+                manager->xAddBatch(streamKey_, batch);
+            }
+        }
+        elapsedMs = timer.elapsed();
+    }
+
+    QCOMPARE(manager->xLen(streamKey_), static_cast<long long>(EVENT_COUNT));
+    reportThroughput("produce", batchSize, EVENT_COUNT, elapsedMs);
+}
+
+// 消费: XREADGROUP COUNT batchSize 后整批 XACK
+void StreamBenchmark::benchmarkConsume_data()
+{
+    addBatchSizes();
+}
+
+void StreamBenchmark::benchmarkConsume()
+{
+    QFETCH(int, batchSize);
+    RedisManager *manager = fixture_->manager();
+
+    preload(EVENT_COUNT);
+    QVERIFY(manager->xGroupCreate(streamKey_, "bench", "0"));
+
+    int consumed = 0;
+    qint64 elapsedMs = 0;
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+        while (consumed < EVENT_COUNT) {
+            QVector<RedisStreamEntry> entries = manager->xReadGroup(streamKey_, "bench", "worker", batchSize);
+            if (entries.isEmpty()) {
+                break;
+            }
+            QVector<QString> ids;
+            ids.reserve(entries.size());
+            for (const auto &entry : entries) {
+                ids.append(entry.id);
+            }
+            manager->xAck(streamKey_, "bench", ids);
+            consumed += entries.size();
+        }
+        elapsedMs = timer.elapsed();
+    }
+
+    QCOMPARE(consumed, EVENT_COUNT);
+    QCOMPARE(manager->xPendingCount(streamKey_, "bench"), 0LL);
+    reportThroughput("consume", batchSize, EVENT_COUNT, elapsedMs);
+}
+
+// 端到端: 工作线程读取并确认
+void StreamBenchmark::benchmarkConsumer_data()
+{
+    addBatchSizes();
+}
+
+void StreamBenchmark::benchmarkConsumer()
+{
+    QFETCH(int, batchSize);
+    RedisManager *manager = fixture_->manager();
+
+    preload(EVENT_COUNT);
+
+    RedisStreamConsumerOptions options;
+    options.stream = streamKey_;
+    options.group = "bench";
+    options.consumer = "worker";
+    options.batchSize = batchSize;
+    options.blockMs = 100;
+    options.startId = "0";
+
+    std::atomic<int> handled(0);
+    RedisStreamConsumer consumer(manager, options, [&handled](const QVector<RedisStreamEntry> &entries) {
+        handled += entries.size();
+        return true;
+    });
+
+    qint64 elapsedMs = 0;
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(consumer.start());
+        while (consumer.ackedCount() < EVENT_COUNT && timer.elapsed() < CONSUMER_TIMEOUT_MS) {
+            QThread::msleep(1);
+        }
+        elapsedMs = timer.elapsed();
+        consumer.stop();
+    }
+
+    QCOMPARE(handled.load(), EVENT_COUNT);
+    QCOMPARE(consumer.ackedCount(), static_cast<qint64>(EVENT_COUNT));
+    reportThroughput("consumer", batchSize, EVENT_COUNT, elapsedMs);
+}
+
+QTEST_APPLESS_MAIN(StreamBenchmark)
+#include "tst_streambenchmark.moc"
@@ -0,0 +1,287 @@
+/*
+ * 多线程共享 RedisManager 测试与扩展性基准
+ * 1. 多个 std::thread 与 QThread 共享同一个 RedisManager 并发执行混合操作, 结果正确
+ * 2. 运行期间切换热点键统计与慢调用日志不影响并发调用
+ * 3. 1 ~ 64 个线程下共享一个 RedisManager(连接池大小 = 线程数)与每线程一个 RedisManager 的吞吐对比,
+ *    只输出扩展比例, 吞吐退化由基线回归检查判断
+ * 结果写入 benchmark_results/threadscaling.json
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QThread>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/benchmarkreporter.h"
+
+namespace {
+
+class FunctionThread : public QThread
+{
+public:
+    explicit FunctionThread(std::function<void()> function) : function_(std::move(function)) {}
+
+protected:
+    void run() override { function_(); }
+
+private:
+    std::function<void()> function_;
+};
+
+} // namespace
+
+class ThreadScalingBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    ThreadScalingBenchmark() : fixture_(nullptr), reporter_("threadscaling") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testConcurrentMixedOperations();
+    void testToggleDiagnosticsUnderLoad();
+    void benchmarkScaling_data();
+    void benchmarkScaling();
+    void testSharedManagerScales();
+
+private:
+    RedisConnectionOptions options(int poolSize) const;
+    void runThreads(int threads, const std::function<void(int)> &body, bool useQThread);
+
+    RedisTestFixture *fixture_;
+    BenchmarkReporter reporter_;
+    QString key_;
+    QStringList keys_;
+    QMap<QString, double> opsPerSec_;
+
+    static constexpr int MIXED_THREADS = 16;
+    static constexpr int MIXED_ITERATIONS = 500;
+    static constexpr int DURATION_MS = 1000;
+    static constexpr int MAX_SAMPLES_PER_THREAD = 200000;
+};
+
+RedisConnectionOptions ThreadScalingBenchmark::options(int poolSize) const
+{
+    RedisConnectionOptions result;
+    result.poolSize = poolSize;
+    result.poolWaitTimeoutMs = 5000;
+    result.warmUp = true;
+    return result;
+}
+
+void ThreadScalingBenchmark::runThreads(int threads, const std::function<void(int)> &body, bool useQThread)
+{
+    if (useQThread) {
+        QVector<FunctionThread *> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.append(new FunctionThread([&body, t]() { body(t); }));
+            workers.last()->start();
+        }
+        for (FunctionThread *worker : workers) {
+            worker->wait();
+            delete worker;
+        }
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&body, t]() { body(t); });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadScalingBenchmark::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+    key_ = RedisTestFixture::generateUniqueKey("scaling");
+    QVERIFY(fixture_->manager()->set(key_, QString(64, QChar('v'))));
+}
+
+void ThreadScalingBenchmark::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        fixture_->manager()->del(key_);
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+
+    QVERIFY(reporter_.write());
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("\n")));
+}
+
+void ThreadScalingBenchmark::testConcurrentMixedOperations()
+{
+    RedisManager manager;
+    QVERIFY(manager.connectToServer(options(MIXED_THREADS / 2)));
+
+    const QString base = RedisTestFixture::generateUniqueKey("scaling-mixed");
+    const QString hash = base + ":hash";
+    const QString list = base + ":list";
+    const QString script = "return tonumber(ARGV[1]) * 2";
+    keys_ << hash << list;
+    for (int t = 0; t < MIXED_THREADS; ++t) {
+        keys_ << QString("%1:string:%2").arg(base).arg(t) << QString("%1:set:%2").arg(base).arg(t);
+    }
+
+    std::atomic<int> failures(0);
+    BenchmarkReporter::suppressDebugOutput(true);
+    // 一半线程为 std::thread, 一半为 QThread, 共享同一个 manager
+    for (bool useQThread : {false, true}) {
+        runThreads(MIXED_THREADS / 2, [&](int index) {
+            const int t = index + (useQThread ? MIXED_THREADS / 2 : 0);
+            const QString own = QString("%1:string:%2").arg(base).arg(t);
+            const QString set = QString("%1:set:%2").arg(base).arg(t);
+            for (int i = 0; i < MIXED_ITERATIONS; ++i) {
+                const QString value = QString("%1-%2").arg(t).arg(i);
+                if (!manager.set(own, value) || manager.get(own) != value
+                    || manager.lastCallStatus() != RedisCallStatus::Ok) {
+                    ++failures;
+                }
+                manager.hSet(hash, value, value);
+                manager.rPush(list, value);
+                manager.sAdd(set, value);
+                if (manager.evalInteger(script, {}, {QString::number(i)}) != 2LL * i) {
+                    ++failures;
+                }
+            }
+        }, useQThread);
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+
+    QCOMPARE(failures.load(), 0);
+    QCOMPARE(manager.hLen(hash), MIXED_THREADS * MIXED_ITERATIONS);
+    QCOMPARE(manager.lLen(list), MIXED_THREADS * MIXED_ITERATIONS);
+    for (int t = 0; t < MIXED_THREADS; ++t) {
+        QCOMPARE(manager.sCard(QString("%1:set:%2").arg(base).arg(t)), MIXED_ITERATIONS);
+    }
+}
+
+void ThreadScalingBenchmark::testToggleDiagnosticsUnderLoad()
+{
+    RedisManager manager;
+    QVERIFY(manager.connectToServer(options(8)));
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> failures(0);
+    std::atomic<qint64> calls(0);
+    BenchmarkReporter::suppressDebugOutput(true);
+    std::thread toggler([&]() {
+        RedisHotKeyOptions hotKeys;
+        hotKeys.sampleRate = 1.0;
+        RedisSlowLogOptions slowLog;
+        slowLog.thresholdUs = 0;
+        slowLog.capacity = 16;
+        while (!stop.load()) {
+            manager.enableHotKeyTracking(hotKeys);
+            manager.enableSlowLog(slowLog);
+            QThread::msleep(5);
+            manager.hotKeyReport();
+            manager.slowLogEntries();
+            manager.disableHotKeyTracking();
+            manager.disableSlowLog();
+            QThread::msleep(5);
+        }
+    });
+    runThreads(8, [&](int) {
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < DURATION_MS / 2) {
+            if (manager.get(key_).size() != 64) {
+                ++failures;
+            }
+            ++calls;
+        }
+    }, false);
+    stop.store(true);
+    toggler.join();
+    BenchmarkReporter::suppressDebugOutput(false);
+
+    QCOMPARE(failures.load(), 0);
+    QVERIFY(calls.load() > 0);
+}
+
+void ThreadScalingBenchmark::benchmarkScaling_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<bool>("shared");
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        QTest::newRow(qPrintable(QString("shared_t%1").arg(threads))) << threads << true;
+        QTest::newRow(qPrintable(QString("perthread_t%1").arg(threads))) << threads << false;
+    }
+}
+
+void ThreadScalingBenchmark::benchmarkScaling()
+{
+    QFETCH(int, threads);
+    QFETCH(bool, shared);
+
+    // 共享: 一个 manager, 连接池大小 = 线程数; 对照: 每个线程一个 manager(各自一个连接)
+    QVector<RedisManager *> managers;
+    for (int i = 0; i < (shared ? 1 : threads); ++i) {
+        managers.append(new RedisManager());
+        QVERIFY(managers.last()->connectToServer(options(shared ? threads : 1)));
+    }
+
+    std::mutex mutex;
+    QVector<qint64> latenciesNs;
+    std::atomic<int> failures(0);
+    QElapsedTimer total;
+    BenchmarkReporter::suppressDebugOutput(true);
+    total.start();
+    runThreads(threads, [&](int t) {
+        RedisManager *manager = managers.at(shared ? 0 : t);
+        QVector<qint64> local;
+        local.reserve(MAX_SAMPLES_PER_THREAD);
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < DURATION_MS && local.size() < MAX_SAMPLES_PER_THREAD) {
+            const qint64 start = timer.nsecsElapsed();
+            if (manager->get(key_).isEmpty()) {
+                ++failures;
+            }
+            local.append(timer.nsecsElapsed() - start);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        latenciesNs += local;
+    }, false);
+    const qint64 elapsedNs = total.nsecsElapsed();
+    BenchmarkReporter::suppressDebugOutput(false);
+    qDeleteAll(managers);
+
+    QCOMPARE(failures.load(), 0);
+    BenchmarkResult result = BenchmarkReporter::summarize(shared ? "getShared" : "getPerThread", threads, 64,
+                                                          latenciesNs, elapsedNs);
+    reporter_.record(result);
+    opsPerSec_.insert(QTest::currentDataTag(), result.opsPerSec);
+    qDebug() << "RESULT:" << QTest::currentDataTag() << result.opsPerSec << "ops/s, p99" << result.p99Us << "us";
+}
+
+void ThreadScalingBenchmark::testSharedManagerScales()
+{
+    // 扩展比例取决于核数与机器负载, 不做固定阈值判断; 各档吞吐已由 reporter_ 记录,
+    // 相对基线的下降由 cleanupTestCase 中的回归检查发现
+    const double single = opsPerSec_.value("shared_t1");
+    QVERIFY(single > 0.0);
+    for (int threads : {2, 4, 8, 16, 32, 64}) {
+        const double sharedOps = opsPerSec_.value(QString("shared_t%1").arg(threads));
+        const double perThreadOps = opsPerSec_.value(QString("perthread_t%1").arg(threads));
+        qDebug() << "RESULT: threads" << threads << "shared/1-thread" << sharedOps / single
+                 << "shared/per-thread" << (perThreadOps > 0.0 ? sharedOps / perThreadOps : 0.0);
+    }
+}
+
+QTEST_APPLESS_MAIN(ThreadScalingBenchmark)
+#include "tst_threadscalingbenchmark.moc"
@@ -0,0 +1,192 @@
+/*
+ * 工作队列吞吐基准测试
+ * 测量 RedisWorkQueue 在不同消费线程数与批大小下的 jobs/sec,
+ * 以及失效消费者处理中任务的恢复
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QThread>
+#include <atomic>
+#include <functional>
+#include "../fixtures/redistestfixture.h"
+#include "../../RedisModule/messaging/redisworkqueue.h"
+
+class WorkQueueBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    WorkQueueBenchmark() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void benchmarkThroughput_data();
+    void benchmarkThroughput();
+
+    void testFailedJobsAreRequeued();
+    void testStaleConsumerRecovery();
+
+private:
+    void preload(int count);
+    bool waitFor(const std::function<bool()> &condition, int timeoutMs);
+
+    RedisTestFixture *fixture_;
+    QString queueName_;
+
+    static constexpr int JOB_COUNT = 20000;
+    static constexpr int PRELOAD_CHUNK = 1000;
+    static constexpr int POOL_SIZE = 16;
+    static constexpr int WAIT_TIMEOUT_MS = 60000;
+};
+
+void WorkQueueBenchmark::initTestCase()
+{
+    // 每个消费线程阻塞时独占一条连接
+    RedisConnectionOptions options;
+    options.poolSize = POOL_SIZE;
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(options), "Failed to connect to Redis server");
+}
+
+void WorkQueueBenchmark::cleanupTestCase()
+{
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void WorkQueueBenchmark::init()
+{
+    queueName_ = RedisTestFixture::generateUniqueKey("workqueue");
+}
+
+void WorkQueueBenchmark::cleanup()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : fixture_->manager()->keys(queueName_ + "*")) {
+            fixture_->manager()->del(key);
+        }
+    }
+}
+
+void WorkQueueBenchmark::preload(int count)
+{
+    for (int offset = 0; offset < count; offset += PRELOAD_CHUNK) {
+        QVector<QString> jobs;
+        for (int i = offset; i < qMin(count, offset + PRELOAD_CHUNK); ++i) {
+            jobs.append(QString("job-%1").arg(i));
+        }
+        QVERIFY(fixture_->manager()->rPush(queueName_, jobs));
+    }
+}
+
+bool WorkQueueBenchmark::waitFor(const std::function<bool()> &condition, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QThread::msleep(1);
+    }
+    return true;
+}
+
+void WorkQueueBenchmark::benchmarkThroughput_data()
+{
+    QTest::addColumn<int>("consumers");
+    QTest::addColumn<int>("batchSize");
+    QTest::newRow("consumers_1_batch_1") << 1 << 1;
+    QTest::newRow("consumers_1_batch_10") << 1 << 10;
+    QTest::newRow("consumers_2_batch_10") << 2 << 10;
+    QTest::newRow("consumers_4_batch_10") << 4 << 10;
+    QTest::newRow("consumers_8_batch_10") << 8 << 10;
+    QTest::newRow("consumers_8_batch_100") << 8 << 100;
+}
+
+void WorkQueueBenchmark::benchmarkThroughput()
+{
+    QFETCH(int, consumers);
+    QFETCH(int, batchSize);
+
+    preload(JOB_COUNT);
+
+    RedisWorkQueueOptions options;
+    options.name = queueName_;
+    options.consumerCount = consumers;
+    options.batchSize = batchSize;
+    RedisWorkQueue queue(fixture_->manager(), options, [](const QString &) { return true; });
+
+    qint64 elapsedMs = 0;
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(queue.start());
+        QVERIFY(waitFor([&queue]() { return queue.processedCount() >= JOB_COUNT; }, WAIT_TIMEOUT_MS));
+        elapsedMs = timer.elapsed();
+        queue.stop();
+    }
+
+    QCOMPARE(queue.processedCount(), static_cast<qint64>(JOB_COUNT));
+    QCOMPARE(queue.pendingCount(), 0);
+    double jobsPerSec = elapsedMs > 0 ? JOB_COUNT * 1000.0 / elapsedMs : 0.0;
+    qDebug() << "RESULT: consumers" << consumers << "batch" << batchSize << "jobs" << JOB_COUNT
+             << "elapsed" << elapsedMs << "ms," << qRound64(jobsPerSec) << "jobs/sec";
+}
+
+void WorkQueueBenchmark::testFailedJobsAreRequeued()
+{
+    std::atomic<int> attempts(0);
+    RedisWorkQueueOptions options;
+    options.name = queueName_;
+    RedisWorkQueue queue(fixture_->manager(), options, [&attempts](const QString &) {
+        // 第一次处理失败, 重新投递后成功
+        return ++attempts > 1;
+    });
+
+    QVERIFY(queue.enqueue("flaky"));
+    QVERIFY(queue.start());
+    QVERIFY(waitFor([&queue]() { return queue.processedCount() == 1; }, 5000));
+    queue.stop();
+
+    QCOMPARE(queue.failedCount(), 1LL);
+    QCOMPARE(attempts.load(), 2);
+    QCOMPARE(queue.pendingCount(), 0);
+}
+
+void WorkQueueBenchmark::testStaleConsumerRecovery()
+{
+    RedisManager *manager = fixture_->manager();
+
+    // 模拟认领后崩溃的消费者: 处理中列表有任务, 已注册但没有心跳
+    const QString dead = "crashed-0";
+    QVERIFY(manager->rPush(queueName_ + ":processing:" + dead, QVector<QString>{"lost-1", "lost-2", "lost-3"}));
+    QVERIFY(manager->sAdd(queueName_ + ":consumers", dead));
+
+    std::atomic<int> handled(0);
+    RedisWorkQueueOptions options;
+    options.name = queueName_;
+    options.recoveryIntervalMs = 100;
+    RedisWorkQueue queue(manager, options, [&handled](const QString &) {
+        ++handled;
+        return true;
+    });
+
+    QVERIFY(queue.start());
+    QVERIFY(waitFor([&queue]() { return queue.processedCount() == 3; }, 5000));
+    queue.stop();
+
+    QCOMPARE(queue.recoveredCount(), 3LL);
+    QCOMPARE(handled.load(), 3);
+    QCOMPARE(manager->lLen(queueName_ + ":processing:" + dead), 0);
+    QVERIFY(!manager->sIsMember(queueName_ + ":consumers", dead));
+}
+
+QTEST_APPLESS_MAIN(WorkQueueBenchmark)
+#include "tst_workqueuebenchmark.moc"
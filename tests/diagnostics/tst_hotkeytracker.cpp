@@ -0,0 +1,223 @@
+/*
+ * 热点键统计测试
+ * 1. 偏斜访问下 top-K 能找出热点键, 估计次数接近实际
+ * 2. 通过操作层调用时统计增加的开销(未启用 / 默认采样率), 报告两者之比
+ * 3. 通过 RedisManager 调用时按命令归类, 周期报告与窗口重置
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QThread>
+#include <atomic>
+#include "../fixtures/redistestfixture.h"
+#include "../../RedisModule/tool/redishotkeytracker.h"
+
+class HotKeyTrackerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    HotKeyTrackerTest() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testFindsHeavyHitters();
+    void testDisabledRecordsNothing();
+    void benchmarkExecuteOverhead();
+    void testManagerReportsPerCommand();
+    void testPeriodicReport();
+
+private:
+    RedisTestFixture *fixture_;
+
+    static constexpr int CALLS = 200000;
+    static constexpr int COLD_KEYS = 10000;
+    static constexpr int OVERHEAD_CALLS = 200000;
+    static constexpr int OVERHEAD_ROUNDS = 5;
+};
+
+void HotKeyTrackerTest::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+}
+
+void HotKeyTrackerTest::cleanupTestCase()
+{
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void HotKeyTrackerTest::testFindsHeavyHitters()
+{
+    RedisHotKeyOptions options;
+    options.sampleRate = 1.0 / 16;
+    options.topK = 5;
+    RedisHotKeyTracker tracker;
+    tracker.enable(options);
+
+    // img:all 占 30%, img:stats 占 10%, 其余均匀分布在大量冷键上
+    QVector<QString> cold;
+    for (int i = 0; i < COLD_KEYS; ++i) {
+        cold.append(QString("img:data:%1").arg(i));
+    }
+    const QString all("img:all");
+    const QString stats("img:stats");
+    for (int i = 0; i < CALLS; ++i) {
+        const int bucket = i % 10;
+        if (bucket < 3) {
+            tracker.record("GET", all);
+        } else if (bucket == 3) {
+            tracker.record("HGETALL", stats);
+        } else {
+            tracker.record("GET", cold.at(i % COLD_KEYS));
+        }
+    }
+
+    RedisHotKeyReport report = tracker.report();
+    qDebug().noquote() << report.toText();
+    QCOMPARE(report.samplePeriod, 16);
+    QVERIFY(!report.topKeys.isEmpty());
+    QCOMPARE(report.topKeys.at(0).key, all);
+    QCOMPARE(report.topKeys.at(1).key, stats);
+
+    const qint64 expectedAll = CALLS * 3 / 10;
+    QVERIFY2(qAbs(report.topKeys.at(0).estimatedCalls - expectedAll) < expectedAll / 5,
+             qPrintable(QString("estimated %1 calls").arg(report.topKeys.at(0).estimatedCalls)));
+    QVERIFY(qAbs(report.estimatedCalls - CALLS) < CALLS / 10);
+
+    QCOMPARE(report.commands.size(), 2);
+    QCOMPARE(report.commands.first().operation, QString("GET"));
+    QCOMPARE(report.commands.first().hotKeys.first().key, all);
+
+    tracker.reset();
+    QCOMPARE(tracker.report().sampledCalls, 0LL);
+}
+
+void HotKeyTrackerTest::testDisabledRecordsNothing()
+{
+    RedisHotKeyTracker tracker;
+    QVERIFY(!tracker.isEnabled());
+    for (int i = 0; i < 1000; ++i) {
+        tracker.record("GET", "img:all");
+    }
+    QCOMPARE(tracker.report().sampledCalls, 0LL);
+
+    RedisHotKeyOptions options;
+    options.sampleRate = 1.0;
+    tracker.enable(options);
+    tracker.record("GET", "img:all");
+    tracker.disable();
+    tracker.record("GET", "img:all");
+    QCOMPARE(tracker.report().sampledCalls, 1LL);
+}
+
+void HotKeyTrackerTest::benchmarkExecuteOverhead()
+{
+    RedisManager *manager = fixture_->manager();
+    QVector<QString> keys;
+    for (int i = 0; i < 1024; ++i) {
+        keys.append(QString("img:data:%1").arg(i));
+    }
+
+    // 截止时间已过期的调用走完操作层(构造命令参数、记录热点键、慢调用计时、检查连接)后不发送,
+    // 测得的是统计本身在 execute() 中增加的开销而不是网络往返; 两种状态交替测量, 各取最小值
+    auto measure = [&]() {
+        RedisCallContext ctx(0);
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < OVERHEAD_CALLS; ++i) {
+            manager->get(keys.at(i & 1023));
+        }
+        return static_cast<double>(timer.nsecsElapsed()) / OVERHEAD_CALLS;
+    };
+
+    double disabledNs = 0.0;
+    double enabledNs = 0.0;
+    qint64 sampled = 0;
+    QBENCHMARK_ONCE {
+        for (int round = 0; round < OVERHEAD_ROUNDS; ++round) {
+            manager->disableHotKeyTracking();
+            const double off = measure();
+            manager->enableHotKeyTracking(RedisHotKeyOptions());
+            const double on = measure();
+            sampled += manager->hotKeyReport().sampledCalls;
+            manager->disableHotKeyTracking();
+            disabledNs = round == 0 ? off : qMin(disabledNs, off);
+            enabledNs = round == 0 ? on : qMin(enabledNs, on);
+        }
+    }
+
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::DeadlineExceeded);
+    QVERIFY(sampled > 0);
+    qDebug() << "RESULT: execute disabled" << disabledNs << "ns/call";
+    qDebug() << "RESULT: execute default_rate" << enabledNs << "ns/call";
+    qDebug() << "RESULT: hot-key tracking adds" << enabledNs - disabledNs << "ns/call, ratio"
+             << enabledNs / disabledNs;
+}
+
+void HotKeyTrackerTest::testManagerReportsPerCommand()
+{
+    RedisManager *manager = fixture_->manager();
+    const QString hot = RedisTestFixture::generateUniqueKey("hotkey");
+    const QString cold = RedisTestFixture::generateUniqueKey("coldkey");
+    QVERIFY(manager->set(hot, "1"));
+
+    RedisHotKeyOptions options;
+    options.sampleRate = 1.0;
+    manager->enableHotKeyTracking(options);
+    QVERIFY(manager->isHotKeyTrackingEnabled());
+    for (int i = 0; i < 200; ++i) {
+        manager->get(hot);
+    }
+    for (int i = 0; i < 20; ++i) {
+        manager->exists(cold);
+    }
+    RedisHotKeyReport report = manager->hotKeyReport();
+    manager->disableHotKeyTracking();
+    manager->del(hot);
+
+    QCOMPARE(report.sampledCalls, 220LL);
+    QCOMPARE(report.commands.size(), 2);
+    QCOMPARE(report.commands.at(0).operation, QString("GET"));
+    QCOMPARE(report.commands.at(0).hotKeys.first().key, hot);
+    QCOMPARE(report.commands.at(0).hotKeys.first().estimatedCalls, 200LL);
+    QCOMPARE(report.commands.at(1).operation, QString("EXISTS"));
+    QCOMPARE(report.topKeys.first().key, hot);
+}
+
+void HotKeyTrackerTest::testPeriodicReport()
+{
+    RedisHotKeyTracker tracker;
+    std::atomic<int> reports(0);
+    std::atomic<qint64> lastSampled(-1);
+    tracker.setReportHandler([&](const RedisHotKeyReport &report) {
+        lastSampled = report.sampledCalls;
+        ++reports;
+    });
+
+    RedisHotKeyOptions options;
+    options.sampleRate = 1.0;
+    options.reportIntervalMs = 100;
+    tracker.enable(options);
+    for (int i = 0; i < 50; ++i) {
+        tracker.record("GET", "img:all");
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    while (reports.load() == 0 && timer.elapsed() < 2000) {
+        QThread::msleep(10);
+    }
+    tracker.disable();
+    QVERIFY(reports.load() >= 1);
+    QVERIFY(lastSampled.load() >= 0);
+    // 每个周期报告后开始新的窗口
+    QCOMPARE(tracker.report().sampledCalls, 0LL);
+}
+
+QTEST_APPLESS_MAIN(HotKeyTrackerTest)
+#include "tst_hotkeytracker.moc"
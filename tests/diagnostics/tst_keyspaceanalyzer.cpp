@@ -0,0 +1,238 @@
+/*
+ * 键空间内存分析测试
+ * 在独立前缀下写入三类键, 验证:
+ * 1. 按前缀模式分组的键数、类型、编码与 TTL 分布
+ * 2. 最大键排序与未匹配键的自动分组
+ * 3. 抽样推算、扫描上限与限速
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include "../fixtures/redistestfixture.h"
+#include "../../RedisModule/diagnostics/rediskeyspaceanalyzer.h"
+
+class KeyspaceAnalyzerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    KeyspaceAnalyzerTest() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testGroupsByPattern();
+    void testLargestKeys();
+    void testAutoGrouping();
+    void testSampling();
+    void testMaxKeys();
+    void testRateLimit();
+
+private:
+    RedisKeyspaceAnalyzerOptions options() const;
+    const RedisKeyspaceGroupStats *findGroup(const RedisKeyspaceReport &report, const QString &group) const;
+
+    RedisTestFixture *fixture_;
+    QString base_;
+    QStringList keys_;
+
+    static constexpr int DATA_KEYS = 200;
+    static constexpr int META_KEYS = 20;
+    static constexpr int TAG_KEYS = 10;
+    static constexpr int BIG_HASH_FIELDS = 1000;
+};
+
+void KeyspaceAnalyzerTest::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+    RedisManager *manager = fixture_->manager();
+
+    base_ = RedisTestFixture::generateUniqueKey("keyspace");
+    const QString value(256, QChar('x'));
+    for (int i = 0; i < DATA_KEYS; ++i) {
+        keys_ << QString("%1:img:data:%2").arg(base_).arg(i);
+        QVERIFY(manager->set(keys_.last(), value));
+    }
+    for (int i = 0; i < META_KEYS; ++i) {
+        keys_ << QString("%1:img:meta:%2").arg(base_).arg(i);
+        QVERIFY(manager->hSet(keys_.last(), {{"width", "640"}, {"height", "480"}}));
+    }
+    for (int i = 0; i < TAG_KEYS; ++i) {
+        keys_ << QString("%1:img:tag:%2").arg(base_).arg(i);
+        QVERIFY(manager->sAdd(keys_.last(), QVector<QString>{"cat", "dog"}));
+        QVERIFY(manager->expire(keys_.last(), 7200));
+    }
+
+    // 超过 listpack 上限的大哈希, 编码为 hashtable
+    QMap<QString, QString> fields;
+    for (int i = 0; i < BIG_HASH_FIELDS; ++i) {
+        fields.insert(QString("field%1").arg(i), value);
+    }
+    keys_ << QString("%1:img:meta:big").arg(base_);
+    QVERIFY(manager->hSet(keys_.last(), fields));
+
+    keys_ << QString("%1:other:counter").arg(base_);
+    QVERIFY(manager->set(keys_.last(), "1"));
+}
+
+void KeyspaceAnalyzerTest::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        for (const auto &key : keys_) {
+            fixture_->manager()->del(key);
+        }
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+RedisKeyspaceAnalyzerOptions KeyspaceAnalyzerTest::options() const
+{
+    RedisKeyspaceAnalyzerOptions options;
+    options.groupPatterns = {base_ + ":img:data:*", base_ + ":img:meta:*", base_ + ":img:tag:*"};
+    options.matchPattern = base_ + ":*";
+    options.maxKeysPerSecond = 0;
+    return options;
+}
+
+const RedisKeyspaceGroupStats *KeyspaceAnalyzerTest::findGroup(const RedisKeyspaceReport &report,
+                                                               const QString &group) const
+{
+    for (const auto &stats : report.groups) {
+        if (stats.group == group) {
+            return &stats;
+        }
+    }
+    return nullptr;
+}
+
+void KeyspaceAnalyzerTest::testGroupsByPattern()
+{
+    RedisKeyspaceAnalyzer analyzer(fixture_->manager(), options());
+    RedisKeyspaceReport report = analyzer.analyze();
+    qDebug().noquote() << report.toText();
+
+    QVERIFY(report.complete);
+    QVERIFY(!analyzer.hasError());
+    QCOMPARE(report.scannedKeys, static_cast<qint64>(keys_.size()));
+    QCOMPARE(report.sampledKeys, report.scannedKeys);
+
+    const RedisKeyspaceGroupStats *data = findGroup(report, base_ + ":img:data:*");
+    QVERIFY(data);
+    QCOMPARE(data->keys, static_cast<qint64>(DATA_KEYS));
+    QCOMPARE(data->types.value("string"), static_cast<qint64>(DATA_KEYS));
+    QVERIFY(data->bytes >= DATA_KEYS * 256LL);
+    QCOMPARE(data->estimatedBytes, data->bytes);
+    QCOMPARE(data->ttlBuckets.at(0), static_cast<qint64>(DATA_KEYS));
+
+    const RedisKeyspaceGroupStats *meta = findGroup(report, base_ + ":img:meta:*");
+    QVERIFY(meta);
+    QCOMPARE(meta->keys, static_cast<qint64>(META_KEYS + 1));
+    QCOMPARE(meta->types.value("hash"), static_cast<qint64>(META_KEYS + 1));
+    QCOMPARE(meta->encodings.value("hashtable"), 1LL);
+    // Redis 7 起小哈希编码为 listpack, 之前为 ziplist
+    QCOMPARE(meta->encodings.value("listpack") + meta->encodings.value("ziplist"),
+             static_cast<qint64>(META_KEYS));
+
+    const RedisKeyspaceGroupStats *tag = findGroup(report, base_ + ":img:tag:*");
+    QVERIFY(tag);
+    QCOMPARE(tag->types.value("set"), static_cast<qint64>(TAG_KEYS));
+    const int dayBucket = RedisKeyspaceReport::ttlBucketLabels().indexOf("<1d");
+    QCOMPARE(tag->ttlBuckets.at(dayBucket), static_cast<qint64>(TAG_KEYS));
+
+    // 大哈希所在分组内存最多, 排在最前
+    QCOMPARE(report.groups.first().group, base_ + ":img:meta:*");
+}
+
+void KeyspaceAnalyzerTest::testLargestKeys()
+{
+    RedisKeyspaceAnalyzerOptions opts = options();
+    opts.topKeys = 5;
+    RedisKeyspaceAnalyzer analyzer(fixture_->manager(), opts);
+    RedisKeyspaceReport report = analyzer.analyze();
+
+    QCOMPARE(report.largestKeys.size(), 5);
+    QCOMPARE(report.largestKeys.first().key, base_ + ":img:meta:big");
+    QCOMPARE(report.largestKeys.first().encoding, QString("hashtable"));
+    for (int i = 1; i < report.largestKeys.size(); ++i) {
+        QVERIFY(report.largestKeys.at(i - 1).bytes >= report.largestKeys.at(i).bytes);
+    }
+}
+
+void KeyspaceAnalyzerTest::testAutoGrouping()
+{
+    RedisKeyspaceAnalyzerOptions opts = options();
+    opts.groupPatterns.clear();
+    opts.autoGroupDepth = 3;
+    RedisKeyspaceAnalyzer analyzer(fixture_->manager(), opts);
+
+    QCOMPARE(analyzer.groupOf(base_ + ":img:tag:7"), base_ + ":img:tag:*");
+    QCOMPARE(analyzer.groupOf(base_ + ":other:counter"), base_ + ":other:*");
+    QCOMPARE(analyzer.groupOf("counter"), QString("(no prefix)"));
+
+    RedisKeyspaceReport report = analyzer.analyze();
+    const RedisKeyspaceGroupStats *data = findGroup(report, base_ + ":img:data:*");
+    QVERIFY(data);
+    QCOMPARE(data->keys, static_cast<qint64>(DATA_KEYS));
+}
+
+void KeyspaceAnalyzerTest::testSampling()
+{
+    RedisKeyspaceAnalyzerOptions opts = options();
+    opts.groupPatterns = {base_ + ":img:data:*"};
+    opts.matchPattern = base_ + ":img:data:*";
+    RedisKeyspaceAnalyzer full(fixture_->manager(), opts);
+    const qint64 fullBytes = full.analyze().totalBytes;
+
+    opts.sampleRate = 0.5;
+    RedisKeyspaceAnalyzer analyzer(fixture_->manager(), opts);
+    RedisKeyspaceReport report = analyzer.analyze();
+
+    QCOMPARE(report.scannedKeys, static_cast<qint64>(DATA_KEYS));
+    QVERIFY2(report.sampledKeys > DATA_KEYS / 4 && report.sampledKeys < DATA_KEYS * 3 / 4,
+             qPrintable(QString("sampled %1 keys").arg(report.sampledKeys)));
+
+    // 各键大小接近, 推算值应接近全量统计
+    QVERIFY(report.totalBytes < fullBytes);
+    QVERIFY2(qAbs(report.estimatedBytes - fullBytes) < fullBytes / 10,
+             qPrintable(QString("estimated %1 bytes, actual %2").arg(report.estimatedBytes).arg(fullBytes)));
+}
+
+void KeyspaceAnalyzerTest::testMaxKeys()
+{
+    RedisKeyspaceAnalyzerOptions opts = options();
+    opts.maxKeys = 10;
+    opts.scanCount = 7;
+    RedisKeyspaceAnalyzer analyzer(fixture_->manager(), opts);
+    RedisKeyspaceReport report = analyzer.analyze();
+
+    QVERIFY(report.complete);
+    QCOMPARE(report.scannedKeys, 10LL);
+    QVERIFY(!analyzer.step());
+}
+
+void KeyspaceAnalyzerTest::testRateLimit()
+{
+    RedisKeyspaceAnalyzerOptions opts = options();
+    opts.matchPattern = base_ + ":img:data:*";
+    opts.scanCount = 20;
+    opts.maxKeysPerSecond = 1000;
+    RedisKeyspaceAnalyzer analyzer(fixture_->manager(), opts);
+
+    QElapsedTimer timer;
+    timer.start();
+    RedisKeyspaceReport report = analyzer.analyze();
+    qint64 elapsed = timer.elapsed();
+
+    QCOMPARE(report.scannedKeys, static_cast<qint64>(DATA_KEYS));
+    // 最后一批之后不再等待, 至少经过前面各批对应的时间
+    QVERIFY2(elapsed >= (DATA_KEYS - 2 * opts.scanCount) * 1000 / opts.maxKeysPerSecond,
+             qPrintable(QString("scan took %1ms").arg(elapsed)));
+    qDebug() << "RESULT: rate-limited scan of" << report.scannedKeys << "keys in" << elapsed << "ms";
+}
+
+QTEST_APPLESS_MAIN(KeyspaceAnalyzerTest)
+#include "tst_keyspaceanalyzer.moc"
@@ -0,0 +1,265 @@
+/*
+ * 客户端慢调用日志测试
+ * 1. 阈值过滤、环形缓冲区覆盖与记录内容(命令、键、值大小、状态)
+ * 2. 与服务器 SLOWLOG 对照: 服务器端耗时长的脚本拆分出服务器执行时间
+ * 3. 对照规则(命令名映射、键截断、每条服务器记录只对应一次、阈值上界、延迟事件)
+ * 4. 未启用 / 启用但未超过阈值时的计时开销
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include "../fixtures/redistestfixture.h"
+#include "../../RedisModule/tool/redisslowlog.h"
+
+class SlowLogTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SlowLogTest() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cleanup();
+
+    void testThresholdAndRing();
+    void testEntryContents();
+    void testServerCorrelation();
+    void testCorrelationRules();
+    void benchmarkTimerOverhead_data();
+    void benchmarkTimerOverhead();
+
+private:
+    RedisTestFixture *fixture_;
+    QString previousServerThreshold_;
+
+    static constexpr int TIMER_CALLS = 1000000;
+    // 服务器端忙循环次数, 约几十毫秒
+    static constexpr int SCRIPT_LOOPS = 3000000;
+};
+
+void SlowLogTest::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+    previousServerThreshold_ = fixture_->manager()->configGet("slowlog-log-slower-than");
+}
+
+void SlowLogTest::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager() && !previousServerThreshold_.isEmpty()) {
+        fixture_->manager()->configSet("slowlog-log-slower-than", previousServerThreshold_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void SlowLogTest::cleanup()
+{
+    fixture_->manager()->disableSlowLog();
+    fixture_->manager()->clearSlowLog();
+}
+
+void SlowLogTest::testThresholdAndRing()
+{
+    RedisManager *manager = fixture_->manager();
+    const QString key = RedisTestFixture::generateUniqueKey("slowlog");
+
+    // 阈值很高时不记录
+    RedisSlowLogOptions options;
+    options.thresholdUs = 60LL * 1000 * 1000;
+    manager->enableSlowLog(options);
+    QVERIFY(manager->isSlowLogEnabled());
+    manager->get(key);
+    QVERIFY(manager->slowLogEntries().isEmpty());
+
+    // 阈值为 0 时每次调用都记录, 只保留最近 capacity 条
+    options.thresholdUs = 0;
+    options.capacity = 4;
+    manager->enableSlowLog(options);
+    for (int i = 0; i < 10; ++i) {
+        manager->exists(key);
+    }
+    QVector<RedisSlowLogEntry> entries = manager->slowLogEntries();
+    QCOMPARE(entries.size(), 4);
+    for (int i = 1; i < entries.size(); ++i) {
+        QCOMPARE(entries.at(i).id, entries.at(i - 1).id - 1);
+    }
+    QCOMPARE(entries.first().id, 9LL);
+
+    manager->disableSlowLog();
+    manager->exists(key);
+    QCOMPARE(manager->slowLogEntries().first().id, 9LL);
+}
+
+void SlowLogTest::testEntryContents()
+{
+    RedisManager *manager = fixture_->manager();
+    const QString key = RedisTestFixture::generateUniqueKey("slowlog");
+    const QString value(1000, QChar('x'));
+
+    RedisSlowLogOptions options;
+    options.thresholdUs = 0;
+    manager->enableSlowLog(options);
+    const qint64 before = QDateTime::currentMSecsSinceEpoch();
+    QVERIFY(manager->set(key, value));
+    QVERIFY(manager->del(key));
+    manager->mGet({key});
+
+    QVector<RedisSlowLogEntry> entries = manager->slowLogEntries();
+    QCOMPARE(entries.size(), 3);
+
+    const RedisSlowLogEntry &set = entries.at(2);
+    QCOMPARE(set.operation, QString("SET"));
+    QCOMPARE(set.key, key);
+    QCOMPARE(set.keyBytes, static_cast<qint64>(key.toUtf8().size()));
+    QCOMPARE(set.valueSize, 1000LL);
+    QCOMPARE(set.status, RedisCallStatus::Ok);
+    QVERIFY(set.timestampMs >= before - 1 && set.timestampMs <= QDateTime::currentMSecsSinceEpoch());
+
+    QCOMPARE(entries.at(1).operation, QString("DEL"));
+    QCOMPARE(entries.at(1).valueSize, 0LL);
+    // 多键命令不记录键
+    QCOMPARE(entries.at(0).operation, QString("MGET"));
+    QVERIFY(entries.at(0).key.isEmpty());
+}
+
+void SlowLogTest::testServerCorrelation()
+{
+    RedisManager *manager = fixture_->manager();
+    QVERIFY(manager->configSet("slowlog-log-slower-than", "1000"));
+    QVERIFY(manager->slowlogReset());
+
+    RedisSlowLogOptions options;
+    options.thresholdUs = 1000;
+    manager->enableSlowLog(options);
+
+    // 服务器端忙循环: 耗时主要在服务器内
+    const QString script = "local i = 0 while i < tonumber(ARGV[1]) do i = i + 1 end return i";
+    QCOMPARE(manager->evalInteger(script, {}, {QString::number(SCRIPT_LOOPS)}),
+             static_cast<long long>(SCRIPT_LOOPS));
+
+    RedisSlowLogReport report = manager->slowLogReport();
+    qDebug().noquote() << report.toText();
+    QCOMPARE(report.serverThresholdUs, 1000LL);
+
+    const RedisSlowCallBreakdown *eval = nullptr;
+    for (const auto &call : report.calls) {
+        if (call.call.operation == "EVALSHA") {
+            eval = &call;
+        }
+    }
+    QVERIFY2(eval, "script call not recorded by the client slow log");
+    QVERIFY2(eval->serverExact, "script call not found in server SLOWLOG");
+    QCOMPARE(eval->server.args.first().toUpper(), QString("EVALSHA"));
+    QVERIFY(eval->serverUs >= 1000);
+    QVERIFY(eval->serverUs <= eval->call.latencyUs);
+    QCOMPARE(eval->outsideServerUs, eval->call.latencyUs - eval->serverUs);
+    qDebug() << "RESULT: script client" << eval->call.latencyUs << "us, server" << eval->serverUs << "us";
+}
+
+void SlowLogTest::testCorrelationRules()
+{
+    const qint64 nowMs = 1700000000000LL;
+    const QString longKey = QString("img:data:") + QString(200, QChar('k'));
+
+    QVector<RedisSlowLogEntry> calls(4);
+    calls[0].operation = "BYTES_GET";
+    calls[0].key = "img:data:1";
+    calls[0].latencyUs = 8000;
+    calls[0].timestampMs = nowMs;
+    calls[1].operation = "BYTES_GET";
+    calls[1].key = "img:data:1";
+    calls[1].latencyUs = 6000;
+    calls[1].timestampMs = nowMs - 10;
+    calls[2].operation = "HSET_MULTI";
+    calls[2].key = longKey;
+    calls[2].latencyUs = 30000;
+    calls[2].timestampMs = nowMs + 5000;
+    calls[3].operation = "GET";
+    calls[3].key = "img:data:2";
+    calls[3].latencyUs = 20000;
+    calls[3].timestampMs = nowMs;
+
+    QVector<RedisServerSlowLogEntry> server(3);
+    server[0].timestamp = nowMs / 1000;
+    server[0].durationUs = 5000;
+    server[0].args = QStringList{"GET", "img:data:1"};
+    // 服务器截断超过 128 字节的参数
+    server[1].timestamp = (nowMs + 5000) / 1000;
+    server[1].durationUs = 25000;
+    server[1].args = QStringList{"HSET", longKey.left(128) + QString("... (%1 more bytes)").arg(longKey.size() - 128)};
+    // 时间相差太远, 不对应任何调用
+    server[2].timestamp = nowMs / 1000 - 60;
+    server[2].durationUs = 15000;
+    server[2].args = QStringList{"get", "img:data:2"};
+
+    QVector<RedisLatencyEvent> events(1);
+    events[0].event = "fork";
+    events[0].timestamp = (nowMs + 5000) / 1000;
+    events[0].latestMs = 12;
+
+    RedisSlowLogReport report = RedisSlowLog::correlate(calls, server, events, 10000);
+    qDebug().noquote() << report.toText();
+    QCOMPARE(report.calls.size(), 4);
+
+    // 同一条服务器记录只对应第一次匹配的调用
+    QVERIFY(report.calls.at(0).serverExact);
+    QCOMPARE(report.calls.at(0).serverUs, 5000LL);
+    QCOMPARE(report.calls.at(0).outsideServerUs, 3000LL);
+    QVERIFY(!report.calls.at(1).serverExact);
+    QCOMPARE(report.calls.at(1).serverUs, 6000LL);
+    QCOMPARE(report.calls.at(1).outsideServerUs, 0LL);
+
+    QVERIFY(report.calls.at(2).serverExact);
+    QCOMPARE(report.calls.at(2).serverUs, 25000LL);
+    QCOMPARE(report.calls.at(2).latencyEvents.size(), 1);
+    QCOMPARE(report.calls.at(2).latencyEvents.first().event, QString("fork"));
+
+    // 未出现在服务器日志中: 服务器执行时间低于阈值
+    QVERIFY(!report.calls.at(3).serverExact);
+    QCOMPARE(report.calls.at(3).serverUs, 10000LL);
+    QCOMPARE(report.calls.at(3).outsideServerUs, 10000LL);
+    QVERIFY(report.calls.at(3).latencyEvents.isEmpty());
+
+    // 服务器阈值未知时不给出拆分
+    RedisSlowLogReport unknown = RedisSlowLog::correlate(calls.mid(3), {}, {}, -1);
+    QCOMPARE(unknown.calls.first().serverUs, -1LL);
+    QCOMPARE(unknown.calls.first().outsideServerUs, -1LL);
+}
+
+void SlowLogTest::benchmarkTimerOverhead_data()
+{
+    QTest::addColumn<bool>("enabled");
+    QTest::newRow("disabled") << false;
+    QTest::newRow("below_threshold") << true;
+}
+
+void SlowLogTest::benchmarkTimerOverhead()
+{
+    QFETCH(bool, enabled);
+
+    RedisSlowLog log;
+    if (enabled) {
+        RedisSlowLogOptions options;
+        options.thresholdUs = 60LL * 1000 * 1000;
+        log.enable(options);
+    }
+    const QString operation("GET");
+    const RedisCommandArgs args(QString("img:data:1"));
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < TIMER_CALLS; ++i) {
+        RedisSlowCallTimer call(&log, operation, args);
+    }
+    const double nsPerCall = static_cast<double>(timer.nsecsElapsed()) / TIMER_CALLS;
+    qDebug() << "RESULT: slow log timer" << QTest::currentDataTag() << nsPerCall << "ns/call";
+    QVERIFY(log.entries().isEmpty());
+}
+
+QTEST_APPLESS_MAIN(SlowLogTest)
+#include "tst_slowlog.moc"
@@ -0,0 +1,235 @@
+#include "benchmarkreporter.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QHash>
+#include <QSysInfo>
+#include <algorithm>
+
+namespace {
+
+constexpr double kDefaultTolerance = 0.25;
+QtMessageHandler previousHandler = nullptr;
+bool suppressing = false;
+
+void dropDebugMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type != QtDebugMsg && previousHandler) {
+        previousHandler(type, context, message);
+    }
+}
+
+constexpr qint64 kDefaultMaxCardinality = 1000000;
+
+double percentileUs(const QVector<qint64> &sortedNs, double percentile)
+{
+    if (sortedNs.isEmpty()) {
+        return 0.0;
+    }
+    int index = static_cast<int>(percentile * (sortedNs.size() - 1) + 0.5);
+    return sortedNs.at(std::min(index, sortedNs.size() - 1)) / 1000.0;
+}
+
+QString resultDir()
+{
+    QString dir = qEnvironmentVariable("BENCHMARK_RESULT_DIR");
+    return dir.isEmpty() ? QDir::current().filePath("benchmark_results") : dir;
+}
+
+} // namespace
+
+QJsonObject BenchmarkResult::toJson() const
+{
+    QJsonObject latency;
+    latency["min"] = minUs;
+    latency["mean"] = meanUs;
+    latency["p50"] = p50Us;
+    latency["p90"] = p90Us;
+    latency["p99"] = p99Us;
+    latency["p999"] = p999Us;
+    latency["max"] = maxUs;
+
+    QJsonObject object;
+    object["name"] = name;
+    object["operation"] = operation;
+    object["cardinality"] = cardinality;
+    object["valueSize"] = valueSize;
+    object["iterations"] = iterations;
+    object["opsPerSec"] = opsPerSec;
+    object["latencyUs"] = latency;
+    return object;
+}
+
+BenchmarkResult BenchmarkResult::fromJson(const QJsonObject &object)
+{
+    BenchmarkResult result;
+    result.name = object["name"].toString();
+    result.operation = object["operation"].toString();
+    result.cardinality = static_cast<qint64>(object["cardinality"].toDouble());
+    result.valueSize = object["valueSize"].toInt();
+    result.iterations = object["iterations"].toInt();
+    result.opsPerSec = object["opsPerSec"].toDouble();
+    QJsonObject latency = object["latencyUs"].toObject();
+    result.minUs = latency["min"].toDouble();
+    result.meanUs = latency["mean"].toDouble();
+    result.p50Us = latency["p50"].toDouble();
+    result.p90Us = latency["p90"].toDouble();
+    result.p99Us = latency["p99"].toDouble();
+    result.p999Us = latency["p999"].toDouble();
+    result.maxUs = latency["max"].toDouble();
+    return result;
+}
+
+BenchmarkReporter::BenchmarkReporter(const QString &suite)
+    : suite_(suite)
+{
+}
+
+BenchmarkResult BenchmarkReporter::summarize(const QString &operation, qint64 cardinality, int valueSize,
+                                             QVector<qint64> latenciesNs, qint64 elapsedNs)
+{
+    BenchmarkResult result;
+    result.name = QString("%1/card_%2/value_%3").arg(operation).arg(cardinality).arg(valueSize);
+    result.operation = operation;
+    result.cardinality = cardinality;
+    result.valueSize = valueSize;
+    result.iterations = latenciesNs.size();
+    if (latenciesNs.isEmpty()) {
+        return result;
+    }
+
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    qint64 sumNs = 0;
+    for (qint64 ns : latenciesNs) {
+        sumNs += ns;
+    }
+    result.opsPerSec = elapsedNs > 0 ? latenciesNs.size() * 1e9 / elapsedNs : 0.0;
+    result.minUs = latenciesNs.first() / 1000.0;
+    result.meanUs = sumNs / 1000.0 / latenciesNs.size();
+    result.p50Us = percentileUs(latenciesNs, 0.50);
+    result.p90Us = percentileUs(latenciesNs, 0.90);
+    result.p99Us = percentileUs(latenciesNs, 0.99);
+    result.p999Us = percentileUs(latenciesNs, 0.999);
+    result.maxUs = latenciesNs.last() / 1000.0;
+    return result;
+}
+
+void BenchmarkReporter::record(const BenchmarkResult &result)
+{
+    results_.append(result);
+    qDebug().noquote() << "RESULT:" << suite_ << result.name
+                       << QString::number(qRound64(result.opsPerSec)) << "ops/sec, p50"
+                       << QString::number(result.p50Us, 'f', 1) << "us, p99"
+                       << QString::number(result.p99Us, 'f', 1) << "us, p999"
+                       << QString::number(result.p999Us, 'f', 1) << "us";
+}
+
+QString BenchmarkReporter::outputPath() const
+{
+    return QDir(resultDir()).filePath(suite_ + ".json");
+}
+
+bool BenchmarkReporter::write() const
+{
+    if (!QDir().mkpath(resultDir())) {
+        qWarning() << "Cannot create benchmark result directory" << resultDir();
+        return false;
+    }
+
+    QJsonArray results;
+    for (const auto &result : results_) {
+        results.append(result.toJson());
+    }
+    QJsonObject root;
+    root["suite"] = suite_;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["host"] = QSysInfo::machineHostName();
+    root["results"] = results;
+
+    QFile file(outputPath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot write benchmark results to" << outputPath();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    qDebug() << "Benchmark results written to" << outputPath();
+    return true;
+}
+
+QStringList BenchmarkReporter::regressions() const
+{
+    QStringList found;
+    const QString baselineDir = qEnvironmentVariable("BENCHMARK_BASELINE_DIR");
+    if (baselineDir.isEmpty()) {
+        return found;
+    }
+    QFile file(QDir(baselineDir).filePath(suite_ + ".json"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "No baseline for suite" << suite_ << "in" << baselineDir;
+        return found;
+    }
+
+    bool ok = false;
+    double tolerance = qEnvironmentVariable("BENCHMARK_TOLERANCE").toDouble(&ok);
+    if (!ok || tolerance <= 0.0) {
+        tolerance = kDefaultTolerance;
+    }
+
+    QHash<QString, BenchmarkResult> baseline;
+    for (const auto &value : QJsonDocument::fromJson(file.readAll()).object()["results"].toArray()) {
+        BenchmarkResult result = BenchmarkResult::fromJson(value.toObject());
+        baseline.insert(result.name, result);
+    }
+
+    for (const auto &result : results_) {
+        auto it = baseline.constFind(result.name);
+        if (it == baseline.constEnd()) {
+            continue;
+        }
+        if (result.opsPerSec < it->opsPerSec * (1.0 - tolerance)) {
+            found.append(QString("%1: %2 ops/sec (baseline %3)")
+                             .arg(result.name).arg(qRound64(result.opsPerSec)).arg(qRound64(it->opsPerSec)));
+        }
+        if (it->p99Us > 0.0 && result.p99Us > it->p99Us * (1.0 + tolerance)) {
+            found.append(QString("%1: p99 %2 us (baseline %3 us)")
+                             .arg(result.name).arg(result.p99Us, 0, 'f', 1).arg(it->p99Us, 0, 'f', 1));
+        }
+    }
+    return found;
+}
+
+QVector<qint64> BenchmarkReporter::cardinalities()
+{
+    QVector<qint64> result;
+    const qint64 limit = maxCardinality();
+    for (qint64 cardinality : {10LL, 1000LL, 100000LL, 1000000LL}) {
+        if (cardinality <= limit) {
+            result.append(cardinality);
+        }
+    }
+    return result;
+}
+
+void BenchmarkReporter::suppressDebugOutput(bool suppress)
+{
+    if (suppress == suppressing) {
+        return;
+    }
+    suppressing = suppress;
+    if (suppress) {
+        previousHandler = qInstallMessageHandler(dropDebugMessages);
+    } else {
+        qInstallMessageHandler(previousHandler);
+        previousHandler = nullptr;
+    }
+}
+
+qint64 BenchmarkReporter::maxCardinality()
+{
+    bool ok = false;
+    qint64 limit = qEnvironmentVariable("BENCHMARK_MAX_CARDINALITY").toLongLong(&ok);
+    return ok && limit > 0 ? limit : kDefaultMaxCardinality;
+}
@@ -0,0 +1,102 @@
+#ifndef BENCHMARKREPORTER_H
+#define BENCHMARKREPORTER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief 单个基准用例的统计结果, 延迟单位为微秒
+ */
+struct BenchmarkResult
+{
+    QString name;
+    QString operation;
+    qint64 cardinality = 0;
+    int valueSize = 0;
+    int iterations = 0;
+    double opsPerSec = 0.0;
+    double minUs = 0.0;
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p90Us = 0.0;
+    double p99Us = 0.0;
+    double p999Us = 0.0;
+    double maxUs = 0.0;
+
+    QJsonObject toJson() const;
+    static BenchmarkResult fromJson(const QJsonObject &object);
+};
+
+/**
+ * @brief 基准测试结果收集与 JSON 输出
+ *
+ * 每个测试套件对应一个 <suite>.json, 写入 BENCHMARK_RESULT_DIR(默认 ./benchmark_results);
+ * 设置 BENCHMARK_BASELINE_DIR 时与同名基线文件比较, 吞吐下降或 p99 上升超过
+ * BENCHMARK_TOLERANCE(默认 0.25)的用例记为回归
+ * BENCHMARK_MAX_CARDINALITY 限制预置数据规模(默认 1000000), 便于在 CI 上缩短运行时间
+ */
+class BenchmarkReporter
+{
+public:
+    explicit BenchmarkReporter(const QString &suite);
+
+    /**
+    * @brief 逐次计时执行 func(i), 汇总后记录并返回结果
+    *
+    * 计时期间丢弃 qDebug 输出, 避免终端 I/O 干扰延迟分布(日志格式化本身仍计入)
+    */
+    template <typename Func>
+    BenchmarkResult measure(const QString &operation, qint64 cardinality, int valueSize, int iterations,
+                            Func &&func)
+    {
+        QVector<qint64> latenciesNs;
+        latenciesNs.reserve(iterations);
+        suppressDebugOutput(true);
+        QElapsedTimer total;
+        total.start();
+        for (int i = 0; i < iterations; ++i) {
+            QElapsedTimer timer;
+            timer.start();
+            func(i);
+            latenciesNs.append(timer.nsecsElapsed());
+        }
+        qint64 elapsedNs = total.nsecsElapsed();
+        suppressDebugOutput(false);
+        BenchmarkResult result = summarize(operation, cardinality, valueSize, latenciesNs, elapsedNs);
+        record(result);
+        return result;
+    }
+
+    static BenchmarkResult summarize(const QString &operation, qint64 cardinality, int valueSize,
+                                     QVector<qint64> latenciesNs, qint64 elapsedNs);
+    void record(const BenchmarkResult &result);
+
+    /**
+    * @brief 输出与回归检查
+    *
+    * 写出 JSON 结果文件,与基线比较并返回回归描述(未配置基线时为空)
+    */
+    bool write() const;
+    QString outputPath() const;
+    QStringList regressions() const;
+
+    /**
+    * @brief 预置数据规模 10 ~ 1M, 受 BENCHMARK_MAX_CARDINALITY 限制
+    */
+    static QVector<qint64> cardinalities();
+    static qint64 maxCardinality();
+
+    /**
+    * @brief 丢弃/恢复 qDebug 输出, 预置大量数据时同样可用
+    */
+    static void suppressDebugOutput(bool suppress);
+
+private:
+    QString suite_;
+    QVector<BenchmarkResult> results_;
+};
+
+#endif // BENCHMARKREPORTER_H
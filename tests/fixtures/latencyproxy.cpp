@@ -0,0 +1,152 @@
+#include "latencyproxy.h"
+#include <QDebug>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+
+LatencyProxy::LatencyProxy(const QString &targetHost, int targetPort)
+    : targetHost_(targetHost)
+    , targetPort_(targetPort)
+    , listenFd_(-1)
+    , port_(0)
+    , running_(false)
+    , delayMs_(0)
+{
+}
+
+LatencyProxy::~LatencyProxy()
+{
+    stop();
+}
+
+bool LatencyProxy::start(int port)
+{
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        return false;
+    }
+    // 以原端口重启时端口可能仍处于 TIME_WAIT
+    int reuse = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(port));  // 0 由系统分配端口
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listenFd_, 64) < 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+
+    running_ = true;
+    acceptThread_ = std::thread(&LatencyProxy::acceptLoop, this);
+    qDebug() << "LatencyProxy listening on port" << port_ << "->" << targetHost_ << ":" << targetPort_;
+    return true;
+}
+
+void LatencyProxy::stop()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    // 关闭监听和所有转发 socket, 使阻塞中的 accept/recv 返回
+    ::shutdown(listenFd_, SHUT_RDWR);
+    ::close(listenFd_);
+    listenFd_ = -1;
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int fd : sockets_) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    for (int fd : sockets_) {
+        ::close(fd);
+    }
+    workers_.clear();
+    sockets_.clear();
+}
+
+int LatencyProxy::port() const
+{
+    return port_;
+}
+
+void LatencyProxy::setDelayMs(int delayMs)
+{
+    delayMs_ = delayMs;
+}
+
+void LatencyProxy::acceptLoop()
+{
+    while (running_) {
+        int clientFd = ::accept(listenFd_, nullptr, nullptr);
+        if (clientFd < 0) {
+            break;
+        }
+
+        int serverFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in target{};
+        target.sin_family = AF_INET;
+        target.sin_port = htons(static_cast<uint16_t>(targetPort_));
+        ::inet_pton(AF_INET, targetHost_.toStdString().c_str(), &target.sin_addr);
+        if (serverFd < 0 || ::connect(serverFd, reinterpret_cast<sockaddr*>(&target), sizeof(target)) < 0) {
+            qWarning() << "LatencyProxy: failed to connect to target";
+            ::close(clientFd);
+            if (serverFd >= 0) {
+                ::close(serverFd);
+            }
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        sockets_.push_back(clientFd);
+        sockets_.push_back(serverFd);
+        workers_.emplace_back(&LatencyProxy::pump, this, clientFd, serverFd, false);
+        workers_.emplace_back(&LatencyProxy::pump, this, serverFd, clientFd, true);
+    }
+}
+
+void LatencyProxy::pump(int from, int to, bool delayed)
+{
+    char buffer[16 * 1024];
+    while (running_) {
+        ssize_t received = ::recv(from, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        int delayMs = delayMs_.load();
+        if (delayed && delayMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        }
+        ssize_t sent = 0;
+        while (sent < received) {
+            ssize_t n = ::send(to, buffer + sent, static_cast<size_t>(received - sent), MSG_NOSIGNAL);
+            if (n <= 0) {
+                break;
+            }
+            sent += n;
+        }
+        if (sent < received) {
+            break;
+        }
+    }
+    // 任一方向结束即关闭整条链路, 客户端超时断开后服务器侧也随之释放
+    ::shutdown(from, SHUT_RDWR);
+    ::shutdown(to, SHUT_RDWR);
+}
@@ -0,0 +1,49 @@
+#ifndef LATENCYPROXY_H
+#define LATENCYPROXY_H
+
+#include <QString>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 延迟注入 TCP 代理
+ *
+ * 在本地随机端口监听, 将连接转发到目标 Redis 服务器,
+ * 服务器应答在转发给客户端前等待 delayMs, 用于模拟慢命令/慢网络
+ */
+class LatencyProxy
+{
+public:
+    explicit LatencyProxy(const QString &targetHost = "127.0.0.1", int targetPort = 6379);
+    ~LatencyProxy();
+
+    /**
+     * @brief 开始监听
+     * @param port 监听端口, 0 表示由系统分配; stop 后以原端口重新 start 可模拟服务器重启
+     */
+    bool start(int port = 0);
+    void stop();
+
+    int port() const;
+    void setDelayMs(int delayMs);
+
+private:
+    void acceptLoop();
+    void pump(int from, int to, bool delayed);
+
+    QString targetHost_;
+    int targetPort_;
+    int listenFd_;
+    int port_;
+    std::atomic<bool> running_;
+    std::atomic<int> delayMs_;
+
+    std::thread acceptThread_;
+    std::mutex mutex_;
+    std::vector<std::thread> workers_;
+    std::vector<int> sockets_;
+};
+
+#endif // LATENCYPROXY_H
@@ -0,0 +1,277 @@
+#include "persistencemanifest.h"
+#include "../../RedisModule/redismanager.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr quint32 kManifestMagic = 0x554D504D; // "UMPM"
+constexpr quint16 kManifestVersion = 2;
+constexpr int kDefaultBatchSize = 1000;
+constexpr int kMaxVerifyThreads = 16;
+
+quint64 splitMix64(quint64 x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+int envInt(const char *name, int defaultValue)
+{
+    bool ok = false;
+    int value = qEnvironmentVariable(name).toInt(&ok);
+    return ok && value > 0 ? value : defaultValue;
+}
+
+} // namespace
+
+PersistenceManifestWriter::PersistenceManifestWriter(const QString &path)
+    : file_(path)
+    , count_(0)
+{
+}
+
+bool PersistenceManifestWriter::open(quint64 seed)
+{
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open manifest for writing:" << file_.fileName();
+        return false;
+    }
+    stream_.setDevice(&file_);
+    stream_.setVersion(QDataStream::Qt_5_12);
+    stream_ << kManifestMagic << kManifestVersion << seed;
+    count_ = 0;
+    return true;
+}
+
+void PersistenceManifestWriter::append(const QByteArray &key, const QByteArray &value)
+{
+    stream_ << key << PersistenceDataset::hashValue(value) << static_cast<quint32>(value.size());
+    ++count_;
+}
+
+bool PersistenceManifestWriter::close()
+{
+    if (!file_.isOpen()) {
+        return false;
+    }
+    bool ok = stream_.status() == QDataStream::Ok && file_.flush();
+    file_.close();
+    return ok;
+}
+
+qint64 PersistenceManifestWriter::count() const
+{
+    return count_;
+}
+
+PersistenceManifestReader::PersistenceManifestReader(const QString &path)
+    : file_(path)
+    , seed_(0)
+    , error_(false)
+{
+}
+
+bool PersistenceManifestReader::open()
+{
+    if (!file_.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open manifest:" << file_.fileName();
+        return false;
+    }
+    stream_.setDevice(&file_);
+    stream_.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream_ >> magic >> version >> seed_;
+    if (stream_.status() != QDataStream::Ok || magic != kManifestMagic || version != kManifestVersion) {
+        qWarning() << "Invalid manifest header:" << file_.fileName();
+        error_ = true;
+        return false;
+    }
+    return true;
+}
+
+int PersistenceManifestReader::read(QVector<PersistenceManifestEntry> &entries, int maxCount)
+{
+    entries.resize(maxCount);
+    int count = 0;
+    while (count < maxCount && !stream_.atEnd()) {
+        PersistenceManifestEntry &entry = entries[count];
+        stream_ >> entry.key >> entry.valueHash >> entry.valueSize;
+        if (stream_.status() != QDataStream::Ok) {
+            qWarning() << "Truncated manifest:" << file_.fileName();
+            error_ = true;
+            break;
+        }
+        ++count;
+    }
+    entries.resize(count);
+    return count;
+}
+
+quint64 PersistenceManifestReader::seed() const
+{
+    return seed_;
+}
+
+bool PersistenceManifestReader::hasError() const
+{
+    return error_;
+}
+
+quint64 PersistenceDataset::hashValue(const QByteArray &value)
+{
+    // FNV-1a
+    quint64 hash = 0xCBF29CE484222325ULL;
+    for (char c : value) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+QByteArray PersistenceDataset::valueFor(quint64 seed, qint64 index)
+{
+    return "value_" + QByteArray::number(seed) + '_'
+           + QByteArray::number(splitMix64(seed + static_cast<quint64>(index)));
+}
+
+bool PersistenceDataset::write(RedisManager *manager, const QString &keyPrefix, qint64 count,
+                               quint64 seed, int batchSize, PersistenceManifestWriter *manifest)
+{
+    const QByteArray prefix = keyPrefix.toUtf8();
+    const QByteArray set("SET");
+    QVector<QVector<QByteArray>> commands;
+    commands.reserve(batchSize);
+
+    for (qint64 offset = 0; offset < count; offset += batchSize) {
+        const qint64 end = std::min(count, offset + batchSize);
+        commands.clear();
+        for (qint64 i = offset; i < end; ++i) {
+            QByteArray key = prefix + QByteArray::number(i);
+            QByteArray value = valueFor(seed, i);
+            if (manifest) {
+                manifest->append(key, value);
+            }
+            commands.append({set, key, value});
+        }
+
+        QVector<RedisPipelineReply> replies = manager->pipeline(commands);
+        if (replies.size() != commands.size()) {
+            qWarning() << "Pipeline write failed at offset" << offset;
+            return false;
+        }
+        for (const auto &reply : replies) {
+            if (reply.isError()) {
+                qWarning() << "SET failed at offset" << offset << ":" << reply.value;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+PersistenceDataset::VerifyResult PersistenceDataset::verify(RedisManager *manager,
+                                                            const QString &manifestPath,
+                                                            int threadCount, int batchSize)
+{
+    VerifyResult result;
+    PersistenceManifestReader reader(manifestPath);
+    if (!reader.open()) {
+        result.manifestError = true;
+        return result;
+    }
+
+    std::mutex readerMutex;
+    std::mutex failedMutex;
+    std::atomic<qint64> total(0);
+    std::atomic<qint64> matched(0);
+
+    auto worker = [&]() {
+        QVector<PersistenceManifestEntry> entries;
+        QVector<QString> keys;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(readerMutex);
+                if (reader.read(entries, batchSize) == 0) {
+                    return;
+                }
+            }
+
+            keys.clear();
+            for (const auto &entry : entries) {
+                keys.append(QString::fromUtf8(entry.key));
+            }
+            // 调用失败时返回空列表, 整批按不一致计入
+            QVector<QString> values = manager->mGet(keys);
+
+            qint64 batchMatched = 0;
+            for (int i = 0; i < entries.size(); ++i) {
+                const PersistenceManifestEntry &entry = entries.at(i);
+                bool ok = false;
+                if (i < values.size()) {
+                    QByteArray value = values.at(i).toUtf8();
+                    ok = static_cast<quint32>(value.size()) == entry.valueSize
+                         && hashValue(value) == entry.valueHash;
+                }
+                if (ok) {
+                    ++batchMatched;
+                } else {
+                    std::lock_guard<std::mutex> lock(failedMutex);
+                    if (result.failedKeys.size() < kMaxFailedKeys) {
+                        result.failedKeys.append(keys.at(i));
+                    }
+                }
+            }
+            total += entries.size();
+            matched += batchMatched;
+        }
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<std::size_t>(threadCount));
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto &thread : workers) {
+        thread.join();
+    }
+
+    result.elapsedMs = timer.elapsed();
+    result.total = total;
+    result.matched = matched;
+    result.mismatched = result.total - result.matched;
+    result.manifestError = reader.hasError();
+    qDebug() << "Verified" << result.total << "keys with" << threadCount << "threads in"
+             << result.elapsedMs << "ms";
+    return result;
+}
+
+qint64 PersistenceDataset::testCount(qint64 defaultCount)
+{
+    bool ok = false;
+    qint64 count = qEnvironmentVariable("PERSISTENCE_TEST_COUNT").toLongLong(&ok);
+    return ok && count > 0 ? count : defaultCount;
+}
+
+int PersistenceDataset::batchSize()
+{
+    return envInt("PERSISTENCE_BATCH_SIZE", kDefaultBatchSize);
+}
+
+int PersistenceDataset::verifyThreads()
+{
+    int defaultThreads = std::min(kMaxVerifyThreads, std::max(1, QThread::idealThreadCount()));
+    return envInt("PERSISTENCE_VERIFY_THREADS", defaultThreads);
+}
@@ -0,0 +1,117 @@
+#ifndef PERSISTENCEMANIFEST_H
+#define PERSISTENCEMANIFEST_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class RedisManager;
+
+/**
+ * @brief 清单中的一条记录: 键, 值的 64 位 FNV-1a 哈希与值长度
+ */
+struct PersistenceManifestEntry
+{
+    QByteArray key;
+    quint64 valueHash = 0;
+    quint32 valueSize = 0;
+};
+
+/**
+ * @brief 持久化测试的二进制清单写入器
+ *
+ * 文件头为魔数, 版本号与生成值所用的种子, 之后逐条追加记录, 不保存值本身,
+ * 千万级键的清单也只需顺序写一遍, 不在内存中构造整个文档
+ */
+class PersistenceManifestWriter
+{
+public:
+    explicit PersistenceManifestWriter(const QString &path);
+
+    bool open(quint64 seed);
+    void append(const QByteArray &key, const QByteArray &value);
+    bool close();
+
+    qint64 count() const;
+
+private:
+    QFile file_;
+    QDataStream stream_;
+    qint64 count_;
+};
+
+/**
+ * @brief 持久化测试的二进制清单读取器
+ *
+ * 按批顺序读取记录, 文件截断或格式错误时 hasError() 返回 true;
+ * open() 成功后 seed() 返回写入清单时使用的种子, 重复写入同一数据集时必须沿用
+ */
+class PersistenceManifestReader
+{
+public:
+    explicit PersistenceManifestReader(const QString &path);
+
+    bool open();
+    quint64 seed() const;
+    // 读取最多 maxCount 条记录到 entries(覆盖原内容), 返回读到的条数, 0 表示已读完
+    int read(QVector<PersistenceManifestEntry> &entries, int maxCount);
+    bool hasError() const;
+
+private:
+    QFile file_;
+    QDataStream stream_;
+    quint64 seed_;
+    bool error_;
+};
+
+/**
+ * @brief 持久化测试数据集的写入与校验
+ *
+ * 写入: 值由 (seed, 序号) 确定性生成, 以流水线批量 SET 写入并同步追加清单;
+ * 校验: 多个线程从同一清单按批领取记录, 各自用 MGET 读取并比较哈希与长度。
+ * 校验线程共享 manager 的连接池, 连接池大小应不小于线程数
+ */
+class PersistenceDataset
+{
+public:
+    struct VerifyResult
+    {
+        qint64 total = 0;
+        qint64 matched = 0;
+        qint64 mismatched = 0;
+        qint64 elapsedMs = 0;
+        bool manifestError = false;
+        QStringList failedKeys;
+    };
+
+    static quint64 hashValue(const QByteArray &value);
+    static QByteArray valueFor(quint64 seed, qint64 index);
+
+    /**
+    * @brief 写入 count 个键 prefix0 .. prefix(count-1)
+    *
+    * manifest 为空时只写 Redis(重复写入同一数据集), 任一批次失败返回 false
+    */
+    static bool write(RedisManager *manager, const QString &keyPrefix, qint64 count, quint64 seed,
+                      int batchSize, PersistenceManifestWriter *manifest);
+    static VerifyResult verify(RedisManager *manager, const QString &manifestPath,
+                               int threadCount, int batchSize);
+
+    /**
+    * @brief 测试规模参数
+    *
+    * 分别读取 PERSISTENCE_TEST_COUNT、PERSISTENCE_BATCH_SIZE、PERSISTENCE_VERIFY_THREADS,
+    * 未设置时使用默认值
+    */
+    static qint64 testCount(qint64 defaultCount);
+    static int batchSize();
+    static int verifyThreads();
+
+private:
+    static constexpr int kMaxFailedKeys = 10;
+};
+
+#endif // PERSISTENCEMANIFEST_H
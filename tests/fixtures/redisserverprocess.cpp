@@ -0,0 +1,203 @@
+#include "redisserverprocess.h"
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QThread>
+
+namespace {
+
+constexpr int kPollIntervalMs = 10;
+
+} // namespace
+
+RedisServerProcess::RedisServerProcess(const QStringList &extraArgs)
+    : extraArgs_(extraArgs)
+    , port_(0)
+    , startupMs_(-1)
+{
+}
+
+RedisServerProcess::~RedisServerProcess()
+{
+    stop();
+}
+
+QString RedisServerProcess::serverBinary()
+{
+    QString binary = qEnvironmentVariable("REDIS_SERVER_BIN");
+    if (binary.isEmpty()) {
+        binary = QStandardPaths::findExecutable("redis-server");
+    }
+    return binary;
+}
+
+int RedisServerProcess::majorVersion()
+{
+    const QString binary = serverBinary();
+    if (binary.isEmpty()) {
+        return 0;
+    }
+    QProcess process;
+    process.start(binary, {"--version"});
+    if (!process.waitForFinished(5000)) {
+        return 0;
+    }
+    // 形如 "Redis server v=7.2.4 sha=..."
+    QRegularExpressionMatch match =
+        QRegularExpression("v=(\\d+)\\.").match(QString::fromLatin1(process.readAllStandardOutput()));
+    return match.hasMatch() ? match.captured(1).toInt() : 0;
+}
+
+int RedisServerProcess::freePort()
+{
+    QTcpServer server;
+    if (!server.listen(QHostAddress::LocalHost, 0)) {
+        return 0;
+    }
+    return server.serverPort();
+}
+
+bool RedisServerProcess::start(int timeoutMs)
+{
+    if (isRunning()) {
+        return true;
+    }
+    const QString binary = serverBinary();
+    if (binary.isEmpty()) {
+        qWarning() << "redis-server not found (set REDIS_SERVER_BIN)";
+        return false;
+    }
+
+    if (!dir_) {
+        const QString parent = qEnvironmentVariable("REDIS_SERVER_DATA_DIR", QDir::tempPath());
+        dir_.reset(new QTemporaryDir(QDir(parent).filePath("redis-server-XXXXXX")));
+        port_ = freePort();
+        if (!dir_->isValid() || port_ == 0) {
+            qWarning() << "Failed to prepare redis-server data directory or port";
+            dir_.reset();
+            return false;
+        }
+    }
+
+    QStringList args = {"--port", QString::number(port_), "--bind", "127.0.0.1", "--dir", dir_->path(),
+                        "--save", "", "--appendonly", "no", "--daemonize", "no"};
+    if (majorVersion() >= 7) {
+        // DEBUG POPULATE 用于快速生成大数据集
+        args << "--enable-debug-command" << "local";
+    }
+    args << extraArgs_;
+
+    process_.reset(new QProcess());
+    process_->setProcessChannelMode(QProcess::MergedChannels);
+    process_->setStandardOutputFile(QDir(dir_->path()).filePath("redis-server.log"), QIODevice::Append);
+
+    QElapsedTimer timer;
+    timer.start();
+    process_->start(binary, args);
+    if (!process_->waitForStarted(timeoutMs) || !waitReady(timeoutMs)) {
+        qWarning() << "redis-server failed to start on port" << port_ << "log:"
+                   << QDir(dir_->path()).filePath("redis-server.log");
+        stop();
+        return false;
+    }
+    startupMs_ = timer.elapsed();
+    qDebug() << "redis-server started on port" << port_ << "in" << startupMs_ << "ms";
+    return true;
+}
+
+bool RedisServerProcess::waitReady(int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < timeoutMs) {
+        if (!isRunning()) {
+            return false;
+        }
+        // 加载数据期间 PING 返回 -LOADING, 加载完成后返回 +PONG
+        QTcpSocket socket;
+        socket.connectToHost(QHostAddress::LocalHost, static_cast<quint16>(port_));
+        if (socket.waitForConnected(100)) {
+            socket.write("PING\r\n");
+            if (socket.waitForReadyRead(1000) && socket.readAll().startsWith("+PONG")) {
+                return true;
+            }
+        }
+        QThread::msleep(kPollIntervalMs);
+    }
+    return false;
+}
+
+void RedisServerProcess::stop(int timeoutMs)
+{
+    if (!process_) {
+        return;
+    }
+    if (process_->state() != QProcess::NotRunning) {
+        process_->terminate();
+        if (!process_->waitForFinished(timeoutMs)) {
+            qWarning() << "redis-server did not exit in time, killing";
+            process_->kill();
+            process_->waitForFinished(5000);
+        }
+    }
+    process_.reset();
+}
+
+bool RedisServerProcess::restart(int timeoutMs)
+{
+    stop();
+    return start(timeoutMs);
+}
+
+bool RedisServerProcess::isRunning() const
+{
+    return process_ && process_->state() != QProcess::NotRunning;
+}
+
+qint64 RedisServerProcess::lastStartupMs() const
+{
+    return startupMs_;
+}
+
+int RedisServerProcess::port() const
+{
+    return port_;
+}
+
+QString RedisServerProcess::dataDir() const
+{
+    return dir_ ? dir_->path() : QString();
+}
+
+qint64 RedisServerProcess::dataSizeBytes() const
+{
+    if (!dir_) {
+        return 0;
+    }
+    // RDB 文件与 AOF(Redis 7 起为 appendonlydir 目录下的多个文件), 不含日志
+    qint64 total = 0;
+    QDirIterator it(dir_->path(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        if (it.fileName() != "redis-server.log") {
+            total += it.fileInfo().size();
+        }
+    }
+    return total;
+}
+
+RedisConnectionOptions RedisServerProcess::connectionOptions(int poolSize) const
+{
+    RedisConnectionOptions options;
+    options.host = "127.0.0.1";
+    options.port = port_;
+    options.poolSize = poolSize;
+    return options;
+}
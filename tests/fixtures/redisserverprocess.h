@@ -0,0 +1,69 @@
+#ifndef REDISSERVERPROCESS_H
+#define REDISSERVERPROCESS_H
+
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <memory>
+
+#include "../../RedisModule/tool/redisconnectionoptions.h"
+
+class QTemporaryDir;
+
+/**
+ * @brief 测试专用的本地 redis-server 进程
+ *
+ * 在随机空闲端口和独立数据目录上启动 redis-server(REDIS_SERVER_BIN 指定可执行文件,
+ * 默认从 PATH 查找; REDIS_SERVER_DATA_DIR 指定数据目录的父目录, 默认系统临时目录),
+ * 默认关闭 RDB 自动快照与 AOF, 由 extraArgs 按测试需要覆盖。
+ * 重启复用同一端口与数据目录, 用于测量重启加载时间
+ * 内部使用 QProcess/QTcpSocket, 测试需使用 QTEST_GUILESS_MAIN 以创建 QCoreApplication
+ */
+class RedisServerProcess
+{
+public:
+    explicit RedisServerProcess(const QStringList &extraArgs = QStringList());
+    ~RedisServerProcess();
+
+    RedisServerProcess(const RedisServerProcess &) = delete;
+    RedisServerProcess& operator=(const RedisServerProcess &) = delete;
+
+    /**
+    * @brief 进程控制
+    *
+    * 启动并等待数据加载完成(PING 返回 PONG),发送 SIGTERM 并等待退出(AOF 会在退出前刷盘),
+    * 停止后以相同参数重新启动
+    */
+    bool start(int timeoutMs = 30000);
+    void stop(int timeoutMs = 60000);
+    bool restart(int timeoutMs = 30000);
+    bool isRunning() const;
+
+    /**
+    * @brief 最近一次启动从创建进程到可以处理命令的耗时(毫秒), 包含数据加载时间
+    */
+    qint64 lastStartupMs() const;
+
+    int port() const;
+    QString dataDir() const;
+    qint64 dataSizeBytes() const;
+    RedisConnectionOptions connectionOptions(int poolSize = 1) const;
+
+    /**
+    * @brief redis-server 可执行文件路径与主版本号(不可用时为 0)
+    */
+    static QString serverBinary();
+    static int majorVersion();
+
+private:
+    bool waitReady(int timeoutMs);
+    static int freePort();
+
+    QStringList extraArgs_;
+    std::unique_ptr<QTemporaryDir> dir_;
+    std::unique_ptr<QProcess> process_;
+    int port_;
+    qint64 startupMs_;
+};
+
+#endif // REDISSERVERPROCESS_H
@@ -16,7 +16,16 @@ RedisTestFixture::~RedisTestFixture()
 
 bool RedisTestFixture::connect()
 {
-    return manager_->connectToServer("127.0.0.1", 6379);
+    // 同一进程中的多个夹具共享一个连接池
+    RedisConnectionOptions options;
+    options.sharedPool = true;
+    options.consumerName = "RedisTestFixture";
+    return manager_->connectToServer(options);
+}
+
+bool RedisTestFixture::connect(const RedisConnectionOptions &options)
+{
+    return manager_->connectToServer(options);
 }
 
 void RedisTestFixture::cleanup()
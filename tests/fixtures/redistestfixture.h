@@ -12,6 +12,7 @@ public:
     ~RedisTestFixture();
 
     bool connect();
+    bool connect(const RedisConnectionOptions &options);
     void cleanup();
     RedisManager* manager();
 
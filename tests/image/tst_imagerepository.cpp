@@ -0,0 +1,600 @@
+/*
+ * 示例 ImageRepository 功能测试
+ * 1. 内容去重: 相同内容只保存一份, 引用计数随创建与删除增减, 最后一个引用释放时删除数据;
+ *    只改元数据的 update 不丢失内容哈希与大小
+ * 2. 冷热分层: 空闲数据移到 pack 文件后可读, 多次访问后提升回 Redis, 压缩后存活数据位置更新、旧文件删除;
+ *    压缩复制数据导致换新文件时, 开始时的当前文件(可能有位置快照之后写入的数据)不被回收
+ * 3. 解码缓存: 并发请求同一张图片只读取一次; 读取期间失效的结果不写入缓存;
+ *    读取抛出异常时等待中的请求得到同一异常, 之后的请求重新读取;
+ *    批量读取的结果在读取期间发生过失效时不写入缓存
+ * 4. 缩略图: 写入时带过期时间, 与同尺寸的原图解码结果分开缓存;
+ *    删除图片时一并删除, 删除后完成的后台生成不会重新写入
+ * 5. 批量解码: 在途字节预算小于单张图片时逐张读取与解码, 结果与进度回调按顺序完整返回,
+ *    不存在的图片返回空图像并同样计入进度
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QBuffer>
+#include <QImage>
+#include <QDir>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../fixtures/redistestfixture.h"
+#include "../../example/redis_examples/repositories/image_repository.h"
+
+class ImageRepositoryTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImageRepositoryTest() : fixture_(nullptr), repo_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void testDedupLinkAndUnlink();
+    void testUpdateKeepsContentReference();
+    void testCompactionKeepsStartingPack();
+    void testDemotePromoteCompactRoundTrip();
+    void testCacheCoalescesConcurrentLoads();
+    void testCacheInvalidateDuringLoad();
+    void testCacheLoadException();
+    void testCacheInsertAfterInvalidate();
+    void testThumbnailTtlAndCacheKey();
+    void testThumbnailsRemovedWithImage();
+    void testBatchDecodeWithinBudget();
+
+private:
+    static QByteArray encodePng(int width, int height, QRgb color);
+    static QByteArray noisePng(int size);
+    static ImageModel model(const QString &filename);
+    QString create(const QByteArray &data, const QString &filename = "test.png");
+    bool blobExists(const QString &hash);
+    QString blobLocator(const QString &hash);
+    static QString thumbnailKey(const QString &id, int size);
+
+    RedisTestFixture *fixture_;
+    ImageRepository *repo_;
+    QStringList created_;
+};
+
+QByteArray ImageRepositoryTest::encodePng(int width, int height, QRgb color)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(color);
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return data;
+}
+
+QByteArray ImageRepositoryTest::noisePng(int size)
+{
+    // 随机像素: 每次运行内容不同, 不与其他用例或之前的运行共享内容哈希
+    QImage image(size, size, QImage::Format_RGB32);
+    for (int y = 0; y < size; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < size; ++x) {
+            line[x] = QRandomGenerator::global()->generate() | 0xff000000;
+        }
+    }
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return data;
+}
+
+ImageModel ImageRepositoryTest::model(const QString &filename)
+{
+    ImageModel result;
+    result.setFilename(filename);
+    result.setMimeType("image/png");
+    return result;
+}
+
+QString ImageRepositoryTest::create(const QByteArray &data, const QString &filename)
+{
+    const QString id = repo_->create(model(filename), data);
+    if (!id.isEmpty()) {
+        created_.append(id);
+    }
+    return id;
+}
+
+bool ImageRepositoryTest::blobExists(const QString &hash)
+{
+    return fixture_->manager()->exists("img:blob:" + hash);
+}
+
+QString ImageRepositoryTest::blobLocator(const QString &hash)
+{
+    return fixture_->manager()->hGet("img:blob:loc", hash);
+}
+
+QString ImageRepositoryTest::thumbnailKey(const QString &id, int size)
+{
+    return QString("img:thumb:%1:%2").arg(id).arg(size);
+}
+
+void ImageRepositoryTest::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+}
+
+void ImageRepositoryTest::cleanupTestCase()
+{
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void ImageRepositoryTest::init()
+{
+    // 每个用例一个新的仓库, 分层、缓存与缩略图配置互不影响
+    repo_ = new ImageRepository(*fixture_->manager());
+    ImageThumbnailOptions thumbnails;
+    thumbnails.eagerSizes.clear();
+    repo_->setThumbnailOptions(thumbnails);
+}
+
+void ImageRepositoryTest::cleanup()
+{
+    for (const QString &id : created_) {
+        if (repo_->exists(id)) {
+            repo_->remove(id);
+        }
+    }
+    created_.clear();
+    delete repo_;
+    repo_ = nullptr;
+}
+
+void ImageRepositoryTest::testDedupLinkAndUnlink()
+{
+    const QByteArray data = encodePng(16, 16, qRgb(10, 20, 30));
+    const QString hash = ImageRepository::contentHash(data);
+    const qint64 storedBefore = repo_->getStoredSize();
+
+    const QString first = create(data, "first.png");
+    QVERIFY(!first.isEmpty());
+    QCOMPARE(repo_->blobReferences(hash), 1);
+    QCOMPARE(repo_->getStoredSize(), storedBefore + data.size());
+
+    // 相同内容: 只增加引用, 不再写入数据
+    const QString second = create(data, "second.png");
+    QVERIFY(!second.isEmpty());
+    QVERIFY(first != second);
+    QCOMPARE(repo_->blobReferences(hash), 2);
+    QCOMPARE(repo_->getStoredSize(), storedBefore + data.size());
+    QCOMPARE(repo_->findById(second).getContentHash(), hash);
+
+    // 释放一个引用后另一条记录仍能读取
+    QVERIFY(repo_->remove(first));
+    QCOMPARE(repo_->blobReferences(hash), 1);
+    QVERIFY(blobExists(hash));
+    QCOMPARE(repo_->getImageData(second), data);
+
+    // 最后一个引用释放时删除数据
+    QVERIFY(repo_->remove(second));
+    QCOMPARE(repo_->blobReferences(hash), 0);
+    QVERIFY(!blobExists(hash));
+    QCOMPARE(repo_->getStoredSize(), storedBefore);
+}
+
+void ImageRepositoryTest::testUpdateKeepsContentReference()
+{
+    const QByteArray data = encodePng(8, 8, qRgb(200, 100, 0));
+    const QString hash = ImageRepository::contentHash(data);
+    const QString id = create(data);
+    QVERIFY(!id.isEmpty());
+
+    // 调用方只构造了要修改的字段, 没有内容哈希与大小
+    ImageModel changed = model("renamed.png");
+    changed.setId(id);
+    changed.setTags({"renamed"});
+    QVERIFY(repo_->update(changed));
+
+    const ImageModel stored = repo_->findById(id);
+    QCOMPARE(stored.getFilename(), QString("renamed.png"));
+    QCOMPARE(stored.getContentHash(), hash);
+    QCOMPARE(stored.getSize(), static_cast<qint64>(data.size()));
+    QCOMPARE(repo_->getImageData(id), data);
+
+    // 删除时仍能释放内容引用
+    QVERIFY(repo_->remove(id));
+    QCOMPARE(repo_->blobReferences(hash), 0);
+    QVERIFY(!blobExists(hash));
+}
+
+void ImageRepositoryTest::testCompactionKeepsStartingPack()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ImagePackStore store(dir.path(), 100);
+
+    // pack 0: 30 字节已失效 + 60 字节存活; pack 1(当前): 60 字节, 模拟在位置快照之后才降级写入
+    const ImagePackLocator dead = store.append(QByteArray(30, 'd'));
+    const ImagePackLocator alive = store.append(QByteArray(60, 'a'));
+    const ImagePackLocator late = store.append(QByteArray(60, 'l'));
+    QCOMPARE(dead.pack, 0);
+    QCOMPARE(alive.pack, 0);
+    QCOMPARE(late.pack, 1);
+
+    // 存活数据复制到 pack 1 放不下, 换新文件 pack 2; pack 1 不在快照中但不能被当作全部失效
+    QMap<QString, ImagePackLocator> live;
+    live.insert("alive", alive);
+    ImagePackCompaction compaction = store.compact(live, 0.9);
+    QCOMPARE(compaction.reclaimablePacks, QList<int>{0});
+    QCOMPARE(compaction.reclaimedBytes, 30LL);
+    QCOMPARE(compaction.moved.value("alive").pack, 2);
+
+    store.removePacks(compaction.reclaimablePacks);
+    QCOMPARE(store.read(late), QByteArray(60, 'l'));
+    QCOMPARE(store.read(compaction.moved.value("alive")), QByteArray(60, 'a'));
+    QVERIFY(store.read(alive).isEmpty());
+}
+
+void ImageRepositoryTest::testDemotePromoteCompactRoundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray dataA = noisePng(24);
+    const QByteArray dataB = noisePng(32);
+    const QString hashA = ImageRepository::contentHash(dataA);
+    const QString hashB = ImageRepository::contentHash(dataB);
+
+    // A 与 B 恰好写满第一个文件, A 再次降级时换新文件; 读取两次后提升
+    ImageTierOptions tier;
+    tier.packDirectory = dir.path();
+    tier.spillSizeBytes = 1LL << 30;
+    tier.idleMs = 0;
+    tier.promoteHits = 2;
+    tier.maxPackBytes = dataA.size() + dataB.size();
+    repo_->setTierOptions(tier);
+
+    const QString a = create(dataA, "a.png");
+    const QString b = create(dataB, "b.png");
+    QVERIFY(!a.isEmpty() && !b.isEmpty());
+    QVERIFY(blobExists(hashA));
+
+    // 降级: Redis 只保留位置, 数据从 pack 文件读取
+    QVERIFY(repo_->demoteIdle(1000) >= 2);
+    QVERIFY(!blobExists(hashA));
+    QVERIFY(!blobExists(hashB));
+    const ImagePackLocator firstA = ImagePackLocator::fromString(blobLocator(hashA));
+    const ImagePackLocator firstB = ImagePackLocator::fromString(blobLocator(hashB));
+    QVERIFY(firstA.isValid() && firstB.isValid());
+    QCOMPARE(repo_->getImageData(a), dataA);
+    QVERIFY(!blobExists(hashA));
+
+    // 第二次访问达到 promoteHits: 回到 Redis, 位置删除
+    QCOMPARE(repo_->getImageData(a), dataA);
+    QVERIFY(blobExists(hashA));
+    QVERIFY(blobLocator(hashA).isEmpty());
+
+    // 再次降级写入新文件, 第一个文件中只剩 B 存活
+    QVERIFY(repo_->demoteIdle(1000) >= 1);
+    const ImagePackLocator secondA = ImagePackLocator::fromString(blobLocator(hashA));
+    QVERIFY(secondA.isValid());
+    QVERIFY(secondA.pack > firstB.pack);
+
+    const QString firstPackPath = QDir(dir.path()).filePath(QString("pack-%1.dat").arg(firstB.pack, 6, 10, QChar('0')));
+    QVERIFY(QFile::exists(firstPackPath));
+    QVERIFY(repo_->compactPacks(1.0) >= dataA.size());
+
+    // B 的位置已更新, 旧文件删除; 两张图片都仍可读
+    const ImagePackLocator movedB = ImagePackLocator::fromString(blobLocator(hashB));
+    QVERIFY(movedB.isValid());
+    QVERIFY(movedB.pack != firstB.pack);
+    QVERIFY(!QFile::exists(firstPackPath));
+    QCOMPARE(repo_->getImageData(b), dataB);
+    QCOMPARE(repo_->getImageData(a), dataA);
+
+    // 删除后冷数据位置一并释放
+    QVERIFY(repo_->remove(a));
+    QVERIFY(repo_->remove(b));
+    QVERIFY(blobLocator(hashA).isEmpty());
+    QVERIFY(blobLocator(hashB).isEmpty());
+}
+
+void ImageRepositoryTest::testCacheCoalescesConcurrentLoads()
+{
+    ImageCache cache;
+    QImage image(4, 4, QImage::Format_RGB32);
+    image.fill(Qt::red);
+
+    // 第一次读取阻塞到其余请求都进入等待, 保证它们是合并而不是命中
+    const int waiters = 7;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> loads(0);
+    auto load = [&]() {
+        ++loads;
+        released.wait();
+        return image;
+    };
+
+    std::vector<std::future<QImage>> results;
+    results.push_back(std::async(std::launch::async, [&]() { return cache.get("coalesce", QSize(), load); }));
+    QTRY_COMPARE(loads.load(), 1);
+    for (int i = 0; i < waiters; ++i) {
+        results.push_back(std::async(std::launch::async, [&]() { return cache.get("coalesce", QSize(), load); }));
+    }
+    QTRY_COMPARE(cache.stats().coalesced, static_cast<qint64>(waiters));
+    release.set_value();
+
+    for (auto &result : results) {
+        QCOMPARE(result.get(), image);
+    }
+    QCOMPARE(loads.load(), 1);
+    QCOMPARE(cache.stats().misses, 1LL);
+
+    // 之后直接命中
+    QCOMPARE(cache.get("coalesce", QSize(), load), image);
+    QCOMPARE(loads.load(), 1);
+    QCOMPARE(cache.stats().hits, 1LL);
+}
+
+void ImageRepositoryTest::testCacheInvalidateDuringLoad()
+{
+    ImageCache cache;
+    QImage oldImage(4, 4, QImage::Format_RGB32);
+    oldImage.fill(Qt::red);
+    QImage newImage(4, 4, QImage::Format_RGB32);
+    newImage.fill(Qt::blue);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> loading(false);
+    std::future<QImage> first = std::async(std::launch::async, [&]() {
+        return cache.get("stale", QSize(64, 64), [&]() {
+            loading = true;
+            released.wait();
+            return oldImage;
+        });
+    });
+    QTRY_VERIFY(loading.load());
+
+    // 读取期间图片被更新: 旧结果仍返回给发起读取的调用方, 但不写入缓存
+    cache.invalidate("stale");
+    release.set_value();
+    QCOMPARE(first.get(), oldImage);
+    QVERIFY(cache.find("stale", QSize(64, 64)).isNull());
+
+    // 失效后的请求重新读取, 不会等待旧的读取
+    int loads = 0;
+    QCOMPARE(cache.get("stale", QSize(64, 64), [&]() { ++loads; return newImage; }), newImage);
+    QCOMPARE(loads, 1);
+    QCOMPARE(cache.find("stale", QSize(64, 64)), newImage);
+
+    // 失效作用于该图片的所有尺寸
+    cache.insert("stale", QSize(), newImage);
+    cache.invalidate("stale");
+    QVERIFY(cache.find("stale", QSize()).isNull());
+    QVERIFY(cache.find("stale", QSize(64, 64)).isNull());
+}
+
+void ImageRepositoryTest::testCacheLoadException()
+{
+    ImageCache cache;
+    QImage image(2, 2, QImage::Format_RGB32);
+    image.fill(Qt::green);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> loading(false);
+    std::future<QImage> first = std::async(std::launch::async, [&]() {
+        return cache.get("throws", QSize(), [&]() -> QImage {
+            loading = true;
+            released.wait();
+            throw std::runtime_error("decode failed");
+        });
+    });
+    QTRY_VERIFY(loading.load());
+    std::future<QImage> waiter = std::async(std::launch::async, [&]() {
+        return cache.get("throws", QSize(), [&]() { return image; });
+    });
+    QTRY_COMPARE(cache.stats().coalesced, 1LL);
+    release.set_value();
+
+    // 发起读取的调用与等待中的调用都得到异常, 不会一直等待
+    QVERIFY_EXCEPTION_THROWN(first.get(), std::runtime_error);
+    QVERIFY_EXCEPTION_THROWN(waiter.get(), std::runtime_error);
+
+    // 等待项已撤下, 之后的请求重新读取
+    int loads = 0;
+    QCOMPARE(cache.get("throws", QSize(), [&]() { ++loads; return image; }), image);
+    QCOMPARE(loads, 1);
+}
+
+void ImageRepositoryTest::testCacheInsertAfterInvalidate()
+{
+    ImageCache cache;
+    QImage image(2, 2, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+
+    // 读取前取得代数, 读取期间图片被删除: 旧结果不写回
+    quint64 generation = cache.generation();
+    cache.invalidate("removed");
+    cache.insert("removed", QSize(), image, generation);
+    QVERIFY(cache.find("removed", QSize()).isNull());
+
+    // 其他图片的失效同样使本次写入放弃, 只多一次未命中
+    generation = cache.generation();
+    cache.invalidate("other");
+    cache.insert("kept", QSize(), image, generation);
+    QVERIFY(cache.find("kept", QSize()).isNull());
+
+    // 期间没有失效时写入
+    generation = cache.generation();
+    cache.insert("kept", QSize(), image, generation);
+    QCOMPARE(cache.find("kept", QSize()), image);
+
+    // clear 同样推进代数
+    generation = cache.generation();
+    cache.clear();
+    cache.insert("kept", QSize(), image, generation);
+    QVERIFY(cache.find("kept", QSize()).isNull());
+}
+
+void ImageRepositoryTest::testThumbnailTtlAndCacheKey()
+{
+    RedisManager *manager = fixture_->manager();
+    ImageThumbnailOptions thumbnails;
+    thumbnails.eagerSizes = {32};
+    thumbnails.ttlSeconds = 600;
+    repo_->setThumbnailOptions(thumbnails);
+
+    const QString id = create(noisePng(64));
+    QVERIFY(!id.isEmpty());
+    const QString sizesKey = QString("img:thumb:%1:sizes").arg(id);
+
+    // 上传时后台生成的尺寸
+    QTRY_VERIFY(manager->exists(thumbnailKey(id, 32)));
+    int ttl = manager->ttl(thumbnailKey(id, 32));
+    QVERIFY2(ttl > 0 && ttl <= thumbnails.ttlSeconds, qPrintable(QString("thumbnail ttl %1").arg(ttl)));
+    ttl = manager->ttl(sizesKey);
+    QVERIFY2(ttl > 0 && ttl <= thumbnails.ttlSeconds, qPrintable(QString("sizes ttl %1").arg(ttl)));
+
+    // 首次访问时生成的尺寸
+    QImage thumbnail = repo_->getThumbnail(id, 48);
+    QVERIFY(!thumbnail.isNull());
+    QVERIFY(qMax(thumbnail.width(), thumbnail.height()) <= 48);
+    ttl = manager->ttl(thumbnailKey(id, 48));
+    QVERIFY2(ttl > 0 && ttl <= thumbnails.ttlSeconds, qPrintable(QString("thumbnail ttl %1").arg(ttl)));
+    QCOMPARE(manager->sCard(sizesKey), 2);
+
+    // 同尺寸的原图解码不命中缩略图的缓存项, 反之亦然
+    ImageCacheStats before = repo_->imageCacheStats();
+    QVERIFY(!repo_->getImageAsQImage(id, QSize(48, 48)).isNull());
+    ImageCacheStats after = repo_->imageCacheStats();
+    QCOMPARE(after.misses, before.misses + 1);
+    QCOMPARE(after.hits, before.hits);
+
+    QVERIFY(!repo_->getThumbnail(id, 32).isNull());
+    before = after;
+    after = repo_->imageCacheStats();
+    QCOMPARE(after.misses, before.misses + 1);
+
+    // 两种形式都已缓存, 再次读取均命中
+    QVERIFY(!repo_->getThumbnail(id, 48).isNull());
+    QVERIFY(!repo_->getImageAsQImage(id, QSize(48, 48)).isNull());
+    before = after;
+    after = repo_->imageCacheStats();
+    QCOMPARE(after.hits, before.hits + 2);
+    QCOMPARE(after.misses, before.misses);
+}
+
+void ImageRepositoryTest::testThumbnailsRemovedWithImage()
+{
+    RedisManager *manager = fixture_->manager();
+    ImageThumbnailOptions thumbnails;
+    thumbnails.eagerSizes = {32, 64};
+    repo_->setThumbnailOptions(thumbnails);
+
+    // 已生成的缩略图随图片删除
+    const QString id = create(noisePng(96));
+    QVERIFY(!id.isEmpty());
+    QTRY_VERIFY(manager->exists(thumbnailKey(id, 32)) && manager->exists(thumbnailKey(id, 64)));
+    QVERIFY(repo_->remove(id));
+    QVERIFY(!manager->exists(thumbnailKey(id, 32)));
+    QVERIFY(!manager->exists(thumbnailKey(id, 64)));
+    QVERIFY(!manager->exists(QString("img:thumb:%1:sizes").arg(id)));
+
+    // 上传后立即删除: 后台生成可能在删除之后才写入, 等全部任务结束后也不应留下缩略图
+    QStringList removed;
+    for (int i = 0; i < 8; ++i) {
+        const QString quick = create(noisePng(96));
+        QVERIFY(!quick.isEmpty());
+        QVERIFY(repo_->remove(quick));
+        removed.append(quick);
+    }
+    // 析构时等待缩略图线程池中的任务完成
+    delete repo_;
+    repo_ = new ImageRepository(*manager);
+
+    for (const QString &quick : removed) {
+        QVERIFY(!manager->exists(thumbnailKey(quick, 32)));
+        QVERIFY(!manager->exists(thumbnailKey(quick, 64)));
+        QVERIFY(!manager->exists(QString("img:thumb:%1:sizes").arg(quick)));
+    }
+
+    // 已删除图片的按需请求同样不写入
+    QVERIFY(repo_->getThumbnail(removed.first(), 48).isNull());
+    QVERIFY(!manager->exists(thumbnailKey(removed.first(), 48)));
+}
+
+void ImageRepositoryTest::testBatchDecodeWithinBudget()
+{
+    const QList<QRgb> colors = {qRgb(255, 0, 0), qRgb(0, 255, 0), qRgb(0, 0, 255),
+                                qRgb(255, 255, 0), qRgb(0, 255, 255)};
+    QStringList ids;
+    for (int i = 0; i < colors.size(); ++i) {
+        const QString id = create(encodePng(40 + i, 30, colors[i]));
+        QVERIFY(!id.isEmpty());
+        ids.append(id);
+    }
+    const int missing = ids.size();
+    ids.append("missing-" + RedisTestFixture::generateUniqueKey("image"));
+
+    // 不缓存解码结果, 每次都经过读取与解码; 预算小于任何一张图片, 每批只有一张
+    repo_->setImageCacheBudget(0);
+    repo_->setInFlightBudget(1);
+
+    QList<int> order;
+    QList<int> counts;
+    QList<QImage> results = repo_->getImagesAsQImage(ids, QSize(),
+        [&](int completed, int total, int index, const QImage &image) {
+            QCOMPARE(total, ids.size());
+            QCOMPARE(image.isNull(), index == missing);
+            counts.append(completed);
+            order.append(index);
+        });
+
+    QCOMPARE(results.size(), ids.size());
+    for (int i = 0; i < colors.size(); ++i) {
+        QCOMPARE(results[i].size(), QSize(40 + i, 30));
+        QCOMPARE(results[i].pixel(0, 0), colors[i]);
+    }
+    QVERIFY(results[missing].isNull());
+
+    // 不存在的图片在解析元数据时即完成; 其余每批解码完成后才读取下一批, 进度按提交顺序回调
+    QList<int> expectedOrder = {missing};
+    QList<int> expectedCounts;
+    for (int i = 0; i < colors.size(); ++i) {
+        expectedOrder.append(i);
+    }
+    for (int i = 1; i <= ids.size(); ++i) {
+        expectedCounts.append(i);
+    }
+    QCOMPARE(order, expectedOrder);
+    QCOMPARE(counts, expectedCounts);
+    QCOMPARE(repo_->imageCacheStats().count, 0);
+
+    // 预算足够时一批读取, 缩放结果与逐张读取一致
+    repo_->setInFlightBudget(64LL * 1024 * 1024);
+    int reported = 0;
+    QList<QImage> scaled = repo_->getImagesAsQImage(ids, QSize(16, 16),
+        [&](int, int, int, const QImage &) { ++reported; });
+    QCOMPARE(reported, ids.size());
+    for (int i = 0; i < colors.size(); ++i) {
+        QCOMPARE(scaled[i], repo_->getImageAsQImage(ids[i], QSize(16, 16)));
+        QVERIFY(qMax(scaled[i].width(), scaled[i].height()) <= 16);
+    }
+    QVERIFY(scaled[missing].isNull());
+}
+
+QTEST_GUILESS_MAIN(ImageRepositoryTest)
+#include "tst_imagerepository.moc"
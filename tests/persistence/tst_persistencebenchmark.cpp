@@ -0,0 +1,427 @@
+/*
+ * 持久化性能测试
+ * 每种配置启动独立的 redis-server(RedisServerProcess), 不影响 6379 上的实例, 测量:
+ * 1. appendfsync 策略(always/everysec/no, 以关闭 AOF 为基线)下的写入吞吐与延迟尖刺
+ * 2. BGSAVE(fork + 写时复制)期间与平时的写入延迟对比
+ * 3. RDB 与 AOF 的重启加载时间
+ * 数据集 10k ~ 10M 键, 受 BENCHMARK_MAX_CARDINALITY 限制(默认 1M)
+ * 结果写入 benchmark_results/persistence.json, 对比报告写入同目录的 persistence_report.md
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "../fixtures/benchmarkreporter.h"
+#include "../fixtures/redisserverprocess.h"
+#include "../../RedisModule/redismanager.h"
+
+class PersistenceBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    PersistenceBenchmark() : reporter_("persistence") {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkFsyncPolicy_data();
+    void benchmarkFsyncPolicy();
+    void benchmarkBgsaveLatency_data();
+    void benchmarkBgsaveLatency();
+    void benchmarkRestartLoad_data();
+    void benchmarkRestartLoad();
+
+private:
+    struct WriteRun
+    {
+        QVector<qint64> latenciesNs;
+        QVector<qint64> offsetsNs;
+        qint64 elapsedNs = 0;
+        qint64 errors = 0;
+    };
+
+    struct FsyncRow
+    {
+        QString policy;
+        BenchmarkResult result;
+        qint64 spikes;
+        qint64 delayedFsync;
+    };
+
+    struct BgsaveRow
+    {
+        qint64 keys;
+        BenchmarkResult outside;
+        BenchmarkResult during;
+        qint64 spikes;
+        qint64 forkUs;
+        qint64 bgsaveSec;
+    };
+
+    struct LoadRow
+    {
+        QString mode;
+        qint64 keys;
+        qint64 loadMs;
+        qint64 dataBytes;
+    };
+
+    WriteRun runWriters(RedisManager *manager, const std::function<void(const QElapsedTimer &)> &during = nullptr);
+    bool populate(RedisManager *manager, qint64 keys);
+    bool waitWhile(RedisManager *manager, const QString &section, const QStringList &fields);
+    static qint64 countSpikes(const QVector<qint64> &latenciesNs);
+    static QVector<qint64> datasetSizes();
+    void writeReport() const;
+
+    BenchmarkReporter reporter_;
+    QVector<FsyncRow> fsyncRows_;
+    QVector<BgsaveRow> bgsaveRows_;
+    QVector<LoadRow> loadRows_;
+
+    static constexpr int WRITER_THREADS = 4;
+    static constexpr int WRITE_DURATION_MS = 5000;
+    static constexpr int BGSAVE_DELAY_MS = 1000;
+    static constexpr int KEYS_PER_WRITER = 10000;
+    static constexpr int VALUE_SIZE = 128;
+    static constexpr int POPULATE_CHUNK = 1000;
+    static constexpr qint64 SPIKE_THRESHOLD_US = 5000;
+    static constexpr int SERVER_TIMEOUT_MS = 600000;
+};
+
+void PersistenceBenchmark::initTestCase()
+{
+    if (RedisServerProcess::serverBinary().isEmpty()) {
+        QSKIP("redis-server not found (set REDIS_SERVER_BIN)");
+    }
+}
+
+void PersistenceBenchmark::cleanupTestCase()
+{
+    QVERIFY(reporter_.write());
+    writeReport();
+    const QStringList regressions = reporter_.regressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions.join("; ")));
+}
+
+QVector<qint64> PersistenceBenchmark::datasetSizes()
+{
+    QVector<qint64> sizes;
+    for (qint64 keys : {10000LL, 100000LL, 1000000LL, 10000000LL}) {
+        if (keys <= BenchmarkReporter::maxCardinality()) {
+            sizes.append(keys);
+        }
+    }
+    return sizes;
+}
+
+PersistenceBenchmark::WriteRun PersistenceBenchmark::runWriters(
+    RedisManager *manager, const std::function<void(const QElapsedTimer &)> &during)
+{
+    std::atomic<bool> stop(false);
+    std::vector<WriteRun> perThread(WRITER_THREADS);
+    const QByteArray value(VALUE_SIZE, 'p');
+
+    BenchmarkReporter::suppressDebugOutput(true);
+    QElapsedTimer clock;
+    clock.start();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < WRITER_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            WriteRun &run = perThread[static_cast<std::size_t>(t)];
+            for (qint64 i = 0; !stop; ++i) {
+                const QString key = QString("write:%1:%2").arg(t).arg(i % KEYS_PER_WRITER);
+                const qint64 begin = clock.nsecsElapsed();
+                manager->bytesSet(key, value);
+                const qint64 end = clock.nsecsElapsed();
+                if (manager->lastCallStatus() != RedisCallStatus::Ok) {
+                    ++run.errors;
+                }
+                run.latenciesNs.append(end - begin);
+                run.offsetsNs.append(begin);
+            }
+        });
+    }
+
+    // during 返回后至少再写满 WRITE_DURATION_MS, 以便比较事件前后的延迟
+    if (during) {
+        during(clock);
+    }
+    while (clock.elapsed() < WRITE_DURATION_MS) {
+        QThread::msleep(10);
+    }
+    stop = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    WriteRun merged;
+    merged.elapsedNs = clock.nsecsElapsed();
+    BenchmarkReporter::suppressDebugOutput(false);
+    for (const auto &run : perThread) {
+        merged.latenciesNs += run.latenciesNs;
+        merged.offsetsNs += run.offsetsNs;
+        merged.errors += run.errors;
+    }
+    return merged;
+}
+
+bool PersistenceBenchmark::populate(RedisManager *manager, qint64 keys)
+{
+    QElapsedTimer timer;
+    timer.start();
+    BenchmarkReporter::suppressDebugOutput(true);
+    // 优先在服务器端生成; 不允许 DEBUG 命令时退回 MSET 分批写入
+    bool ok = manager->debugPopulate(keys, "key", VALUE_SIZE);
+    if (!ok) {
+        const QString value(VALUE_SIZE, 'v');
+        ok = true;
+        for (qint64 offset = 0; ok && offset < keys; offset += POPULATE_CHUNK) {
+            QMap<QString, QString> chunk;
+            for (qint64 i = offset; i < qMin(keys, offset + POPULATE_CHUNK); ++i) {
+                chunk.insert(QString("key:%1").arg(i), value);
+            }
+            ok = manager->mSet(chunk);
+        }
+    }
+    BenchmarkReporter::suppressDebugOutput(false);
+    qDebug() << "RESULT: populate" << keys << "keys in" << timer.elapsed() << "ms";
+    return ok && manager->dbSize() == keys;
+}
+
+bool PersistenceBenchmark::waitWhile(RedisManager *manager, const QString &section, const QStringList &fields)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool busy = true;
+    while (busy && timer.elapsed() < SERVER_TIMEOUT_MS) {
+        const QMap<QString, QString> info = manager->info(section);
+        busy = info.isEmpty();
+        for (const QString &field : fields) {
+            busy = busy || info.value(field) == "1";
+        }
+        if (busy) {
+            QThread::msleep(5);
+        }
+    }
+    return !busy;
+}
+
+qint64 PersistenceBenchmark::countSpikes(const QVector<qint64> &latenciesNs)
+{
+    return std::count_if(latenciesNs.constBegin(), latenciesNs.constEnd(),
+                         [](qint64 ns) { return ns > SPIKE_THRESHOLD_US * 1000; });
+}
+
+void PersistenceBenchmark::benchmarkFsyncPolicy_data()
+{
+    QTest::addColumn<QString>("policy");
+    QTest::newRow("aof_off") << QString("off");
+    QTest::newRow("fsync_always") << QString("always");
+    QTest::newRow("fsync_everysec") << QString("everysec");
+    QTest::newRow("fsync_no") << QString("no");
+}
+
+void PersistenceBenchmark::benchmarkFsyncPolicy()
+{
+    QFETCH(QString, policy);
+    QStringList args;
+    if (policy != "off") {
+        args << "--appendonly" << "yes" << "--appendfsync" << policy;
+    }
+    RedisServerProcess server(args);
+    QVERIFY2(server.start(), "Failed to start redis-server");
+    RedisManager manager;
+    QVERIFY(manager.connectToServer(server.connectionOptions(WRITER_THREADS)));
+
+    WriteRun run;
+    QBENCHMARK_ONCE {
+        run = runWriters(&manager);
+    }
+    QCOMPARE(run.errors, 0LL);
+
+    const QMap<QString, QString> info = manager.info("persistence");
+    BenchmarkResult result = BenchmarkReporter::summarize("fsync_" + policy, 0, VALUE_SIZE, run.latenciesNs,
+                                                          run.elapsedNs);
+    reporter_.record(result);
+    fsyncRows_.append({policy, result, countSpikes(run.latenciesNs), info.value("aof_delayed_fsync").toLongLong()});
+}
+
+void PersistenceBenchmark::benchmarkBgsaveLatency_data()
+{
+    QTest::addColumn<qint64>("keys");
+    for (qint64 keys : datasetSizes()) {
+        QTest::newRow(qPrintable(QString("keys_%1").arg(keys))) << keys;
+    }
+}
+
+void PersistenceBenchmark::benchmarkBgsaveLatency()
+{
+    QFETCH(qint64, keys);
+    RedisServerProcess server;
+    QVERIFY2(server.start(), "Failed to start redis-server");
+    RedisManager manager;
+    QVERIFY(manager.connectToServer(server.connectionOptions(WRITER_THREADS + 1)));
+    QVERIFY(populate(&manager, keys));
+
+    qint64 startNs = -1;
+    qint64 endNs = -1;
+    WriteRun run;
+    QBENCHMARK_ONCE {
+        run = runWriters(&manager, [&](const QElapsedTimer &clock) {
+            QThread::msleep(BGSAVE_DELAY_MS);
+            startNs = clock.nsecsElapsed();
+            if (manager.bgSave() && waitWhile(&manager, "persistence", {"rdb_bgsave_in_progress"})) {
+                endNs = clock.nsecsElapsed();
+            }
+        });
+    }
+    QVERIFY2(endNs > startNs && startNs >= 0, "BGSAVE did not complete");
+    QCOMPARE(run.errors, 0LL);
+
+    const QMap<QString, QString> persistence = manager.info("persistence");
+    const QMap<QString, QString> stats = manager.info("stats");
+    QCOMPARE(persistence.value("rdb_last_bgsave_status"), QString("ok"));
+
+    // 按请求发出时间划分为 BGSAVE 期间与其余时间
+    QVector<qint64> during;
+    QVector<qint64> outside;
+    for (int i = 0; i < run.latenciesNs.size(); ++i) {
+        const qint64 offset = run.offsetsNs.at(i);
+        (offset >= startNs && offset <= endNs ? during : outside).append(run.latenciesNs.at(i));
+    }
+    BenchmarkResult duringResult = BenchmarkReporter::summarize("bgsave_during", keys, VALUE_SIZE, during,
+                                                                endNs - startNs);
+    BenchmarkResult outsideResult = BenchmarkReporter::summarize("bgsave_outside", keys, VALUE_SIZE, outside,
+                                                                 run.elapsedNs - (endNs - startNs));
+    reporter_.record(outsideResult);
+    reporter_.record(duringResult);
+    bgsaveRows_.append({keys, outsideResult, duringResult, countSpikes(during),
+                        stats.value("latest_fork_usec").toLongLong(),
+                        persistence.value("rdb_last_bgsave_time_sec").toLongLong()});
+}
+
+void PersistenceBenchmark::benchmarkRestartLoad_data()
+{
+    QTest::addColumn<QString>("mode");
+    QTest::addColumn<qint64>("keys");
+    for (qint64 keys : datasetSizes()) {
+        QTest::newRow(qPrintable(QString("rdb_%1").arg(keys))) << QString("rdb") << keys;
+        QTest::newRow(qPrintable(QString("aof_%1").arg(keys))) << QString("aof") << keys;
+    }
+}
+
+void PersistenceBenchmark::benchmarkRestartLoad()
+{
+    QFETCH(QString, mode);
+    QFETCH(qint64, keys);
+
+    // AOF 关闭 RDB 前导, 测量纯命令重放的加载时间
+    QStringList args;
+    if (mode == "aof") {
+        args << "--appendonly" << "yes" << "--aof-use-rdb-preamble" << QString("no");
+    }
+    RedisServerProcess server(args);
+    QVERIFY2(server.start(), "Failed to start redis-server");
+    {
+        RedisManager manager;
+        QVERIFY(manager.connectToServer(server.connectionOptions()));
+        QVERIFY(populate(&manager, keys));
+        if (mode == "rdb") {
+            QVERIFY(manager.save());
+        } else {
+            // DEBUG POPULATE 不写入 AOF, 通过重写把数据集落到 AOF
+            QVERIFY(manager.bgRewriteAof());
+            BenchmarkReporter::suppressDebugOutput(true);
+            const bool rewritten =
+                waitWhile(&manager, "persistence", {"aof_rewrite_in_progress", "aof_rewrite_scheduled"});
+            BenchmarkReporter::suppressDebugOutput(false);
+            QVERIFY(rewritten);
+        }
+    }
+    const qint64 dataBytes = server.dataSizeBytes();
+
+    QBENCHMARK_ONCE {
+        QVERIFY2(server.restart(SERVER_TIMEOUT_MS), "redis-server failed to restart");
+    }
+    const qint64 loadMs = server.lastStartupMs();
+
+    RedisManager manager;
+    QVERIFY(manager.connectToServer(server.connectionOptions()));
+    QCOMPARE(manager.dbSize(), keys);
+
+    BenchmarkResult result;
+    result.operation = "restart_" + mode;
+    result.name = QString("%1/card_%2/value_%3").arg(result.operation).arg(keys).arg(VALUE_SIZE);
+    result.cardinality = keys;
+    result.valueSize = VALUE_SIZE;
+    result.iterations = 1;
+    result.opsPerSec = loadMs > 0 ? keys * 1000.0 / loadMs : 0.0;
+    result.minUs = result.meanUs = result.p50Us = result.p90Us = result.p99Us = result.p999Us = result.maxUs =
+        loadMs * 1000.0;
+    reporter_.record(result);
+    loadRows_.append({mode, keys, loadMs, dataBytes});
+    qDebug() << "RESULT: restart" << mode << keys << "keys," << dataBytes << "bytes, loaded in" << loadMs << "ms";
+}
+
+void PersistenceBenchmark::writeReport() const
+{
+    auto us = [](double value) { return QString::number(value, 'f', 1); };
+
+    QString report;
+    QTextStream out(&report);
+    out << "# 持久化性能对比\n\n";
+    out << "写入线程 " << WRITER_THREADS << ", 值 " << VALUE_SIZE << "B, 每项写入至少 " << WRITE_DURATION_MS
+        << "ms; 尖刺指延迟超过 " << SPIKE_THRESHOLD_US / 1000 << "ms 的请求\n\n";
+
+    out << "## appendfsync 策略\n\n";
+    out << "| 策略 | ops/sec | p50(us) | p99(us) | p999(us) | max(us) | 尖刺 | aof_delayed_fsync |\n";
+    out << "|---|---|---|---|---|---|---|---|\n";
+    for (const auto &row : fsyncRows_) {
+        out << "| " << row.policy << " | " << qRound64(row.result.opsPerSec) << " | " << us(row.result.p50Us)
+            << " | " << us(row.result.p99Us) << " | " << us(row.result.p999Us) << " | " << us(row.result.maxUs)
+            << " | " << row.spikes << " | " << row.delayedFsync << " |\n";
+    }
+
+    out << "\n## BGSAVE 期间的写入延迟\n\n";
+    out << "| 键数量 | fork(us) | BGSAVE(s) | p99 平时(us) | p99 期间(us) | p999 期间(us) | max 期间(us) | 期间尖刺 |\n";
+    out << "|---|---|---|---|---|---|---|---|\n";
+    for (const auto &row : bgsaveRows_) {
+        out << "| " << row.keys << " | " << row.forkUs << " | " << row.bgsaveSec << " | " << us(row.outside.p99Us)
+            << " | " << us(row.during.p99Us) << " | " << us(row.during.p999Us) << " | " << us(row.during.maxUs)
+            << " | " << row.spikes << " |\n";
+    }
+
+    out << "\n## 重启加载时间\n\n";
+    out << "| 方式 | 键数量 | 文件大小(MB) | 加载时间(ms) | 键/秒 |\n";
+    out << "|---|---|---|---|---|\n";
+    for (const auto &row : loadRows_) {
+        out << "| " << row.mode << " | " << row.keys << " | "
+            << QString::number(row.dataBytes / (1024.0 * 1024.0), 'f', 1) << " | " << row.loadMs << " | "
+            << (row.loadMs > 0 ? qRound64(row.keys * 1000.0 / row.loadMs) : 0) << " |\n";
+    }
+    out.flush();
+
+    const QString path = QFileInfo(reporter_.outputPath()).dir().filePath("persistence_report.md");
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        file.write(report.toUtf8());
+        qDebug() << "Persistence report written to" << path;
+    }
+    qDebug().noquote() << report;
+}
+
+// QProcess/QTcpSocket 需要 QCoreApplication
+QTEST_GUILESS_MAIN(PersistenceBenchmark)
+#include "tst_persistencebenchmark.moc"
@@ -1,8 +1,10 @@
 /*
  * RDB 持久化测试
  * 测试流程：
- * 1. write_data - 写入测试数据并保存到文件
- * 2. verify_data - 从文件读取数据并验证
+ * 1. write_data - 以流水线批量写入测试数据, 同时写出二进制清单
+ * 2. verify_data - 按清单多线程 MGET 并比较值的哈希与长度
+ *
+ * 数据量由 PERSISTENCE_TEST_COUNT 指定(默认 1000), 千万级键也只需顺序读写一遍清单
  */
 
 #include <QObject>
@@ -11,16 +13,16 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QFile>
-#include <QDateTime>
 #include <QRandomGenerator>
 #include "../fixtures/redistestfixture.h"
+#include "../fixtures/persistencemanifest.h"
 
 class RdbPersistenceTest : public QObject
 {
     Q_OBJECT
 
 public:
-    RdbPersistenceTest() : fixture_(nullptr) {}
+    RdbPersistenceTest() : fixture_(nullptr), testCount_(0) {}
 
 private slots:
     void initTestCase();
@@ -33,29 +35,26 @@ private slots:
 private:
     RedisTestFixture* fixture_;
     QString dataFilePath_;
+    qint64 testCount_;
     
-    struct TestData {
-        QString key;
-        QString value;
-    };
-    QList<TestData> testData_;
-    
-    static constexpr int TEST_COUNT = 1000;
-    
-    void saveTestData();
-    bool loadTestData();
+    static constexpr qint64 DEFAULT_TEST_COUNT = 1000;
 };
 
 void RdbPersistenceTest::initTestCase()
 {
     fixture_ = new RedisTestFixture();
-    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+
+    // 校验线程共享连接池
+    RedisConnectionOptions options;
+    options.poolSize = PersistenceDataset::verifyThreads() + 1;
+    QVERIFY2(fixture_->connect(options), "Failed to connect to Redis server");
     
     // 从环境变量获取数据文件路径
     dataFilePath_ = QString::fromLocal8Bit(qgetenv("PERSISTENCE_TEST_DATA_FILE"));
     if (dataFilePath_.isEmpty()) {
-        dataFilePath_ = "/tmp/rdb_test_data.json";
+        dataFilePath_ = "/tmp/rdb_test_data.bin";
     }
+    testCount_ = PersistenceDataset::testCount(DEFAULT_TEST_COUNT);
 }
 
 void RdbPersistenceTest::cleanupTestCase()
@@ -69,44 +68,32 @@ void RdbPersistenceTest::testWriteData()
     QVERIFY(fixture_ != nullptr);
     QVERIFY(fixture_->manager() != nullptr);
     
-    // 静态变量确保只生成一次数据
-    static bool dataGenerated = false;
-    static QList<TestData> staticTestData;
-    
-    if (!dataGenerated) {
-        // 生成测试数据（只执行一次）
-        for (int i = 0; i < TEST_COUNT; ++i) {
-            QString key = QString("rdb_test_key_%1").arg(i);
-            QString value = QString("value_%1_%2")
-                .arg(QDateTime::currentMSecsSinceEpoch())
-                .arg(QRandomGenerator::global()->generate());
-            
-            TestData data;
-            data.key = key;
-            data.value = value;
-            staticTestData.append(data);
-        }
-        
-        // 复制到成员变量（用于 saveTestData）
-        testData_ = staticTestData;
-        
-        // 保存到文件（只执行一次）
-        saveTestData();
-        
-        dataGenerated = true;
+    // 检查文件是否已存在，避免覆盖清单; 已存在时沿用清单头中的种子, 保证写入的值与清单一致
+    PersistenceManifestWriter manifest(dataFilePath_);
+    const bool writeManifest = !QFile::exists(dataFilePath_);
+    quint64 seed = 0;
+    if (writeManifest) {
+        seed = QRandomGenerator::global()->generate64();
+        QVERIFY(manifest.open(seed));
     } else {
-        // 后续迭代使用已生成的数据
-        testData_ = staticTestData;
+        PersistenceManifestReader existing(dataFilePath_);
+        QVERIFY2(existing.open(), "Existing test data file is unreadable; delete it to regenerate");
+        seed = existing.seed();
+        qDebug() << "Test data file already exists, skipping save (seed" << seed << ")";
     }
     
-    // 写入 Redis（每次迭代都执行，用于 benchmark）
-    QBENCHMARK {
-        for (const auto& data : testData_) {
-            QVERIFY(fixture_->manager()->set(data.key, data.value));
-        }
+    // 写入 Redis（清单随第一遍写入同步生成, 大数据量下只写一遍）
+    QBENCHMARK_ONCE {
+        QVERIFY(PersistenceDataset::write(fixture_->manager(), "rdb_test_key_", testCount_, seed,
+                                          PersistenceDataset::batchSize(),
+                                          writeManifest ? &manifest : nullptr));
+    }
+    if (writeManifest) {
+        QVERIFY(manifest.close());
+        qDebug() << "Test data saved to:" << dataFilePath_ << "(" << manifest.count() << "records )";
     }
     
-    qDebug() << "RESULT: Written" << testData_.size() << "keys to Redis";
+    qDebug() << "RESULT: Written" << testCount_ << "keys to Redis";
 }
 
 void RdbPersistenceTest::testVerifyData()
@@ -122,45 +109,25 @@ void RdbPersistenceTest::testVerifyData()
         // 使用之前的结果
         QJsonDocument doc(verificationResult);
         qDebug().noquote() << "RESULT:" << doc.toJson(QJsonDocument::Compact);
-        QCOMPARE(verificationResult["mismatched"].toInt(), 0);
-        QCOMPARE(verificationResult["matched"].toInt(), TEST_COUNT);
+        QCOMPARE(verificationResult["mismatched"].toDouble(), 0.0);
+        QCOMPARE(verificationResult["matched"].toDouble(), static_cast<double>(testCount_));
         return;
     }
     
-
-    
-    // 从文件加载测试数据
-    QVERIFY(loadTestData());
-    
-    int matched = 0;
-    int mismatched = 0;
-    QList<QString> failedKeys;
-    
-    // 验证每个 key（只执行一次验证逻辑）
-    for (const auto& data : testData_) {
-        QString actualValue = fixture_->manager()->get(data.key);
-        
-        if (actualValue == data.value) {
-            ++matched;
-        } else {
-            ++mismatched;
-            if (failedKeys.size() < 10) {  // 只记录前10个失败的
-                failedKeys.append(data.key);
-            }
-        }
-    }
+    // 按清单并行校验（只执行一次验证逻辑）
+    const int threads = PersistenceDataset::verifyThreads();
+    PersistenceDataset::VerifyResult result = PersistenceDataset::verify(
+        fixture_->manager(), dataFilePath_, threads, PersistenceDataset::batchSize());
+    QVERIFY2(!result.manifestError, "Failed to read test data manifest");
     
     // 保存结果（验证阶段不需要性能测试）
-    verificationResult["result"] = (mismatched == 0) ? "PASS" : "FAIL";
-    verificationResult["total"] = testData_.size();
-    verificationResult["matched"] = matched;
-    verificationResult["mismatched"] = mismatched;
-    
-    QJsonArray failedArray;
-    for (const auto& key : failedKeys) {
-        failedArray.append(key);
-    }
-    verificationResult["failed_keys"] = failedArray;
+    verificationResult["result"] = (result.mismatched == 0 && result.total == testCount_) ? "PASS" : "FAIL";
+    verificationResult["total"] = static_cast<double>(result.total);
+    verificationResult["matched"] = static_cast<double>(result.matched);
+    verificationResult["mismatched"] = static_cast<double>(result.mismatched);
+    verificationResult["threads"] = threads;
+    verificationResult["elapsed_ms"] = static_cast<double>(result.elapsedMs);
+    verificationResult["failed_keys"] = QJsonArray::fromStringList(result.failedKeys);
     
     verificationDone = true;
     
@@ -169,72 +136,8 @@ void RdbPersistenceTest::testVerifyData()
     qDebug().noquote() << "RESULT:" << doc.toJson(QJsonDocument::Compact);
     
     // 验证通过条件
-    QCOMPARE(mismatched, 0);
-    QCOMPARE(matched, TEST_COUNT);
-}
-
-void RdbPersistenceTest::saveTestData()
-{
-    // 检查文件是否已存在，避免 QBENCHMARK 多次执行时重复追加
-    QFile checkFile(dataFilePath_);
-    if (checkFile.exists()) {
-        qDebug() << "Test data file already exists, skipping save.";
-        return;
-    }
-    
-    QJsonArray dataArray;
-    for (const auto& data : testData_) {
-        QJsonObject obj;
-        obj["key"] = data.key;
-        obj["value"] = data.value;
-        dataArray.append(obj);
-    }
-    
-    QJsonObject root;
-    root["count"] = testData_.size();
-    root["data"] = dataArray;
-    
-    QJsonDocument doc(root);
-    
-    QFile file(dataFilePath_);
-    QVERIFY(file.open(QIODevice::WriteOnly));
-    file.write(doc.toJson());
-    file.close();
-    
-    qDebug() << "Test data saved to:" << dataFilePath_ << "(" << testData_.size() << "records )";
-}
-
-bool RdbPersistenceTest::loadTestData()
-{
-    QFile file(dataFilePath_);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "Failed to open test data file:" << dataFilePath_;
-        return false;
-    }
-    
-    QByteArray rawData = file.readAll();
-    file.close();
-    
-    QJsonDocument doc = QJsonDocument::fromJson(rawData);
-    if (doc.isNull() || !doc.isObject()) {
-        qWarning() << "Invalid JSON in test data file";
-        return false;
-    }
-    
-    QJsonObject root = doc.object();
-    QJsonArray dataArray = root["data"].toArray();
-    
-    testData_.clear();
-    for (const auto& item : dataArray) {
-        QJsonObject obj = item.toObject();
-        TestData data;
-        data.key = obj["key"].toString();
-        data.value = obj["value"].toString();
-        testData_.append(data);
-    }
-    
-    qDebug() << "Loaded" << testData_.size() << "test records from file";
-    return !testData_.isEmpty();
+    QCOMPARE(result.mismatched, 0LL);
+    QCOMPARE(result.matched, testCount_);
 }
 
 QTEST_APPLESS_MAIN(RdbPersistenceTest)
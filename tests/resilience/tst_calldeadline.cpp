@@ -0,0 +1,252 @@
+/*
+ * 调用截止时间测试
+ * 通过本地延迟注入代理连接 Redis, 验证:
+ * 1. 慢应答下调用耗时受截止时间约束(p99 有界)
+ * 2. 截止时间到期与 nil、服务器错误可区分
+ * 3. 截止时间到期不会触发熔断
+ * 4. socket 超时按剩余时间向下取档后仍保留大部分预算; 剩余时间不足最小档位时不发送
+ * 5. 连接探测直接使用主连接池; 不同截止时间打开的分档连接池数量受 maxDeadlinePools 限制
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <vector>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/latencyproxy.h"
+
+class CallDeadlineTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    CallDeadlineTest() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void testP99BoundedByDeadline();
+    void testNilIsNotDeadline();
+    void testExpiredDeadlineSkipsNetwork();
+    void testSubBucketDeadlineSkipsNetwork();
+    void testRoundingKeepsMostOfBudget();
+    void testServerErrorIsNotDeadline();
+    void testNestedContextKeepsEarlierDeadline();
+    void testBucketPoolsCapped();
+
+private:
+    qint64 connectedClients();
+
+    RedisTestFixture *fixture_;
+    LatencyProxy proxy_;
+    QString testKey_;
+
+    static constexpr int DEADLINE_MS = 50;
+    static constexpr int INJECTED_DELAY_MS = 300;
+    static constexpr int SAMPLE_COUNT = 100;
+    // 调度与建连的额外开销容忍
+    static constexpr int SLACK_MS = 30;
+};
+
+qint64 CallDeadlineTest::connectedClients()
+{
+    return fixture_->manager()->info("clients").value("connected_clients").toLongLong();
+}
+
+void CallDeadlineTest::initTestCase()
+{
+    QVERIFY2(proxy_.start(), "Failed to start latency proxy");
+
+    RedisConnectionOptions options;
+    options.port = proxy_.port();
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(options), "Failed to connect to Redis server through proxy");
+}
+
+void CallDeadlineTest::cleanupTestCase()
+{
+    delete fixture_;
+    fixture_ = nullptr;
+    proxy_.stop();
+}
+
+void CallDeadlineTest::init()
+{
+    proxy_.setDelayMs(0);
+    testKey_ = RedisTestFixture::generateUniqueKey("deadline");
+}
+
+void CallDeadlineTest::cleanup()
+{
+    proxy_.setDelayMs(0);
+    if (fixture_ && fixture_->manager()) {
+        fixture_->manager()->del(testKey_);
+    }
+}
+
+void CallDeadlineTest::testP99BoundedByDeadline()
+{
+    RedisManager *manager = fixture_->manager();
+    QVERIFY(manager->set(testKey_, "value"));
+
+    proxy_.setDelayMs(INJECTED_DELAY_MS);
+
+    std::vector<qint64> latencies;
+    latencies.reserve(SAMPLE_COUNT);
+    int deadlineExceeded = 0;
+
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        {
+            RedisCallContext ctx(DEADLINE_MS);
+            QString value = manager->get(testKey_);
+            Q_UNUSED(value);
+        }
+        latencies.push_back(timer.elapsed());
+        if (manager->lastCallStatus() == RedisCallStatus::DeadlineExceeded) {
+            ++deadlineExceeded;
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    qint64 p50 = latencies[latencies.size() / 2];
+    qint64 p99 = latencies[(latencies.size() * 99) / 100];
+    qDebug() << "RESULT: delay" << INJECTED_DELAY_MS << "ms, deadline" << DEADLINE_MS
+             << "ms, p50" << p50 << "ms, p99" << p99 << "ms, exceeded" << deadlineExceeded;
+
+    QVERIFY2(p99 <= DEADLINE_MS + SLACK_MS, qPrintable(QString("p99 %1ms exceeds deadline").arg(p99)));
+    QCOMPARE(deadlineExceeded, SAMPLE_COUNT);
+
+    // 截止时间到期是调用方预算问题, 连接应保持可用
+    QVERIFY(manager->isAvailable());
+
+    proxy_.setDelayMs(0);
+    QCOMPARE(manager->get(testKey_), QString("value"));
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::Ok);
+}
+
+void CallDeadlineTest::testNilIsNotDeadline()
+{
+    RedisManager *manager = fixture_->manager();
+
+    RedisCallContext ctx(1000);
+    QString value = manager->get(testKey_);
+    QVERIFY(value.isEmpty());
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::Ok);
+}
+
+void CallDeadlineTest::testExpiredDeadlineSkipsNetwork()
+{
+    RedisManager *manager = fixture_->manager();
+    proxy_.setDelayMs(INJECTED_DELAY_MS);
+
+    QElapsedTimer timer;
+    timer.start();
+    {
+        RedisCallContext ctx(0);
+        manager->set(testKey_, "never-sent");
+    }
+    qint64 elapsed = timer.elapsed();
+
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::DeadlineExceeded);
+    QVERIFY2(elapsed < 5, qPrintable(QString("expired call took %1ms").arg(elapsed)));
+
+    proxy_.setDelayMs(0);
+    QVERIFY(!manager->exists(testKey_));
+}
+
+void CallDeadlineTest::testSubBucketDeadlineSkipsNetwork()
+{
+    RedisManager *manager = fixture_->manager();
+    proxy_.setDelayMs(INJECTED_DELAY_MS);
+
+    // 剩余不足 1ms(最小档位): 任何 socket 超时都会越过截止时间
+    QElapsedTimer timer;
+    timer.start();
+    {
+        RedisCallContext ctx(RedisCallContext::Clock::now() + std::chrono::microseconds(500));
+        manager->set(testKey_, "never-sent");
+    }
+    qint64 elapsed = timer.elapsed();
+
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::DeadlineExceeded);
+    QVERIFY2(elapsed < 5, qPrintable(QString("sub-bucket call took %1ms").arg(elapsed)));
+
+    proxy_.setDelayMs(0);
+    QVERIFY(!manager->exists(testKey_));
+}
+
+void CallDeadlineTest::testRoundingKeepsMostOfBudget()
+{
+    RedisManager *manager = fixture_->manager();
+    QVERIFY(manager->set(testKey_, "value"));
+
+    // 剩余 49ms 时取 40ms 档位, 30ms 的应答能在截止时间内返回(按 1/2/5 分档时只有 20ms)
+    proxy_.setDelayMs(30);
+    int ok = 0;
+    for (int i = 0; i < 10; ++i) {
+        RedisCallContext ctx(49);
+        if (manager->get(testKey_) == "value" && manager->lastCallStatus() == RedisCallStatus::Ok) {
+            ++ok;
+        }
+    }
+    qDebug() << "RESULT: 30ms replies within 49ms deadline:" << ok << "/ 10";
+    // 允许调度抖动导致个别调用超时
+    QVERIFY2(ok >= 8, qPrintable(QString("%1/10 calls succeeded").arg(ok)));
+}
+
+void CallDeadlineTest::testServerErrorIsNotDeadline()
+{
+    RedisManager *manager = fixture_->manager();
+    QVERIFY(manager->set(testKey_, "string-value"));
+
+    // 对字符串执行哈希命令, 服务器返回 WRONGTYPE
+    RedisCallContext ctx(1000);
+    manager->hGet(testKey_, "field");
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::Error);
+}
+
+void CallDeadlineTest::testNestedContextKeepsEarlierDeadline()
+{
+    RedisCallContext outer(20);
+    {
+        RedisCallContext inner(10000);
+        QVERIFY(inner.deadline() <= outer.deadline());
+        QVERIFY(RedisCallContext::remaining() <= std::chrono::milliseconds(20));
+    }
+    QVERIFY(RedisCallContext::hasDeadline());
+}
+
+void CallDeadlineTest::testBucketPoolsCapped()
+{
+    // 直连服务器, 不经过代理; 主连接池不共享, 便于统计本用例新建的连接
+    RedisConnectionOptions options;
+    options.maxDeadlinePools = 2;
+    const qint64 before = connectedClients();
+    RedisTestFixture direct;
+    QVERIFY2(direct.connect(options), "Failed to connect to Redis server");
+
+    // 连接时的 PING 使用主连接池, 不另开档位连接池
+    QCOMPARE(connectedClients() - before, 1LL);
+
+    // 每个截止时间落在不同的细分档位
+    const QVector<int> deadlinesMs = {7, 13, 22, 45, 70, 130, 260, 550, 1100, 2200, 4500};
+    for (int deadlineMs : deadlinesMs) {
+        RedisCallContext ctx(deadlineMs);
+        direct.manager()->exists(testKey_);
+        QCOMPARE(direct.manager()->lastCallStatus(), RedisCallStatus::Ok);
+    }
+
+    // 前两个细分档位(6/12ms)之后只再打开粗档位 30/100/300/1000/3000ms
+    const qint64 opened = connectedClients() - before - 1;
+    qDebug() << "RESULT: bucket pools opened for" << deadlinesMs.size() << "deadlines:" << opened;
+    QVERIFY2(opened <= 7, qPrintable(QString("%1 bucket pools opened").arg(opened)));
+}
+
+QTEST_APPLESS_MAIN(CallDeadlineTest)
+#include "tst_calldeadline.moc"
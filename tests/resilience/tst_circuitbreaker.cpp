@@ -0,0 +1,164 @@
+/*
+ * 熔断与重连测试
+ * 1. 熔断器: 连续失败达到阈值时打开且只有一个调用方得到状态变化, 成功清零计数, reset 关闭
+ * 2. 重试策略: 只读命令与返回值不随重复执行变化的写命令可重试, 其余不重试
+ * 3. 服务器不可达(停止代理)时连续传输失败打开熔断, 之后的调用快速失败并启动后台重连
+ * 4. 服务器恢复(以原端口重启代理)后后台重连关闭熔断, 调用恢复正常
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../fixtures/redistestfixture.h"
+#include "../fixtures/latencyproxy.h"
+#include "../../RedisModule/tool/rediscircuitbreaker.h"
+#include "../../RedisModule/tool/rediscommandpolicy.h"
+
+class CircuitBreakerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    CircuitBreakerTest() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testBreakerThreshold();
+    void testBreakerConcurrentOpen();
+    void testRetryPolicy();
+    void testOpenFailsFastAndReconnects();
+
+private:
+    RedisTestFixture *fixture_;
+    LatencyProxy proxy_;
+    QString testKey_;
+
+    static constexpr int FAILURE_THRESHOLD = 2;
+    static constexpr int RECONNECT_DELAY_MS = 50;
+    // 熔断打开后的调用不经过网络
+    static constexpr int FAST_FAIL_MS = 5;
+};
+
+void CircuitBreakerTest::initTestCase()
+{
+    QVERIFY2(proxy_.start(), "Failed to start latency proxy");
+
+    RedisConnectionOptions options;
+    options.port = proxy_.port();
+    options.connectTimeoutMs = 200;
+    options.socketTimeoutMs = 500;
+    options.failureThreshold = FAILURE_THRESHOLD;
+    options.reconnectInitialDelayMs = RECONNECT_DELAY_MS;
+    options.reconnectMaxDelayMs = 200;
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(options), "Failed to connect to Redis server through proxy");
+    testKey_ = RedisTestFixture::generateUniqueKey("breaker");
+}
+
+void CircuitBreakerTest::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        fixture_->manager()->del(testKey_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+    proxy_.stop();
+}
+
+void CircuitBreakerTest::testBreakerThreshold()
+{
+    RedisCircuitBreaker breaker(3);
+    QVERIFY(!breaker.recordFailure());
+    QVERIFY(!breaker.recordFailure());
+    QVERIFY(!breaker.isOpen());
+
+    // 成功清零连续失败计数
+    breaker.recordSuccess();
+    QCOMPARE(breaker.consecutiveFailures(), 0);
+    QVERIFY(!breaker.recordFailure());
+    QVERIFY(!breaker.recordFailure());
+    QVERIFY(breaker.recordFailure());
+    QVERIFY(breaker.isOpen());
+
+    // 已打开时不再报告状态变化
+    QVERIFY(!breaker.recordFailure());
+    QVERIFY(breaker.isOpen());
+
+    breaker.reset();
+    QVERIFY(!breaker.isOpen());
+    QCOMPARE(breaker.consecutiveFailures(), 0);
+
+    // 阈值不合法时按 1 处理
+    breaker.setFailureThreshold(0);
+    QVERIFY(breaker.recordFailure());
+}
+
+void CircuitBreakerTest::testBreakerConcurrentOpen()
+{
+    RedisCircuitBreaker breaker(10);
+    std::atomic<int> transitions(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 100; ++i) {
+                if (breaker.recordFailure()) {
+                    transitions.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    QVERIFY(breaker.isOpen());
+    QCOMPARE(transitions.load(), 1);
+}
+
+void CircuitBreakerTest::testRetryPolicy()
+{
+    for (const char *operation : {"GET", "HGETALL", "MGET", "PFCOUNT", "SET", "HSET", "SADD", "DEL", "EXPIRE"}) {
+        QVERIFY2(RedisCommandPolicy::isRetrySafe(operation), operation);
+    }
+    // 非幂等, 或重试后返回值与首次执行不同
+    for (const char *operation : {"LPUSH", "LPOP", "INCR", "PERSIST", "ZREM", "XACK", "BITFIELD_SET", "EVAL"}) {
+        QVERIFY2(!RedisCommandPolicy::isRetrySafe(operation), operation);
+    }
+}
+
+void CircuitBreakerTest::testOpenFailsFastAndReconnects()
+{
+    RedisManager *manager = fixture_->manager();
+    QVERIFY(manager->set(testKey_, "value"));
+    QVERIFY(manager->isAvailable());
+
+    // 服务器不可达: 连续传输失败达到阈值后熔断打开
+    const int port = proxy_.port();
+    proxy_.stop();
+    for (int i = 0; i < FAILURE_THRESHOLD * 2 && manager->isAvailable(); ++i) {
+        QVERIFY(manager->get(testKey_).isEmpty());
+        QVERIFY(manager->lastCallStatus() != RedisCallStatus::Ok);
+    }
+    QVERIFY(!manager->isAvailable());
+    QVERIFY(manager->isReconnecting());
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(manager->get(testKey_).isEmpty());
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::CircuitOpen);
+    QVERIFY2(timer.elapsed() < FAST_FAIL_MS, qPrintable(QString("open call took %1ms").arg(timer.elapsed())));
+
+    // 服务器恢复: 后台重连探测成功后关闭熔断
+    QVERIFY2(proxy_.start(port), "Failed to restart latency proxy on the same port");
+    QTRY_VERIFY_WITH_TIMEOUT(manager->isAvailable(), 5000);
+    QTRY_VERIFY_WITH_TIMEOUT(!manager->isReconnecting(), 1000);
+    QCOMPARE(manager->get(testKey_), QString("value"));
+    QCOMPARE(manager->lastCallStatus(), RedisCallStatus::Ok);
+}
+
+QTEST_GUILESS_MAIN(CircuitBreakerTest)
+#include "tst_circuitbreaker.moc"
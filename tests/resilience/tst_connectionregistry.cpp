@@ -0,0 +1,254 @@
+/*
+ * 共享连接注册表测试
+ * 1. 连接参数相同的 RedisManager 共享一个连接池, 服务器端连接数不随使用方增加
+ * 2. 连接参数不同或未开启共享时使用独立的连接池
+ * 3. 每个使用方的调用与失败统计
+ * 4. 引用计数: 最后一个使用方归还时连接池关闭, 其余使用方不受前者断开影响
+ * 5. 关闭注册表后拒绝新的使用方, 并等待已借出的连接池归还
+ * 6. 阻塞命令使用专用连接池, 阻塞期间共享连接池上其他使用方与本使用方的调用不排队
+ */
+
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <thread>
+#include "../fixtures/redistestfixture.h"
+
+class ConnectionRegistryTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ConnectionRegistryTest() : fixture_(nullptr) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testManagersSharePool();
+    void testSeparatePools();
+    void testConsumerMetrics();
+    void testReleaseClosesPool();
+    void testShutdown();
+    void testBlockingCallKeepsSharedPoolFree();
+
+private:
+    RedisConnectionOptions options(const QString &consumer, int poolSize = 4) const;
+    RedisSharedPoolInfo poolOf(const QString &consumer) const;
+    qint64 connectedClients();
+
+    RedisTestFixture *fixture_;
+    QString key_;
+};
+
+RedisConnectionOptions ConnectionRegistryTest::options(const QString &consumer, int poolSize) const
+{
+    RedisConnectionOptions result;
+    result.poolSize = poolSize;
+    result.poolWaitTimeoutMs = 2000;
+    result.sharedPool = true;
+    result.consumerName = consumer;
+    return result;
+}
+
+RedisSharedPoolInfo ConnectionRegistryTest::poolOf(const QString &consumer) const
+{
+    // 主连接池的 socket 超时为 0, 与分档连接池区分
+    for (const auto &pool : RedisManager::sharedPools()) {
+        if (pool.socketTimeoutMs != 0) {
+            continue;
+        }
+        for (const auto &info : pool.consumers) {
+            if (info.name == consumer) {
+                return pool;
+            }
+        }
+    }
+    return RedisSharedPoolInfo();
+}
+
+qint64 ConnectionRegistryTest::connectedClients()
+{
+    return fixture_->manager()->info("clients").value("connected_clients").toLongLong();
+}
+
+void ConnectionRegistryTest::initTestCase()
+{
+    fixture_ = new RedisTestFixture();
+    QVERIFY2(fixture_->connect(), "Failed to connect to Redis server");
+    QVERIFY(fixture_->manager()->isPoolShared());
+    key_ = RedisTestFixture::generateUniqueKey("registry");
+    QVERIFY(fixture_->manager()->set(key_, "v"));
+}
+
+void ConnectionRegistryTest::cleanupTestCase()
+{
+    if (fixture_ && fixture_->manager()) {
+        fixture_->manager()->del(key_);
+    }
+    delete fixture_;
+    fixture_ = nullptr;
+}
+
+void ConnectionRegistryTest::testManagersSharePool()
+{
+    const int poolsBefore = RedisConnectionRegistry::instance().poolCount();
+    const qint64 before = connectedClients();
+
+    RedisConnectionOptions first = options("share-a");
+    first.warmUp = true;
+    RedisManager a;
+    QVERIFY(a.connectToServer(first));
+    QVERIFY(a.isPoolShared());
+    const qint64 afterA = connectedClients();
+    QVERIFY(afterA - before >= first.poolSize);
+
+    // 第二个使用方借出同一组连接, 预热不再建立新连接
+    RedisConnectionOptions second = options("share-b");
+    second.warmUp = true;
+    RedisManager b;
+    QVERIFY(b.connectToServer(second));
+    QCOMPARE(connectedClients(), afterA);
+    QCOMPARE(b.get(key_), QString("v"));
+
+    const RedisSharedPoolInfo pool = poolOf("share-a");
+    QCOMPARE(pool.consumers.size(), 2);
+    QCOMPARE(pool.consumers.at(1).name, QString("share-b"));
+    QCOMPARE(pool.poolSize, first.poolSize);
+    QCOMPARE(pool.savedConnections, first.poolSize);
+    QCOMPARE(poolOf("share-b").key, pool.key);
+    QVERIFY(RedisConnectionRegistry::instance().poolCount() > poolsBefore);
+}
+
+void ConnectionRegistryTest::testSeparatePools()
+{
+    RedisManager shared;
+    QVERIFY(shared.connectToServer(options("separate-shared", 4)));
+
+    // 连接池大小不同: 另一个连接池
+    RedisManager larger;
+    QVERIFY(larger.connectToServer(options("separate-larger", 8)));
+    QVERIFY(poolOf("separate-larger").key != poolOf("separate-shared").key);
+    QCOMPARE(poolOf("separate-larger").consumers.size(), 1);
+
+    // 未开启共享: 不出现在注册表中
+    RedisConnectionOptions privateOptions = options("separate-private", 4);
+    privateOptions.sharedPool = false;
+    RedisManager isolated;
+    QVERIFY(isolated.connectToServer(privateOptions));
+    QVERIFY(!isolated.isPoolShared());
+    QCOMPARE(poolOf("separate-private").consumers.size(), 0);
+    QCOMPARE(isolated.get(key_), QString("v"));
+}
+
+void ConnectionRegistryTest::testConsumerMetrics()
+{
+    RedisManager a;
+    RedisManager b;
+    QVERIFY(a.connectToServer(options("metrics-a")));
+    QVERIFY(b.connectToServer(options("metrics-b")));
+
+    for (int i = 0; i < 10; ++i) {
+        a.get(key_);
+    }
+    for (int i = 0; i < 3; ++i) {
+        b.get(key_);
+    }
+
+    const RedisSharedPoolInfo pool = poolOf("metrics-a");
+    for (const auto &consumer : pool.consumers) {
+        if (consumer.name == "metrics-a") {
+            QCOMPARE(consumer.calls, 10LL);
+        } else if (consumer.name == "metrics-b") {
+            QCOMPARE(consumer.calls, 3LL);
+        }
+        QCOMPARE(consumer.failures, 0LL);
+        QVERIFY(consumer.acquiredAtMs > 0);
+    }
+}
+
+void ConnectionRegistryTest::testReleaseClosesPool()
+{
+    const qint64 before = connectedClients();
+    RedisConnectionOptions opts = options("release-a", 6);
+    opts.warmUp = true;
+    RedisManager a;
+    QVERIFY(a.connectToServer(opts));
+    opts.consumerName = "release-b";
+    RedisManager b;
+    QVERIFY(b.connectToServer(opts));
+    const qint64 opened = connectedClients();
+    QVERIFY(opened - before >= opts.poolSize);
+
+    // 一个使用方断开不影响另一个
+    a.disconnect();
+    QCOMPARE(poolOf("release-b").consumers.size(), 1);
+    QCOMPARE(b.get(key_), QString("v"));
+    QCOMPARE(connectedClients(), opened);
+
+    // 最后一个使用方归还后连接池关闭
+    const QString key = poolOf("release-b").key;
+    b.disconnect();
+    QVERIFY(poolOf("release-b").key.isEmpty());
+    for (const auto &pool : RedisManager::sharedPools()) {
+        QVERIFY(pool.key != key);
+    }
+    QTRY_VERIFY(connectedClients() <= before);
+}
+
+void ConnectionRegistryTest::testShutdown()
+{
+    RedisConnectionRegistry &registry = RedisConnectionRegistry::instance();
+    RedisManager holder;
+    QVERIFY(holder.connectToServer(options("shutdown-holder")));
+
+    // 仍有使用方时不等待的关闭返回 false, 之后拒绝新的使用方
+    QVERIFY(!registry.shutdown());
+    QVERIFY(registry.isShutdown());
+    RedisManager late;
+    QVERIFY(!late.connectToServer(options("shutdown-late")));
+    QCOMPARE(holder.get(key_), QString("v"));
+
+    // 全部使用方归还后关闭完成; 夹具也是使用方, 需一并断开
+    std::thread releaser([&]() {
+        QThread::msleep(100);
+        holder.disconnect();
+        fixture_->manager()->disconnect();
+    });
+    QVERIFY(registry.shutdown(std::chrono::milliseconds(5000)));
+    releaser.join();
+    QCOMPARE(registry.poolCount(), 0);
+
+    registry.reopen();
+    QVERIFY(fixture_->connect());
+    QVERIFY(late.connectToServer(options("shutdown-late")));
+    QCOMPARE(late.get(key_), QString("v"));
+}
+
+void ConnectionRegistryTest::testBlockingCallKeepsSharedPoolFree()
+{
+    // 单连接且等待不限时的共享连接池: 阻塞读取若占用它, 其他调用要等到阻塞结束
+    RedisConnectionOptions opts = options("blocking-reader", 1);
+    opts.poolWaitTimeoutMs = 0;
+    RedisManager reader;
+    QVERIFY(reader.connectToServer(opts));
+    opts.consumerName = "blocking-other";
+    RedisManager other;
+    QVERIFY(other.connectToServer(opts));
+
+    const QString emptyList = RedisTestFixture::generateUniqueKey("registry-empty");
+    std::thread blocked([&]() { reader.bLPop({emptyList}, 2); });
+    // 等阻塞读取发出
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    QElapsedTimer timer;
+    timer.start();
+    QCOMPARE(other.get(key_), QString("v"));
+    QCOMPARE(reader.get(key_), QString("v"));
+    const qint64 elapsed = timer.elapsed();
+    blocked.join();
+    QVERIFY2(elapsed < 1000, qPrintable(QString("calls waited %1ms behind a blocking read").arg(elapsed)));
+}
+
+QTEST_APPLESS_MAIN(ConnectionRegistryTest)
+#include "tst_connectionregistry.moc"
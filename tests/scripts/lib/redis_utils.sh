@@ -74,7 +74,8 @@ trigger_bgsave() {
     
     # 等待保存完成
     local last_save_before=$(redis-cli LASTSAVE)
-    local timeout=30
+    # 大数据量(如千万级键)时通过 REDIS_SAVE_TIMEOUT 延长
+    local timeout=${REDIS_SAVE_TIMEOUT:-30}
     local elapsed=0
     
     while [ $elapsed -lt $timeout ]; do
@@ -107,8 +108,8 @@ restart_redis() {
         redis-server --daemonize yes --dir "$BUILD_DIR"
     fi
     
-    # 等待启动和加载完成（AOF文件可能很大，需要更长时间）
-    local timeout=120
+    # 等待启动和加载完成（AOF文件可能很大，需要更长时间，可通过 REDIS_LOAD_TIMEOUT 延长）
+    local timeout=${REDIS_LOAD_TIMEOUT:-120}
     local elapsed=0
     while [ $elapsed -lt $timeout ]; do
         local ping_result
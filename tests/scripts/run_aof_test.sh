@@ -15,9 +15,11 @@ SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
 source "${SCRIPT_DIR}/lib/redis_utils.sh"
 
 # 测试配置
-TEST_DATA_FILE="/tmp/aof_test_data.json"
+TEST_DATA_FILE="/tmp/aof_test_data.bin"
 TEST_RESULT_FILE="/tmp/aof_test_result.json"
-TEST_COUNT=1000
+# 数据量可通过 PERSISTENCE_TEST_COUNT 覆盖, 如 10000000
+TEST_COUNT="${PERSISTENCE_TEST_COUNT:-1000}"
+export PERSISTENCE_TEST_COUNT="$TEST_COUNT"
 
 # 清理旧数据文件
 rm -f "$TEST_DATA_FILE" "$TEST_RESULT_FILE"
@@ -44,7 +46,8 @@ log_info "写入 $TEST_COUNT 条测试数据..."
 PERSISTENCE_TEST_DATA_FILE="$TEST_DATA_FILE" \
     "${BUILD_DIR}/tests/tst_aofpersistence" testWriteData
 
-KEYS_BEFORE=$(redis-cli KEYS "aof_test_*" 2>/dev/null | wc -l | tr -d ' ')
+# 写入前已清空数据库, 用 DBSIZE 代替 KEYS 避免大数据量下阻塞服务器
+KEYS_BEFORE=$(redis-cli DBSIZE 2>/dev/null | tr -d ' ')
 log_info "写入完成，共 $KEYS_BEFORE 条 key"
 
 # 检查 AOF 文件
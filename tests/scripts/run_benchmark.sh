@@ -32,4 +32,49 @@ log_info "运行 Bytes 基准测试..."
 "${BUILD_DIR}/tests/tst_bytesbenchmark" -maxwarnings 0 > "${RESULT_DIR}/bytes_benchmark.log" 2>&1 || true
 log_success "Bytes 测试完成"
 
+# 运行 Stream Benchmark
+if [ -f "${BUILD_DIR}/tests/tst_streambenchmark" ]; then
+    log_info "运行 Stream 基准测试..."
+    "${BUILD_DIR}/tests/tst_streambenchmark" -maxwarnings 0 > "${RESULT_DIR}/stream_benchmark.log" 2>&1 || true
+    log_success "Stream 测试完成"
+fi
+
+# 运行 Pub/Sub Benchmark
+if [ -f "${BUILD_DIR}/tests/tst_pubsubbenchmark" ]; then
+    log_info "运行 Pub/Sub 基准测试..."
+    "${BUILD_DIR}/tests/tst_pubsubbenchmark" -maxwarnings 0 > "${RESULT_DIR}/pubsub_benchmark.log" 2>&1 || true
+    log_success "Pub/Sub 测试完成"
+fi
+
+# 运行 Work Queue Benchmark
+if [ -f "${BUILD_DIR}/tests/tst_workqueuebenchmark" ]; then
+    log_info "运行 Work Queue 基准测试..."
+    "${BUILD_DIR}/tests/tst_workqueuebenchmark" -maxwarnings 0 > "${RESULT_DIR}/workqueue_benchmark.log" 2>&1 || true
+    log_success "Work Queue 测试完成"
+fi
+
+# 运行 Delayed Queue Benchmark
+if [ -f "${BUILD_DIR}/tests/tst_delayedqueuebenchmark" ]; then
+    log_info "运行 Delayed Queue 基准测试..."
+    "${BUILD_DIR}/tests/tst_delayedqueuebenchmark" -maxwarnings 0 > "${RESULT_DIR}/delayedqueue_benchmark.log" 2>&1 || true
+    log_success "Delayed Queue 测试完成"
+fi
+
+# 运行按数据类型划分的基准套件, JSON 结果写入结果目录
+export BENCHMARK_RESULT_DIR="${RESULT_DIR}/json"
+for suite in hash list set sortedset expiration generic; do
+    if [ -f "${BUILD_DIR}/tests/tst_${suite}benchmark" ]; then
+        log_info "运行 ${suite} 基准测试..."
+        "${BUILD_DIR}/tests/tst_${suite}benchmark" -maxwarnings 0 > "${RESULT_DIR}/${suite}_benchmark.log" 2>&1 || true
+        log_success "${suite} 测试完成"
+    fi
+done
+
+# 运行 Core Benchmark
+if [ -f "${BUILD_DIR}/tests/tst_corebenchmark" ]; then
+    log_info "运行核心库 CPU 开销对比测试..."
+    "${BUILD_DIR}/tests/tst_corebenchmark" -maxwarnings 0 > "${RESULT_DIR}/core_benchmark.log" 2>&1 || true
+    log_success "核心库对比测试完成"
+fi
+
 log_success "性能基准测试完成！"
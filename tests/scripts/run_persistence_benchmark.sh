@@ -0,0 +1,37 @@
+#!/bin/bash
+#
+# 持久化性能测试脚本
+# 为每种配置启动独立的 redis-server, 比较 appendfsync 策略、BGSAVE 期间延迟与重启加载时间
+#
+# 环境变量:
+#   BENCHMARK_MAX_CARDINALITY  最大数据集规模(本脚本默认 10000000)
+#   REDIS_SERVER_BIN           redis-server 可执行文件(默认从 PATH 查找)
+#   REDIS_SERVER_DATA_DIR      临时数据目录的父目录(大数据集需要足够磁盘空间)
+#
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+source "${SCRIPT_DIR}/lib/common.sh"
+
+RESULT_DIR="${REPORT_DIR}"
+export BENCHMARK_RESULT_DIR="${RESULT_DIR}/json"
+export BENCHMARK_MAX_CARDINALITY="${BENCHMARK_MAX_CARDINALITY:-10000000}"
+
+if [ ! -f "${BUILD_DIR}/tests/tst_persistencebenchmark" ]; then
+    log_error "测试程序未找到，请先编译项目"
+    exit 1
+fi
+
+if ! command -v "${REDIS_SERVER_BIN:-redis-server}" > /dev/null 2>&1; then
+    log_error "未找到 redis-server"
+    exit 1
+fi
+
+log_info "运行持久化性能测试 (最大数据集 ${BENCHMARK_MAX_CARDINALITY} 键)..."
+if "${BUILD_DIR}/tests/tst_persistencebenchmark" -maxwarnings 0 > "${RESULT_DIR}/persistence_benchmark.log" 2>&1; then
+    log_success "持久化性能测试完成，对比报告: ${BENCHMARK_RESULT_DIR}/persistence_report.md"
+else
+    log_error "持久化性能测试失败，详见 ${RESULT_DIR}/persistence_benchmark.log"
+    exit 1
+fi
@@ -0,0 +1,159 @@
+/*
+ * redismodule_keyspace - 基于 SCAN 的键空间内存分析工具
+ *
+ * 按前缀模式与类型统计键数量、内存、编码与 TTL 分布, 并列出内存最大的键。
+ * 遍历速度受 --rate 限制, 可以对生产实例运行
+ *
+ * 示例:
+ *   redismodule_keyspace --group 'img:data:*' --group 'img:meta:*' --group 'img:tag:*' \
+ *                        --rate 2000 --sample-rate 0.1 --top 50 --json keyspace.json
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+
+#include <RedisModule/redismanager.h>
+#include <RedisModule/diagnostics/rediskeyspaceanalyzer.h>
+
+namespace {
+
+QtMessageHandler previousHandler = nullptr;
+
+// 每批 SCAN 与流水线都会输出 qDebug 日志, 只保留警告及以上级别
+void dropDebugMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type != QtDebugMsg && type != QtInfoMsg && previousHandler) {
+        previousHandler(type, context, message);
+    }
+}
+
+bool readInt(const QCommandLineParser &parser, const QString &name, qint64 *value)
+{
+    if (!parser.isSet(name)) {
+        return true;
+    }
+    bool ok = false;
+    *value = parser.value(name).toLongLong(&ok);
+    return ok;
+}
+
+bool writeJson(const RedisKeyspaceReport &report, const QString &path)
+{
+    const QByteArray json = QJsonDocument(report.toJson()).toJson(QJsonDocument::Indented);
+    if (path == "-") {
+        QTextStream(stdout) << json;
+        return true;
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(json) == json.size();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("redismodule_keyspace");
+    QTextStream err(stderr);
+
+    RedisKeyspaceAnalyzerOptions options;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Keyspace memory profiler grouped by key prefix and type");
+    parser.addHelpOption();
+    parser.addOptions({
+        {{"H", "host"}, "Redis host (default 127.0.0.1).", "host", "127.0.0.1"},
+        {{"p", "port"}, "Redis port (default 6379).", "port", "6379"},
+        {{"g", "group"}, "Group pattern, e.g. 'img:data:*' (repeatable, first match wins).", "pattern"},
+        {"depth", "Prefix segments used to group unmatched keys (default 2).", "n", "2"},
+        {"delimiter", "Prefix delimiter (default ':').", "char", ":"},
+        {"match", "SCAN MATCH pattern (default '*').", "pattern", "*"},
+        {"count", "SCAN COUNT hint (default 200).", "n", "200"},
+        {"rate", "Maximum keys scanned per second, 0 for unlimited (default 1000).", "n", "1000"},
+        {"sample-rate", "Fraction of scanned keys inspected with TYPE/MEMORY USAGE (default 1.0).", "ratio",
+         "1.0"},
+        {"samples", "MEMORY USAGE SAMPLES for aggregate types, 0 for exact (default 5).", "n", "5"},
+        {"top", "Number of largest keys to report (default 20).", "n", "20"},
+        {"max-keys", "Stop after scanning this many keys.", "n"},
+        {"json", "Write JSON report to file ('-' for stdout).", "path"},
+        {"quiet", "Do not print progress or the text report."},
+        {"verbose", "Keep per-command debug logging."},
+    });
+    parser.process(app);
+
+    qint64 port = 6379;
+    qint64 depth = options.autoGroupDepth;
+    qint64 count = options.scanCount;
+    qint64 rate = options.maxKeysPerSecond;
+    qint64 samples = options.memorySamples;
+    qint64 top = options.topKeys;
+    bool rateOk = true;
+    options.sampleRate = parser.value("sample-rate").toDouble(&rateOk);
+    if (!rateOk || !readInt(parser, "port", &port) || !readInt(parser, "depth", &depth)
+        || !readInt(parser, "count", &count) || !readInt(parser, "rate", &rate)
+        || !readInt(parser, "samples", &samples) || !readInt(parser, "top", &top)
+        || !readInt(parser, "max-keys", &options.maxKeys)) {
+        err << "Invalid numeric option\n";
+        return 2;
+    }
+    if (parser.value("delimiter").size() != 1) {
+        err << "Delimiter must be a single character\n";
+        return 2;
+    }
+    options.groupPatterns = parser.values("group");
+    options.delimiter = parser.value("delimiter").at(0);
+    options.autoGroupDepth = static_cast<int>(depth);
+    options.matchPattern = parser.value("match");
+    options.scanCount = static_cast<int>(count);
+    options.maxKeysPerSecond = static_cast<int>(rate);
+    options.memorySamples = static_cast<int>(samples);
+    options.topKeys = static_cast<int>(top);
+    const bool quiet = parser.isSet("quiet");
+
+    if (!parser.isSet("verbose")) {
+        previousHandler = qInstallMessageHandler(dropDebugMessages);
+    }
+
+    RedisManager manager;
+    RedisConnectionOptions connection;
+    connection.host = parser.value("host");
+    connection.port = static_cast<int>(port);
+    if (!manager.connectToServer(connection)) {
+        err << "Failed to connect to " << connection.host << ":" << connection.port << "\n";
+        return 1;
+    }
+
+    RedisKeyspaceAnalyzer analyzer(&manager, options);
+    QElapsedTimer progress;
+    progress.start();
+    while (analyzer.step()) {
+        if (!quiet && progress.elapsed() >= 5000) {
+            RedisKeyspaceReport partial = analyzer.report();
+            err << "Scanned " << partial.scannedKeys << " keys, sampled " << partial.sampledKeys << "...\n";
+            err.flush();
+            progress.restart();
+        }
+    }
+    if (analyzer.hasError()) {
+        err << "Scan stopped on error, report is partial\n";
+    }
+
+    RedisKeyspaceReport report = analyzer.report();
+    if (!quiet) {
+        // JSON 输出到标准输出时, 文本报告改写到标准错误
+        const bool jsonToStdout = parser.value("json") == "-";
+        QTextStream(jsonToStdout ? stderr : stdout) << report.toText();
+    }
+    if (parser.isSet("json") && !writeJson(report, parser.value("json"))) {
+        err << "Failed to write JSON report to " << parser.value("json") << "\n";
+        return 1;
+    }
+    return analyzer.hasError() ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+#include "distributions.h"
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+double uniformReal(std::mt19937_64 &rng)
+{
+    return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+}
+
+qint64 uniformInt(std::mt19937_64 &rng, qint64 low, qint64 high)
+{
+    return std::uniform_int_distribution<qint64>(low, high)(rng);
+}
+
+bool parseFraction(const QString &text, double *value)
+{
+    bool ok = false;
+    double parsed = text.toDouble(&ok);
+    if (!ok || parsed <= 0.0 || parsed >= 1.0) {
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+} // namespace
+
+std::unique_ptr<KeyDistribution> KeyDistribution::create(const QString &spec, qint64 keyspace, QString *error)
+{
+    QStringList parts = spec.trimmed().toLower().split(':');
+    const QString name = parts.value(0);
+    if (keyspace <= 0) {
+        *error = "keyspace must be positive";
+        return nullptr;
+    }
+
+    if (name == "uniform" && parts.size() == 1) {
+        return std::unique_ptr<KeyDistribution>(new UniformKeyDistribution(keyspace));
+    }
+    if (name == "zipfian" && parts.size() <= 2) {
+        double theta = 0.99;
+        if (parts.size() == 2 && !parseFraction(parts.at(1), &theta)) {
+            *error = "zipfian theta must be in (0, 1): " + parts.at(1);
+            return nullptr;
+        }
+        return std::unique_ptr<KeyDistribution>(new ZipfianKeyDistribution(keyspace, theta));
+    }
+    if (name == "hotspot" && (parts.size() == 1 || parts.size() == 3)) {
+        double hotKeys = 0.2;
+        double hotOps = 0.8;
+        if (parts.size() == 3 && (!parseFraction(parts.at(1), &hotKeys) || !parseFraction(parts.at(2), &hotOps))) {
+            *error = "hotspot fractions must be in (0, 1): " + spec;
+            return nullptr;
+        }
+        return std::unique_ptr<KeyDistribution>(new HotspotKeyDistribution(keyspace, hotKeys, hotOps));
+    }
+    *error = "unknown key distribution: " + spec;
+    return nullptr;
+}
+
+UniformKeyDistribution::UniformKeyDistribution(qint64 keyspace)
+    : keyspace_(keyspace)
+{
+}
+
+qint64 UniformKeyDistribution::next(std::mt19937_64 &rng) const
+{
+    return uniformInt(rng, 0, keyspace_ - 1);
+}
+
+QString UniformKeyDistribution::describe() const
+{
+    return "uniform";
+}
+
+// Gray 等人的 Zipf 生成算法(YCSB ZipfianGenerator), zeta(n) 在构造时计算一次
+ZipfianKeyDistribution::ZipfianKeyDistribution(qint64 keyspace, double theta)
+    : keyspace_(keyspace)
+    , theta_(theta)
+    , zetan_(0.0)
+{
+    for (qint64 i = 1; i <= keyspace_; ++i) {
+        zetan_ += 1.0 / std::pow(static_cast<double>(i), theta_);
+    }
+    double zeta2 = 1.0 + 1.0 / std::pow(2.0, theta_);
+    alpha_ = 1.0 / (1.0 - theta_);
+    eta_ = (1.0 - std::pow(2.0 / static_cast<double>(keyspace_), 1.0 - theta_)) / (1.0 - zeta2 / zetan_);
+    halfPowTheta_ = 1.0 + std::pow(0.5, theta_);
+}
+
+qint64 ZipfianKeyDistribution::next(std::mt19937_64 &rng) const
+{
+    double u = uniformReal(rng);
+    double uz = u * zetan_;
+    if (uz < 1.0) {
+        return 0;
+    }
+    if (uz < halfPowTheta_) {
+        return std::min<qint64>(1, keyspace_ - 1);
+    }
+    auto index = static_cast<qint64>(static_cast<double>(keyspace_) * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+    return std::min(index, keyspace_ - 1);
+}
+
+QString ZipfianKeyDistribution::describe() const
+{
+    return QString("zipfian(theta=%1)").arg(theta_);
+}
+
+HotspotKeyDistribution::HotspotKeyDistribution(qint64 keyspace, double hotKeyFraction, double hotOpFraction)
+    : keyspace_(keyspace)
+    , hotKeys_(std::max<qint64>(1, static_cast<qint64>(static_cast<double>(keyspace) * hotKeyFraction)))
+    , hotKeyFraction_(hotKeyFraction)
+    , hotOpFraction_(hotOpFraction)
+{
+    hotKeys_ = std::min(hotKeys_, keyspace_);
+}
+
+qint64 HotspotKeyDistribution::next(std::mt19937_64 &rng) const
+{
+    if (hotKeys_ >= keyspace_ || uniformReal(rng) < hotOpFraction_) {
+        return uniformInt(rng, 0, hotKeys_ - 1);
+    }
+    return uniformInt(rng, hotKeys_, keyspace_ - 1);
+}
+
+QString HotspotKeyDistribution::describe() const
+{
+    return QString("hotspot(%1% keys -> %2% ops)").arg(hotKeyFraction_ * 100).arg(hotOpFraction_ * 100);
+}
+
+ValueSizeDistribution::ValueSizeDistribution()
+    : kind_(Kind::Fixed)
+    , min_(64)
+    , max_(64)
+{
+}
+
+int ValueSizeDistribution::next(std::mt19937_64 &rng) const
+{
+    switch (kind_) {
+    case Kind::Fixed:
+        return min_;
+    case Kind::Uniform:
+        return static_cast<int>(uniformInt(rng, min_, max_));
+    case Kind::Weighted: {
+        double u = uniformReal(rng) * cumulative_.last();
+        auto it = std::upper_bound(cumulative_.constBegin(), cumulative_.constEnd(), u);
+        int index = std::min(static_cast<int>(it - cumulative_.constBegin()), sizes_.size() - 1);
+        return sizes_.at(index);
+    }
+    }
+    return min_;
+}
+
+int ValueSizeDistribution::maxSize() const
+{
+    return max_;
+}
+
+QString ValueSizeDistribution::describe() const
+{
+    switch (kind_) {
+    case Kind::Fixed:
+        return QString("fixed(%1B)").arg(min_);
+    case Kind::Uniform:
+        return QString("uniform(%1-%2B)").arg(min_).arg(max_);
+    case Kind::Weighted: {
+        QStringList items;
+        double previous = 0.0;
+        for (int i = 0; i < sizes_.size(); ++i) {
+            items.append(QString("%1B=%2").arg(sizes_.at(i)).arg(cumulative_.at(i) - previous));
+            previous = cumulative_.at(i);
+        }
+        return "weighted(" + items.join(',') + ")";
+    }
+    }
+    return QString();
+}
+
+bool ValueSizeDistribution::parse(const QString &spec, ValueSizeDistribution *result, QString *error)
+{
+    const QString text = spec.trimmed().toLower();
+    const int colon = text.indexOf(':');
+    const QString kind = colon < 0 ? QString("fixed") : text.left(colon);
+    const QString body = colon < 0 ? text : text.mid(colon + 1);
+
+    auto parseSize = [](const QString &value, int *size) {
+        bool ok = false;
+        int parsed = value.trimmed().toInt(&ok);
+        if (!ok || parsed < 0) {
+            return false;
+        }
+        *size = parsed;
+        return true;
+    };
+
+    ValueSizeDistribution distribution;
+    if (kind == "fixed") {
+        int size = 0;
+        if (!parseSize(body, &size)) {
+            *error = "invalid fixed value size: " + spec;
+            return false;
+        }
+        distribution.kind_ = Kind::Fixed;
+        distribution.min_ = distribution.max_ = size;
+    } else if (kind == "uniform") {
+        QStringList range = body.split('-');
+        int low = 0;
+        int high = 0;
+        if (range.size() != 2 || !parseSize(range.at(0), &low) || !parseSize(range.at(1), &high) || low > high) {
+            *error = "invalid uniform value size range: " + spec;
+            return false;
+        }
+        distribution.kind_ = Kind::Uniform;
+        distribution.min_ = low;
+        distribution.max_ = high;
+    } else if (kind == "weighted") {
+        distribution.kind_ = Kind::Weighted;
+        distribution.min_ = std::numeric_limits<int>::max();
+        distribution.max_ = 0;
+        double total = 0.0;
+        for (const QString &item : body.split(',', QString::SkipEmptyParts)) {
+            QStringList pair = item.split('=');
+            int size = 0;
+            bool ok = false;
+            double weight = pair.value(1).toDouble(&ok);
+            if (pair.size() != 2 || !parseSize(pair.at(0), &size) || !ok || weight <= 0.0) {
+                *error = "invalid weighted value size entry: " + item;
+                return false;
+            }
+            total += weight;
+            distribution.sizes_.append(size);
+            distribution.cumulative_.append(total);
+            distribution.min_ = std::min(distribution.min_, size);
+            distribution.max_ = std::max(distribution.max_, size);
+        }
+        if (distribution.sizes_.isEmpty()) {
+            *error = "weighted value size needs at least one SIZE=WEIGHT entry";
+            return false;
+        }
+    } else {
+        *error = "unknown value size distribution: " + spec;
+        return false;
+    }
+    *result = distribution;
+    return true;
+}
@@ -0,0 +1,109 @@
+#ifndef DISTRIBUTIONS_H
+#define DISTRIBUTIONS_H
+
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <random>
+
+/**
+ * @brief 键分布
+ *
+ * 在 [0, keyspace) 中选取键编号, 每个工作线程使用自己的随机数引擎
+ * - uniform: 均匀分布
+ * - zipfian[:theta]: Zipf 分布(YCSB 算法, theta 默认 0.99), 编号越小越热
+ * - hotspot[:hotKeys:hotOps]: 前 hotKeys 比例的键承担 hotOps 比例的访问(默认 0.2:0.8)
+ */
+class KeyDistribution
+{
+public:
+    virtual ~KeyDistribution() = default;
+
+    virtual qint64 next(std::mt19937_64 &rng) const = 0;
+    virtual QString describe() const = 0;
+
+    /**
+    * @brief 按规格字符串创建分布, 规格无效时返回空并写入 error
+    */
+    static std::unique_ptr<KeyDistribution> create(const QString &spec, qint64 keyspace, QString *error);
+};
+
+class UniformKeyDistribution : public KeyDistribution
+{
+public:
+    explicit UniformKeyDistribution(qint64 keyspace);
+
+    qint64 next(std::mt19937_64 &rng) const override;
+    QString describe() const override;
+
+private:
+    qint64 keyspace_;
+};
+
+class ZipfianKeyDistribution : public KeyDistribution
+{
+public:
+    ZipfianKeyDistribution(qint64 keyspace, double theta);
+
+    qint64 next(std::mt19937_64 &rng) const override;
+    QString describe() const override;
+
+private:
+    qint64 keyspace_;
+    double theta_;
+    double zetan_;
+    double alpha_;
+    double eta_;
+    double halfPowTheta_;
+};
+
+class HotspotKeyDistribution : public KeyDistribution
+{
+public:
+    HotspotKeyDistribution(qint64 keyspace, double hotKeyFraction, double hotOpFraction);
+
+    qint64 next(std::mt19937_64 &rng) const override;
+    QString describe() const override;
+
+private:
+    qint64 keyspace_;
+    qint64 hotKeys_;
+    double hotKeyFraction_;
+    double hotOpFraction_;
+};
+
+/**
+ * @brief 值大小分布(字节)
+ *
+ * - fixed:N 固定大小
+ * - uniform:MIN-MAX 均匀分布
+ * - weighted:SIZE=WEIGHT,... 按权重选取若干大小, 例如 weighted:64=70,1024=25,65536=5
+ * 只写数字时等同于 fixed
+ */
+class ValueSizeDistribution
+{
+public:
+    ValueSizeDistribution();
+
+    int next(std::mt19937_64 &rng) const;
+    int maxSize() const;
+    QString describe() const;
+
+    static bool parse(const QString &spec, ValueSizeDistribution *result, QString *error);
+
+private:
+    enum class Kind
+    {
+        Fixed,
+        Uniform,
+        Weighted
+    };
+
+    Kind kind_;
+    int min_;
+    int max_;
+    QVector<int> sizes_;
+    QVector<double> cumulative_;
+};
+
+#endif // DISTRIBUTIONS_H
@@ -0,0 +1,102 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram()
+    : count_(0)
+    , min_(std::numeric_limits<qint64>::max())
+    , max_(0)
+    , sum_(0.0)
+{
+    buckets_.fill(0);
+}
+
+// 小于 64 的值每个值一个桶; 更大的值按最高位右移, 保留 6 位有效数字(其中最高位恒为 1)
+int LatencyHistogram::bucketIndex(quint64 value)
+{
+    int msb = 63;
+    while (msb > 0 && !(value & (quint64(1) << msb))) {
+        --msb;
+    }
+    int shift = std::max(0, msb - 5);
+    return kSubBuckets * shift + static_cast<int>(value >> shift);
+}
+
+quint64 LatencyHistogram::bucketLower(int index)
+{
+    if (index < 2 * kSubBuckets) {
+        return static_cast<quint64>(index);
+    }
+    int shift = index / kSubBuckets - 1;
+    quint64 sub = static_cast<quint64>(index - kSubBuckets * shift);
+    return sub << shift;
+}
+
+quint64 LatencyHistogram::bucketUpper(int index)
+{
+    if (index < 2 * kSubBuckets) {
+        return static_cast<quint64>(index);
+    }
+    int shift = index / kSubBuckets - 1;
+    return bucketLower(index) + (quint64(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(qint64 nanos)
+{
+    quint64 value = nanos > 0 ? static_cast<quint64>(nanos) : 0;
+    ++buckets_[static_cast<std::size_t>(bucketIndex(value))];
+    ++count_;
+    min_ = std::min(min_, static_cast<qint64>(value));
+    max_ = std::max(max_, static_cast<qint64>(value));
+    sum_ += static_cast<double>(value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+
+qint64 LatencyHistogram::count() const
+{
+    return count_;
+}
+
+qint64 LatencyHistogram::min() const
+{
+    return count_ > 0 ? min_ : 0;
+}
+
+qint64 LatencyHistogram::max() const
+{
+    return max_;
+}
+
+double LatencyHistogram::mean() const
+{
+    return count_ > 0 ? sum_ / static_cast<double>(count_) : 0.0;
+}
+
+qint64 LatencyHistogram::percentile(double quantile) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    quantile = std::min(1.0, std::max(0.0, quantile));
+    qint64 target = std::max<qint64>(1, static_cast<qint64>(std::ceil(quantile * static_cast<double>(count_))));
+    qint64 seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[static_cast<std::size_t>(i)];
+        if (seen >= target) {
+            quint64 mid = bucketLower(i) + (bucketUpper(i) - bucketLower(i)) / 2;
+            return std::min(max_, std::max(min(), static_cast<qint64>(mid)));
+        }
+    }
+    return max_;
+}
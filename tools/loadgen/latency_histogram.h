@@ -0,0 +1,47 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief 对数线性延迟直方图(纳秒)
+ *
+ * 每个 2 的幂区间再等分为 32 个桶, 相对误差约 3%, 内存固定(16KB)且记录为 O(1),
+ * 适合长时间压测中每个工作线程独立记录、结束后合并
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(qint64 nanos);
+    void merge(const LatencyHistogram &other);
+
+    /**
+    * @brief 统计
+    *
+    * 样本数,最小值,最大值,平均值,分位数(quantile 取 0~1, 返回所在桶的中点)
+    */
+    qint64 count() const;
+    qint64 min() const;
+    qint64 max() const;
+    double mean() const;
+    qint64 percentile(double quantile) const;
+
+private:
+    static constexpr int kSubBuckets = 32;
+    static constexpr int kBucketCount = kSubBuckets * 64;
+
+    static int bucketIndex(quint64 value);
+    static quint64 bucketLower(int index);
+    static quint64 bucketUpper(int index);
+
+    std::array<qint64, kBucketCount> buckets_;
+    qint64 count_;
+    qint64 min_;
+    qint64 max_;
+    double sum_;
+};
+
+#endif // LATENCY_HISTOGRAM_H
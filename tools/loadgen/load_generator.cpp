@@ -0,0 +1,419 @@
+#include "load_generator.h"
+#include <RedisModule/redismanager.h>
+#include <QMap>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 预置与清理时每批处理的键数量
+constexpr qint64 kBatchKeys = 1000;
+constexpr int kPollIntervalMs = 100;
+
+struct CommandInfo
+{
+    LoadCommand command;
+    const char *name;
+};
+
+const CommandInfo kCommands[] = {
+    {LoadCommand::Get, "GET"},
+    {LoadCommand::Set, "SET"},
+    {LoadCommand::HGet, "HGET"},
+    {LoadCommand::HSet, "HSET"},
+    {LoadCommand::LPush, "LPUSH"},
+    {LoadCommand::RPop, "RPOP"},
+    {LoadCommand::SAdd, "SADD"},
+    {LoadCommand::SIsMember, "SISMEMBER"},
+    {LoadCommand::ZAdd, "ZADD"},
+    {LoadCommand::ZScore, "ZSCORE"},
+    {LoadCommand::Del, "DEL"},
+    {LoadCommand::Exists, "EXISTS"},
+};
+
+bool usesAny(const QVector<LoadCommandWeight> &mix, std::initializer_list<LoadCommand> commands)
+{
+    for (const auto &entry : mix) {
+        if (std::find(commands.begin(), commands.end(), entry.command) != commands.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+QString loadCommandName(LoadCommand command)
+{
+    return QString::fromLatin1(kCommands[static_cast<int>(command)].name);
+}
+
+bool parseCommandMix(const QString &spec, QVector<LoadCommandWeight> *mix, QString *error)
+{
+    mix->clear();
+    for (const QString &item : spec.split(',', QString::SkipEmptyParts)) {
+        QStringList pair = item.trimmed().split('=');
+        const QString name = pair.value(0).trimmed().toUpper();
+        bool ok = pair.size() == 2;
+        double weight = ok ? pair.at(1).toDouble(&ok) : 0.0;
+        if (!ok || weight <= 0.0) {
+            *error = "invalid command mix entry (expected name=weight): " + item;
+            return false;
+        }
+        auto it = std::find_if(std::begin(kCommands), std::end(kCommands),
+                               [&name](const CommandInfo &info) { return name == QLatin1String(info.name); });
+        if (it == std::end(kCommands)) {
+            *error = "unsupported command in mix: " + name;
+            return false;
+        }
+        mix->append({it->command, weight});
+    }
+    if (mix->isEmpty()) {
+        *error = "command mix is empty";
+        return false;
+    }
+    return true;
+}
+
+void LoadCommandStats::merge(const LoadCommandStats &other)
+{
+    ops += other.ops;
+    errors += other.errors;
+    latency.merge(other.latency);
+}
+
+struct LoadGenerator::Worker
+{
+    std::vector<LoadCommandStats> stats = std::vector<LoadCommandStats>(kLoadCommandCount);
+};
+
+LoadGenerator::LoadGenerator(RedisManager *manager, const LoadGenConfig &config)
+    : manager_(manager)
+    , config_(config)
+    , stop_(false)
+    , activeWorkers_(0)
+    , issued_(0)
+    , completed_(0)
+{
+    keyPrefix_ = config_.keyPrefix.toUtf8();
+    hashKey_ = keyPrefix_ + ":hash";
+    listKey_ = keyPrefix_ + ":list";
+    setKey_ = keyPrefix_ + ":set";
+    zsetKey_ = keyPrefix_ + ":zset";
+}
+
+LoadGenerator::~LoadGenerator()
+{
+    stop_ = true;
+}
+
+bool LoadGenerator::prepare(QString *error)
+{
+    if (config_.threads <= 0 || config_.pipeline <= 0 || config_.durationSec <= 0 || config_.requests < 0) {
+        *error = "threads, pipeline and duration must be positive";
+        return false;
+    }
+    keys_ = KeyDistribution::create(config_.keyDistribution, config_.keyspace, error);
+    if (!keys_) {
+        return false;
+    }
+    if (!ValueSizeDistribution::parse(config_.valueSize, &values_, error)
+        || !parseCommandMix(config_.mix, &mix_, error)) {
+        return false;
+    }
+
+    cumulative_.clear();
+    double total = 0.0;
+    for (const auto &entry : mix_) {
+        total += entry.weight;
+        cumulative_.append(total);
+    }
+    // 所有值共享同一块可打印字符缓冲区, 按大小截取, 避免压测中分配与填充
+    payload_ = QByteArray(std::max(1, values_.maxSize()), 'v');
+    return true;
+}
+
+QByteArray LoadGenerator::stringKey(qint64 index) const
+{
+    return keyPrefix_ + ":key:" + QByteArray::number(index);
+}
+
+QByteArray LoadGenerator::member(qint64 index) const
+{
+    return "m:" + QByteArray::number(index);
+}
+
+LoadCommand LoadGenerator::pickCommand(std::mt19937_64 &rng) const
+{
+    if (mix_.size() == 1) {
+        return mix_.first().command;
+    }
+    double u = std::uniform_real_distribution<double>(0.0, cumulative_.last())(rng);
+    auto it = std::upper_bound(cumulative_.constBegin(), cumulative_.constEnd(), u);
+    int index = std::min(static_cast<int>(it - cumulative_.constBegin()), mix_.size() - 1);
+    return mix_.at(index).command;
+}
+
+bool LoadGenerator::executeSingle(LoadCommand command, qint64 index, const QByteArray &value)
+{
+    const QString key = QString::fromLatin1(stringKey(index));
+    const QString field = QString::fromLatin1(member(index));
+    switch (command) {
+    case LoadCommand::Get:
+        manager_->bytesGet(key);
+        break;
+    case LoadCommand::Set:
+        manager_->bytesSet(key, value);
+        break;
+    case LoadCommand::HGet:
+        manager_->hGet(QString::fromLatin1(hashKey_), field);
+        break;
+    case LoadCommand::HSet:
+        manager_->hSet(QString::fromLatin1(hashKey_), field, QString::fromLatin1(value));
+        break;
+    case LoadCommand::LPush:
+        manager_->lPush(QString::fromLatin1(listKey_), QString::fromLatin1(value));
+        break;
+    case LoadCommand::RPop:
+        manager_->rPop(QString::fromLatin1(listKey_));
+        break;
+    case LoadCommand::SAdd:
+        manager_->sAdd(QString::fromLatin1(setKey_), field);
+        break;
+    case LoadCommand::SIsMember:
+        manager_->sIsMember(QString::fromLatin1(setKey_), field);
+        break;
+    case LoadCommand::ZAdd:
+        manager_->zAdd(QString::fromLatin1(zsetKey_), static_cast<double>(index), field);
+        break;
+    case LoadCommand::ZScore:
+        manager_->zScore(QString::fromLatin1(zsetKey_), field);
+        break;
+    case LoadCommand::Del:
+        manager_->del(key);
+        break;
+    case LoadCommand::Exists:
+        manager_->exists(key);
+        break;
+    }
+    return manager_->lastCallStatus() == RedisCallStatus::Ok;
+}
+
+QVector<QByteArray> LoadGenerator::commandArgs(LoadCommand command, qint64 index, const QByteArray &value) const
+{
+    switch (command) {
+    case LoadCommand::Get:
+        return {"GET", stringKey(index)};
+    case LoadCommand::Set:
+        return {"SET", stringKey(index), value};
+    case LoadCommand::HGet:
+        return {"HGET", hashKey_, member(index)};
+    case LoadCommand::HSet:
+        return {"HSET", hashKey_, member(index), value};
+    case LoadCommand::LPush:
+        return {"LPUSH", listKey_, value};
+    case LoadCommand::RPop:
+        return {"RPOP", listKey_};
+    case LoadCommand::SAdd:
+        return {"SADD", setKey_, member(index)};
+    case LoadCommand::SIsMember:
+        return {"SISMEMBER", setKey_, member(index)};
+    case LoadCommand::ZAdd:
+        return {"ZADD", zsetKey_, QByteArray::number(index), member(index)};
+    case LoadCommand::ZScore:
+        return {"ZSCORE", zsetKey_, member(index)};
+    case LoadCommand::Del:
+        return {"DEL", stringKey(index)};
+    case LoadCommand::Exists:
+        return {"EXISTS", stringKey(index)};
+    }
+    return {};
+}
+
+qint64 LoadGenerator::reserve(qint64 count)
+{
+    if (config_.requests <= 0) {
+        return count;
+    }
+    // 最后一批只领取剩余的请求数, 总请求数恰好为 requests
+    const qint64 issued = issued_.fetch_add(count, std::memory_order_relaxed);
+    if (issued >= config_.requests) {
+        return 0;
+    }
+    return std::min(count, config_.requests - issued);
+}
+
+bool LoadGenerator::preload()
+{
+    const bool strings = usesAny(mix_, {LoadCommand::Get, LoadCommand::Set, LoadCommand::Del, LoadCommand::Exists});
+    const bool hashes = usesAny(mix_, {LoadCommand::HGet, LoadCommand::HSet});
+    const bool sets = usesAny(mix_, {LoadCommand::SAdd, LoadCommand::SIsMember});
+    const bool zsets = usesAny(mix_, {LoadCommand::ZAdd, LoadCommand::ZScore});
+
+    std::mt19937_64 rng(config_.seed);
+    for (qint64 offset = 0; offset < config_.keyspace; offset += kBatchKeys) {
+        const qint64 end = std::min(config_.keyspace, offset + kBatchKeys);
+        QMap<QString, QString> values;
+        QVector<QVector<QByteArray>> commands;
+        for (qint64 i = offset; i < end; ++i) {
+            QByteArray value = QByteArray::fromRawData(payload_.constData(), values_.next(rng));
+            if (strings) {
+                values.insert(QString::fromLatin1(stringKey(i)), QString::fromLatin1(value));
+            }
+            if (hashes) {
+                commands.append(commandArgs(LoadCommand::HSet, i, value));
+            }
+            if (sets) {
+                commands.append(commandArgs(LoadCommand::SAdd, i, value));
+            }
+            if (zsets) {
+                commands.append(commandArgs(LoadCommand::ZAdd, i, value));
+            }
+        }
+        if (!values.isEmpty() && !manager_->mSet(values)) {
+            return false;
+        }
+        if (!commands.isEmpty() && manager_->pipeline(commands).size() != commands.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LoadGenerator::cleanup()
+{
+    for (qint64 offset = 0; offset < config_.keyspace; offset += kBatchKeys) {
+        const qint64 end = std::min(config_.keyspace, offset + kBatchKeys);
+        QVector<QVector<QByteArray>> commands;
+        commands.reserve(static_cast<int>(end - offset));
+        for (qint64 i = offset; i < end; ++i) {
+            commands.append({"DEL", stringKey(i)});
+        }
+        manager_->pipeline(commands);
+    }
+    manager_->pipeline({{"DEL", hashKey_}, {"DEL", listKey_}, {"DEL", setKey_}, {"DEL", zsetKey_}});
+}
+
+LoadReport LoadGenerator::run()
+{
+    stop_ = false;
+    issued_ = 0;
+    completed_ = 0;
+    activeWorkers_ = config_.threads;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    workers.reserve(static_cast<std::size_t>(config_.threads));
+    threads.reserve(static_cast<std::size_t>(config_.threads));
+
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point deadline = start + std::chrono::seconds(config_.durationSec);
+    for (int i = 0; i < config_.threads; ++i) {
+        workers.emplace_back(new Worker());
+        threads.emplace_back(&LoadGenerator::runWorker, this, i, workers.back().get());
+    }
+
+    QTextStream progress(stderr);
+    Clock::time_point lastTick = start;
+    qint64 lastCompleted = 0;
+    while (activeWorkers_ > 0 && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+        const Clock::time_point now = Clock::now();
+        if (config_.progress && now - lastTick >= std::chrono::seconds(1)) {
+            const qint64 done = completed_.load(std::memory_order_relaxed);
+            const double seconds = std::chrono::duration<double>(now - lastTick).count();
+            progress << QString("\r  %1s  %2 ops/sec   ")
+                            .arg(std::chrono::duration_cast<std::chrono::seconds>(now - start).count())
+                            .arg(qRound64((done - lastCompleted) / seconds));
+            progress.flush();
+            lastTick = now;
+            lastCompleted = done;
+        }
+    }
+    stop_ = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    if (config_.progress) {
+        progress << "\n";
+    }
+
+    LoadReport report;
+    report.config = config_;
+    report.keyDistribution = keys_->describe();
+    report.valueSizes = values_.describe();
+    report.elapsedSec = elapsed;
+    for (int c = 0; c < kLoadCommandCount; ++c) {
+        LoadCommandStats merged;
+        for (const auto &worker : workers) {
+            merged.merge(worker->stats[static_cast<std::size_t>(c)]);
+        }
+        if (merged.ops > 0) {
+            report.total.merge(merged);
+            report.commands.append(qMakePair(static_cast<LoadCommand>(c), merged));
+        }
+    }
+    return report;
+}
+
+void LoadGenerator::runWorker(int index, Worker *worker)
+{
+    std::mt19937_64 rng(config_.seed + static_cast<quint64>(index + 1) * 0x9E3779B97F4A7C15ULL);
+    const int depth = config_.pipeline;
+    QVector<QVector<QByteArray>> batch;
+    QVector<LoadCommand> batchCommands;
+    batch.reserve(depth);
+    batchCommands.reserve(depth);
+
+    while (!stop_) {
+        const int count = static_cast<int>(reserve(depth));
+        if (count == 0) {
+            break;
+        }
+        if (depth == 1) {
+            const LoadCommand command = pickCommand(rng);
+            const qint64 key = keys_->next(rng);
+            const QByteArray value = QByteArray::fromRawData(payload_.constData(), values_.next(rng));
+
+            const Clock::time_point begin = Clock::now();
+            const bool ok = executeSingle(command, key, value);
+            const qint64 nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+
+            LoadCommandStats &stats = worker->stats[static_cast<std::size_t>(command)];
+            ++stats.ops;
+            stats.errors += ok ? 0 : 1;
+            stats.latency.record(nanos);
+        } else {
+            batch.clear();
+            batchCommands.clear();
+            for (int i = 0; i < count; ++i) {
+                const LoadCommand command = pickCommand(rng);
+                const QByteArray value = QByteArray::fromRawData(payload_.constData(), values_.next(rng));
+                batchCommands.append(command);
+                batch.append(commandArgs(command, keys_->next(rng), value));
+            }
+
+            const Clock::time_point begin = Clock::now();
+            const QVector<RedisPipelineReply> replies = manager_->pipeline(batch);
+            const qint64 nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+
+            // 整批失败(连接错误/熔断)时返回空, 批内每条命令都记为错误
+            const bool failed = replies.size() != batch.size();
+            for (int i = 0; i < count; ++i) {
+                LoadCommandStats &stats = worker->stats[static_cast<std::size_t>(batchCommands.at(i))];
+                ++stats.ops;
+                stats.errors += (failed || replies.at(i).isError()) ? 1 : 0;
+                stats.latency.record(nanos);
+            }
+        }
+        completed_.fetch_add(count, std::memory_order_relaxed);
+    }
+    --activeWorkers_;
+}
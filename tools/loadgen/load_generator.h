@@ -0,0 +1,169 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <random>
+
+#include "distributions.h"
+#include "latency_histogram.h"
+
+class RedisManager;
+
+/**
+ * @brief 压测命令
+ *
+ * 字符串命令作用于 <prefix>:key:<n>, 集合类命令作用于每种类型一个键
+ * (<prefix>:hash / :list / :set / :zset), 键编号作为字段或成员, 与 redis-benchmark 一致
+ */
+enum class LoadCommand
+{
+    Get,
+    Set,
+    HGet,
+    HSet,
+    LPush,
+    RPop,
+    SAdd,
+    SIsMember,
+    ZAdd,
+    ZScore,
+    Del,
+    Exists
+};
+
+constexpr int kLoadCommandCount = static_cast<int>(LoadCommand::Exists) + 1;
+
+QString loadCommandName(LoadCommand command);
+
+struct LoadCommandWeight
+{
+    LoadCommand command;
+    double weight;
+};
+
+/**
+ * @brief 解析命令配比, 例如 get=80,set=20; 权重为相对值, 不要求合计 100
+ */
+bool parseCommandMix(const QString &spec, QVector<LoadCommandWeight> *mix, QString *error);
+
+/**
+ * @brief 压测配置
+ *
+ * durationSec 与 requests 任一先到即结束(requests 为 0 时只按时长)
+ * pipeline 大于 1 时每个工作线程一次发送 pipeline 条命令, 每条命令的延迟记为整批往返时间
+ */
+struct LoadGenConfig
+{
+    QString host = "127.0.0.1";
+    int port = 6379;
+    int threads = 4;
+    int connections = 0;
+    int durationSec = 10;
+    qint64 requests = 0;
+    int pipeline = 1;
+    qint64 keyspace = 100000;
+    QString keyPrefix = "loadgen";
+    QString keyDistribution = "uniform";
+    QString valueSize = "fixed:64";
+    QString mix = "get=80,set=20";
+    quint64 seed = 1;
+    bool preload = false;
+    bool cleanup = false;
+    bool progress = true;
+};
+
+/**
+ * @brief 单个命令(或全部命令)的统计
+ */
+struct LoadCommandStats
+{
+    qint64 ops = 0;
+    qint64 errors = 0;
+    LatencyHistogram latency;
+
+    void merge(const LoadCommandStats &other);
+};
+
+/**
+ * @brief 压测结果, 延迟单位为纳秒
+ */
+struct LoadReport
+{
+    LoadGenConfig config;
+    QString keyDistribution;
+    QString valueSizes;
+    double elapsedSec = 0.0;
+    QVector<QPair<LoadCommand, LoadCommandStats>> commands;
+    LoadCommandStats total;
+};
+
+/**
+ * @brief 基于 RedisManager 的多线程负载生成器
+ *
+ * 所有工作线程共享同一个 RedisManager(连接池大小应不小于线程数), 因此测得的是
+ * 连接池、熔断、重试与日志在内的完整调用路径; 单命令模式通过 lastCallStatus() 统计错误,
+ * 流水线模式统计整批失败与逐条服务器错误
+ */
+class LoadGenerator
+{
+public:
+    LoadGenerator(RedisManager *manager, const LoadGenConfig &config);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator &) = delete;
+    LoadGenerator& operator=(const LoadGenerator &) = delete;
+
+    /**
+    * @brief 解析分布与命令配比, 配置无效时返回 false 并写入 error
+    */
+    bool prepare(QString *error);
+
+    /**
+    * @brief 压测前后
+    *
+    * 写入全部键(字符串用 MSET, 集合类用流水线), 删除压测产生的全部键
+    */
+    bool preload();
+    void cleanup();
+
+    LoadReport run();
+
+private:
+    struct Worker;
+
+    void runWorker(int index, Worker *worker);
+    LoadCommand pickCommand(std::mt19937_64 &rng) const;
+    bool executeSingle(LoadCommand command, qint64 index, const QByteArray &value);
+    QVector<QByteArray> commandArgs(LoadCommand command, qint64 index, const QByteArray &value) const;
+    // 领取最多 count 个请求, 返回实际领取数, 总请求数用完后返回 0
+    qint64 reserve(qint64 count);
+
+    QByteArray stringKey(qint64 index) const;
+    QByteArray member(qint64 index) const;
+
+    RedisManager *manager_;
+    LoadGenConfig config_;
+    std::unique_ptr<KeyDistribution> keys_;
+    ValueSizeDistribution values_;
+    QVector<LoadCommandWeight> mix_;
+    QVector<double> cumulative_;
+    QByteArray payload_;
+
+    QByteArray keyPrefix_;
+
+    QByteArray hashKey_;
+    QByteArray listKey_;
+    QByteArray setKey_;
+    QByteArray zsetKey_;
+
+    std::atomic<bool> stop_;
+    std::atomic<int> activeWorkers_;
+    std::atomic<qint64> issued_;
+    std::atomic<qint64> completed_;
+};
+
+#endif // LOAD_GENERATOR_H
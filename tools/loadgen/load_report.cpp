@@ -0,0 +1,137 @@
+#include "load_report.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStringList>
+#include <QSysInfo>
+#include <QTextStream>
+
+namespace {
+
+double toUs(qint64 nanos)
+{
+    return nanos / 1000.0;
+}
+
+double opsPerSec(const LoadCommandStats &stats, double elapsedSec)
+{
+    return elapsedSec > 0.0 ? stats.ops / elapsedSec : 0.0;
+}
+
+double errorRate(const LoadCommandStats &stats)
+{
+    return stats.ops > 0 ? static_cast<double>(stats.errors) / stats.ops : 0.0;
+}
+
+QJsonObject statsJson(const QString &name, const LoadCommandStats &stats, double elapsedSec)
+{
+    QJsonObject latency;
+    latency["min"] = toUs(stats.latency.min());
+    latency["mean"] = stats.latency.mean() / 1000.0;
+    latency["p50"] = toUs(stats.latency.percentile(0.50));
+    latency["p99"] = toUs(stats.latency.percentile(0.99));
+    latency["p999"] = toUs(stats.latency.percentile(0.999));
+    latency["max"] = toUs(stats.latency.max());
+
+    QJsonObject object;
+    object["command"] = name;
+    object["ops"] = stats.ops;
+    object["errors"] = stats.errors;
+    object["errorRate"] = errorRate(stats);
+    object["opsPerSec"] = opsPerSec(stats, elapsedSec);
+    object["latencyUs"] = latency;
+    return object;
+}
+
+QString statsLine(const QString &name, const LoadCommandStats &stats, double elapsedSec)
+{
+    return QString("%1 %2 %3 %4 %5 %6 %7 %8 %9")
+        .arg(name, -10)
+        .arg(stats.ops, 12)
+        .arg(stats.errors, 9)
+        .arg(errorRate(stats) * 100.0, 7, 'f', 3)
+        .arg(opsPerSec(stats, elapsedSec), 12, 'f', 0)
+        .arg(toUs(stats.latency.percentile(0.50)), 10, 'f', 1)
+        .arg(toUs(stats.latency.percentile(0.99)), 10, 'f', 1)
+        .arg(toUs(stats.latency.percentile(0.999)), 10, 'f', 1)
+        .arg(toUs(stats.latency.max()), 10, 'f', 1);
+}
+
+} // namespace
+
+namespace LoadReportFormat {
+
+QString toText(const LoadReport &report)
+{
+    const LoadGenConfig &config = report.config;
+    QStringList lines;
+    lines << "====== redismodule_loadgen ======";
+    lines << QString("  server %1:%2  threads %3  connections %4  pipeline %5  elapsed %6s")
+                 .arg(config.host).arg(config.port).arg(config.threads)
+                 .arg(config.connections > 0 ? config.connections : config.threads)
+                 .arg(config.pipeline).arg(report.elapsedSec, 0, 'f', 2);
+    lines << QString("  keys %1 %2  values %3  mix %4")
+                 .arg(config.keyspace).arg(report.keyDistribution, report.valueSizes, config.mix);
+    if (config.pipeline > 1) {
+        lines << "  latency of pipelined commands is the round trip of the whole batch";
+    }
+    lines << "";
+    lines << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9")
+                 .arg("command", -10).arg("ops", 12).arg("errors", 9).arg("err%", 7).arg("ops/sec", 12)
+                 .arg("p50(us)", 10).arg("p99(us)", 10).arg("p999(us)", 10).arg("max(us)", 10);
+    for (const auto &entry : report.commands) {
+        lines << statsLine(loadCommandName(entry.first), entry.second, report.elapsedSec);
+    }
+    lines << statsLine("TOTAL", report.total, report.elapsedSec);
+    return lines.join('\n') + '\n';
+}
+
+QJsonObject toJson(const LoadReport &report)
+{
+    const LoadGenConfig &config = report.config;
+    QJsonObject configJson;
+    configJson["host"] = config.host;
+    configJson["port"] = config.port;
+    configJson["threads"] = config.threads;
+    configJson["connections"] = config.connections > 0 ? config.connections : config.threads;
+    configJson["durationSec"] = config.durationSec;
+    configJson["requests"] = config.requests;
+    configJson["pipeline"] = config.pipeline;
+    configJson["keyspace"] = config.keyspace;
+    configJson["keyDistribution"] = report.keyDistribution;
+    configJson["valueSize"] = report.valueSizes;
+    configJson["mix"] = config.mix;
+    configJson["seed"] = QString::number(config.seed);
+
+    QJsonArray commands;
+    for (const auto &entry : report.commands) {
+        commands.append(statsJson(loadCommandName(entry.first), entry.second, report.elapsedSec));
+    }
+
+    QJsonObject object;
+    object["tool"] = "redismodule_loadgen";
+    object["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    object["host"] = QSysInfo::machineHostName();
+    object["config"] = configJson;
+    object["elapsedSec"] = report.elapsedSec;
+    object["total"] = statsJson("TOTAL", report.total, report.elapsedSec);
+    object["commands"] = commands;
+    return object;
+}
+
+bool writeJson(const LoadReport &report, const QString &path)
+{
+    const QByteArray json = QJsonDocument(toJson(report)).toJson(QJsonDocument::Indented);
+    if (path == "-") {
+        QTextStream(stdout) << json;
+        return true;
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(json) == json.size();
+}
+
+} // namespace LoadReportFormat
@@ -0,0 +1,22 @@
+#ifndef LOAD_REPORT_H
+#define LOAD_REPORT_H
+
+#include <QJsonObject>
+#include <QString>
+
+#include "load_generator.h"
+
+/**
+ * @brief 压测结果输出
+ *
+ * 文本表格(每个命令一行及合计),JSON 对象(延迟单位为微秒),写入 JSON 文件("-" 表示标准输出)
+ */
+namespace LoadReportFormat {
+
+QString toText(const LoadReport &report);
+QJsonObject toJson(const LoadReport &report);
+bool writeJson(const LoadReport &report, const QString &path);
+
+} // namespace LoadReportFormat
+
+#endif // LOAD_REPORT_H
@@ -0,0 +1,152 @@
+/*
+ * redismodule_loadgen - 基于 RedisManager 的 redis-benchmark 风格负载生成器
+ *
+ * 示例:
+ *   redismodule_loadgen --threads 8 --duration 30 --mix get=90,set=10 \
+ *                       --keys 1000000 --distribution zipfian:0.99 --value-size weighted:64=80,4096=20 \
+ *                       --preload --json result.json
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+#include <algorithm>
+
+#include <RedisModule/redismanager.h>
+#include "load_generator.h"
+#include "load_report.h"
+
+namespace {
+
+QtMessageHandler previousHandler = nullptr;
+
+// 每次调用都会输出 qDebug 日志, 压测期间只保留警告及以上级别
+void dropDebugMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type != QtDebugMsg && type != QtInfoMsg && previousHandler) {
+        previousHandler(type, context, message);
+    }
+}
+
+bool readInt(const QCommandLineParser &parser, const QString &name, qint64 *value)
+{
+    if (!parser.isSet(name)) {
+        return true;
+    }
+    bool ok = false;
+    *value = parser.value(name).toLongLong(&ok);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("redismodule_loadgen");
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Load generator for RedisModule (redis-benchmark style)");
+    parser.addHelpOption();
+    parser.addOptions({
+        {{"H", "host"}, "Redis host (default 127.0.0.1).", "host", "127.0.0.1"},
+        {{"p", "port"}, "Redis port (default 6379).", "port", "6379"},
+        {{"t", "threads"}, "Worker threads (default 4).", "n", "4"},
+        {{"c", "connections"}, "Connection pool size (default: threads).", "n"},
+        {{"d", "duration"}, "Run time in seconds (default 10).", "sec", "10"},
+        {{"n", "requests"}, "Stop after this many requests (the duration limit still applies).", "n"},
+        {{"P", "pipeline"}, "Commands per pipeline (default 1).", "n", "1"},
+        {{"k", "keys"}, "Keyspace size (default 100000).", "n", "100000"},
+        {"prefix", "Key prefix (default loadgen).", "prefix", "loadgen"},
+        {"distribution", "Key distribution: uniform | zipfian[:theta] | hotspot[:hotKeys:hotOps].", "spec",
+         "uniform"},
+        {"value-size", "Value size: N | fixed:N | uniform:MIN-MAX | weighted:SIZE=W,...", "spec", "fixed:64"},
+        {"mix", "Command mix, e.g. get=80,set=20 (GET SET HGET HSET LPUSH RPOP SADD SISMEMBER ZADD ZSCORE "
+                "DEL EXISTS).", "spec", "get=80,set=20"},
+        {"seed", "Random seed (default 1).", "n", "1"},
+        {"preload", "Write every key before the run."},
+        {"cleanup", "Delete generated keys after the run."},
+        {"json", "Write JSON results to file ('-' for stdout).", "path"},
+        {"quiet", "Do not print progress or the text report."},
+        {"verbose", "Keep per-command debug logging (slows down the run)."},
+    });
+    parser.process(app);
+
+    LoadGenConfig config;
+    qint64 port = config.port;
+    qint64 threads = config.threads;
+    qint64 connections = 0;
+    qint64 duration = config.durationSec;
+    qint64 pipeline = config.pipeline;
+    qint64 seed = static_cast<qint64>(config.seed);
+    if (!readInt(parser, "port", &port) || !readInt(parser, "threads", &threads)
+        || !readInt(parser, "connections", &connections) || !readInt(parser, "duration", &duration)
+        || !readInt(parser, "requests", &config.requests) || !readInt(parser, "pipeline", &pipeline)
+        || !readInt(parser, "keys", &config.keyspace) || !readInt(parser, "seed", &seed)) {
+        err << "Invalid numeric option\n";
+        return 2;
+    }
+    config.host = parser.value("host");
+    config.port = static_cast<int>(port);
+    config.threads = static_cast<int>(threads);
+    config.connections = static_cast<int>(connections);
+    config.durationSec = static_cast<int>(duration);
+    config.pipeline = static_cast<int>(pipeline);
+    config.seed = static_cast<quint64>(seed);
+    config.keyPrefix = parser.value("prefix");
+    config.keyDistribution = parser.value("distribution");
+    config.valueSize = parser.value("value-size");
+    config.mix = parser.value("mix");
+    config.preload = parser.isSet("preload");
+    config.cleanup = parser.isSet("cleanup");
+    config.progress = !parser.isSet("quiet");
+
+    if (!parser.isSet("verbose")) {
+        previousHandler = qInstallMessageHandler(dropDebugMessages);
+    }
+
+    RedisManager manager;
+    LoadGenerator generator(&manager, config);
+    QString error;
+    if (!generator.prepare(&error)) {
+        err << "Invalid configuration: " << error << "\n";
+        return 2;
+    }
+
+    RedisConnectionOptions options;
+    options.host = config.host;
+    options.port = config.port;
+    options.poolSize = std::max(1, config.connections > 0 ? config.connections : config.threads);
+    if (!manager.connectToServer(options)) {
+        err << "Failed to connect to " << config.host << ":" << config.port << "\n";
+        return 1;
+    }
+
+    if (config.preload) {
+        if (config.progress) {
+            err << "Preloading " << config.keyspace << " keys...\n";
+            err.flush();
+        }
+        if (!generator.preload()) {
+            err << "Preload failed\n";
+            return 1;
+        }
+    }
+
+    LoadReport report = generator.run();
+
+    if (config.cleanup) {
+        generator.cleanup();
+    }
+    if (!parser.isSet("quiet")) {
+        // JSON 输出到标准输出时, 文本报告改写到标准错误
+        const bool jsonToStdout = parser.value("json") == "-";
+        QTextStream(jsonToStdout ? stderr : stdout) << LoadReportFormat::toText(report);
+    }
+    if (parser.isSet("json") && !LoadReportFormat::writeJson(report, parser.value("json"))) {
+        err << "Failed to write JSON results to " << parser.value("json") << "\n";
+        return 1;
+    }
+    return report.total.ops > 0 ? 0 : 1;
+}